@@ -305,6 +305,28 @@ For help, run code with no arguments
  Mar 20 2205: replace a few SIM_TEMPLATE_INDEX>0 with SIM_TEMPLATE_INDEX!=0 ..
               because 91bg is a contaminant with SIM_TEMPLATE_INDEX = -9
 
+ Oct 2026: new input fitgrad_analytic=1 computes chi2 gradient w.r.t.
+           alpha, beta, gamma and M0 params in the same data pass as chi2,
+           and passes it to MINUIT (SET GRAdient); MINUIT checks it
+           against numerical derivatives before accepting it.
+
+ Oct 2026: new input SUBPROCESS_SHM=<name> to exchange GENPDF maps and
+           output tables with python driver via POSIX shared memory
+           instead of SUBPROCESS text files (see SUBPROCESS_HELP).
+
+ Oct 2026: store biasCor cell index (J1D) and 1/muerr^2 weight for each
+           biasCor event once, instead of re-computing them for each
+           map (binavg, each fitPar). The sigmu map uses its own coarser
+           cells and is unchanged.
+
+ Oct 2026: new input NPROC_SPLITRAN=<n> forks <n> processes after data,
+           biasCor and CCprior are read once, and runs the NSPLITRAN
+           fits concurrently (see SPLITRAN_FORK_DRIVER).
+
+ Oct 2026: cosmodl evaluates comoving-distance integral from a z-grid
+           table (sntools_cosmology) that is re-filled only when cosPar
+           changes; rombint is used for any other cosPar.
+
  ******************************************************/
 
 #include "sntools.h" 
@@ -313,6 +335,10 @@ For help, run code with no arguments
 #include <gsl/gsl_fit.h>  // Jun 13 2016
 #include <sys/types.h>
 #include <sys/stat.h>
+#include <sys/wait.h>   // Oct 2026: waitpid for NPROC_SPLITRAN
+#include <sys/mman.h>   // Oct 2026: shared memory for SUBPROCESS_SHM
+#include <fcntl.h>
+#include <errno.h>
 
 #define USE_THREAD   // Sep 2020 : used in SUBPROCESS mode
 
@@ -844,6 +870,9 @@ struct {
   // alpha,beta,z binning
   int8_t  *IA, *IB, *IG; // store alpha,beta,gamma index for each event
   int8_t  *IZ, *iz ;     // store redshift index for each event
+  int     *J1D ;         // store biasCor cell index for each event
+  double  *WGT1 ;        // store WGT_biasCor(opt=1) for each event
+  bool    USE_J1D_STORE; // true -> J1D_biasCor returns stored J1D
 
   BININFO_DEF BININFO_SIM_ALPHA ; 
   BININFO_DEF BININFO_SIM_BETA ;
@@ -1047,6 +1076,7 @@ struct INPUTS {
   
   int    minos;  // 1 -> use minos for full fit (very slow)
   int    minos2; // 1 -> use minos only for repeat after crazy errors
+  int    fitgrad_analytic; // 1 -> analytic chi2 gradient for MINUIT
 
   int    nmax_tot ;   // Nmax to fit for all
   int    nmax_survey[MXIDSURVEY];       // idem by survey
@@ -1214,6 +1244,7 @@ struct INPUTS {
 
   int NSPLITRAN ;       // number of random subsets to split jobs
   int JOBID_SPLITRAN ;  // do only this JOBID among NSPLITRAN
+  int NPROC_SPLITRAN ;  // number of forked processes for NSPLITRAN jobs
 
   int iflag_duplicate;
 
@@ -1316,6 +1347,8 @@ struct {
   int IPARMAP_MN[MAXPAR];  // map minuit ipar to user ipar
   int IPARMAPINV_MN[MAXPAR];
 
+  bool USE_GRAD ; // true -> fcn returns analytic gradient (Oct 2026)
+
 } FITINP ; 
 
 
@@ -1359,6 +1392,8 @@ typedef struct {
   double nsnfitIa, nsnfitcc ;   // note double for sum of BBC Probs
   int    nsnfit, nsnfit_truecc ;
   int    nsnspecIa ; // Dec 1 2024
+
+  double grad_fcn[MAXPAR] ; // d(chi2)/d(xval) for iflag=2 (Oct 2026)
   
 } thread_chi2sums_def ;
 
@@ -1579,6 +1614,12 @@ void   get_INTERPWGT_abg(double alpha,double beta,double gammadm, int DUMPFLAG,
 
 void   fcnFetch_AlphaBetaGamma(double *xval, double z, double logmass,
 			       double *alpha, double *beta, double *gammadm );
+void   fcnDeriv_AlphaBetaGamma(double *xval, double z, double logmass,
+			       double *DALPHA, double *DBETA, double *DGAMMADM);
+void   get_INTERPWGT_abg_deriv(double alpha, double beta, double gammadm,
+			       INTERPWGT_AlphaBetaGammaDM *INTERPWGT,
+			       double (*DWGT)[MXa][MXb][MXg] );
+void   set_fitgrad_analytic(void);
 
 void   read_simFile_CCprior(void);
 void   store_INFO_CCPRIOR_CUTS(void);
@@ -1661,6 +1702,15 @@ void   get_muBias(char *NAME,
 		  double *muBias, double *muBiasErr, 
 		  double *muCOVscale, double *muCOVadd, int *nevt_biascor ) ;
 
+void   get_muBias_deriv(char *NAME, 
+			BIASCORLIST_DEF *BIASCORLIST,  
+			FITPARBIAS_DEF (*FITPARBIAS_ABGRID)[MXb][MXg],
+			double         (*MUCOVSCALE_ABGRID)[MXb][MXg],
+			double         (*MUCOVADD_ABGRID)[MXb][MXg],
+			INTERPWGT_AlphaBetaGammaDM *INTERPWGT,  
+			double (*DWGT)[MXa][MXb][MXg],
+			double *dmuBias, double *dmuCOVscale, double *dmuCOVadd);
+
 double get_gammadm_host(double z, double logmass, double *hostPar);
 
 void  set_defaults(void);
@@ -1710,6 +1760,8 @@ void  write_NWARN(FILE *fp, int FLAG) ;
 
 int   SPLITRAN_ACCEPT(int isn, int snid);
 void  SPLITRAN_cutmask(void);
+void  SPLITRAN_FORK_DRIVER(void);
+void  SPLITRAN_FORK_CHILD(int jobid);
 
 void  CPU_SUMMARY(void);
 
@@ -1727,6 +1779,14 @@ double cosmodl_forFit(double zhel, double zcmb, double *cosPar);
 double cosmodl(double zhel, double zcmb, double *cosPar);
 double inc    (double zcmb, double *cosPar);
 
+// Oct 2026: z-grid table of comoving-distance integral for cosmodl
+struct {
+  bool   VALID ;
+  double cosPar[NCOSPAR] ;   // OL, Ok, w0, wa used to fill table
+  COSMO_ZGRID_DEF ZGRID ;
+} COSMO_ZGRID_SALT2mu ;
+void   set_COSMO_ZGRID_SALT2mu(double *cosPar);
+
 void ludcmp(double* a, const int n, const int ndim, int* indx, 
 	    double* d, int* icon);
 void lubksb(const double* a, const int n, const int ndim, 
@@ -1737,6 +1797,7 @@ double rombint(double f(double z, double *cosPar),
 double avemag0_calc(int opt_dump);
 void   M0dif_calc(void) ;
 double fcn_M0(int n, double *M0LIST );
+double fcn_M0_wgt(int n, double *M0LIST, int *IZ, double *WGT);
 
 void   muerr_renorm(void);
 void   printCOVMAT(FILE *fp, int NPAR, int NPARz_write);
@@ -1772,6 +1833,9 @@ void   J1D_invert_I(int IDSAMPLE, int J1D, int *ia, int *ib, int *ig,
 void   get_J1DNBR_LIST(int IDSAMPLE, int J1D, int *NJ1DNBR, int *J1DNBR_LIST) ;
 double WGT_biasCor(int opt, int ievt, char *msg);
 double WGT_biasCor_population(int ievt, char *msg);
+double WGTCELL_biasCor(int ievt, char *msg);
+void   store_J1D_biasCor(void);
+void   store_WGT_biasCor(int IDSAMPLE);
 
 int validRowKey_TEXT(char *string) ; // see sntools_output_text.c
 
@@ -1856,6 +1920,11 @@ void SUBPROCESS_REMIND_STDOUT(void) ;
 void SUBPROCESS_STORE_BININFO(int itable, int ivar, char *string);
 void SUBPROCESS_MAP1D_BININFO(int itable);
 void SUBPROCESS_OUTPUT_TABLE_HEADER(int itable);
+void SUBPROCESS_READ_GENPDF_FILE(int ITER_EXPECT);
+
+void SUBPROCESS_SHM_INIT(void);
+void SUBPROCESS_SHM_READ_GENPDF(int ITER_EXPECT);
+void SUBPROCESS_SHM_WRITE_OUTPUT(void);
 
 #include "sntools_genPDF.h" 
 #include "sntools_genPDF.c"
@@ -1869,6 +1938,43 @@ void SUBPROCESS_OUTPUT_TABLE_HEADER(int itable);
 #define SUBPROCESS_OPTMASK_WRM0DIF  2 // write M0DIF file for each iteration
 #define SUBPROCESS_OPTMASK_RANSEED  4 // Use different set of randoms for each reweight event
 
+// Oct 2026: shared-memory transport (SUBPROCESS_SHM=<name>).
+// Memory layout is
+//   HEADER | INP region (GENPDF maps) | OUT region (fit results, tables)
+// INP region: int32 NMAP, int32 unused, then for each map a
+//   SUBPROCESS_SHM_MAP_DEF followed by (NDIM+1)*NROW doubles stored
+//   column by column (NDIM grid columns, then PROB column).
+// OUT region: SUBPROCESS_SHM_OUTHEAD_DEF, MAXPAR SUBPROCESS_SHM_FITPAR_DEF,
+//   then for each table: int32 NVAR, int32 NBINTOT, and NBINTOT rows of
+//   (NVAR+4) doubles: ibin per var, NEVT, MURES_SUM, STD, STD_ROBUST.
+#define SUBPROCESS_SHM_MAGIC     0x53414C54  // "SALT"
+#define SUBPROCESS_SHM_VERSION   1
+#define MXCHAR_SHM_VARNAMES      200
+
+typedef struct {
+  int32_t MAGIC, VERSION ;
+  int32_t ITER_INP ;  // set by driver after loading INP region
+  int32_t ITER_OUT ;  // set by SALT2mu after loading OUT region
+  int64_t SIZE_TOT ;
+  int64_t OFFSET_INP, SIZE_INP ;
+  int64_t OFFSET_OUT, SIZE_OUT ;
+} SUBPROCESS_SHM_HEADER_DEF ;
+
+typedef struct {
+  char    VARNAMES[MXCHAR_SHM_VARNAMES]; // e.g., "SIM_c HOST_LOGMASS PROB"
+  int32_t NDIM, NROW ;
+} SUBPROCESS_SHM_MAP_DEF ;
+
+typedef struct {
+  int32_t ITER, NSNFIT, NFITPAR, N_TABLE ;
+  double  CPU_MINUTES, CHI2_MIN, AVEMAG0, MAXPROB_RATIO ;
+} SUBPROCESS_SHM_OUTHEAD_DEF ;
+
+typedef struct {
+  char    NAME[24];
+  double  VAL, ERR ;
+} SUBPROCESS_SHM_FITPAR_DEF ;
+
 #define VARNAME_SIM_AV   "SIM_AV"
 #define VARNAME_SIM_RV   "SIM_RV"
 #define VARNAME_SIM_EBV  "SIM_EBV"
@@ -1912,12 +2018,16 @@ struct {
   int    NEVT_SIM_PRESCALE ;   // tune sim prescale to fit this many
   int    INPUT_ISEED;         // random seed
   int    STDOUT_CLOBBER; // default=T ==> rewind FP_STDOUT each iter
+  char   INPUT_SHM_NAME[MXCHAR_FILENAME]; // optional shared-memory name
   
   // variables below are computed/extracted from INPUT_xxx
   char  *INPFILE ; // read PDF map from here
   char  *OUTFILE ; // write info back to python driver
   char  *STDOUT_FILE ; // direct stdout here (used only for visual debug)
   FILE  *FP_INP, *FP_OUT ;
+  bool   USE_SHM ;    // true -> INPFILE and OUTFILE replaced by shm
+  char  *SHM_PTR ;    // start of mapped shared memory
+  SUBPROCESS_SHM_HEADER_DEF *SHM_HEADER ;
   char   VARNAMES_GENPDF[MXVAR_GENPDF][40];
   int   NVAR_GENPDF;
   int   IVAR_TABLE_GENPDF[MXMAP_GENPDF][MXVAR_GENPDF]; // map GENPDF <-> TABLE
@@ -1969,6 +2079,11 @@ int main(int argc,char* argv[ ]) {
   if (argc < 2) { print_SALT2mu_HELP();  exit(0); }
 
   SALT2mu_DRIVER_INIT(argc,argv);
+
+  // Oct 2026: run SPLITRAN fits in forked processes sharing loaded data
+  if ( INPUTS.NPROC_SPLITRAN > 1 && INPUTS.NSPLITRAN > 1 && 
+       INPUTS.JOBID_SPLITRAN < 0 ) 
+    { SPLITRAN_FORK_DRIVER(); return(0); }
   
   NCALL_SALT2mu_DRIVER_EXEC = 0;
 
@@ -2146,6 +2261,9 @@ void SALT2mu_DRIVER_EXEC(void) {
   // execuate minuit mnparm_ commands
   exec_mnparm(); 
 
+  // check option for analytic chi2 gradient (Oct 2026)
+  set_fitgrad_analytic();
+
   // use FCN call and make chi2-outlier cut (Jul 19 2019)
   applyCut_chi2max();
 
@@ -2406,6 +2524,62 @@ void exec_mnparm(void) {
   return ;
   
 } // end exec_mnparm
+// ==============================================
+void set_fitgrad_analytic(void) {
+
+  // Created Oct 2026
+  // If user requests fitgrad_analytic=1, check that each floated
+  // parameter has an analytic chi2 derivative in MNCHI2FUN; if so, 
+  // tell MINUIT to use the gradient computed in fcn (iflag=2).
+  // MINUIT compares the analytic and numerical gradient before
+  // the first MIGRAD iteration and refuses a gradient that disagrees.
+  // Otherwise print reason and continue with numerical derivatives.
+
+  int  i, icondn, len ;
+  const int null=0;
+  char text[100], reason[100] ;
+  //  char fnam[] = "set_fitgrad_analytic" ;
+
+  // -------------- BEGIN --------------
+
+  FITINP.USE_GRAD = false ;
+  if ( !INPUTS.fitgrad_analytic ) { return ; }
+
+  reason[0] = 0 ;
+  if ( INFO_CCPRIOR.USE ) 
+    { sprintf(reason,"CC prior (BEAMS) chi2"); }
+  else if ( INPUTS.FLOAT_COSPAR ) 
+    { sprintf(reason,"floated cosmology params"); }
+  else if ( !INPUTS.ISMODEL_LCFIT_SALT2 ) 
+    { sprintf(reason,"LCFIT model is not SALT2"); }
+  else {
+    for (i=0; i < MXCOSPAR; i++ ) {
+      if ( !FITINP.ISFLOAT[i] ) { continue; }
+      if ( i==IPAR_ALPHA0 || i==IPAR_BETA0 || i==3 || i==4 ) { continue; }
+      if ( i==IPAR_GAMMA0 || i==IPAR_GAMMA1 || i==15 || i==16) { continue; }
+      sprintf(reason,"floated param %s", FITRESULT.PARNAME[i]);
+      break ;
+    }
+  }
+
+  if ( strlen(reason) > 0 ) {
+    fprintf(FP_STDOUT, "\n fitgrad_analytic disabled: %s \n", reason);
+    fprintf(FP_STDOUT, "\t -> use numerical derivatives.\n");
+    fflush(FP_STDOUT);
+    return ;
+  }
+
+  fprintf(FP_STDOUT, "\n fitgrad_analytic: pass analytic chi2 gradient "
+	  "to MINUIT\n");
+  fflush(FP_STDOUT);
+
+  FITINP.USE_GRAD = true ;
+  sprintf(text,"SET GRA");  len = strlen(text);
+  mncomd_(fcn, text, &icondn, &null, len);
+
+  return ;
+
+} // end set_fitgrad_analytic
 
 
 // ***********************************************
@@ -4008,6 +4182,9 @@ void fcn(int *npar, double grad[], double *fval, double xval[],
     if ( isinf(xval[ipar]) ) { *fval = 1.0E14; return; }
   }
 
+  // refill distance table (before threads) if cosmology params float
+  if ( INPUTS.FLOAT_COSPAR ) { set_COSMO_ZGRID_SALT2mu(&xval[IPAR_OL]); }
+
   if ( nthread == 1 ) 
     { NSN_per_thread = NSN_DATA; }
   else
@@ -4082,6 +4259,15 @@ void fcn(int *npar, double grad[], double *fval, double xval[],
   }
 
 
+  // sum analytic gradient over threads (Oct 2026)
+  if ( *iflag == 2 && FITINP.USE_GRAD ) {
+    for(ipar=0; ipar < NFITPAR_ALL; ipar++ ) {
+      grad[ipar] = 0.0 ;
+      for ( t = 0; t < nthread; t++ ) 
+	{ grad[ipar] += thread_chi2sums[t].grad_fcn[ipar]; }
+    }
+  }
+
   // load globals
   FITRESULT.NSNFIT        = nsnfit ;
   FITRESULT.NSNFIT_TRUECC = nsnfit_truecc ;
@@ -4120,6 +4306,7 @@ void *MNCHI2FUN(void *thread) {
   // Apr 8 2021: subtract muerr_vpec from muerr_raw
   // Sep 24 2021: abort on muerrsq < 0
   // Sep 27 2021: require muCOVadd>0 to implement; fixes rare muerrsq<0 problem.
+  // Oct 2026: for iflag=2, accumulate analytic gradient in grad_fcn.
 
   thread_chi2sums_def *thread_chi2sums = (thread_chi2sums_def *)thread;
   //  int  npar      = thread_chi2sums->npar_fcn ;
@@ -4173,9 +4360,21 @@ void *MNCHI2FUN(void *thread) {
   double   *fitParBias;
 
   bool LDMP = ISMODEL_LCFIT_BAYESN ;
+
+  // analytic gradient: index 0,1,2 -> d/dalpha, d/dbeta, d/dgammaDM
+  bool   DO_GRAD   = ( iflag == 2 && FITINP.USE_GRAD );
+  double *grad_fcn = thread_chi2sums->grad_fcn ;
+  double DWGT[3][MXa][MXb][MXg], dmuBias[3], dmuCOVscale[3], dmuCOVadd[3];
+  double DALPHA[MXCOSPAR], DBETA[MXCOSPAR], DGAMMADM[MXCOSPAR];
+  double dmures[3], dmuerrsq[3], dmuerrsq_lc[3], dchi2[3], VEC[NLCPAR];
+  double muerrsq_lc=0.0, dchi2_dM0, WGT_M0[2];
+  int    IZ_M0[2], k ;
   
   // -------------- BEGIN ------------
 
+  if ( DO_GRAD ) 
+    { for(ipar=0; ipar < MAXPAR; ipar++ ) { grad_fcn[ipar] = 0.0; } }
+
   //Set input cosmology parameters
   //  alpha0       = xval[IPAR_ALPHA0] ;
   //  beta0        = xval[IPAR_BETA0] ;
@@ -4326,7 +4525,7 @@ void *MNCHI2FUN(void *thread) {
     DUMPFLAG = 0 ;
 
     // get mag offset for this z-bin
-    M0    = fcn_M0(n, &xval[MXCOSPAR] );
+    M0    = fcn_M0_wgt(n, &xval[MXCOSPAR], IZ_M0, WGT_M0 );
 
     // compute distance modulus from cosmology params
     if ( INPUTS.FLOAT_COSPAR ) {
@@ -4346,6 +4545,7 @@ void *MNCHI2FUN(void *thread) {
     // compute error-squared on distance mod
     muerrsq  = fcn_muerrsq(name, alpha, beta, gamma, covmat_tot,
 			   z, zmuerr, optmask_muerrsq );
+    muerrsq_lc = muerrsq ; // before biasCor scale or add
 
 
     // --------------------------------
@@ -4585,6 +4785,62 @@ void *MNCHI2FUN(void *thread) {
     chi2sum_tot      += chi2evt;
     INFO_DATA.chi2[n] = chi2evt; // store each chi2 to allow for outlier cut
 
+    // - - - - - - 
+    // analytic gradient; chain rule through local alpha, beta, gammaDM
+    // (mu, muBias, muerrsq) and through M0 (Oct 2026)
+    if ( DO_GRAD && !USE_CCPRIOR ) {
+      for(k=0; k < 3; k++ ) 
+	{ dmuBias[k] = dmuCOVscale[k] = dmuCOVadd[k] = dmuerrsq_lc[k] = 0.0; }
+
+      if ( NDIM_BIASCOR >= 5 && INTERPFLAG_abg ) {
+	get_INTERPWGT_abg_deriv(alpha, beta, gammaDM, &INTERPWGT, DWGT);
+	get_muBias_deriv(name, &BIASCORLIST, FITPARBIAS_ALPHABETA, 
+			 MUCOVSCALE_ALPHABETA, MUCOVADD_ALPHABETA, 
+			 &INTERPWGT, DWGT, 
+			 dmuBias, dmuCOVscale, dmuCOVadd );
+      }
+
+      // muerrsq_lc = VEC x COV x VEC with VEC = (1,alpha,-beta)
+      if ( !set_fitwgt0 ) {
+	VEC[INDEX_d] = 1.0;  VEC[INDEX_s] = alpha;  VEC[INDEX_c] = -beta;
+	for(ipar=0; ipar < NLCPAR; ipar++ ) {
+	  dmuerrsq_lc[0] += (covmat_tot[INDEX_s][ipar] + 
+			     covmat_tot[ipar][INDEX_s]) * VEC[ipar] ;
+	  dmuerrsq_lc[1] -= (covmat_tot[INDEX_c][ipar] + 
+			     covmat_tot[ipar][INDEX_c]) * VEC[ipar] ;
+	}
+      }
+
+      dmures[0] =  s   - dmuBias[0] ;
+      dmures[1] = -c   - dmuBias[1] ;
+      dmures[2] = -1.0 - dmuBias[2] ;
+
+      for(k=0; k < 3; k++ ) {
+	if ( APPLY_COVADD ) 
+	  { dmuerrsq[k] = dmuerrsq_lc[k] + dmuCOVadd[k]; }
+	else {
+	  dmuerrsq[k] = dmuerrsq_lc[k] * muCOVscale + 
+	    (muerrsq_lc - muerrsq_vpec) * dmuCOVscale[k] ;
+	}
+
+	dchi2[k] = 2.0*mures*dmures[k]/muerrsq - 
+	  sqmures*dmuerrsq[k]/(muerrsq*muerrsq) ;
+	if ( INPUTS.fitflag_sigmb == 2 ) 
+	  { dchi2[k] += dmuerrsq[k]/muerrsq ; }
+      }
+
+      fcnDeriv_AlphaBetaGamma(xval, z, logmass, DALPHA, DBETA, DGAMMADM);
+      for(ipar=0; ipar < MXCOSPAR; ipar++ ) {
+	grad_fcn[ipar] += ( dchi2[0]*DALPHA[ipar] + dchi2[1]*DBETA[ipar] +
+			    dchi2[2]*DGAMMADM[ipar] ) ;
+      }
+
+      dchi2_dM0 = -2.0*mures/muerrsq ;
+      for(k=0; k < 2; k++ ) 
+	{ grad_fcn[MXCOSPAR+IZ_M0[k]] += dchi2_dM0 * WGT_M0[k] ; }
+
+    } // end DO_GRAD
+
     // check things on final pass
     if (  iflag==3 ) {	
 
@@ -4713,14 +4969,66 @@ void  fcnFetch_AlphaBetaGamma(double *xval, double z, double logmass,
   return ;
 
 } // end fcnFetch_AlphaBetaGamma
+// ==============================================
+void  fcnDeriv_AlphaBetaGamma(double *xval, double z, double logmass, 
+			      double *DALPHA, double *DBETA, double *DGAMMADM) {
+
+  // Created Oct 2026
+  // Return derivatives of alpha, beta (from fcnFetch_AlphaBetaGamma)
+  // and gammaDM (from get_gammadm_host) w.r.t. each xval[ipar],
+  // for ipar < MXCOSPAR. Derivatives w.r.t. logmass_cen and logmass_tau
+  // are not computed; see set_fitgrad_analytic.
+
+  double logmass_cen = xval[7];
+  double logmass_tau = xval[8];
+  double dlogmass    = logmass - logmass_cen ;
+  double FermiFun ;
+  int    ipar ;
+
+  // ----------- BEGIN ------------
+
+  for(ipar=0; ipar < MXCOSPAR; ipar++ ) 
+    { DALPHA[ipar] = DBETA[ipar] = DGAMMADM[ipar] = 0.0 ; }
+
+  DALPHA[1] = 1.0 ;   DALPHA[3] = z ;
+  DBETA[2]  = 1.0 ;   DBETA[4]  = z ;
+
+  if ( INPUTS.ipar[15]<=1 || INPUTS.ipar[16]<=1 ) 
+    { DALPHA[15] += dlogmass ;  DBETA[16] += dlogmass ; }
+
+  if ( INPUTS.ipar[15]==2 || INPUTS.ipar[16]==2 ) {
+    if ( dlogmass > 0.0 ) 
+      { DALPHA[15] += 0.5 ;  DBETA[16] += 0.5 ; }
+    else
+      { DALPHA[15] -= 0.5 ;  DBETA[16] -= 0.5 ; }
+  }
+
+  if ( INPUTS.USE_GAMMA0 ) {
+    FermiFun    = 1.0/(1.0 + exp(-dlogmass/logmass_tau) ) ;
+    DGAMMADM[5] = ( 0.5 - FermiFun ) ;
+    DGAMMADM[6] = ( 0.5 - FermiFun ) * z ;
+  }
+
+  return ;
+
+} // end fcnDeriv_AlphaBetaGamma
 
 // ================================
 double fcn_M0(int n, double *M0LIST) {
+  int    IZ[2];
+  double WGT[2];
+  return fcn_M0_wgt(n, M0LIST, IZ, WGT);
+} // end fcn_M0
+
+// ================================
+double fcn_M0_wgt(int n, double *M0LIST, int *IZ, double *WGT) {
 
   // return model M0 for this data index 'n'
   // and list of M0LIST in each z bin
   // Jun 27 2017: REFACTOR z bins
   // Jan 29 2019: if no iz1 bin, return(M0) instead of retrn(M0bin0)
+  // Oct 2026: rename fcn_M0 -> fcn_M0_wgt and return z-bin indices IZ 
+  //           and weights WGT such that d(M0)/d(M0LIST[IZ[i]]) = WGT[i]
 
   int LDMP=0;
   int iz, iz0, iz1, NBINz, NSN_BIASCOR ;
@@ -4732,6 +5040,8 @@ double fcn_M0(int n, double *M0LIST) {
   M0      = INPUTS.M0 ;
 
   iz0     = INFO_DATA.TABLEVAR.IZBIN[n];
+  IZ[0]   = IZ[1]  = iz0 ;
+  WGT[0]  = WGT[1] = 0.0 ;
   zdata   = INFO_DATA.TABLEVAR.zhd[n];
   ptr_zM0 = INFO_BIASCOR.zM0 ;
   NSN_BIASCOR = INFO_BIASCOR.TABLEVAR.NSN_ALL ;
@@ -4740,6 +5050,7 @@ double fcn_M0(int n, double *M0LIST) {
        INPUTS.uM0 == M0FITFLAG_ZBINS_FLAT ) {
     iz    = iz0;
     M0    = M0LIST[iz] ;
+    WGT[0] = 1.0 ;
   }
   else if ( INPUTS.uM0 == M0FITFLAG_ZBINS_INTERP ) {
     // linear interp
@@ -4782,6 +5093,7 @@ double fcn_M0(int n, double *M0LIST) {
 
     zfrac = ( zdata - zbin0 ) / ( zbin1 - zbin0) ;
     M0    = M0bin0 + (M0bin1-M0bin0) * zfrac ;
+    IZ[1] = iz1;  WGT[0] = 1.0 - zfrac;  WGT[1] = zfrac ;
 
     LDMP = (n == -95 ); // xxx REMOVE
     if ( LDMP ) {    
@@ -4804,7 +5116,7 @@ double fcn_M0(int n, double *M0LIST) {
 
   return(M0);
 
-} // end fcn_M0
+} // end fcn_M0_wgt
 
 
 
@@ -5047,6 +5359,110 @@ void get_INTERPWGT_abg(double alpha, double beta, double gammadm, int DUMPFLAG,
   
 } // end get_INTERPWGT_abg
 
+// ==============================================
+void get_INTERPWGT_abg_deriv(double alpha, double beta, double gammadm,
+			     INTERPWGT_AlphaBetaGammaDM *INTERPWGT,
+			     double (*DWGT)[MXa][MXb][MXg] ) {
+
+  // Created Oct 2026
+  // Inputs alpha, beta, gammadm and INTERPWGT are the same as those
+  // passed to (and returned by) get_INTERPWGT_abg.
+  // Output DWGT[k][ia][ib][ig] = d(WGT[ia][ib][ig])/dX 
+  // with X = alpha, beta, gammadm for k = 0, 1, 2.
+  // The normalized weights are WGT = w/SUM(w); thus
+  //    dWGT = ( dw - WGT*SUM(dw) ) / SUM(w)
+  // Derivative is zero along a grid axis where the input is clamped
+  // to the grid boundary or where there is only one bin.
+
+  BININFO_DEF *BININFO[3] ;
+  double X[3], X_interp[3], binSize[3], DX[3], SIGN[3], DERIV[3] ;
+  int    NBIN[3], IBIN[3], ia, ib, ig, k ;
+  double w[MXa][MXb][MXg], dw[3][MXa][MXb][MXg] ;
+  double SUMW = 0.0, SUMDW[3] = { 0.0, 0.0, 0.0 } ;
+  char fnam[] = "get_INTERPWGT_abg_deriv" ;
+
+  // ------------------ BEGIN ---------------
+
+  for(k=0; k < 3; k++ ) {
+    for(ia=0; ia < MXa; ia++ ) {
+      for(ib=0; ib < MXb; ib++ ) {
+	for(ig=0; ig < MXg; ig++ ) 
+	  { DWGT[k][ia][ib][ig] = dw[k][ia][ib][ig] = w[ia][ib][ig] = 0.0; }
+      }
+    }
+  }
+
+  if ( INPUTS.ISMODEL_LCFIT_BAYESN ) { return ; }
+
+  BININFO[0] = &INFO_BIASCOR.BININFO_SIM_ALPHA ;
+  BININFO[1] = &INFO_BIASCOR.BININFO_SIM_BETA ;
+  BININFO[2] = &INFO_BIASCOR.BININFO_SIM_GAMMADM ;
+  X[0] = alpha;  X[1] = beta;  X[2] = gammadm ;
+
+  for(k=0; k < 3; k++ ) {
+    NBIN[k]     = BININFO[k]->nbin ;
+    binSize[k]  = BININFO[k]->binSize ;
+    IBIN[k]     = IBINFUN(X[k], BININFO[k], 2, fnam );
+    X_interp[k] = X[k] ;
+    DERIV[k]    = 1.0 ;
+    if ( X[k] < BININFO[k]->avg[0] ) 
+      { X_interp[k] = BININFO[k]->avg[0];  DERIV[k] = 0.0 ; }
+    if ( X[k] > BININFO[k]->avg[NBIN[k]-1] ) 
+      { X_interp[k] = BININFO[k]->avg[NBIN[k]-1];  DERIV[k] = 0.0 ; }
+    if ( NBIN[k] <= 1 ) { DERIV[k] = 0.0 ; }
+  }
+
+  // same grid loop as in get_INTERPWGT_abg, but also store dw/dX
+  for(ia=IBIN[0]-1; ia <= IBIN[0]+1; ia++ ) {
+    if ( ia < 0 || ia >= NBIN[0] ) { continue ; }
+    for(ib=IBIN[1]-1; ib <= IBIN[1]+1; ib++ ) {
+      if ( ib < 0 || ib >= NBIN[1] ) { continue ; }
+      for(ig=IBIN[2]-1; ig <= IBIN[2]+1; ig++ ) {
+	if ( ig < 0 || ig >= NBIN[2] ) { continue ; }
+
+	DX[0] = X_interp[0] - BININFO[0]->avg[ia] ;
+	DX[1] = X_interp[1] - BININFO[1]->avg[ib] ;
+	DX[2] = X_interp[2] - BININFO[2]->avg[ig] ;
+
+	for(k=0; k < 3; k++ ) {
+	  SIGN[k] = 0.0 ;
+	  if ( DX[k] > 0.0 ) { SIGN[k] = +1.0; }
+	  if ( DX[k] < 0.0 ) { SIGN[k] = -1.0; }
+	  if ( NBIN[k] > 1 ) 
+	    { DX[k] = fabs(DX[k])/binSize[k]; SIGN[k] /= binSize[k]; }
+	  else
+	    { DX[k] = 0.0 ; }
+	  if ( DX[k] > 0.99999 ) { break; }
+	}
+	if ( k < 3 ) { continue ; }
+
+	w[ia][ib][ig] = (1.0-DX[0]) * (1.0-DX[1]) * (1.0-DX[2]) ;
+	dw[0][ia][ib][ig] = -SIGN[0]*DERIV[0] * (1.0-DX[1]) * (1.0-DX[2]);
+	dw[1][ia][ib][ig] = -SIGN[1]*DERIV[1] * (1.0-DX[0]) * (1.0-DX[2]);
+	dw[2][ia][ib][ig] = -SIGN[2]*DERIV[2] * (1.0-DX[0]) * (1.0-DX[1]);
+
+	SUMW += w[ia][ib][ig] ;
+	for(k=0; k < 3; k++ ) { SUMDW[k] += dw[k][ia][ib][ig] ; }
+      }
+    }
+  }
+
+  if ( SUMW < 1.0E-9 ) { return ; } // get_INTERPWGT_abg already aborted
+
+  for(ia=INTERPWGT->ia_min; ia <= INTERPWGT->ia_max; ia++ ) {
+    for(ib=INTERPWGT->ib_min; ib <= INTERPWGT->ib_max; ib++ ) {
+      for(ig=INTERPWGT->ig_min; ig <= INTERPWGT->ig_max; ig++ ) {
+	for(k=0; k < 3; k++ ) {
+	  DWGT[k][ia][ib][ig] = 
+	    ( dw[k][ia][ib][ig] - INTERPWGT->WGT[ia][ib][ig]*SUMDW[k] )/SUMW;
+	}
+      }
+    }
+  }
+
+  return ;
+
+} // end get_INTERPWGT_abg_deriv
 
 // ===========================================================
 double fcn_muerrsq(char *name, double alpha, double beta, double gamma,
@@ -5404,6 +5820,7 @@ void set_defaults(void) {
   INPUTS.write_chi2grid  = 0 ;
 
   INPUTS.minos      = 0 ; // disable default minos, Apr 22 2022
+  INPUTS.fitgrad_analytic = 0 ;
   INPUTS.nfile_data = 0 ;
   INPUTS.nfile_data_override = 0 ;
   sprintf(INPUTS.PREFIX,     "NONE" );
@@ -5443,6 +5860,7 @@ void set_defaults(void) {
 
   INPUTS.NSPLITRAN      = 1; // default is all SN in one job
   INPUTS.JOBID_SPLITRAN = -9;
+  INPUTS.NPROC_SPLITRAN = 1;
 
   INPUTS.iflag_duplicate = IFLAG_DUPLICATE_ABORT ;
 
@@ -5660,6 +6078,8 @@ void set_defaults(void) {
   SUBPROCESS.INPUT_ISEED = 12345;
   SUBPROCESS.STDOUT_CLOBBER  = 1; // default is to clobber each stdout
   SUBPROCESS.NEVT_SIM_PRESCALE     = -9; 
+  SUBPROCESS.INPUT_SHM_NAME[0]     = 0 ;
+  SUBPROCESS.USE_SHM               = false ;
 #endif
 
 
@@ -6246,6 +6666,8 @@ void read_data_override(void) {
   //   + avoid double-counting zHD override if zHEL and VPEC are both
   //      on override list. Same for zHDERR with ZHELERR and VPECERR.
   //
+  // Oct 2026: resolve AUTOSTORE handle once per override variable,
+  //           and read with hash lookup per event.
 
   int IVAR_OVER_VPEC = -9, IVAR_OVER_VPECERR = -9 ;
   int IVAR_OVER_zHEL = -9, IVAR_OVER_zHELERR = -9 ;
@@ -6441,11 +6863,16 @@ void read_data_override(void) {
   // and replace value.
 
   int NSN_DATA = INFO_DATA.TABLEVAR.NSN_ALL ;
-  int istat, isn;
+  int istat, isn, HANDLE_OVER[MXVAR_OVERRIDE];
   bool  override_zhd, override_zhderr;
   double dval;    char *name, cval[20] ;
   double zhd_over, zhderr_over, dl, zhel_over, zhd_orig, zhel_orig ;
 
+  for(ivar_over=0; ivar_over < NVAR_OVER; ivar_over++ ) {
+    varName = INFO_DATA.VARNAMES_OVERRIDE[ivar_over];
+    HANDLE_OVER[ivar_over] = HANDLE_VARNAME_AUTOSTORE(varName);
+  }
+
   for(isn=0; isn < NSN_DATA; isn++ ) { 
 
     zhd_orig   = (double)INFO_DATA.TABLEVAR.zhd[isn];
@@ -6458,8 +6885,8 @@ void read_data_override(void) {
       if ( ivar_over == IVAR_OVER_zHDERR ) { continue ; }
 
       name    = INFO_DATA.TABLEVAR.name[isn];
-      varName = INFO_DATA.VARNAMES_OVERRIDE[ivar_over];
-      SNTABLE_AUTOSTORE_READ(name, varName, &istat, &dval, cval );      
+      SNTABLE_AUTOSTORE_READ_HANDLE(name, HANDLE_OVER[ivar_over], 
+				    &istat, &dval, cval );      
 
       // xxxxxxx
       if ( istat == -99990 ) {
@@ -6669,6 +7096,9 @@ void malloc_INFO_BIASCOR(int opt, int LEN_MALLOC ) {
     malloc_TABLEVAR(opt, LEN_MALLOC, &INFO_BIASCOR.TABLEVAR);
     free(INFO_BIASCOR.iz); free(INFO_BIASCOR.IZ);
     free(INFO_BIASCOR.IA); free(INFO_BIASCOR.IB);
+    if ( INFO_BIASCOR.USE_J1D_STORE ) 
+      { free(INFO_BIASCOR.J1D); free(INFO_BIASCOR.WGT1); }
+    INFO_BIASCOR.USE_J1D_STORE = false ;
   }
 
 
@@ -9968,6 +10398,9 @@ void prepare_biasCor(void) {
   // make sparse list for each IDSAMPLE: for faster looping below
   makeSparseList_biasCor();
 
+  // store cell index for each biasCor event used in maps
+  store_J1D_biasCor();
+
   // determine sigInt for biasCor sample BEFORE makeMap since
   // sigInt is needed for 1/muerr^2 weight
   for(IDSAMPLE=0; IDSAMPLE < NSAMPLE_BIASCOR ; IDSAMPLE++ )  {  
@@ -10012,6 +10445,9 @@ void prepare_biasCor(void) {
     }
     fflush(FP_STDOUT);
 
+    // store 1/muerr^2 weight for each event used in maps below
+    store_WGT_biasCor(IDSAMPLE);
+
     // get wgted avg in each bin to use for interpolation 
     makeMap_binavg_biasCor(IDSAMPLE);
 
@@ -10894,6 +11330,7 @@ void makeMap_fitPar_biasCor(int IDSAMPLE, int ipar_LCFIT) {
   //
   // Aug 26 2019: account for gammadm
   // Feb 24 2020: update for ipar_LCFIT = index_mu
+  // Oct 2026: use stored WGT1 and J1D for each event
   //
   // - - - - - - - - - -
 
@@ -10976,9 +11413,10 @@ void makeMap_fitPar_biasCor(int IDSAMPLE, int ipar_LCFIT) {
 
     biasVal = fit_val - sim_val ; 
 
-    WGT     = WGT_biasCor(2,ievt,fnam) ;  // WGT= WGT_pop * 1/muerr^2 for wgted average
+    // WGT = WGT_pop * 1/muerr^2 * WGTCELL for wgted average
+    WGT     = INFO_BIASCOR.WGT1[ievt] * WGTCELL_biasCor(ievt,fnam) ;
     WGT_pop = WGT_biasCor_population(ievt,fnam) ;
-    J1D     = J1D_biasCor(ievt,fnam);     // 1D index
+    J1D     = J1D_biasCor(ievt,fnam);     // 1D index (stored)
 
     SUMBIAS[J1D]  += (WGT * biasVal) ;
     SUMWGT[J1D]   += WGT ;
@@ -11195,9 +11633,10 @@ double WGT_biasCor(int opt, int ievt, char *msg ) {
   //
   // Aug 22 2019: include logmass dependence
   // Sep 27 2021: check INPUTS.interp_biascor_logmass
+  // Oct 2026: move cell-location weight to WGTCELL_biasCor
 
   int  USEMASK = USEMASK_BIASCOR_COVTOT + USEMASK_BIASCOR_ZMUERR;
-  int  istat_cov, J1D, idsample ;
+  int  istat_cov ;
   double WGT, muerrsq ;
   char fnam[] = "WGT_biasCor" ;
   
@@ -11210,7 +11649,26 @@ double WGT_biasCor(int opt, int ievt, char *msg ) {
 
   if ( opt == 1 ) { return(WGT); }
 
-  if ( INPUTS.sigma_cell_biasCor > 10.0 ) { return(WGT); } // default
+  WGT *= WGTCELL_biasCor(ievt,msg) ;
+
+  return(WGT);
+
+} // end WGT_biasCor
+
+// =====================================================
+double WGTCELL_biasCor(int ievt, char *msg) {
+
+  // Created Oct 2026 [code moved from WGT_biasCor]
+  // Return weight based on 3D/4D separation of biasCor event 
+  // from wgted-avg in its cell; WGT_CELL=1 for default sigma_cell.
+
+  int  J1D, idsample ;
+  char fnam[] = "WGTCELL_biasCor" ;
+
+  // --------------- BEGIN -------------------
+
+  if ( INPUTS.sigma_cell_biasCor > 10.0 ) { return(1.0); } // default
+
 
   // If we get here, compute additional weight based on 3D/4D
   // separation from wgted-avg in cell.
@@ -11247,11 +11705,10 @@ double WGT_biasCor(int opt, int ievt, char *msg ) {
   SQSIGMA_CELL = INPUTS.sigma_cell_biasCor * INPUTS.sigma_cell_biasCor ;
   ARG      = -0.5 * (SQD/SQSIGMA_CELL);
   WGT_CELL = exp(ARG) ;
-  WGT     *= WGT_CELL ;
+  return(WGT_CELL);
 
-  return(WGT);
 
-} // end WGT_biasCor
+} // end WGTCELL_biasCor
 
 // =====================================================
 double WGT_biasCor_population(int ievt, char *msg) {
@@ -11276,6 +11733,8 @@ int J1D_biasCor(int ievt, char *msg ) {
   // Created May 12 2016
   // For biasCor event "ievt", return 1D index to biasCor map.
   // *msg is used only for error message.
+  //
+  // Oct 2026: return stored index after store_J1D_biasCor is called.
 
   bool  ISMODEL_LCFIT_SALT2  = INPUTS.ISMODEL_LCFIT_SALT2;
   bool  ISMODEL_LCFIT_BAYESN = INPUTS.ISMODEL_LCFIT_BAYESN;
@@ -11290,6 +11749,8 @@ int J1D_biasCor(int ievt, char *msg ) {
 
   // -------------- BEGIN ------------
 
+  if ( INFO_BIASCOR.USE_J1D_STORE ) { return INFO_BIASCOR.J1D[ievt]; }
+
   J1D = -9 ;
 
   get_abg_biasCor(ievt, &a, &b, &g, fnam);
@@ -11340,6 +11801,68 @@ int J1D_biasCor(int ievt, char *msg ) {
 } // end J1D_biasCor
 
 
+// =====================================================
+void store_J1D_biasCor(void) {
+
+  // Created Oct 2026
+  // Store biasCor cell index J1D for each event in the sparse 
+  // (IROW_CUTS) list of each IDSAMPLE, so that each map below uses a 
+  // lookup instead of 7 IBINFUN calls per event. Events not in any
+  // sparse list have J1D=-9. Call after makeSparseList_biasCor.
+
+  int NROW = INFO_BIASCOR.TABLEVAR.NSN_ALL ;
+  int MEMI = (NROW+1) * sizeof(int);
+  int MEMD = (NROW+1) * sizeof(double);
+  int irow, isp, idsample, ievt, *J1D_TMP ;
+  char fnam[] = "store_J1D_biasCor" ;
+
+  // ------------ BEGIN ------------
+
+  INFO_BIASCOR.USE_J1D_STORE = false ;
+  J1D_TMP           = (int   *) malloc(MEMI);
+  INFO_BIASCOR.WGT1 = (double*) malloc(MEMD);
+
+  for(irow=0; irow < NROW; irow++ ) 
+    { J1D_TMP[irow] = -9;  INFO_BIASCOR.WGT1[irow] = 0.0 ; }
+
+  for(idsample=0; idsample < NSAMPLE_BIASCOR; idsample++ ) {
+    for(isp=0; isp < SAMPLE_BIASCOR[idsample].NBIASCOR_CUTS; isp++ ) {
+      ievt          = SAMPLE_BIASCOR[idsample].IROW_CUTS[isp];
+      J1D_TMP[ievt] = J1D_biasCor(ievt,fnam);
+    }
+  }
+
+  INFO_BIASCOR.J1D           = J1D_TMP ;
+  INFO_BIASCOR.USE_J1D_STORE = true ;
+
+  return ;
+
+} // end store_J1D_biasCor
+
+
+// =====================================================
+void store_WGT_biasCor(int IDSAMPLE) {
+
+  // Created Oct 2026
+  // Store WGT_biasCor(opt=1) = WGT_pop/muerr^2 for each event in
+  // sparse list of IDSAMPLE, so that it is computed once instead of
+  // once per map. Call after init_COVINT_biasCor.
+
+  int isp, ievt ;
+  char fnam[] = "store_WGT_biasCor" ;
+
+  // ------------ BEGIN ------------
+
+  for(isp=0; isp < SAMPLE_BIASCOR[IDSAMPLE].NBIASCOR_CUTS; isp++ ) {
+    ievt = SAMPLE_BIASCOR[IDSAMPLE].IROW_CUTS[isp];
+    INFO_BIASCOR.WGT1[ievt] = WGT_biasCor(1,ievt,fnam);
+  }
+
+  return ;
+
+} // end store_WGT_biasCor
+
+
 // ======================================================
 void  J1D_invert_D(int IDSAMPLE, int J1D, 
 		   double *a, double *b, double *g,
@@ -13122,9 +13645,9 @@ void  makeMap_binavg_biasCor(int IDSAMPLE) {
 
     irow = SAMPLE_BIASCOR[IDSAMPLE].IROW_CUTS[isp] ;
 
-    WGT = WGT_biasCor(1,irow,fnam) ;  // WGT = WGT_population * 1/muerr^2
+    WGT = INFO_BIASCOR.WGT1[irow] ;   // WGT = WGT_population * 1/muerr^2
 
-    J1D = J1D_biasCor(irow,fnam);     // 1D index
+    J1D = J1D_biasCor(irow,fnam);     // 1D index (stored)
     NperCell[J1D]++ ; // not used ??
     SUM_WGT_5D[J1D] += WGT ;
 
@@ -15029,6 +15552,100 @@ void get_muBias(char *NAME,
 
 } // end get_muBias
 
+// ==============================================
+void get_muBias_deriv(char *NAME,
+		      BIASCORLIST_DEF *BIASCORLIST, 
+		      FITPARBIAS_DEF (*FITPARBIAS_ABGRID)[MXb][MXg],
+		      double         (*MUCOVSCALE_ABGRID)[MXb][MXg],
+		      double         (*MUCOVADD_ABGRID)[MXb][MXg],
+		      INTERPWGT_AlphaBetaGammaDM *INTERPWGT,  
+		      double (*DWGT)[MXa][MXb][MXg],
+		      double *dmuBias, double *dmuCOVscale, double *dmuCOVadd) {
+
+  // Created Oct 2026
+  // Derivatives of get_muBias outputs w.r.t. X = alpha, beta, gammadm
+  // (index k = 0, 1, 2). DWGT = d(INTERPWGT->WGT)/dX is from
+  // get_INTERPWGT_abg_deriv. Grid nodes are skipped exactly as in
+  // get_muBias, and muBias = SUM MUCOEF*biasVal includes the explicit
+  // alpha and beta dependence of MUCOEF.
+
+  double alpha    = BIASCORLIST->alpha ;
+  double beta     = BIASCORLIST->beta  ;
+  bool DO_COVADD  = (INPUTS.opt_biasCor & MASK_BIASCOR_MUCOVADD  ) > 0;
+
+  int  ILCPAR_MIN = INFO_BIASCOR.ILCPAR_MIN ;
+  int  ILCPAR_MAX = INFO_BIASCOR.ILCPAR_MAX ;
+
+  double WGTabg, VAL, MUCOEF[NLCPAR+1], WGTpar_SUM[NLCPAR+1];
+  double biasVal[NLCPAR+1], dsumVal[3][NLCPAR+1], dWGTpar_SUM[3][NLCPAR+1];
+  double dbias ;
+  int  ia, ib, ig, ipar, k ;
+  //  char fnam[] = "get_muBias_deriv";
+
+  // --------------- BEGIN ------------
+
+  for(ipar=0; ipar < NLCPAR+1; ipar++ )  { 
+    biasVal[ipar] = WGTpar_SUM[ipar] = 0.0 ;
+    for(k=0; k < 3; k++ ) { dsumVal[k][ipar] = dWGTpar_SUM[k][ipar] = 0.0; }
+  }
+  for(k=0; k < 3; k++ ) 
+    { dmuBias[k] = dmuCOVscale[k] = dmuCOVadd[k] = 0.0 ; }
+
+  MUCOEF[INDEX_d]  = +1.0 ;
+  MUCOEF[INDEX_s]  = +alpha ;
+  MUCOEF[INDEX_c ] = -beta ;
+  MUCOEF[INDEX_mu] = +1.0 ;
+
+  for(ia=INTERPWGT->ia_min; ia <= INTERPWGT->ia_max; ia++ ) {
+    for(ib=INTERPWGT->ib_min; ib <= INTERPWGT->ib_max; ib++ ) {
+      for(ig=INTERPWGT->ig_min; ig <= INTERPWGT->ig_max; ig++ ) {
+      
+	WGTabg = INTERPWGT->WGT[ia][ib][ig] ;
+
+	if ( FITPARBIAS_ABGRID[ia][ib][ig].NEVT_BIASCOR == 0 ) { 
+	  if ( !INPUTS.restore_bug_WGTabg ) { continue; } 
+	}
+
+	for(ipar = ILCPAR_MIN; ipar <= ILCPAR_MAX ; ipar++ ) {
+	  VAL = FITPARBIAS_ABGRID[ia][ib][ig].VAL[ipar];
+	  WGTpar_SUM[ipar] += WGTabg ;
+	  biasVal[ipar]    += ( WGTabg * VAL );
+	  for(k=0; k < 3; k++ ) {
+	    dWGTpar_SUM[k][ipar] += DWGT[k][ia][ib][ig] ;
+	    dsumVal[k][ipar]     += ( DWGT[k][ia][ib][ig] * VAL );
+	  }
+	}
+
+	VAL = MUCOVSCALE_ABGRID[ia][ib][ig] ;
+	for(k=0; k < 3; k++ ) 
+	  { dmuCOVscale[k] += ( DWGT[k][ia][ib][ig] * VAL ); }
+
+	if ( DO_COVADD ) {
+	  VAL = MUCOVADD_ABGRID[ia][ib][ig] ;
+	  for(k=0; k < 3; k++ ) 
+	    { dmuCOVadd[k] += ( DWGT[k][ia][ib][ig] * VAL ); }
+	}
+	
+      } // end ig
+    } // end ib
+  } // end ia
+
+  // biasVal = sumVal/WGTpar_SUM  -> quotient rule
+  for(ipar = ILCPAR_MIN; ipar <= ILCPAR_MAX ; ipar++ ) {
+    if( WGTpar_SUM[ipar] == 0.0 ) { continue; }
+    biasVal[ipar] /= WGTpar_SUM[ipar] ;
+    for(k=0; k < 3; k++ ) {
+      dbias = ( dsumVal[k][ipar] - biasVal[ipar]*dWGTpar_SUM[k][ipar] ) /
+	WGTpar_SUM[ipar] ;
+      dmuBias[k] += ( MUCOEF[ipar] * dbias ) ;
+    }
+    if ( ipar == INDEX_s ) { dmuBias[0] += biasVal[ipar] ; }
+    if ( ipar == INDEX_c ) { dmuBias[1] -= biasVal[ipar] ; }
+  } 
+
+  return ;
+
+} // end get_muBias_deriv
 
 // ==================================================
 double get_gammadm_host(double z, double logmass, double *hostPar) {
@@ -17204,6 +17821,10 @@ int ppar(char* item) {
   if ( uniqueOverlap(item,"SUBPROCESS_OPTMASK=") ) {
     sscanf(&item[19], "%d", &SUBPROCESS.INPUT_OPTMASK ); return(1);
   }
+  if ( uniqueOverlap(item,"SUBPROCESS_SHM=") ) {
+    s = SUBPROCESS.INPUT_SHM_NAME ; 
+    sscanf(&item[15], "%s", s ); remove_quote(s); return(1);
+  }
 
 #endif
 
@@ -17218,6 +17839,9 @@ int ppar(char* item) {
   if ( uniqueOverlap(item,"minos2=") ) 
     { sscanf(&item[7],"%i", &INPUTS.minos2 ); return(1); }  
 
+  if ( uniqueOverlap(item,"fitgrad_analytic=") ) 
+    { sscanf(&item[17],"%i", &INPUTS.fitgrad_analytic ); return(1); }  
+
 
   // - - - - - -
   // allow two different keys for data file name
@@ -17698,6 +18322,8 @@ int ppar(char* item) {
     { sscanf(&item[10],"%d", &INPUTS.NSPLITRAN); return(1); }
   if ( uniqueOverlap(item,"JOBID_SPLITRAN=")) 
     { sscanf(&item[15],"%d", &INPUTS.JOBID_SPLITRAN); return(1); }
+  if ( uniqueOverlap(item,"NPROC_SPLITRAN=")) 
+    { sscanf(&item[15],"%d", &INPUTS.NPROC_SPLITRAN); return(1); }
 
   if ( uniqueOverlap(item,"iflag_duplicate=")) 
     { sscanf(&item[16],"%d", &INPUTS.iflag_duplicate ); return(1); }
@@ -19264,6 +19890,133 @@ int SPLITRAN_ACCEPT(int isn, int snid) {
 } // end of SPLITRAN_ACCEPT
 
 
+// **************************************************
+void SPLITRAN_FORK_DRIVER(void) {
+
+  // Created Oct 2026
+  // Called after SALT2mu_DRIVER_INIT has read data, biasCor and CCprior.
+  // Run the NSPLITRAN fits in up to NPROC_SPLITRAN concurrent child
+  // processes. Each child is forked from the fully loaded parent, so
+  // it has its own MINUIT state and globals while the large biasCor
+  // and CCprior tables are shared copy-on-write. Each child writes
+  // its own stdout log and output files (see SPLITRAN_FORK_CHILD).
+
+  int  NPROC    = INPUTS.NPROC_SPLITRAN ;
+  int  NSPLIT   = INPUTS.NSPLITRAN ;
+  int  NRUN = 0, NFAIL = 0, jobid, status ;
+  pid_t pid ;
+  char fnam[] = "SPLITRAN_FORK_DRIVER" ;
+
+  // ------------ BEGIN -----------
+
+  fprint_banner(FP_STDOUT,fnam);
+  fprintf(FP_STDOUT,"   Run %d SPLITRAN fits with %d processes \n",
+	  NSPLIT, NPROC);
+  fflush(FP_STDOUT);
+
+  for(jobid=1; jobid <= NSPLIT; jobid++ ) {
+
+    // wait for a free process slot
+    if ( NRUN == NPROC ) {
+      do { pid = waitpid(-1, &status, 0); } 
+      while ( pid < 0 && errno == EINTR );
+      if ( pid < 0 ) {
+	sprintf(c1err,"waitpid failed before SPLITRAN job %d (errno=%d)", 
+		jobid, errno);
+	sprintf(c2err,"NRUN=%d running jobs may be lost", NRUN);
+	errlog(FP_STDOUT, SEV_FATAL, fnam, c1err, c2err);  
+      }
+      if ( !WIFEXITED(status) || WEXITSTATUS(status) != 0 ) { NFAIL++; }
+      NRUN-- ;
+    }
+
+    fflush(stdout);  fflush(FP_STDOUT); // avoid duplicate buffered output
+    pid = fork();
+    if ( pid < 0 ) {
+      sprintf(c1err,"fork failed for SPLITRAN job %d of %d", jobid, NSPLIT);
+      sprintf(c2err,"Try smaller NPROC_SPLITRAN (now %d)", NPROC);
+      errlog(FP_STDOUT, SEV_FATAL, fnam, c1err, c2err);  
+    }
+    else if ( pid == 0 ) {
+      SPLITRAN_FORK_CHILD(jobid);  // never returns
+    }
+
+    NRUN++ ;
+    fprintf(FP_STDOUT,"   Launched SPLITRAN job %4d (pid=%d)\n", 
+	    jobid, (int)pid);
+    fflush(FP_STDOUT);
+  }
+
+  // wait for remaining jobs
+  while ( NRUN > 0 ) {
+    pid = waitpid(-1, &status, 0);
+    if ( pid < 0 ) { break; }
+    if ( !WIFEXITED(status) || WEXITSTATUS(status) != 0 ) { NFAIL++; }
+    NRUN-- ;
+  }
+
+  if ( NFAIL > 0 ) {
+    sprintf(c1err,"%d of %d SPLITRAN jobs failed.", NFAIL, NSPLIT);
+    sprintf(c2err,"Check [prefix]_SPLIT[nnnn].LOG files.");
+    errlog(FP_STDOUT, SEV_FATAL, fnam, c1err, c2err);  
+  }
+
+  fprintf(FP_STDOUT,"   All %d SPLITRAN jobs finished.\n", NSPLIT);
+  fprintf(FP_STDOUT, "\n Done. \n"); fflush(FP_STDOUT);
+
+  return ;
+
+} // end SPLITRAN_FORK_DRIVER
+
+
+// **************************************************
+void SPLITRAN_FORK_CHILD(int jobid) {
+
+  // Created Oct 2026
+  // Run one SPLITRAN fit in forked child process, with stdout 
+  // redirected to [prefix]_SPLIT[nnnn].LOG; then exit.
+
+  char prefix_orig[100], logFile[MXPATHLEN];
+  int  FLAG, LEN ;
+  char fnam[] = "SPLITRAN_FORK_CHILD" ;
+
+  // ------------ BEGIN -----------
+
+  sprintf(prefix_orig, "%s", INPUTS.PREFIX);
+  if ( strlen(prefix_orig) > 0 && !IGNOREFILE(prefix_orig) ) {
+    LEN = snprintf(INPUTS.PREFIX, 100, "%s_SPLIT%4.4d", prefix_orig, jobid);
+    if ( LEN >= 100 ) {
+      sprintf(c1err,"prefix for SPLITRAN job %d exceeds 99 chars", jobid);
+      sprintf(c2err,"Shorten prefix = %s", prefix_orig);
+      errlog(FP_STDOUT, SEV_FATAL, fnam, c1err, c2err);  
+    }
+    sprintf(logFile, "%s.LOG", INPUTS.PREFIX);
+  }
+  else 
+    { sprintf(logFile, "SALT2mu_SPLIT%4.4d.LOG", jobid); }
+
+  if ( freopen(logFile, "wt", stdout) == NULL ) {
+    sprintf(c1err,"Cannot open log file for SPLITRAN job %d", jobid);
+    sprintf(c2err,"logFile = %s", logFile);
+    errlog(FP_STDOUT, SEV_FATAL, fnam, c1err, c2err);  
+  }
+  FP_STDOUT = stdout ;
+
+  INPUTS.JOBID_SPLITRAN     = jobid ;
+  NCALL_SALT2mu_DRIVER_EXEC = 0 ;
+
+  do {
+    NCALL_SALT2mu_DRIVER_EXEC++ ;
+    SALT2mu_DRIVER_EXEC();
+    FLAG = SALT2mu_DRIVER_SUMMARY();
+  } while ( FLAG == FLAG_EXEC_REPEAT );
+
+  fprintf(FP_STDOUT, "\n Done. \n"); fflush(FP_STDOUT);
+  exit(0);
+
+} // end SPLITRAN_FORK_CHILD
+
+
 // ======================================
 void  CPU_SUMMARY(void) {
 
@@ -20040,6 +20793,7 @@ void prep_input_load_COSPAR(void) {
   INPUTS.COSPAR[1] = INPUTS.parval[IPAR_Ok] ;
   INPUTS.COSPAR[2] = INPUTS.parval[IPAR_w0] ;
   INPUTS.COSPAR[3] = INPUTS.parval[IPAR_wa] ;
+  set_COSMO_ZGRID_SALT2mu(INPUTS.COSPAR); // Oct 2026
 }
 
 // **********************************************
@@ -22800,6 +23554,7 @@ double cosmodl(double zhel, double zhd, double *cosPar)
 {
   // Dec 11 2020: 
   // pass both zhel and zhd, where zhd has both cmb and vpec corrections.
+  // Oct 2026: use z-grid table (see set_COSMO_ZGRID_SALT2mu) 
  
   const double  cvel = LIGHT_km; // 2.99792458e5;
   const double  tol  = 1.e-6;
@@ -22827,8 +23582,15 @@ double cosmodl(double zhel, double zhd, double *cosPar)
   if(fabs(omega_k)<tol) { omega_k = 0.0; }
   OK      = fabs(omega_k);
 
-  //comoving distance to redshift
-  dflat = rombint(inc, 0.0, zhd, cosPar, tol);
+  //comoving distance to redshift; use z-grid table if cosPar matches
+  if ( COSMO_ZGRID_SALT2mu.VALID &&
+       cosPar[0] == COSMO_ZGRID_SALT2mu.cosPar[0] &&
+       cosPar[1] == COSMO_ZGRID_SALT2mu.cosPar[1] &&
+       cosPar[2] == COSMO_ZGRID_SALT2mu.cosPar[2] &&
+       cosPar[3] == COSMO_ZGRID_SALT2mu.cosPar[3] ) 
+    { dflat = Ezinv_integral_ZGRID(zhd, &COSMO_ZGRID_SALT2mu.ZGRID); }
+  else
+    { dflat = rombint(inc, 0.0, zhd, cosPar, tol); }
 
   H0inv = 1.0/INPUTS.H0 ;
 
@@ -22845,6 +23607,80 @@ double cosmodl(double zhel, double zhd, double *cosPar)
 } // end cosmodl
 
 
+// ==============================================
+void set_COSMO_ZGRID_SALT2mu(double *cosPar) {
+
+  // Created Oct 2026
+  // Fill z-grid table of comoving-distance integral (c/H0 = 1) for 
+  // cosPar = OL, Ok, w0, wa. Table is re-filled only when cosPar 
+  // changes, and cosmodl uses the table only for matching cosPar.
+  // Must be called outside threads. On first fill, check against
+  // rombint and abort if fractional difference exceeds 1E-6.
+
+  bool   FIRST = ( COSMO_ZGRID_SALT2mu.ZGRID.NZBIN_ALLOC == 0 );
+  double cosPar_HzFUN[NCOSPAR_HzFUN];
+  double OL, Ok, z, d_grid, d_romb, frac, frac_max=0.0 ;
+  double z_list[] = { 0.011, 0.123, 0.456, 0.789, 1.357, 2.468 };
+  int    NZ = sizeof(z_list)/sizeof(double);
+  int    ipar, iz ;
+  HzFUN_INFO_DEF HzFUN_INFO ;
+  char fnam[] = "set_COSMO_ZGRID_SALT2mu" ;
+
+  // ------------- BEGIN --------------
+
+  if ( COSMO_ZGRID_SALT2mu.VALID ) {
+    bool SAME = true;
+    for(ipar=0; ipar < NCOSPAR; ipar++ ) 
+      { if ( cosPar[ipar] != COSMO_ZGRID_SALT2mu.cosPar[ipar] ) { SAME=false;} }
+    if ( SAME ) { return; }
+  }
+
+  OL = cosPar[0];  Ok = cosPar[1];
+  if ( fabs(Ok) < 1.0E-6 ) { Ok = 0.0 ; } // same as in inc()
+
+  cosPar_HzFUN[ICOSPAR_HzFUN_H0] = 1.0 ;
+  cosPar_HzFUN[ICOSPAR_HzFUN_OM] = 1.0 - OL - Ok ;
+  cosPar_HzFUN[ICOSPAR_HzFUN_OL] = OL ;
+  cosPar_HzFUN[ICOSPAR_HzFUN_w0] = cosPar[2] ;
+  cosPar_HzFUN[ICOSPAR_HzFUN_wa] = cosPar[3] ;
+
+  HzFUN_INFO.USE_MAP   = false ;
+  HzFUN_INFO.Nzbin_MAP = 0 ;
+  for(ipar=0; ipar < NCOSPAR_HzFUN; ipar++ ) 
+    { HzFUN_INFO.COSPAR_LIST[ipar] = cosPar_HzFUN[ipar]; }
+
+  init_COSMO_ZGRID(ZMAX_ZGRID_DEFAULT, DZBIN_ZGRID_DEFAULT, &HzFUN_INFO,
+		   &COSMO_ZGRID_SALT2mu.ZGRID);
+
+  for(ipar=0; ipar < NCOSPAR; ipar++ ) 
+    { COSMO_ZGRID_SALT2mu.cosPar[ipar] = cosPar[ipar]; }
+  COSMO_ZGRID_SALT2mu.VALID = true ;
+
+  if ( !FIRST ) { return; }
+
+  for(iz=0; iz < NZ; iz++ ) {
+    z      = z_list[iz];
+    d_grid = Ezinv_integral_ZGRID(z, &COSMO_ZGRID_SALT2mu.ZGRID);
+    d_romb = rombint(inc, 0.0, z, cosPar, 1.0E-8);
+    frac   = fabs(d_grid/d_romb - 1.0);
+    if ( frac > frac_max ) { frac_max = frac; }
+  }
+
+  fprintf(FP_STDOUT, "  %s: max |table/rombint-1| = %.2e \n", 
+	  fnam, frac_max);
+  fflush(FP_STDOUT);
+
+  if ( frac_max > 1.0E-6 ) {
+    sprintf(c1err,"z-grid distance integral differs from rombint");
+    sprintf(c2err,"max |table/rombint-1| = %.3e", frac_max);
+    errlog(FP_STDOUT, SEV_FATAL, fnam, c1err, c2err);  
+  }
+
+  return ;
+
+} // end set_COSMO_ZGRID_SALT2mu
+
+
 double rombint(double f(double z, double *cosPar),
 	       double a, double b, double *cosPar, double tol) {
 
@@ -23178,6 +24014,9 @@ void print_SALT2mu_HELP(void) {
     "NSPLITRAN=[NRAN] # number of independent sub-samples to run SALT2mu.",
     "                 # separate output is created for each sub-sample.",
     "JOBID_SPLITRAN=[JOBID] # do only this splitran job (in batch mode)",
+    "NPROC_SPLITRAN=[NPROC] # run NSPLITRAN jobs in NPROC forked processes",
+    "                 # after reading data/biasCor once; output for each",
+    "                 # job is [prefix]_SPLIT[nnnn].[ext]",
 
     " - - - - -  biasCor options - - - - - ",
     "",
@@ -23400,6 +24239,7 @@ void print_SALT2mu_HELP(void) {
     "",
     "minos=0          #  1 --> MINUIT minos errors (warning: very slow)",
     "minos2=0         #  1 --> use minos on repeat fit after crazy errors",    
+    "fitgrad_analytic=1 # analytic chi2 gradient for MIGRAD (a,b,g,M0 params)",
     "fitflag_sigmb=1  #  find sigmB giving chi2(Ia)/N = 1 (or sig1fit=1)",
     "fitflag_sigmb=2  #  idem, with extra fit adding 2log(sigma)",
     "redchi2_tol=0.02 #  tolerance on chi2/dof-1",
@@ -23559,6 +24399,14 @@ void  SUBPROCESS_HELP(void) {
 	 "\t CID < 10 -> isn index (e.g. CID=2 -> dump 2nd event)\n"
 	 "\t CID > 10 -> dump this exact CID\n"
 	 "\n" 
+	 "SUBPROCESS_SHM=<name>    (optional) \n"
+	 "\t create POSIX shared memory /<name> to replace inpFile and\n"
+	 "\t outFile; GENPDF maps and output tables are binary arrays.\n"
+	 "\t Driver writes maps + header ITER_INP before sending ITERATION;\n"
+	 "\t SALT2mu sets header ITER_OUT after writing output tables.\n"
+	 "\t See SUBPROCESS_SHM_HEADER_DEF in SALT2mu.c for layout.\n"
+	 "\t Driver must shm_unlink /<name> when finished.\n"
+	 "\n" 
 	 "Example of full SUBPROCESS command:\n"
 	 "SALT2mu.exe SALT2mu_SIMDATA.input \\\n"
 	 "   SUBPROCESS_FILES="
@@ -23606,10 +24454,16 @@ void  SUBPROCESS_INIT(void) {
   tmpFiles[1]   = SUBPROCESS.OUTFILE ;
   tmpFiles[2]   = SUBPROCESS.STDOUT_FILE ;
   splitString(SUBPROCESS.INPUT_FILES, ",", fnam, 3, &NSPLIT, tmpFiles);
+
+  SUBPROCESS.USE_SHM = ( strlen(SUBPROCESS.INPUT_SHM_NAME) > 0 );
   
   // open INPFILE in read mode, but only for sim data.
   // skip for real data since there is nothing to rewgt.
-  if ( !ISDATA_REAL ) {
+  if ( SUBPROCESS.USE_SHM ) {
+    printf("%s  Ignore input and output files; use shared memory\n",
+	   KEYNAME_SUBPROCESS_STDOUT);
+  }
+  else if ( !ISDATA_REAL ) {
     SUBPROCESS.FP_INP = fopen(SUBPROCESS.INPFILE, "rt");
     if ( !SUBPROCESS.FP_INP ) {
       sprintf(c1err,"Could not open input GENPDF file to read:" );
@@ -23625,8 +24479,15 @@ void  SUBPROCESS_INIT(void) {
   }
 
   // open OUTFILE in write mode
-  SUBPROCESS.FP_OUT = fopen(SUBPROCESS.OUTFILE, "wt");
-  if ( !SUBPROCESS.FP_OUT ) {
+  if ( SUBPROCESS.USE_SHM ) 
+    { SUBPROCESS.FP_OUT = NULL; }
+  else
+    { SUBPROCESS.FP_OUT = fopen(SUBPROCESS.OUTFILE, "wt"); }
+
+  if ( SUBPROCESS.USE_SHM ) {
+    // shm is created after output tables are prepared below
+  }
+  else if ( !SUBPROCESS.FP_OUT ) {
     sprintf(c1err,"Could not open output file to write:" );
     sprintf(c2err," '%s' ", SUBPROCESS.OUTFILE) ;
     SUBPROCESS_REMIND_STDOUT();
@@ -23660,6 +24521,9 @@ void  SUBPROCESS_INIT(void) {
   for(itable=0; itable < SUBPROCESS.N_OUTPUT_TABLE; itable++ )
     { SUBPROCESS_OUTPUT_TABLE_PREP(itable) ; }
     // debugexit(fnam);
+
+  // create shared memory after table sizes are known (Oct 2026)
+  if ( SUBPROCESS.USE_SHM ) { SUBPROCESS_SHM_INIT(); }
   
   // prep flat random for each event
   SUBPROCESS_INIT_RANFLAT(-1);
@@ -24113,8 +24977,10 @@ void SUBPROCESS_PREP_NEXTITER(void) {
   prep_input_repeat();
 
   // rewind all SUBPROCESS files
-  rewind(SUBPROCESS.FP_INP);   
-  rewind(SUBPROCESS.FP_OUT);   
+  if ( !SUBPROCESS.USE_SHM ) {
+    rewind(SUBPROCESS.FP_INP);   
+    rewind(SUBPROCESS.FP_OUT);   
+  }
   if ( SUBPROCESS.STDOUT_CLOBBER ) { rewind(FP_STDOUT); }
 
   // - - - - - -
@@ -24139,55 +25005,23 @@ void SUBPROCESS_SIM_REWGT(int ITER_EXPECT) {
   // 
   // July 13 2021
   // Updated to include bounding function option
+  //
+  // Oct 2026: move text-file read to SUBPROCESS_READ_GENPDF_FILE,
+  //           and check option to read maps from shared memory.
 
-  int  OPTMASK  = OPTMASK_GENPDF_EXTERNAL_FP ;
-  int  ITER     = SUBPROCESS.ITER ;
-  FILE *FP_INP  = SUBPROCESS.FP_INP ;
-  char *INPFILE = SUBPROCESS.INPFILE ;
-
-  bool FOUND_ITER_BEGIN = false;
-  char c_get[60];
-  int  ISTAT_READ=-9, ITER_FOUND = -9  ;
   char fnam[] = "SUBPROCESS_SIM_REWGT" ;
 
   // -------- BEGIN -----------
 
-  // read input file until we reach iteration key
-  while ( !FOUND_ITER_BEGIN && ISTAT_READ != EOF ) {
-    ISTAT_READ = fscanf(FP_INP, "%s", c_get) ;
-    if ( strcmp(c_get,KEYNAME_SUBPROCESS_ITERATION_BEGIN) == 0 ) {
-      FOUND_ITER_BEGIN = true ;
-      fscanf(FP_INP, "%d", &ITER_FOUND);
-    }
-  }
-
-  // make sure that ITERATION key was found, and that it
-  // matches ITER_EXPECT entered on command line.
-
-  if ( ITER_FOUND < 0 ) {
-    SUBPROCESS_REMIND_STDOUT();
-    sprintf(c1err,"Could not find required '%s' key in", 
-	    KEYNAME_SUBPROCESS_ITERATION_BEGIN);
-    sprintf(c2err,"file %s", INPFILE );
-    errlog(FP_STDOUT, SEV_FATAL, fnam, c1err, c2err);
-  }
-
-  if ( ITER_EXPECT != ITER_FOUND ) {
-    SUBPROCESS_REMIND_STDOUT();
-    sprintf(c1err,"Found ITERATION=%d in PDF file %s",
-	    ITER_FOUND, INPFILE);
-    sprintf(c2err,"But expected ITERATION=%d passed via std input", 
-	    ITER_EXPECT);
-    errlog(FP_STDOUT, SEV_FATAL, fnam, c1err, c2err);
-  }
-
-  printf("%s Read PDF map(s) for ITERATION=%d\n", 
-	 KEYNAME_SUBPROCESS_STDOUT, ITER );
-
   // re-init uniqueOverlap in case a key is parsed again
   uniqueOverlap(STRINGMATCH_INIT,"SUBPROCESS"); 
 
-  init_genPDF(OPTMASK, FP_INP, INPFILE, BLANK_STRING);
+  // load GENPDF maps; each read function aborts if ITER_EXPECT 
+  // does not match iteration from python driver.
+  if ( SUBPROCESS.USE_SHM ) 
+    { SUBPROCESS_SHM_READ_GENPDF(ITER_EXPECT); }
+  else
+    { SUBPROCESS_READ_GENPDF_FILE(ITER_EXPECT); }
 
   // over-write CUTBIT_SPLITRAN 
   sprintf(CUTSTRING_LIST[CUTBIT_SPLITRAN],  "GENPDF rewgt");
@@ -24265,7 +25099,7 @@ void SUBPROCESS_SIM_REWGT(int ITER_EXPECT) {
       istat = interp_GRIDMAP(&GENPDF[imap].GRIDMAP, XVAL_for_GENPDF, &PROB);
       // check for bounding function here
       if (! SUBPROCESS.ISFLAT_SIM) {
-	PROB_SIMREF =  SUBPROCESS_PROB_SIMREF(ITER_FOUND, imap, XVAL_for_GENPDF[0]) ;
+	PROB_SIMREF =  SUBPROCESS_PROB_SIMREF(ITER_EXPECT, imap, XVAL_for_GENPDF[0]) ;
       }
 
       PROB_RATIO = (PROB/ PROB_SIMREF) ;
@@ -24311,6 +25145,63 @@ void SUBPROCESS_SIM_REWGT(int ITER_EXPECT) {
 
 } // end SUBPROCESS_SIM_REWGT
 
+// ========================================
+void SUBPROCESS_READ_GENPDF_FILE(int ITER_EXPECT) {
+
+  // Created Oct 2026 [code moved from SUBPROCESS_SIM_REWGT]
+  // Read GENPDF map(s) for ITER_EXPECT from SUBPROCESS input file.
+
+  int  OPTMASK  = OPTMASK_GENPDF_EXTERNAL_FP ;
+  int  ITER     = SUBPROCESS.ITER ;
+  FILE *FP_INP  = SUBPROCESS.FP_INP ;
+  char *INPFILE = SUBPROCESS.INPFILE ;
+
+  bool FOUND_ITER_BEGIN = false;
+  char c_get[60];
+  int  ISTAT_READ=-9, ITER_FOUND = -9  ;
+  char fnam[] = "SUBPROCESS_READ_GENPDF_FILE" ;
+
+  // -------- BEGIN -----------
+
+  // read input file until we reach iteration key
+  while ( !FOUND_ITER_BEGIN && ISTAT_READ != EOF ) {
+    ISTAT_READ = fscanf(FP_INP, "%s", c_get) ;
+    if ( strcmp(c_get,KEYNAME_SUBPROCESS_ITERATION_BEGIN) == 0 ) {
+      FOUND_ITER_BEGIN = true ;
+      fscanf(FP_INP, "%d", &ITER_FOUND);
+    }
+  }
+
+  // make sure that ITERATION key was found, and that it
+  // matches ITER_EXPECT entered on command line.
+
+  if ( ITER_FOUND < 0 ) {
+    SUBPROCESS_REMIND_STDOUT();
+    sprintf(c1err,"Could not find required '%s' key in", 
+	    KEYNAME_SUBPROCESS_ITERATION_BEGIN);
+    sprintf(c2err,"file %s", INPFILE );
+    errlog(FP_STDOUT, SEV_FATAL, fnam, c1err, c2err);
+  }
+
+  if ( ITER_EXPECT != ITER_FOUND ) {
+    SUBPROCESS_REMIND_STDOUT();
+    sprintf(c1err,"Found ITERATION=%d in PDF file %s",
+	    ITER_FOUND, INPFILE);
+    sprintf(c2err,"But expected ITERATION=%d passed via std input", 
+	    ITER_EXPECT);
+    errlog(FP_STDOUT, SEV_FATAL, fnam, c1err, c2err);
+  }
+
+  printf("%s Read PDF map(s) for ITERATION=%d\n", 
+	 KEYNAME_SUBPROCESS_STDOUT, ITER );
+
+  init_genPDF(OPTMASK, FP_INP, INPFILE, BLANK_STRING);
+
+  return ;
+
+} // end SUBPROCESS_READ_GENPDF_FILE
+
+
 double SUBPROCESS_PROB_SIMREF(int ITER, int imap, double XVAL) {
 
   // Created July 2021
@@ -25034,6 +25925,8 @@ void SUBPROCESS_OUTPUT_WRITE(void) {
   printf("%s write SALT2mu output\n",  KEYNAME_SUBPROCESS_STDOUT );
   fflush(stdout);
 
+  if ( SUBPROCESS.USE_SHM ) { SUBPROCESS_SHM_WRITE_OUTPUT(); return; }
+
   fprintf(FP_OUT,"# Created by SALT2mu SUBPROCESS\n"); // Aug 30 2021
 
   fprintf(FP_OUT,"# ITERATION: %d\n#\n", ITER);
@@ -25152,6 +26045,284 @@ void SUBPROCESS_OUTPUT_TABLE_WRITE(int ITABLE) {
 } //  end SUBPROCESS_OUTPUT_TABLE_WRITE
 
 
+// =======================================
+void SUBPROCESS_SHM_INIT(void) {
+
+  // Created Oct 2026
+  // Create and map POSIX shared memory /SUBPROCESS.INPUT_SHM_NAME,
+  // sized for MXMAP_GENPDF input maps and all output tables.
+  // Shared memory replaces the SUBPROCESS input and output text files; 
+  // ITERATION handshake is still via stdin.
+
+  int  N_TABLE = SUBPROCESS.N_OUTPUT_TABLE ;
+  int64_t SIZE_HEAD, SIZE_INP, SIZE_OUT, SIZE_MAP, SIZE_TOT ;
+  int  itable, NVAR, NBINTOT, fd ;
+  char shmName[MXCHAR_FILENAME+2] ;
+  char *ptr ;
+  SUBPROCESS_SHM_HEADER_DEF *HEADER ;
+  char fnam[] = "SUBPROCESS_SHM_INIT" ;
+
+  // ------------ BEGIN ------------
+
+  if ( SUBPROCESS.INPUT_SHM_NAME[0] == '/' ) 
+    { sprintf(shmName, "%s",  SUBPROCESS.INPUT_SHM_NAME); }
+  else
+    { sprintf(shmName, "/%s", SUBPROCESS.INPUT_SHM_NAME); }
+
+  // header is padded to 8-byte multiple so that doubles are aligned
+  SIZE_HEAD = 8 * ((sizeof(SUBPROCESS_SHM_HEADER_DEF)+7)/8) ;
+
+  // input: NMAP + maps with up to MXROW_GENPDF rows and MXVAR_GENPDF cols
+  SIZE_MAP = sizeof(SUBPROCESS_SHM_MAP_DEF) + 
+    (int64_t)MXROW_GENPDF * MXVAR_GENPDF * sizeof(double) ;
+  SIZE_INP = 2*sizeof(int32_t) + MXMAP_GENPDF * SIZE_MAP ;
+
+  // output: fit summary, fit params, then each table
+  SIZE_OUT = sizeof(SUBPROCESS_SHM_OUTHEAD_DEF) + 
+    MAXPAR * sizeof(SUBPROCESS_SHM_FITPAR_DEF) ;
+  for(itable=0; itable < N_TABLE; itable++ ) {
+    NVAR     = SUBPROCESS.OUTPUT_TABLE[itable].NVAR ;
+    NBINTOT  = SUBPROCESS.OUTPUT_TABLE[itable].NBINTOT ;
+    SIZE_OUT += 2*sizeof(int32_t) + 
+      (int64_t)NBINTOT * (NVAR+4) * sizeof(double) ;
+  }
+
+  SIZE_TOT = SIZE_HEAD + SIZE_INP + SIZE_OUT ;
+
+  fd = shm_open(shmName, O_CREAT | O_RDWR, 0600);
+  if ( fd < 0 ) {
+    SUBPROCESS_REMIND_STDOUT();
+    sprintf(c1err,"Could not create shared memory '%s'", shmName);
+    sprintf(c2err,"%s", strerror(errno) );
+    errlog(FP_STDOUT, SEV_FATAL, fnam, c1err, c2err);
+  }
+
+  if ( ftruncate(fd, (off_t)SIZE_TOT) != 0 ) {
+    SUBPROCESS_REMIND_STDOUT();
+    sprintf(c1err,"Could not set size=%lld of shared memory '%s'", 
+	    (long long)SIZE_TOT, shmName);
+    sprintf(c2err,"%s", strerror(errno) );
+    errlog(FP_STDOUT, SEV_FATAL, fnam, c1err, c2err);
+  }
+
+  ptr = (char*) mmap(NULL, (size_t)SIZE_TOT, PROT_READ | PROT_WRITE, 
+		     MAP_SHARED, fd, 0);
+  close(fd);
+  if ( ptr == MAP_FAILED ) {
+    SUBPROCESS_REMIND_STDOUT();
+    sprintf(c1err,"Could not mmap shared memory '%s'", shmName);
+    sprintf(c2err,"%s", strerror(errno) );
+    errlog(FP_STDOUT, SEV_FATAL, fnam, c1err, c2err);
+  }
+
+  HEADER = (SUBPROCESS_SHM_HEADER_DEF*) ptr ;
+  HEADER->MAGIC      = SUBPROCESS_SHM_MAGIC ;
+  HEADER->VERSION    = SUBPROCESS_SHM_VERSION ;
+  HEADER->ITER_INP   = -9 ;
+  HEADER->ITER_OUT   = -9 ;
+  HEADER->SIZE_TOT   = SIZE_TOT ;
+  HEADER->OFFSET_INP = SIZE_HEAD ;
+  HEADER->SIZE_INP   = SIZE_INP ;
+  HEADER->OFFSET_OUT = SIZE_HEAD + SIZE_INP ;
+  HEADER->SIZE_OUT   = SIZE_OUT ;
+
+  SUBPROCESS.SHM_PTR    = ptr ;
+  SUBPROCESS.SHM_HEADER = HEADER ;
+
+  printf("%s  Opened shared memory: %s  (%.1f MB)\n", 
+	 KEYNAME_SUBPROCESS_STDOUT, shmName, (double)SIZE_TOT/1.0E6 );
+  fflush(stdout);
+
+  return ;
+
+} // end SUBPROCESS_SHM_INIT
+
+
+// =======================================
+void SUBPROCESS_SHM_READ_GENPDF(int ITER_EXPECT) {
+
+  // Created Oct 2026
+  // Load GENPDF maps from shared-memory input region, as if read by
+  // init_genPDF from SUBPROCESS input file. Grid and PROB columns
+  // are passed directly (no copy) to init_interp_GRIDMAP.
+  // Asymmetric-Gaussian populations (e.g., SALT2ALPHA) must be
+  // passed as tabulated 1D maps.
+
+  SUBPROCESS_SHM_HEADER_DEF *HEADER = SUBPROCESS.SHM_HEADER ;
+  char    *ptr_inp  = SUBPROCESS.SHM_PTR + HEADER->OFFSET_INP ;
+  char    *ptr_end  = ptr_inp + HEADER->SIZE_INP ;
+  int      NFUN = 1 ;
+  int      NMAP, imap, ivar, NVAR, NDIM, NROW, IDMAP ;
+  char    *ptr, *ptrSplit[MXVAR_GENPDF], *MAPNAME ;
+  double  *COLS[MXVAR_GENPDF], *VAL ;
+  SUBPROCESS_SHM_MAP_DEF *MAP ;
+  char fnam[] = "SUBPROCESS_SHM_READ_GENPDF" ;
+
+  // ------------ BEGIN ------------
+
+  __sync_synchronize(); // make sure driver writes are visible
+
+  if ( HEADER->ITER_INP != ITER_EXPECT ) {
+    SUBPROCESS_REMIND_STDOUT();
+    sprintf(c1err,"Found ITER_INP=%d in shared memory header",
+	    HEADER->ITER_INP );
+    sprintf(c2err,"But expected ITERATION=%d passed via std input", 
+	    ITER_EXPECT);
+    errlog(FP_STDOUT, SEV_FATAL, fnam, c1err, c2err);
+  }
+
+  NMAP = *(int32_t*)ptr_inp ;
+  if ( NMAP < 0 || NMAP > MXMAP_GENPDF ) {
+    SUBPROCESS_REMIND_STDOUT();
+    sprintf(c1err,"Invalid NMAP=%d in shared memory", NMAP);
+    sprintf(c2err,"Valid range is 0 to MXMAP_GENPDF=%d", MXMAP_GENPDF);
+    errlog(FP_STDOUT, SEV_FATAL, fnam, c1err, c2err);
+  }
+
+  printf("%s Read %d PDF map(s) from shared memory for ITERATION=%d\n", 
+	 KEYNAME_SUBPROCESS_STDOUT, NMAP, ITER_EXPECT );
+  fflush(stdout);
+
+  NMAP_GENPDF = NCALL_GENPDF = 0;
+  OPTMASK_GENPDF    = OPTMASK_GENPDF_EXTERNAL_FP ;
+  OPT_EXTRAP_GENPDF = 0 ;
+  MAG_OFFSET_GENPDF = 0.0 ;
+
+  for(ivar=0; ivar < MXVAR_GENPDF; ivar++ ) 
+    { ptrSplit[ivar] = (char*) malloc(MXCHAR_SHM_VARNAMES*sizeof(char)); }
+
+  ptr = ptr_inp + 2*sizeof(int32_t);
+  for(imap=0; imap < NMAP; imap++ ) {
+    MAP  = (SUBPROCESS_SHM_MAP_DEF*) ptr ;
+    NDIM = MAP->NDIM ;
+    NROW = MAP->NROW ;
+    VAL  = (double*)(ptr + sizeof(SUBPROCESS_SHM_MAP_DEF)) ;
+
+    MAP->VARNAMES[MXCHAR_SHM_VARNAMES-1] = 0 ;
+    splitString(MAP->VARNAMES, " ", fnam, MXVAR_GENPDF, &NVAR, ptrSplit);
+
+    if ( NDIM < 1 || NVAR != NDIM+NFUN || NROW < 1 || NROW > MXROW_GENPDF ||
+	 (char*)(VAL + NVAR*NROW) > ptr_end ) {
+      SUBPROCESS_REMIND_STDOUT();
+      sprintf(c1err,"Invalid map %d: NDIM=%d NROW=%d VARNAMES='%s'", 
+	      imap, NDIM, NROW, MAP->VARNAMES);
+      sprintf(c2err,"Expect NVAR=NDIM+1 and NROW <= %d", MXROW_GENPDF);
+      errlog(FP_STDOUT, SEV_FATAL, fnam, c1err, c2err);
+    }
+
+    GENPDF[imap].NVAR = NVAR ;
+    for(ivar=0; ivar < NVAR; ivar++ ) { 
+      assign_VARNAME_GENPDF(imap, ivar, ptrSplit[ivar]);
+      GENPDF[imap].IVAR_HOSTLIB[ivar] = -9 ;
+      COLS[ivar] = VAL + ivar*NROW ;
+    }
+    checkAbort_VARNAME_GENPDF(GENPDF[imap].VARNAMES[0]);
+
+    IDMAP   = IDGRIDMAP_GENPDF + imap ;
+    MAPNAME = GENPDF[imap].MAPNAME ;
+    init_interp_GRIDMAP(IDMAP, MAPNAME, NROW, NDIM, NFUN, OPT_EXTRAP_GENPDF,
+			COLS, &COLS[NDIM], 
+			&GENPDF[imap].GRIDMAP );   // <== returned
+
+    GENPDF[imap].N_CALL      = 0 ;
+    GENPDF[imap].N_ITER_SUM  = 0 ;
+    GENPDF[imap].N_ITER_MAX  = 0 ;
+    GENPDF[imap].PROB_EXPON_REWGT = 1.0 ;
+
+    printf("    Load GENPDF map %s(%s)  NROW=%d \n", 
+	   MAPNAME, GENPDF[imap].GRIDMAP.VARLIST, NROW);
+    fflush(stdout);
+
+    ptr = (char*)(VAL + NVAR*NROW) ;
+    NMAP_GENPDF++ ;
+  }
+
+  for(ivar=0; ivar < MXVAR_GENPDF; ivar++ ) { free(ptrSplit[ivar]); }
+
+  return ;
+
+} // end SUBPROCESS_SHM_READ_GENPDF
+
+
+// =======================================
+void SUBPROCESS_SHM_WRITE_OUTPUT(void) {
+
+  // Created Oct 2026
+  // Binary version of SUBPROCESS_OUTPUT_WRITE: write fit summary,
+  // fitted nuisance params and output tables to shared-memory output
+  // region, then set header ITER_OUT to tell driver it is ready.
+
+  SUBPROCESS_SHM_HEADER_DEF  *HEADER = SUBPROCESS.SHM_HEADER ;
+  SUBPROCESS_SHM_OUTHEAD_DEF *OUTHEAD ;
+  SUBPROCESS_SHM_FITPAR_DEF  *FITPAR ;
+  SUBPROCESS_TABLE_DEF       *TABLE ;
+  int  N_TABLE = SUBPROCESS.N_OUTPUT_TABLE ;
+  int  ISFLOAT, ISM0, NPAR=0, n, itable, IBIN1D, ivar, NVAR, NBINTOT ;
+  char *ptr ;
+  double *ROW ;
+
+  // ------------ BEGIN ------------
+
+  HEADER->ITER_OUT = -9 ;
+  ptr     = SUBPROCESS.SHM_PTR + HEADER->OFFSET_OUT ;
+  OUTHEAD = (SUBPROCESS_SHM_OUTHEAD_DEF*) ptr ;
+  FITPAR  = (SUBPROCESS_SHM_FITPAR_DEF*) (ptr + sizeof(*OUTHEAD)) ;
+
+  OUTHEAD->ITER          = SUBPROCESS.ITER ;
+  OUTHEAD->NSNFIT        = FITRESULT.NSNFIT ;
+  OUTHEAD->N_TABLE       = N_TABLE ;
+  OUTHEAD->CPU_MINUTES   = (t_end_fit-t_start_fit)/60.0 ;
+  OUTHEAD->CHI2_MIN      = FITRESULT.CHI2SUM_MIN ;
+  OUTHEAD->AVEMAG0       = FITRESULT.AVEMAG0 ;
+  OUTHEAD->MAXPROB_RATIO = SUBPROCESS.MAXPROB_RATIO ;
+
+  // same fit params as text output: floated nuisance params + sigint
+  for ( n=0; n < FITINP.NFITPAR_ALL ; n++ ) {
+    ISFLOAT = FITINP.ISFLOAT[n] ;
+    ISM0    = (n >= MXCOSPAR) ; 
+    if ( !ISFLOAT || ISM0 ) { continue; }
+    snprintf(FITPAR[NPAR].NAME, 24, "%s", FITRESULT.PARNAME[n]);
+    FITPAR[NPAR].VAL = FITRESULT.PARVAL[1][n] ;
+    FITPAR[NPAR].ERR = FITRESULT.PARERR[1][n] ;
+    NPAR++ ;
+  }
+  snprintf(FITPAR[NPAR].NAME, 24, "%s", FITRESULT.PARNAME[IPAR_COVINT_PARAM]);
+  FITPAR[NPAR].VAL = FITINP.COVINT_PARAM_FIX ;
+  FITPAR[NPAR].ERR = 0.0 ;
+  NPAR++ ;
+  OUTHEAD->NFITPAR = NPAR ;
+
+  // tables start after MAXPAR fit params
+  ptr += sizeof(*OUTHEAD) + MAXPAR * sizeof(SUBPROCESS_SHM_FITPAR_DEF) ;
+
+  for(itable=0; itable < N_TABLE; itable++ ) {
+    TABLE   = &SUBPROCESS.OUTPUT_TABLE[itable] ;
+    NVAR    = TABLE->NVAR ;
+    NBINTOT = TABLE->NBINTOT ;
+    ((int32_t*)ptr)[0] = NVAR ;
+    ((int32_t*)ptr)[1] = NBINTOT ;
+    ROW = (double*)(ptr + 2*sizeof(int32_t)) ;
+
+    for(IBIN1D=0; IBIN1D < NBINTOT; IBIN1D++ ) {
+      for(ivar=0; ivar < NVAR; ivar++ ) 
+	{ ROW[ivar] = (double)TABLE->INDEX_BININFO[ivar][IBIN1D]; }
+      ROW[NVAR+0] = (double)TABLE->NEVT[IBIN1D] ;
+      ROW[NVAR+1] = TABLE->MURES_SUM[IBIN1D] ;
+      ROW[NVAR+2] = TABLE->MURES_STD[IBIN1D] ;
+      ROW[NVAR+3] = TABLE->MURES_STD_ROBUST[IBIN1D] ;
+      ROW += (NVAR+4);
+    }
+    ptr = (char*)ROW ;
+  } // end itable
+
+  __sync_synchronize(); // output visible before ITER_OUT is set
+  HEADER->ITER_OUT = SUBPROCESS.ITER ;
+
+  return ;
+
+} // end SUBPROCESS_SHM_WRITE_OUTPUT
+
+
 // =======================================
 void SUBPROCESS_REMIND_STDOUT(void) {
   printf("\n");
@@ -25164,6 +26335,11 @@ void SUBPROCESS_REMIND_STDOUT(void) {
 void SUBPROCESS_EXIT(void) {
 
   SUBPROCESS_REMIND_STDOUT();
+
+  // shared memory is unlinked by python driver (Oct 2026)
+  if ( SUBPROCESS.USE_SHM ) 
+    { munmap(SUBPROCESS.SHM_PTR, (size_t)SUBPROCESS.SHM_HEADER->SIZE_TOT); }
+
   printf("%s Graceful Program Exit. Bye.\n", KEYNAME_SUBPROCESS_STDOUT);
   fflush(stdout);
   exit(0);
@@ -155,6 +155,17 @@
 
  Dec 12 2023: new --rowmatch option
 
+ Oct 2026: new --stream option for large (e.g., 10^7 row biasCor) files.
+   Files 2,3,... are read into float/interned-string columns with a
+   CID hash per file; the first file is then streamed one row at a
+   time and each joined row is written directly with buffered text
+   output. Memory for the hashed files is bounded by --mxmem_mb.
+   See STREAM_FITRES().
+
+ Oct 2026: non-stream reader (ADD_FITRES) reads each file into
+   table-owned float and interned-string columns (no per-cell malloc);
+   combined strings (STR_ALL) are pointers to interned strings.
+
 ******************************/
 
 #include <stdio.h>
@@ -202,6 +213,17 @@ void  freeVar_TMP(int ifile, int NVARTOT, int NVARSTR, int MAXLEN);
 
 void malloc_NMATCH_PER_EVT(int N);
 
+void  check_FIRST_SNANA(int ifile, int NVARALL);
+void  add_VARNAME_COMBINE(int ifile, int ivar, char *VARNAME, int ICAST);
+void  WRITE_SNTABLE_OPEN(void);
+void  WRITE_SNTABLE_CLOSE(void);
+void  fill_TABLEROW_CCID(int isn);
+bool  SKIP_TABLEROW_zCUT(void);
+
+void  STREAM_FITRES(void);
+void  STREAM_PREP_FITRES(int ifile);
+void  STREAM_FILL_SNTABLE(void);
+
 void  relabel_rownum(int ifile);
 
 // ================================
@@ -265,6 +287,9 @@ struct INPUTS {
 
   int DO_ROWMATCH;
 
+  int    DO_STREAM ;   // Oct 2026: streaming join
+  double MXMEM_MB ;    // max memory (MB) for hashed files in stream mode
+
 } INPUTS ;
 
 
@@ -328,6 +353,36 @@ struct hash_table {
 
 struct hash_table *users = NULL; 
 
+// Oct 2026: output files (see WRITE_SNTABLE_OPEN)
+struct {
+  int  NOUT ;
+  char NAME[6][200] ;
+  int  GZIPFLAG ;
+} OUTFILE_SNTABLE ;
+int CIDint_EXISTS ;
+
+// Oct 2026: streaming join; files ifile>0 are hashed by CID,
+// and ifile=0 is streamed.
+#define DEFAULT_MXMEM_STREAM_MB  8000.0
+#define NROW_FLUSH_STREAM        10000  // text rows per fflush
+
+struct hash_stream_def {
+  int  irow ;
+  char *name ;     // interned CID; see SNTABLE_READPREP_COLUMN
+  UT_hash_handle hh ;
+} ;
+
+struct {
+  int    NVAR[MXFFILE] ;              // NVAR in each file
+  int    IVARTOT[MXFFILE][MXVAR_TOT]; // combined index; -1 -> skip
+  float  **FLT[MXFFILE] ;             // [ivar][irow] for ifile > 0
+  char   ***STR[MXFFILE] ;            // [ivar][irow] interned strings
+  struct hash_stream_def *HASH[MXFFILE] ;       // CID -> irow
+  struct hash_stream_def *HASH_STORE[MXFFILE] ; // entries (for free)
+  char   *PTRSTR0[MXVAR_TOT] ;        // row pointers for ifile=0 strings
+  double MEM_MB ;                     // memory used by hashed files
+} STREAM_JOIN ;
+
 char *NMATCH_PER_EVT ; // just 1 byte each to save memory
 int  NEVT_COMMON;   // number of events common to all FITRES files
 int  NEVT_READ[MXFFILE];    // NEVT read from each file
@@ -366,6 +421,16 @@ int main(int argc, char **argv) {
 
   TABLEFILE_INIT(); // Oct 27 2014
 
+  if ( INPUTS.DO_STREAM ) { 
+    STREAM_FITRES(); 
+    sprintf(str_cputime,"%s(stream_join)", STRING_CPUTIME_PROC_ALL);
+    print_cputime(t_start, str_cputime, UNIT_TIME_SECOND, 0 );
+    printf("   Done writing %d events. \n", NWRITE_SNTABLE );
+    fflush(stdout);
+    print_stats();
+    return(0);
+  }
+
   for ( ifile = 0; ifile < INPUTS.NFFILE; ifile++ ) {
     ADD_FITRES(ifile);
   }
@@ -459,6 +524,10 @@ void  print_combine_fitres_help(void) {
     " --nullval_float -12345  # override default nullval of -888",
     "",
     "--rowmatch       # force match for each row, regardless of CID",
+    "",
+    "--stream         # stream 1st file; hash other files by CID",
+    "                 # (put the largest file first)",
+    "--mxmem_mb <MB>  # stream-mode memory limit for hashed files",
     0
   };
 
@@ -519,6 +588,8 @@ void  PARSE_ARGV(int argc, char **argv) {
   INPUTS.NVARNAMES_KEEP  = 0 ;
   INPUTS.VARLIST_KEEP[0] = 0 ;
   INPUTS.DO_ROWMATCH     = 0 ;
+  INPUTS.DO_STREAM       = 0 ;
+  INPUTS.MXMEM_MB        = DEFAULT_MXMEM_STREAM_MB ;
 
   printf("\n Full command: ");
   for ( i = 0; i < NARGV_LIST ; i++ ) {  printf("%s ", argv[i]);   }
@@ -594,6 +665,16 @@ void  PARSE_ARGV(int argc, char **argv) {
       continue ;
     }
 
+    if ( keyarg_match(argv[i],"stream") )  {
+      INPUTS.DO_STREAM = 1;
+      continue ;
+    }
+
+    if ( keyarg_match(argv[i],"mxmem_mb") )  {
+      i++ ; sscanf(argv[i], "%le", &INPUTS.MXMEM_MB);
+      continue ;
+    }
+
     // parse FITRES file(s) and add to INPUTS.FFILE list
     parse_FFILE(argv[i]);
 
@@ -607,6 +688,16 @@ void  PARSE_ARGV(int argc, char **argv) {
     printf("   CID-match method: hash table with sntools util.\n");
   }
 
+  if ( INPUTS.DO_STREAM ) {
+    printf("   CID-match method: stream 1st file; hash other files "
+	   "(MXMEM=%.0f MB)\n", INPUTS.MXMEM_MB);
+    if ( INPUTS.DO_ROWMATCH ) {
+      sprintf(c1err, "--rowmatch is not compatible with --stream");
+      sprintf(c2err, "Remove one of these options.");
+      errmsg(SEV_FATAL, 0, fnam, c1err, c2err); 
+    }
+  }
+
   if ( INPUTS.NFFILE <= 0 ) {
     sprintf(c1err, "Bad args. Must give fitres file(s)");
     sprintf(c2err, "  combine_fitres.exe <fitresFile List> ");
@@ -732,14 +823,17 @@ void ADD_FITRES(int ifile) {
   // Sep 24: slightly improve matching method so that it is very 
   //         fast when both files have exactly the same CIDs.
   //
+  // Oct 2026: read into table-owned columns (SNTABLE_READPREP_COLUMN);
+  //           FLT_TMP and STR_TMP point to columns after read.
 
-  int  ivar, ivarstr, j, isn, isn2, NMATCH2 ;
-  int  NVARALL, NVARSTR, NVAR, NTAG_DEJA, NLIST, ICAST ;
-  int  index=-9, REPEATCID, NEVT_APPROX, IFILETYPE, iappend ;
+  int  ivar, ivarstr, isn, isn2, NMATCH2 ;
+  int  NVARALL, NVARSTR, NLIST, ICAST ;
+  int  NEVT_APPROX, IFILETYPE ;
+  int  INDEX_COLUMN[MXVAR_TOT];
 
   char 
-    *VARNAME, VARNAME_F[MXCHAR_VARNAME], VARNAME_C[MXCHAR_VARNAME]
-    ,*ptr_CTAG, ccid[60]
+    *VARNAME
+    ,ccid[60]
     ,fnam[] = "ADD_FITRES"
     ;
 
@@ -754,19 +848,7 @@ void ADD_FITRES(int ifile) {
   NVARALL_FILE[ifile] = NVARALL;
 
   // check if this is an SNANA file; mark first SNANA file
-  if ( IFILE_FIRST_SNANA < 0 ) {
-    for ( ivar=0; ivar < NVARALL; ivar++ ) {    
-      VARNAME = READTABLE_POINTERS.VARNAME[ivar] ;
-      for(j=0; j < NVARNAME_1ONLY; j++ ) {
-	if ( strcmp(VARNAME,VARNAME_1ONLY[j])==0 ) 
-	  {  IFILE_FIRST_SNANA = ifile; }	
-      }
-    }
-    if ( IFILE_FIRST_SNANA >= 0 ) {
-      printf("\t First SNANA ifile = %d (%s) \n",
-	     IFILE_FIRST_SNANA, INPUTS.FFILE[ifile] );
-    }
-  }
+  check_FIRST_SNANA(ifile, NVARALL);
 
   // --------------------------------------------------
   //                 MEMORY ALLOC
@@ -801,13 +883,14 @@ void ADD_FITRES(int ifile) {
   // ----------------------------------------------------
 
   ivarstr = 0 ;
-  NVAR    = NVARALL_FITRES ;
 
   NVARALL_FITRES_LAST = NVARALL_FITRES ;
   NVARSTR_FITRES_LAST = NVARSTR_FITRES ;
 
   for ( ivar=0; ivar < NVARALL; ivar++ ) {
 
+    INDEX_COLUMN[ivar] = -9 ;
+
     // don't duplicate FIELD (Dec 8 2014)
     if ( SKIP_VARNAME(ifile,ivar) ) { continue ; }
 
@@ -829,50 +912,17 @@ void ADD_FITRES(int ifile) {
  
     if ( ICAST == ICAST_C ) {
       NVARSTR_FITRES++ ;   // summed over fitres files
-      sprintf(VARNAME_C, "%s:C*20", VARNAME) ;  //specify char ptr
-      index = SNTABLE_READPREP_VARDEF(VARNAME_C, 
-			     &FITRES_VALUES.STR_TMP[ivarstr][0], MXSN, 1 ) ;
+      INDEX_COLUMN[ivar] = 
+	SNTABLE_READPREP_COLUMN(VARNAME, ICAST_C, NEVT_APPROX, 1);
       ivarstr++ ;          // sum for each separate fitres file
     }
     else {     
-      sprintf(VARNAME_F, "%s:F", VARNAME) ;  // specify float pointer
-      index = SNTABLE_READPREP_VARDEF(VARNAME_F, 
-			     &FITRES_VALUES.FLT_TMP[ivar][0], MXSN, 1 ) ; 
+      INDEX_COLUMN[ivar] = 
+	SNTABLE_READPREP_COLUMN(VARNAME, ICAST_F, NEVT_APPROX, 1);
     }
 
 
-    if ( NVAR >= MXVAR_TOT ) {
-      sprintf(c1err,"NVARALL_COMBINE=%d exceeds arround bound of", NVAR);
-      sprintf(c2err,"MXVAR_TOT = %d ", MXVAR_TOT ) ;
-      errmsg(SEV_FATAL, 0, fnam, c1err, c2err ); 
-    }      
-    ptr_CTAG = VARNAME_COMBINE[NVAR] ;
-    sprintf(ptr_CTAG, "%s", VARNAME );
-
-    // use CID (1st var) in 1st file only
-    REPEATCID = ( ifile > 0 && ivar == IVARSTR_CCID ) ;
-    if ( REPEATCID ) { 
-      ICAST_FITRES_COMBINE[NVAR] = -1 ;  // don't write repeated CIDs
-      NVARALL_FITRES++ ;     NVAR = NVARALL_FITRES ;
-      continue ;
-    } 
-    else { 
-      ICAST_FITRES_COMBINE[NVAR] = ICAST ;
-      NVAR_WRITE_COMBINED++ ; 
-    } 
-    
-    // check if this tag name already exists;
-    // if so, append '_$ifile' to end of tagname
-
-    NTAG_DEJA = NMATCH_VARNAME(ptr_CTAG, NVAR) ;
-    if ( NTAG_DEJA > 0 ) {
-      iappend = ifile+1; // first iappend is 2
-      printf("\t ADD_FITRES WARNING: VARNAME=%s already exists: ", ptr_CTAG);
-      printf("append %d \n", iappend );
-      sprintf( VARNAME_COMBINE[NVAR], "%s_%d", ptr_CTAG, iappend );
-    }
-
-    NVARALL_FITRES++ ;     NVAR = NVARALL_FITRES ;
+    add_VARNAME_COMBINE(ifile, ivar, VARNAME, ICAST);
 
     fflush(stdout);
 
@@ -883,6 +933,18 @@ void ADD_FITRES(int ifile) {
   NLIST = SNTABLE_READ_EXEC();
   NEVT_READ[ifile] = NLIST;
 
+  // take table-owned columns
+  ivarstr = 0 ;
+  for ( ivar=0; ivar < NVARALL; ivar++ ) {
+    if ( INDEX_COLUMN[ivar] < 0 ) { continue ; }
+    if ( READTABLE_POINTERS.ICAST_STORE[ivar] == ICAST_C ) {
+      FITRES_VALUES.STR_TMP[ivarstr] = SNTABLE_COLUMN_C(INDEX_COLUMN[ivar]);
+      ivarstr++ ;
+    }
+    else
+      { FITRES_VALUES.FLT_TMP[ivar] = SNTABLE_COLUMN_F(INDEX_COLUMN[ivar]); }
+  }
+
   if ( INPUTS.DO_ROWMATCH  ) { relabel_rownum(ifile); }
 
   if ( ifile == 0 ) {
@@ -938,6 +1000,82 @@ void ADD_FITRES(int ifile) {
 
 } // end of ADD_FITRES
 
+
+// ===============================================
+void check_FIRST_SNANA(int ifile, int NVARALL) {
+
+  // Created Oct 2026: code moved from ADD_FITRES.
+  // Check if this is an SNANA file; mark first SNANA file.
+
+  int ivar, j;
+  char *VARNAME ;
+
+  if ( IFILE_FIRST_SNANA >= 0 ) { return; }
+
+  for ( ivar=0; ivar < NVARALL; ivar++ ) {    
+    VARNAME = READTABLE_POINTERS.VARNAME[ivar] ;
+    for(j=0; j < NVARNAME_1ONLY; j++ ) {
+      if ( strcmp(VARNAME,VARNAME_1ONLY[j])==0 ) 
+	{  IFILE_FIRST_SNANA = ifile; }	
+    }
+  }
+  if ( IFILE_FIRST_SNANA >= 0 ) {
+    printf("\t First SNANA ifile = %d (%s) \n",
+	   IFILE_FIRST_SNANA, INPUTS.FFILE[ifile] );
+  }
+
+} // end check_FIRST_SNANA
+
+// ===============================================
+void add_VARNAME_COMBINE(int ifile, int ivar, char *VARNAME, int ICAST) {
+
+  // Created Oct 2026: code moved from ADD_FITRES so that 
+  // STREAM_PREP_FITRES defines the same combined varnames.
+  // Append VARNAME from ifile to VARNAME_COMBINE list and
+  // increment NVARALL_FITRES.
+
+  int  NVAR = NVARALL_FITRES ;
+  int  NTAG_DEJA, REPEATCID, iappend ;
+  char *ptr_CTAG ;
+  char fnam[] = "add_VARNAME_COMBINE" ;
+
+  // ----------- BEGIN ------------
+
+  if ( NVAR >= MXVAR_TOT ) {
+    sprintf(c1err,"NVARALL_COMBINE=%d exceeds arround bound of", NVAR);
+    sprintf(c2err,"MXVAR_TOT = %d ", MXVAR_TOT ) ;
+    errmsg(SEV_FATAL, 0, fnam, c1err, c2err ); 
+  }      
+  ptr_CTAG = VARNAME_COMBINE[NVAR] ;
+  sprintf(ptr_CTAG, "%s", VARNAME );
+
+  // use CID (1st var) in 1st file only
+  REPEATCID = ( ifile > 0 && ivar == IVARSTR_CCID ) ;
+  if ( REPEATCID ) { 
+    ICAST_FITRES_COMBINE[NVAR] = -1 ;  // don't write repeated CIDs
+    NVARALL_FITRES++ ;
+    return ;
+  } 
+  else { 
+    ICAST_FITRES_COMBINE[NVAR] = ICAST ;
+    NVAR_WRITE_COMBINED++ ; 
+  } 
+  
+  // check if this tag name already exists;
+  // if so, append '_$ifile' to end of tagname
+
+  NTAG_DEJA = NMATCH_VARNAME(ptr_CTAG, NVAR) ;
+  if ( NTAG_DEJA > 0 ) {
+    iappend = ifile+1; // first iappend is 2
+    printf("\t ADD_FITRES WARNING: VARNAME=%s already exists: ", ptr_CTAG);
+    printf("append %d \n", iappend );
+    sprintf( VARNAME_COMBINE[NVAR], "%s_%d", ptr_CTAG, iappend );
+  }
+
+  NVARALL_FITRES++ ;
+
+} // end add_VARNAME_COMBINE
+
 // =====================================
 int match_CID_orig(int ifile, int isn2) {
 
@@ -1032,8 +1170,9 @@ void ADD_FITRES_VARLIST(int ifile, int isn, int isn2) {
       IVARSTR = NVARSTR_FITRES_LAST + ivarstr ;
       IVARSTR_STORE[IVARTOT] = IVARSTR ;
       
-      sprintf(FITRES_VALUES.STR_ALL[IVARSTR][isn],"%s", 
-	      FITRES_VALUES.STR_TMP[ivarstr][isn2] ); 
+      // interned string; copy pointer (Oct 2026)
+      FITRES_VALUES.STR_ALL[IVARSTR][isn] = 
+	FITRES_VALUES.STR_TMP[ivarstr][isn2] ; 
       
       ivarstr++ ;
     }
@@ -1045,6 +1184,297 @@ void ADD_FITRES_VARLIST(int ifile, int isn, int isn2) {
 } // end ADD_FITRES_VARLIST
 
  
+// =====================================
+void STREAM_FITRES(void) {
+
+  // Created Oct 2026
+  // Streaming join for very large files (e.g., 10^7 row biasCor):
+  //  1) read header of each file (in order) to define combined 
+  //     varnames, and read files ifile>0 into float and interned-string
+  //     columns with a CID hash table per file;
+  //  2) stream ifile=0 one row at a time, join other files via hash,
+  //     and write each row.
+  // Only ifile>0 are held in memory, so the largest file should be
+  // first. The first file still defines the output list of CIDs.
+
+  int NFFILE = INPUTS.NFFILE ;
+  int ifile, ivar ;
+  char fnam[] = "STREAM_FITRES" ;
+
+  // ----------- BEGIN -----------
+
+  print_banner(fnam);
+  STREAM_JOIN.MEM_MB = 0.0 ;
+
+  for ( ifile = 0; ifile < NFFILE; ifile++ ) 
+    { STREAM_PREP_FITRES(ifile); }
+
+  STREAM_FILL_SNTABLE();
+
+  // free hashed files
+  for ( ifile = 1; ifile < NFFILE; ifile++ ) {
+    HASH_CLEAR(hh, STREAM_JOIN.HASH[ifile]);
+    free(STREAM_JOIN.HASH_STORE[ifile]);
+    for ( ivar=0; ivar < STREAM_JOIN.NVAR[ifile]; ivar++ ) {
+      if ( STREAM_JOIN.FLT[ifile][ivar] ) { free(STREAM_JOIN.FLT[ifile][ivar]); }
+      if ( STREAM_JOIN.STR[ifile][ivar] ) { free(STREAM_JOIN.STR[ifile][ivar]); }
+    }
+    free(STREAM_JOIN.FLT[ifile]);  free(STREAM_JOIN.STR[ifile]);
+  }
+
+  return ;
+
+} // end STREAM_FITRES
+
+
+// =====================================
+void STREAM_PREP_FITRES(int ifile) {
+
+  // Created Oct 2026
+  // Read header of ifile and append its variables to the combined
+  // varname list (same logic as ADD_FITRES). For ifile > 0, read the
+  // whole file into columns and build CID -> row hash table; 
+  // for ifile = 0, close the file so that it can be streamed later.
+
+  int  NVARALL, IFILETYPE, NROW=0, NFLT=0, NSTR=0 ;
+  int  ivar, irow, ICAST, IVARTOT, indx ;
+  double MEM_MB ;
+  char *VARNAME, **CCID ;
+  struct hash_stream_def *h ;
+  char fnam[] = "STREAM_PREP_FITRES" ;
+
+  // ----------- BEGIN -----------
+
+  IFILETYPE = TABLEFILE_OPEN( INPUTS.FFILE[ifile], "read text" );
+  NVARALL   = SNTABLE_READPREP(IFILETYPE,"SNTABLE");
+  NVARALL_FILE[ifile]     = NVARALL ;
+  STREAM_JOIN.NVAR[ifile] = NVARALL ;
+
+  check_FIRST_SNANA(ifile, NVARALL);
+
+  if ( ifile > 0 ) {
+    // enforce memory limit before allocating
+    for ( ivar=0; ivar < NVARALL; ivar++ ) {    
+      if ( SKIP_VARNAME(ifile, ivar) ) { continue ; }
+      if ( READTABLE_POINTERS.ICAST_STORE[ivar] == ICAST_C ) 
+	{ NSTR++ ; } else { NFLT++ ; }
+    }
+    NROW   = SNTABLE_NEVT(INPUTS.FFILE[ifile],"TABLE");
+    MEM_MB = (double)NROW * 
+      (double)( NFLT*sizeof(float) + NSTR*sizeof(char*) + 
+		sizeof(struct hash_stream_def) ) / 1.0E6 ;
+    STREAM_JOIN.MEM_MB += MEM_MB ;
+    printf("\t Hash %d rows from ifile=%d (%.1f MB; total %.1f MB)\n",
+	   NROW, ifile, MEM_MB, STREAM_JOIN.MEM_MB);
+    fflush(stdout);
+
+    if ( STREAM_JOIN.MEM_MB > INPUTS.MXMEM_MB ) {
+      sprintf(c1err,"Stream memory for hashed files is %.1f MB, "
+	      "exceeds --mxmem_mb %.1f", STREAM_JOIN.MEM_MB, INPUTS.MXMEM_MB);
+      sprintf(c2err,"Put largest file first, or increase --mxmem_mb");
+      errmsg(SEV_FATAL, 0, fnam, c1err, c2err ); 
+    }
+
+    STREAM_JOIN.FLT[ifile] = (float**) malloc(NVARALL*sizeof(float*) );
+    STREAM_JOIN.STR[ifile] = (char***) malloc(NVARALL*sizeof(char**) );
+  }
+
+  NVARALL_FITRES_LAST = NVARALL_FITRES ;
+  NVARSTR_FITRES_LAST = NVARSTR_FITRES ;
+
+  for ( ivar=0; ivar < NVARALL; ivar++ ) {
+
+    STREAM_JOIN.IVARTOT[ifile][ivar] = -1 ;
+    if ( ifile > 0 ) {
+      STREAM_JOIN.FLT[ifile][ivar] = NULL ;
+      STREAM_JOIN.STR[ifile][ivar] = NULL ;
+    }
+
+    if ( SKIP_VARNAME(ifile,ivar) ) { continue ; }
+
+    VARNAME = READTABLE_POINTERS.VARNAME[ivar] ;
+    ICAST   = READTABLE_POINTERS.ICAST_STORE[ivar] ;
+    IVARTOT = NVARALL_FITRES ;
+    STREAM_JOIN.IVARTOT[ifile][ivar] = IVARTOT ;
+
+    if ( ifile==0 && strcmp(VARNAME,"zHD") == 0 ) { IVAR_zHD = IVARTOT; }
+
+    // make sure first column is CID
+    if ( ivar == IVARSTR_CCID ) {
+      if ( ICAST_for_textVar(VARNAME) != ICAST_C ) {
+	sprintf(c1err,"Unrecognized first column: %s", VARNAME);
+	sprintf(c2err,"Check %s", INPUTS.FFILE[ifile] );
+	errmsg(SEV_FATAL, 0, fnam, c1err, c2err );       
+      }
+    }
+
+    if ( ICAST == ICAST_C ) {
+      IVARSTR_STORE[IVARTOT] = NVARSTR_FITRES ;
+      NVARSTR_FITRES++ ;  
+      if ( ifile > 0 ) {
+	indx = SNTABLE_READPREP_COLUMN(VARNAME, ICAST_C, NROW, 1);
+	STREAM_JOIN.STR[ifile][ivar] = SNTABLE_COLUMN_C(indx);
+      }
+    }
+    else if ( ifile > 0 ) {
+      indx = SNTABLE_READPREP_COLUMN(VARNAME, ICAST_F, NROW, 1);
+      STREAM_JOIN.FLT[ifile][ivar] = SNTABLE_COLUMN_F(indx);
+    }
+
+    add_VARNAME_COMBINE(ifile, ivar, VARNAME, ICAST);
+
+  } // end ivar
+
+  // first file is streamed later
+  if ( ifile == 0 ) { SNTABLE_CLOSE_TEXT();  return ; }
+
+  NROW = SNTABLE_READ_EXEC();
+  NEVT_READ[ifile] = NROW ;
+
+  // CID -> row hash; for duplicate CIDs keep first row.
+  CCID = STREAM_JOIN.STR[ifile][IVARSTR_CCID] ;
+  STREAM_JOIN.HASH[ifile] = NULL ;
+  STREAM_JOIN.HASH_STORE[ifile] = (struct hash_stream_def*)
+    malloc( (NROW+1) * sizeof(struct hash_stream_def) );
+
+  for ( irow=0; irow < NROW; irow++ ) {
+    HASH_FIND_STR(STREAM_JOIN.HASH[ifile], CCID[irow], h);
+    if ( h != NULL ) { continue ; }
+    h = &STREAM_JOIN.HASH_STORE[ifile][irow] ;
+    h->irow = irow ;
+    h->name = CCID[irow] ;
+    HASH_ADD_KEYPTR(hh, STREAM_JOIN.HASH[ifile], h->name, 
+		    strlen(h->name), h);
+  }
+
+  return ;
+
+} // end STREAM_PREP_FITRES
+
+
+// =====================================
+void STREAM_FILL_SNTABLE(void) {
+
+  // Created Oct 2026
+  // Stream first fitres file one row at a time; for each row, 
+  // join values from hashed files (or NULL values if CID is missing)
+  // and write row to output table(s).
+
+  int  NFFILE = INPUTS.NFFILE ;
+  int  NMATCH_FILE[MXFFILE];
+  int  NVARALL, IFILETYPE, NROW0 = 0, NMATCH, ifile, ivar, irow ;
+  int  ICAST, IVARTOT, ivarstr ;
+  char *VARNAME, *ptrSTR, *ccid, VARNAME_CAST[MXCHAR_VARNAME+4] ;
+  struct hash_stream_def *h ;
+  char fnam[] = "STREAM_FILL_SNTABLE" ;
+
+  // ----------- BEGIN -----------
+
+  IFILETYPE = TABLEFILE_OPEN( INPUTS.FFILE[0], "read text" );
+  NVARALL   = SNTABLE_READPREP(IFILETYPE,"SNTABLE");
+
+  // point 1-row read buffers directly to output row
+  for ( ivar=0; ivar < NVARALL; ivar++ ) {
+    IVARTOT = STREAM_JOIN.IVARTOT[0][ivar] ;
+    if ( IVARTOT < 0 ) { continue ; }
+    VARNAME = READTABLE_POINTERS.VARNAME[ivar] ;
+    ICAST   = READTABLE_POINTERS.ICAST_STORE[ivar] ;
+    if ( ICAST == ICAST_C ) {
+      ivarstr = IVARSTR_STORE[IVARTOT] ;
+      STREAM_JOIN.PTRSTR0[ivarstr] = TABLEROW_VALUES.STR[ivarstr] ;
+      sprintf(VARNAME_CAST, "%s:C", VARNAME) ;
+      SNTABLE_READPREP_VARDEF(VARNAME_CAST, &STREAM_JOIN.PTRSTR0[ivarstr],
+			      1, 0);
+    }
+    else {
+      sprintf(VARNAME_CAST, "%s:F", VARNAME) ;
+      SNTABLE_READPREP_VARDEF(VARNAME_CAST, &TABLEROW_VALUES.FLT[IVARTOT],
+			      1, 0);
+    }
+  }
+
+  WRITE_SNTABLE_OPEN();
+  if ( CREATEFILE_TEXT ) 
+    { set_NROW_FLUSH_TEXT(TABLEID_COMBINE, NROW_FLUSH_STREAM); }
+
+  for ( ifile=0; ifile < NFFILE; ifile++ ) { NMATCH_FILE[ifile] = 0; }
+
+  printf("   Stream %s and fill combined table ... \n", INPUTS.FFILE[0]);
+  fflush(stdout);
+
+  while ( SNTABLE_READ_ROW(0) ) {
+
+    ccid   = TABLEROW_VALUES.STR[IVARSTR_CCID] ;
+    NMATCH = 1 ;
+
+    for ( ifile=1; ifile < NFFILE; ifile++ ) {
+
+      HASH_FIND_STR(STREAM_JOIN.HASH[ifile], ccid, h);
+      irow = -9 ;
+      if ( h != NULL ) { irow = h->irow; NMATCH++ ; NMATCH_FILE[ifile]++ ; }
+
+      for ( ivar=0; ivar < STREAM_JOIN.NVAR[ifile]; ivar++ ) {
+	IVARTOT = STREAM_JOIN.IVARTOT[ifile][ivar] ;
+	if ( IVARTOT < 0 ) { continue ; }
+	ICAST = ICAST_FITRES_COMBINE[IVARTOT] ;
+	if ( ICAST < 0 ) { continue ; } // repeated CID
+
+	if ( ICAST == ICAST_C ) {
+	  ptrSTR = TABLEROW_VALUES.STR[IVARSTR_STORE[IVARTOT]] ;
+	  if ( irow >= 0 ) 
+	    { sprintf(ptrSTR, "%s", STREAM_JOIN.STR[ifile][ivar][irow]); }
+	  else
+	    { sprintf(ptrSTR, "%s", DEFAULT_NULLVAL_STRING); }
+	}
+	else {
+	  if ( irow >= 0 ) 
+	    { TABLEROW_VALUES.FLT[IVARTOT] = STREAM_JOIN.FLT[ifile][ivar][irow]; }
+	  else
+	    { TABLEROW_VALUES.FLT[IVARTOT] = INPUTS.NULLVAL_FLOAT ; }
+	}
+      } // end ivar
+    } // end ifile
+
+    if ( NMATCH == NFFILE ) { NEVT_COMMON++ ; }
+
+    fill_TABLEROW_CCID(NROW0);
+    NROW0++ ;
+
+    if ( SKIP_TABLEROW_zCUT() ) { continue ; }
+
+    NWRITE_SNTABLE++ ;
+    SNTABLE_FILL(TABLEID_COMBINE);
+
+    if ( NROW0 >= INPUTS.MXROW_READ ) {
+      printf("\n\t STOP AFTER WRITING %d ROWS. \n\n", NWRITE_SNTABLE);
+      fflush(stdout);  
+      SNTABLE_CLOSE_TEXT();
+      break ;
+    }
+
+  } // end while
+
+  NEVT_READ[0]       = NROW0 ;
+  NLIST_FIRST_FITRES = NROW0 ;
+  for ( ifile=1; ifile < NFFILE; ifile++ ) 
+    { NEVT_MISSING[ifile] = NROW0 - NMATCH_FILE[ifile]; }
+
+  for ( ifile=1; ifile < NFFILE; ifile++ ) {
+    if ( NEVT_READ[ifile] > NROW0 ) {
+      printf("   %s NOTE: ifile=%d has more rows than streamed ifile=0; "
+	     "list largest file first to reduce memory.\n", 
+	     fnam, ifile);
+      fflush(stdout);
+    }
+  }
+
+  WRITE_SNTABLE_CLOSE();
+
+  return ;
+
+} // end STREAM_FILL_SNTABLE
+
+
 // =====================================
 int SKIP_VARNAME(int ifile, int ivar) {
 
@@ -1086,21 +1516,15 @@ void freeVar_TMP(int ifile, int NVARTOT, int NVARSTR, int MAXLEN) {
   // Aug 2013
   // Free _TMP arrays so that they can be re-allocated
   // with a different number of variables and SN.
+  //
+  // Oct 2026: _TMP arrays are table columns; free the column arrays,
+  //           but not the interned strings.
 
-  int ivar, isn ;
+  int ivar ;
 
   for ( ivar=0; ivar < NVARTOT; ivar++ ) {
-
-    if ( ivar < NVARSTR ) {
-
-      for ( isn=0; isn < MAXLEN; isn++ ) 
-	{ free(FITRES_VALUES.STR_TMP[ivar][isn]) ; }
-
-      free( FITRES_VALUES.STR_TMP[ivar]  ) ;
-    }
-
+    if ( ivar < NVARSTR ) { free( FITRES_VALUES.STR_TMP[ivar]  ) ; }
     free( FITRES_VALUES.FLT_TMP[ivar] ) ;
-
   }  // ivar
 
   free(FITRES_VALUES.FLT_TMP);
@@ -1116,6 +1540,8 @@ void  fitres_malloc_flt(int ifile, int NVAR, int MAXLEN) {
   // to store all fitres values.
   // NVAR is the number of variables to read from this fitres file.
   // MAXLEN is an estimate of the max array length to allocate.
+  //
+  // Oct 2026: FLT_TMP[ivar] is set to table column in ADD_FITRES.
 
   int ivar, isn, IVAR_ALL, NTOT, MEMF ;
   //  char fnam[] = "fitres_malloc_flt" ;
@@ -1144,12 +1570,11 @@ void  fitres_malloc_flt(int ifile, int NVAR, int MAXLEN) {
     MEMF = sizeof(float  ) * MAXLEN ;
     IVAR_ALL = NVARALL_FITRES + ivar ;
 
-    FITRES_VALUES.FLT_TMP[ivar]     = (float  *)malloc(MEMF);
+    FITRES_VALUES.FLT_TMP[ivar]     = NULL ; // column from ADD_FITRES
     FITRES_VALUES.FLT_ALL[IVAR_ALL] = (float  *)malloc(MEMF);    
 
     for ( isn=0; isn < MAXLEN; isn++ ) {
       USEDCID[isn] = false ;
-      FITRES_VALUES.FLT_TMP[ivar][isn]     = INPUTS.NULLVAL_FLOAT ;
       FITRES_VALUES.FLT_ALL[IVAR_ALL][isn] = INPUTS.NULLVAL_FLOAT ;
     }
   }
@@ -1169,9 +1594,12 @@ void  fitres_malloc_str(int ifile, int NVAR, int MAXLEN) {
   // be there.
   //
   // Apr 27 2020: init STR_ALL and STR_TMP to 'NULL'
+  // Oct 2026: STR_TMP[ivar] is set to table column in ADD_FITRES;
+  //           STR_ALL elements point to interned strings.
 
   //  char fnam[] = "fitres_malloc_str" ;
   int ivar, IVAR_ALL, isn, MEMC, NTOT ;
+  char *NULLSTR = intern_READTABLE_STRING(DEFAULT_NULLVAL_STRING);
   
   // ---------- BEGIN ------------
 
@@ -1199,18 +1627,11 @@ void  fitres_malloc_str(int ifile, int NVAR, int MAXLEN) {
 
     // allocate SN-dimension
     MEMC = sizeof(char*) * MAXLEN ;
-    FITRES_VALUES.STR_TMP[ivar]      = (char**)malloc(MEMC);
+    FITRES_VALUES.STR_TMP[ivar]      = NULL ; // column from ADD_FITRES
     FITRES_VALUES.STR_ALL[IVAR_ALL]  = (char**)malloc(MEMC);    
 
-    // allocate chars for each string argument
-    MEMC = MXSTRLEN * sizeof(char)  ;
-    for ( isn=0; isn < MAXLEN; isn++ ) {
-      FITRES_VALUES.STR_TMP[ivar][isn]     = (char*)malloc(MEMC);
-      FITRES_VALUES.STR_ALL[IVAR_ALL][isn] = (char*)malloc(MEMC);
-      sprintf(FITRES_VALUES.STR_TMP[ivar][isn],"%s"    , DEFAULT_NULLVAL_STRING) ;
-      sprintf(FITRES_VALUES.STR_ALL[IVAR_ALL][isn],"%s", DEFAULT_NULLVAL_STRING) ;
-   
-    } // isn
+    for ( isn=0; isn < MAXLEN; isn++ ) 
+      { FITRES_VALUES.STR_ALL[IVAR_ALL][isn] = NULLSTR ; }
   }  // ivar
 
 
@@ -1277,7 +1698,8 @@ void  print_stats(void) {
 
 
   if ( NFFILE > 1 ) {
-    for(isn=0; isn < NLIST_FIRST_FITRES; isn++ ) {
+    // stream mode counts NEVT_COMMON while streaming
+    for(isn=0; isn < NLIST_FIRST_FITRES && !INPUTS.DO_STREAM; isn++ ) {
       if ( NMATCH_PER_EVT[isn] == NFFILE ) { NEVT_COMMON++; }
     }
     printf("%s NEVT_COMMON: %d  (%d missing in at least one file)\n\n", 
@@ -1300,34 +1722,93 @@ void WRITE_SNTABLE(void) {
   // Jan  7, 2014: for hbook, call remove_string_termination(...)
   // Apr 26, 2014: return gracefully if neither hbook & root are defined.
   // Feb 26, 2017: if CIDint already exists, don't write out another one.
+  // Oct 2026: move open/close to WRITE_SNTABLE_[OPEN,CLOSE] and 
+  //           CCID logic to fill_TABLEROW_CCID for streaming join.
+
+  char *ptrSTR ;
+  int ivar, ivarstr, isn, ICAST ;
+
+  //  char  fnam[] = "WRITE_SNTABLE" ;
+  // --------------- BEGIN ------------
+
+  WRITE_SNTABLE_OPEN();
+
+  // ------------------------------
+  printf("   Fill combined table with %d rows ... \n", NLIST_FIRST_FITRES );
+  fflush(stdout);
+
+  for ( isn = 0; isn < NLIST_FIRST_FITRES ; isn++ ) {
+
+    for ( ivar=0; ivar < NVARALL_FITRES; ivar++ ) {
+
+      ICAST = ICAST_FITRES_COMBINE[ivar] ;
+      if ( ICAST < 0 ) { continue ; }
+
+      if ( ICAST == ICAST_C )  { 
+	ivarstr = IVARSTR_STORE[ivar];
+	ptrSTR  = TABLEROW_VALUES.STR[ivarstr] ;
+
+	sprintf(ptrSTR,"%s", FITRES_VALUES.STR_ALL[ivarstr][isn]);
+      }
+      else
+	{ TABLEROW_VALUES.FLT[ivar] = FITRES_VALUES.FLT_ALL[ivar][isn];  }
+
+    } // ivar
+
+    fill_TABLEROW_CCID(isn);
+
+    if ( SKIP_TABLEROW_zCUT() ) { continue ; }
+
+    NWRITE_SNTABLE++ ;
+    SNTABLE_FILL(TABLEID_COMBINE);
+
+    // Jan 2020: stop if -mxrow
+    if ( isn >= INPUTS.MXROW_READ-1 ) {
+      printf("\n\t STOP AFTER WRITING %d ROWS. \n\n", isn);
+      fflush(stdout);  goto DONE_FILL ;
+    }
+    
+  } // isn
+
+ DONE_FILL:
+
+  WRITE_SNTABLE_CLOSE();
+
+  return;
+
+} // end of WRITE_SNTABLE
+
+
+// =========================================
+void WRITE_SNTABLE_OPEN(void) {
+
+  // Created Oct 2026: code moved from WRITE_SNTABLE.
+  // Open output file(s), create table and define columns
+  // pointing to TABLEROW_VALUES.
 
   char 
-    OUTFILE[6][200] 
-    ,tableVar[60]
-    ,*ptrSTR
+    tableVar[60]
     ,BLOCKVAR[]   = "VAR"     
-    ,openOpt[40], CCIDint[40]
+    ,openOpt[40]
     ;
 
-  double zHD;
-  int GZIPFLAG = 0 ;
-  int ivar, ivarstr, isn, ICAST, CIDint ;
-  int IFILETYPE, NOUT, out, SKIP ;
+  int ivar, ivarstr, ICAST ;
+  int IFILETYPE, NOUT ;
 
-  char  fnam[] = "WRITE_SNTABLE" ;
+  //  char  fnam[] = "WRITE_SNTABLE_OPEN" ;
   // --------------- BEGIN ------------
 
   NOUT = 0 ;
-  OUTFILE[NOUT][0] = 0 ;
+  OUTFILE_SNTABLE.GZIPFLAG = 0 ;
   NWRITE_SNTABLE = 0 ;
 
 
 #ifdef USE_HBOOK
   if (CREATEFILE_HBOOK)  { 
-    sprintf(OUTFILE[NOUT], "%s.%s", 
+    sprintf(OUTFILE_SNTABLE.NAME[NOUT], "%s.%s", 
 	    INPUTS.OUTPREFIX_COMBINE, ptrSuffix_hbook );  
     sprintf(openOpt,"%s new", ptrSuffix_hbook);
-    IFILETYPE = TABLEFILE_OPEN(OUTFILE[NOUT],openOpt);
+    IFILETYPE = TABLEFILE_OPEN(OUTFILE_SNTABLE.NAME[NOUT],openOpt);
     NOUT++ ;
   }
 #endif
@@ -1335,10 +1816,10 @@ void WRITE_SNTABLE(void) {
 
 #ifdef USE_ROOT
   if ( CREATEFILE_ROOT )  { 
-    sprintf(OUTFILE[NOUT], "%s.%s", 
+    sprintf(OUTFILE_SNTABLE.NAME[NOUT], "%s.%s", 
 	    INPUTS.OUTPREFIX_COMBINE, ptrSuffix_root ); 
     sprintf(openOpt,"%s new", ptrSuffix_root);
-    IFILETYPE = TABLEFILE_OPEN(OUTFILE[NOUT],openOpt);
+    IFILETYPE = TABLEFILE_OPEN(OUTFILE_SNTABLE.NAME[NOUT],openOpt);
     NOUT++ ;
   }
 #endif
@@ -1346,16 +1827,18 @@ void WRITE_SNTABLE(void) {
 
 #ifdef USE_TEXT
   if ( CREATEFILE_TEXT )  { 
-    sprintf(OUTFILE[NOUT], "%s.%s", 
+    sprintf(OUTFILE_SNTABLE.NAME[NOUT], "%s.%s", 
 	    INPUTS.OUTPREFIX_COMBINE, ptrSuffix_text ); 
-    outFile_text_override(OUTFILE[NOUT],&GZIPFLAG); 
+    outFile_text_override(OUTFILE_SNTABLE.NAME[NOUT],
+			  &OUTFILE_SNTABLE.GZIPFLAG); 
     sprintf(openOpt,"%s new", ptrSuffix_text);
-    //    IFILETYPE = TABLEFILE_OPEN(OUTPREFIX_COMBINE,openOpt);
-    IFILETYPE = TABLEFILE_OPEN(OUTFILE[NOUT],openOpt);
+    IFILETYPE = TABLEFILE_OPEN(OUTFILE_SNTABLE.NAME[NOUT],openOpt);
     NOUT++ ;
   }
 #endif
 
+  OUTFILE_SNTABLE.NOUT = NOUT ;
+
   printf("\n   Create combined SNTable with %d variables \n", 
 	 NVAR_WRITE_COMBINED );
 
@@ -1364,7 +1847,7 @@ void WRITE_SNTABLE(void) {
   ADD_SNTABLE_COMMENTS() ;
 
   // check of CIDint is already there (Feb 2017)
-  int CIDint_EXISTS = 0 ;
+  CIDint_EXISTS = 0 ;
   for ( ivar=0; ivar < NVARALL_FITRES; ivar++ ) {
     if ( strcmp(VARNAME_COMBINE[ivar],"CIDint")==0 ) { CIDint_EXISTS=1; }
   }
@@ -1409,99 +1892,91 @@ void WRITE_SNTABLE(void) {
 
   }    // ivar
 
-
-  // ------------------------------
-  printf("   Fill combined table with %d rows ... \n", NLIST_FIRST_FITRES );
-  fflush(stdout);
-
   if ( INPUTS.DOzCUT ) {
     printf("\n ONLY WRITE EVENTS with %.3f < zHD < %.3f \n\n",
 	   INPUTS.CUTWIN_zHD[0], INPUTS.CUTWIN_zHD[1] );
     fflush(stdout);
   }
 
-  for ( isn = 0; isn < NLIST_FIRST_FITRES ; isn++ ) {
-
-    TABLEROW_VALUES.CIDint = -999;
-    sprintf(TABLEROW_VALUES.CCID,"xxx ");
+  return;
 
-    for ( ivar=0; ivar < NVARALL_FITRES; ivar++ ) {
+} // end of WRITE_SNTABLE_OPEN
 
-      ICAST = ICAST_FITRES_COMBINE[ivar] ;
-      if ( ICAST < 0 ) { continue ; }
 
-      if ( ICAST == ICAST_C )  { 
-	ivarstr = IVARSTR_STORE[ivar];
-	ptrSTR  = TABLEROW_VALUES.STR[ivarstr] ;
+// =========================================
+void WRITE_SNTABLE_CLOSE(void) {
 
-	sprintf(ptrSTR,"%s", FITRES_VALUES.STR_ALL[ivarstr][isn]);
+  // Created Oct 2026: code moved from WRITE_SNTABLE.
+  int out ;
 
-	if ( ivar == 0 ) {
-	  sprintf(TABLEROW_VALUES.CCID, "%s ", ptrSTR); // Dec 8 2014
-	  CIDint = atoi(ptrSTR); 
-	  sprintf(CCIDint,"%d", CIDint);
-	  if ( strcmp(CCIDint,ptrSTR) == 0 ) 
-	    { TABLEROW_VALUES.CIDint = CIDint; } // CCID is already int
-	  else { 
-	    // CCID is a string, so integer CIDint increments
-	    TABLEROW_VALUES.CIDint = isn ; 
-	  }
-	}
+  // close it
+  for(out=0; out < OUTFILE_SNTABLE.NOUT; out++ ) 
+    { TABLEFILE_CLOSE(OUTFILE_SNTABLE.NAME[out]);  }
 
-	if ( CREATEFILE_HBOOK ) 
-	  { remove_string_termination(ptrSTR, MXSTRLEN); }
+  // check gzip option
+  if ( OUTFILE_SNTABLE.GZIPFLAG )  { 
+    char cmd[400];
+    sprintf(cmd,"gzip %s", INPUTS.OUTFILE_TEXT);
+    system(cmd); 
+  }
 
-      }
-      else
-	{ TABLEROW_VALUES.FLT[ivar] = FITRES_VALUES.FLT_ALL[ivar][isn];  }
-      
-      /*
-      float VAL = TABLEROW_VALUES.FLT[ivar];
-      if ( ivar == 54 && VAL < 0.0 ) {
-	printf(" xxx %s: CID=%d  %s = %le \n", 
-	       fnam, CIDint,  VARNAME_COMBINE[ivar], 
-	       TABLEROW_VALUES.FLT[ivar] );
-	fflush(stdout);
-	}  */
+  return;
 
+} // end of WRITE_SNTABLE_CLOSE
 
-    } // ivar
 
-    SKIP = 0 ;
-    if ( INPUTS.DOzCUT ) {
-      zHD = TABLEROW_VALUES.FLT[IVAR_zHD];
-      if ( zHD < INPUTS.CUTWIN_zHD[0] ) { SKIP = 1; }
-      if ( zHD > INPUTS.CUTWIN_zHD[1] ) { SKIP = 1; }
-    }
-    if ( SKIP ) { continue ; }
+// =========================================
+void fill_TABLEROW_CCID(int isn) {
 
-    NWRITE_SNTABLE++ ;
-    SNTABLE_FILL(TABLEID_COMBINE);
+  // Created Oct 2026: code moved from WRITE_SNTABLE.
+  // Set CCID and CIDint in TABLEROW_VALUES from string CID column
+  // (IVARSTR_CCID) after the rest of the row is filled.
+  // isn is the output row index used for CIDint if CCID is a string.
 
-    // Jan 2020: stop if -mxrow
-    if ( isn >= INPUTS.MXROW_READ-1 ) {
-      printf("\n\t STOP AFTER WRITING %d ROWS. \n\n", isn);
-      fflush(stdout);  goto DONE_FILL ;
-    }
-    
-  } // isn
+  char *ptrSTR = TABLEROW_VALUES.STR[IVARSTR_CCID] ;
+  char CCIDint[40];
+  int  ivar, CIDint;
 
- DONE_FILL:
+  // ----------- BEGIN -------------
 
-  // close it
-  for(out=0; out < NOUT; out++ ) 
-    { TABLEFILE_CLOSE(OUTFILE[out]);  }
+  sprintf(TABLEROW_VALUES.CCID, "%s ", ptrSTR); // Dec 8 2014
+  CIDint = atoi(ptrSTR); 
+  sprintf(CCIDint,"%d", CIDint);
+  if ( strcmp(CCIDint,ptrSTR) == 0 ) 
+    { TABLEROW_VALUES.CIDint = CIDint; } // CCID is already int
+  else { 
+    // CCID is a string, so integer CIDint increments
+    TABLEROW_VALUES.CIDint = isn ; 
+  }
 
-  // check gzip option
-  if ( GZIPFLAG )  { 
-    char cmd[400];
-    sprintf(cmd,"gzip %s", INPUTS.OUTFILE_TEXT);
-    system(cmd); 
+  if ( CREATEFILE_HBOOK ) {
+    for ( ivar=0; ivar < NVARALL_FITRES; ivar++ ) {
+      if ( ICAST_FITRES_COMBINE[ivar] != ICAST_C ) { continue ; }
+      ptrSTR = TABLEROW_VALUES.STR[IVARSTR_STORE[ivar]] ;
+      remove_string_termination(ptrSTR, MXSTRLEN); 
+    }
   }
 
   return;
 
-} // end of WRITE_SNTABLE
+} // end fill_TABLEROW_CCID
+
+
+// =========================================
+bool SKIP_TABLEROW_zCUT(void) {
+
+  // Created Oct 2026: code moved from WRITE_SNTABLE.
+  // Return true if zHD in TABLEROW_VALUES fails --zcut.
+
+  double zHD;
+  if ( !INPUTS.DOzCUT ) { return false; }
+
+  zHD = TABLEROW_VALUES.FLT[IVAR_zHD];
+  if ( zHD < INPUTS.CUTWIN_zHD[0] ) { return true; }
+  if ( zHD > INPUTS.CUTWIN_zHD[1] ) { return true; }
+  return false;
+
+} // end SKIP_TABLEROW_zCUT
 
 
 // ====================================================
@@ -1607,7 +2082,7 @@ void relabel_rownum(int ifile) {
   int N0  = NEVT_READ[0];
   int NSN = NEVT_READ[ifile];
   int isn, rownum=0 ;
-
+  char crow[20];
   char fnam[] = "relabel_rownum";
   
   // --------- BEGIN ----------
@@ -1623,7 +2098,8 @@ void relabel_rownum(int ifile) {
 
   for(isn=0; isn < NSN; isn++ ) {   
     rownum++ ;
-    sprintf(FITRES_VALUES.STR_TMP[IVARSTR_CCID][isn],"%d", rownum);
+    sprintf(crow, "%d", rownum);
+    FITRES_VALUES.STR_TMP[IVARSTR_CCID][isn] = intern_READTABLE_STRING(crow);
   }
 
 
@@ -1016,6 +1016,8 @@ void INTEG_zSED_PySEDMODEL(int OPT_SPEC, int ifilt_obs, double Tobs,
   //    use GENSMEAR.MAGSMEAR_LIST[ilamobs] instead of 
   //    undefined/obsolsete magSmear[ilamobs]
   //
+  // Oct 2026: broadband flux uses band projector (get_BANDPROJ_SEDMODEL)
+  //
 
   int    ifilt          = IFILTMAP_SEDMODEL[ifilt_obs] ;
   int    NLAMFILT       = FILTER_SEDMODEL[ifilt].NLAM ;
@@ -1083,6 +1085,22 @@ void INTEG_zSED_PySEDMODEL(int OPT_SPEC, int ifilt_obs, double Tobs,
   }
 
   // - - - - - -
+  // Oct 2026: broadband flux is a sparse dot product with the
+  //   band projector; explicit loop below is for spectra.
+  if ( OPT_SPEC == 0 && !DO_SPECTROGRAPH ) {
+    BANDPROJ_SEDMODEL_DEF *BANDPROJ = 
+      get_BANDPROJ_SEDMODEL(ifilt, zHEL, NLAM, LAM);
+    fold_XT_BANDPROJ_SEDMODEL(BANDPROJ, RV_host, AV_host);
+    if ( ISTAT_SMEAR ) 
+      { Finteg_filter = 
+	  eval_BANDPROJ_SEDMODEL(BANDPROJ, SED, GENSMEAR.MAGSMEAR_LIST); }
+    else
+      { Finteg_filter = eval_BANDPROJ_SEDMODEL(BANDPROJ, SED, NULL); }
+
+    *Finteg = (Finteg_filter * x0 * MODELNORM_Finteg);
+    if ( *Finteg < FLUXSUM_MIN ) { *FLAG_Finteg = (int)MAG_ZEROFLUX; }
+    return ;
+  }
 
   LAMSED_STEP = lamstep_filt ;
 
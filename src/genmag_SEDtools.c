@@ -51,6 +51,10 @@
       extinction table is no longer created for every iteration.
       Fits now go almost x10 faster ... same speed as in March 2020
 
+  Oct 2026:
+    + new BANDPROJ functions to integrate SED x filter with a
+      pre-computed sparse weight vector over the SED lambda grid.
+
 ********************************************/
 
 #include "sntools.h"           // community tools
@@ -70,6 +74,8 @@ int reset_SEDMODEL(void) {
   NFILT_SEDMODEL           =  0 ;
   FILTLIST_SEDMODEL[0]     =  0 ;
   ISED_SEDMODEL            = -9 ; // Mar 6 2017
+  MMAP_SEDMODEL_FLUXTABLE  = false ; // Oct 2026
+  init_BANDPROJ_SEDMODEL();          // Oct 2026
 
   SEDMODEL.DAYMIN_ALL = +9999999.0 ;
   SEDMODEL.DAYMAX_ALL = -9999999.0 ;
@@ -573,6 +579,8 @@ void malloc_FLUXTABLE_SEDMODEL( int NFILT, int NZBIN, int NLAMPOW,
   // Jan 30, 2010: switch from fancy 5-dim pointer to 1d pointer
   // Dec 15, 2021: fix isize=sizeof(float) instead of pointer size.
   // Feb 01, 2024: abort if max pointer size (NBTOT_DBL) exceeds 2 billion
+  // Oct 2026: if MMAP_SEDMODEL_FLUXTABLE is set, only set the binning;
+  //           caller maps the table from a binary file (see SIMSED).
   int isize;
   char fnam[] = "malloc_FLUXTABLE_SEDMODEL" ;
 
@@ -655,10 +663,17 @@ void malloc_FLUXTABLE_SEDMODEL( int NFILT, int NZBIN, int NLAMPOW,
   NBTOT_SEDMODEL_FLUXTABLE = N1DBINOFF_SEDMODEL_FLUXTABLE[0] ;
   ISIZE_SEDMODEL_FLUXTABLE = NBTOT_SEDMODEL_FLUXTABLE * isize ;
 
-  PTR_SEDMODEL_FLUXTABLE =  (float*)malloc(ISIZE_SEDMODEL_FLUXTABLE);
-
-  printf("  %s : allocate %6.2f Mb of memory for integral-flux tables. \n", 
-	 fnam, 1.E-6*(double)ISIZE_SEDMODEL_FLUXTABLE );
+  if ( MMAP_SEDMODEL_FLUXTABLE ) {
+    // table is mapped later from binary file; no private copy here
+    PTR_SEDMODEL_FLUXTABLE = NULL ;
+    printf("  %s : %6.2f Mb integral-flux table will be mmap'ed. \n", 
+	   fnam, 1.E-6*(double)ISIZE_SEDMODEL_FLUXTABLE );
+  }
+  else {
+    PTR_SEDMODEL_FLUXTABLE =  (float*)malloc(ISIZE_SEDMODEL_FLUXTABLE);
+    printf("  %s : allocate %6.2f Mb of memory for integral-flux tables. \n",
+	   fnam, 1.E-6*(double)ISIZE_SEDMODEL_FLUXTABLE );
+  }
 
   //  printf("\t\t Tables include lambda powers up to %d .\n",  NLAMPOW );
   printf("\t Table bins include %3d DAYs. \n",    NDAY);
@@ -680,7 +695,7 @@ void malloc_FLUXTABLE_SEDMODEL( int NFILT, int NZBIN, int NLAMPOW,
   }
 
 
-  zero_flux_SEDMODEL();
+  if ( !MMAP_SEDMODEL_FLUXTABLE ) { zero_flux_SEDMODEL(); }
 
   // - - - - - - - 
  
@@ -2743,6 +2758,203 @@ void fill_TABLE_HOSTXT_SEDMODEL(double RV, double AV, double z) {
 
 } // end fill_TABLE_HOSTXT_SEDMODEL
 
+// ************************************
+void init_BANDPROJ_SEDMODEL(void) {
+
+  // Created Oct 2026
+  // Free projectors built since last init (e.g., previous SEDMODEL
+  // or filter set), then flag every band projector as not built;
+  // memory is allocated on first use in get_BANDPROJ_SEDMODEL.
+  int ifilt;
+  BANDPROJ_SEDMODEL_DEF *BANDPROJ ;
+  for(ifilt=0; ifilt < MXFILT_SEDMODEL; ifilt++ ) {
+    BANDPROJ = &BANDPROJ_SEDMODEL[ifilt] ;
+    if ( BANDPROJ->IFILT >= 0 && BANDPROJ->ILAMOBS != NULL ) {
+      free(BANDPROJ->ILAMOBS);  free(BANDPROJ->ILAMSED);
+      free(BANDPROJ->COEFF);    free(BANDPROJ->XTFRAC);
+    }
+    if ( BANDPROJ->IFILT >= 0 && BANDPROJ->NLAM_SED > 0 ) 
+      { free(BANDPROJ->LAM_SED);  free(BANDPROJ->WGT_SED); }
+
+    BANDPROJ->IFILT    = -9 ;
+    BANDPROJ->NLAM_SED =  0 ;
+    BANDPROJ->ILAMOBS  = NULL ;
+  }
+  return ;
+
+} // end init_BANDPROJ_SEDMODEL
+
+
+// ************************************
+BANDPROJ_SEDMODEL_DEF *get_BANDPROJ_SEDMODEL(int ifilt, double z, 
+					     int NLAM, double *LAM) {
+
+  // Created Oct 2026
+  // Return band projector for sparse filter index ifilt, redshift z,
+  // and rest-frame SED grid LAM[0:NLAM-1]. Projector is rebuilt only
+  // if z or LAM grid changed since last call for this filter.
+  //
+  // For each filter bin with TRANS>0, store the SED bin and the 3
+  // quadratic-interp (Lagrange) coefficients at LAMSED=LAMOBS/(1+z)
+  // multiplied by LAMSED*TRANS. quadInterp is the same quadratic
+  // through the 3 points, so results agree to numerical precision.
+
+  BANDPROJ_SEDMODEL_DEF *BANDPROJ = &BANDPROJ_SEDMODEL[ifilt] ;
+  int    NLAMFILT  = FILTER_SEDMODEL[ifilt].NLAM ;
+  double z1        = 1.0 + z ;
+  double MEMD      = sizeof(double);
+  int    ilamobs, ilamsed, NBIN ;
+  double TRANS, LAMOBS, LAMSED, v0, v1, v2, FAC ;
+  bool   SAME_GRID ;
+  char fnam[] = "get_BANDPROJ_SEDMODEL" ;
+
+  // ------------ BEGIN ------------
+
+  if ( BANDPROJ->ILAMOBS == NULL ) {
+    BANDPROJ->ILAMOBS = (int   *)malloc(NLAMFILT * sizeof(int) );
+    BANDPROJ->ILAMSED = (int   *)malloc(NLAMFILT * sizeof(int) );
+    BANDPROJ->COEFF   = (double*)malloc(NLAMFILT * 3 * MEMD );
+    BANDPROJ->XTFRAC  = (double*)malloc(NLAMFILT * MEMD );
+  }
+
+  SAME_GRID = ( BANDPROJ->NLAM_SED == NLAM &&
+		memcmp(BANDPROJ->LAM_SED, LAM, NLAM*MEMD) == 0 );
+
+  if ( BANDPROJ->IFILT == ifilt && BANDPROJ->ZHEL == z && SAME_GRID ) 
+    { return(BANDPROJ); }
+
+  if ( !SAME_GRID ) {
+    if ( BANDPROJ->NLAM_SED > 0 ) 
+      { free(BANDPROJ->LAM_SED);  free(BANDPROJ->WGT_SED); }
+    BANDPROJ->LAM_SED  = (double*)malloc(NLAM * MEMD);
+    BANDPROJ->WGT_SED  = (double*)malloc(NLAM * MEMD);
+    BANDPROJ->NLAM_SED = NLAM ;
+    memcpy(BANDPROJ->LAM_SED, LAM, NLAM*MEMD);
+  }
+
+  NBIN = 0 ;
+  for ( ilamobs=0; ilamobs < NLAMFILT; ilamobs++ ) {
+
+    TRANS  = FILTER_SEDMODEL[ifilt].transSN[ilamobs] ;
+    if ( TRANS < 1.0E-12 ) { continue ; }
+
+    LAMOBS = FILTER_SEDMODEL[ifilt].lam[ilamobs] ;
+    LAMSED = LAMOBS / z1 ;
+    if ( LAMSED < LAM[0] || LAMSED > LAM[NLAM-1] ) { continue; }
+
+    ilamsed = quickBinSearch(LAMSED, NLAM, LAM, fnam);
+    if ( ilamsed >= NLAM-2 ) { ilamsed = NLAM-3; }
+
+    v0 = LAM[ilamsed+0];  v1 = LAM[ilamsed+1];  v2 = LAM[ilamsed+2];
+    FAC = LAMSED * TRANS ;
+
+    BANDPROJ->ILAMOBS[NBIN]     = ilamobs ;
+    BANDPROJ->ILAMSED[NBIN]     = ilamsed ;
+    BANDPROJ->COEFF[3*NBIN+0]   = 
+      FAC * (LAMSED-v1)*(LAMSED-v2) / ((v0-v1)*(v0-v2)) ;
+    BANDPROJ->COEFF[3*NBIN+1]   = 
+      FAC * (LAMSED-v0)*(LAMSED-v2) / ((v1-v0)*(v1-v2)) ;
+    BANDPROJ->COEFF[3*NBIN+2]   = 
+      FAC * (LAMSED-v0)*(LAMSED-v1) / ((v2-v0)*(v2-v1)) ;
+    NBIN++ ;
+  }
+
+  BANDPROJ->IFILT       = ifilt ;
+  BANDPROJ->ZHEL        = z ;
+  BANDPROJ->NBIN        = NBIN ;
+  BANDPROJ->FOLD_KEY[0] = -999.0 ; // force re-fold of extinction
+
+  return(BANDPROJ);
+
+} // end get_BANDPROJ_SEDMODEL
+
+
+// ************************************
+void fold_XT_BANDPROJ_SEDMODEL(BANDPROJ_SEDMODEL_DEF *BANDPROJ, 
+			       double RV_host, double AV_host) {
+
+  // Created Oct 2026
+  // Fold Galactic and host extinction into BANDPROJ->WGT_SED.
+  // Must call fill_TABLE_MWXT_SEDMODEL and fill_TABLE_HOSTXT_SEDMODEL
+  // first; fold is skipped if extinction is unchanged since last fold.
+
+  int    ifilt   = BANDPROJ->IFILT ;
+  int    NBIN    = BANDPROJ->NBIN ;
+  bool   USE_HOSTXT = ( RV_host > 1.0E-9 && AV_host > 1.0E-9 );
+  int    ibin, ilamobs, ilamsed, k, IMIN, IMAX ;
+  double XTFRAC ;
+
+  // ------------ BEGIN ------------
+
+  if ( BANDPROJ->FOLD_KEY[0] == SEDMODEL_MWEBV_LAST &&
+       BANDPROJ->FOLD_KEY[1] == RV_host &&
+       BANDPROJ->FOLD_KEY[2] == AV_host ) { return; }
+
+  for(ilamsed=0; ilamsed < BANDPROJ->NLAM_SED; ilamsed++ ) 
+    { BANDPROJ->WGT_SED[ilamsed] = 0.0 ; }
+
+  IMIN = BANDPROJ->NLAM_SED;  IMAX = -1 ;
+  for(ibin=0; ibin < NBIN; ibin++ ) {
+    ilamobs = BANDPROJ->ILAMOBS[ibin] ;
+    ilamsed = BANDPROJ->ILAMSED[ibin] ;
+    XTFRAC  = SEDMODEL_TABLE_MWXT_FRAC[ifilt][ilamobs] ;
+    if ( USE_HOSTXT ) 
+      { XTFRAC *= SEDMODEL_TABLE_HOSTXT_FRAC[ifilt][ilamobs] ; }
+
+    BANDPROJ->XTFRAC[ibin] = XTFRAC ;
+    for(k=0; k < 3; k++ ) 
+      { BANDPROJ->WGT_SED[ilamsed+k] += XTFRAC * BANDPROJ->COEFF[3*ibin+k]; }
+
+    if ( ilamsed   < IMIN ) { IMIN = ilamsed;   }
+    if ( ilamsed+2 > IMAX ) { IMAX = ilamsed+2; }
+  }
+
+  BANDPROJ->ILAMSED_MIN = IMIN ;
+  BANDPROJ->ILAMSED_MAX = IMAX ;
+  BANDPROJ->FOLD_KEY[0] = SEDMODEL_MWEBV_LAST ;
+  BANDPROJ->FOLD_KEY[1] = RV_host ;
+  BANDPROJ->FOLD_KEY[2] = AV_host ;
+
+  return ;
+
+} // end fold_XT_BANDPROJ_SEDMODEL
+
+
+// ************************************
+double eval_BANDPROJ_SEDMODEL(BANDPROJ_SEDMODEL_DEF *BANDPROJ, 
+			      double *SED, double *MAGSMEAR) {
+
+  // Created Oct 2026
+  // Return sum over filter bins of SED x LAMSED x TRANS x XTFRAC,
+  // without normalization. If MAGSMEAR is NULL, this is a dot product
+  // of SED with the folded WGT_SED; else each filter bin is scaled by
+  // 10^(-0.4*MAGSMEAR[ilamobs]) so the per-bin sum is needed.
+
+  int    ibin, ilamobs, ilamsed ;
+  double *C, FSUM = 0.0 ;
+
+  // ------------ BEGIN ------------
+
+  if ( MAGSMEAR == NULL ) {
+    for(ilamsed = BANDPROJ->ILAMSED_MIN; 
+	ilamsed <= BANDPROJ->ILAMSED_MAX; ilamsed++ ) 
+      { FSUM += BANDPROJ->WGT_SED[ilamsed] * SED[ilamsed] ; }
+    return(FSUM);
+  }
+
+  for(ibin=0; ibin < BANDPROJ->NBIN; ibin++ ) {
+    ilamobs = BANDPROJ->ILAMOBS[ibin] ;
+    ilamsed = BANDPROJ->ILAMSED[ibin] ;
+    C       = &BANDPROJ->COEFF[3*ibin] ;
+    FSUM   += BANDPROJ->XTFRAC[ibin] * pow(TEN,-0.4*MAGSMEAR[ilamobs]) *
+      ( C[0]*SED[ilamsed] + C[1]*SED[ilamsed+1] + C[2]*SED[ilamsed+2] ) ;
+  }
+
+  return(FSUM);
+
+} // end eval_BANDPROJ_SEDMODEL
+
+
 // ************************************
 double filterTrans_BessB(double lam) {
 
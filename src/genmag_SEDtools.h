@@ -170,6 +170,31 @@ double **SEDMODEL_TABLE_HOSTXT_FRAC ;
 struct{double AV, z, RV; } SEDMODEL_HOSTXT_LAST ;
 
 
+// Oct 2026: band projector = sparse weights over an SED lambda grid
+// for the integral of redshifted SED x filter-trans x lambda.
+// Built once per (filter, redshift, SED grid); Galactic & host
+// extinction are folded into WGT_SED once per event, so that the
+// band flux is a single sparse dot product with the SED.
+typedef struct {
+  int    IFILT ;            // sparse filter index; -9 => not built
+  double ZHEL ;             // redshift used to build
+  int    NLAM_SED ;         // SED lambda-grid used to build
+  double *LAM_SED ;
+
+  int    NBIN ;             // number of filter bins with TRANS>0
+  int    *ILAMOBS ;         // filter-bin index (for XT & smear tables)
+  int    *ILAMSED ;         // first of 3 SED bins for quadratic interp
+  double *COEFF ;           // 3 coeff per bin, including LAMSED*TRANS
+
+  double FOLD_KEY[3] ;      // MWEBV, RV_host, AV_host folded into WGT_SED
+  double *XTFRAC ;          // MW x host flux-fraction per filter bin
+  int    ILAMSED_MIN, ILAMSED_MAX ; // range of non-zero WGT_SED
+  double *WGT_SED ;         // weight per SED bin (XT folded)
+} BANDPROJ_SEDMODEL_DEF ;
+
+BANDPROJ_SEDMODEL_DEF BANDPROJ_SEDMODEL[MXFILT_SEDMODEL] ;
+
+
 // define TEMP structure that gets over-written for each SED.
 // This is mainly to avoid wasting memory storing each SED
 // because we only need to store the flux-integrals 
@@ -246,6 +271,7 @@ long int  NBTOT_SEDMODEL_FLUXTABLE;  // total number of fluxtable bins
 int       NBIN_SEDMODEL_FLUXTABLE[NDIM_SEDMODEL_FLUXTABLE+1];
 long int  N1DBINOFF_SEDMODEL_FLUXTABLE[NDIM_SEDMODEL_FLUXTABLE+1];
 char      VARNAME_SEDMODEL_FLUXTABLE[NDIM_SEDMODEL_FLUXTABLE+1][12] ;
+bool      MMAP_SEDMODEL_FLUXTABLE;   // T => table is mmap'ed from binary file
 
 
 // SPECTROGRAPH STUFF (July 2016)
@@ -356,6 +382,14 @@ void fill_TABLE_HOSTXT_SEDMODEL(double RV, double AV, double z) ;
 
 double filterTrans_BessB(double lam) ;
 
+void   init_BANDPROJ_SEDMODEL(void);
+BANDPROJ_SEDMODEL_DEF *get_BANDPROJ_SEDMODEL(int ifilt, double z, 
+					     int NLAM, double *LAM);
+void   fold_XT_BANDPROJ_SEDMODEL(BANDPROJ_SEDMODEL_DEF *BANDPROJ, 
+				 double RV_host, double AV_host);
+double eval_BANDPROJ_SEDMODEL(BANDPROJ_SEDMODEL_DEF *BANDPROJ, 
+			      double *SED, double *MAGSMEAR);
+
 
 void T0shiftPeak_SEDMODEL(SEDMODEL_FLUX_DEF *SEDFLUX, int vboseFlag);
 void T0shiftExplode_SEDMODEL(int OPTMASK, SEDMODEL_FLUX_DEF *SEDFLUX, 
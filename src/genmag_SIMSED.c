@@ -56,12 +56,20 @@
  Mar 02 2022: fix bug so that UVLAM_EXTRAP works when reading binary file
               or original text files.
 
+ Oct 2026: in binary-read mode, mmap SED.BINARY and the flux-table binary
+           (read-only) instead of fread into private memory. Concurrent
+           sim jobs on a node share the flux-table pages, and pages are
+           read from disk only when used. SIMSED_USE_BINARY += 8 restores
+           the legacy fread.
+
 *************************************/
 
 #include  <stdio.h> 
 #include  <math.h>     
 #include  <stdlib.h>   
 #include  <sys/stat.h>
+#include  <sys/mman.h>
+#include  <fcntl.h>
 
 #include  "sntools.h"           // SNANA community tools
 #include  "genmag_SEDtools.h"
@@ -120,6 +128,7 @@ int init_genmag_SIMSED(char *VERSION      // SIMSED version
   // OPTMASK +=  1 --> create binary file if it doesn't exist
   // OPTMASK +=  2 --> force creation of SED.BINARY
   // OPTMASK +=  4 --> force creaton of flux-table binary
+  // OPTMASK +=  8 --> fread binaries instead of mmap
   // OPTMASK += 64 --> test mode only, no binary, no time-stamp checks
   // OPTMASK += 128 -> batch mode, thus abort on stale binary
   //
@@ -127,6 +136,7 @@ int init_genmag_SIMSED(char *VERSION      // SIMSED version
   // Dec 14 2021: new OPTMASK 2 and 4
   // Mar 02 2022: check UVLAM_EXTRAP
   // Feb 05 2024: abort if PATH_BINARY is not a directory.
+  // Oct 2026: mmap binaries unless OPTMASK has NOMMAP bit.
 
   int NZBIN, IZSIZE, ifilt, ifilt_obs, ised, istat, IS_DIR;
   int retval = SUCCESS ;
@@ -164,6 +174,12 @@ int init_genmag_SIMSED(char *VERSION      // SIMSED version
   if ( (OPTMASK & OPTMASK_INIT_SIMSED_BINARY2)> 0 )
     { FORCE_TABBINARY = true; USE_BINARY = true;  }
 
+  INTERP_SIMSED_CORNERS.NDIM = -9 ; // no cached corners yet
+
+  SIMSED_MMAP.USE      = ( OPTMASK & OPTMASK_INIT_SIMSED_NOMMAP ) == 0 ;
+  SIMSED_MMAP.BASE_SED = SIMSED_MMAP.BASE_TAB = NULL ;
+  SIMSED_MMAP.SIZE_SED = SIMSED_MMAP.SIZE_TAB = 0 ;
+
   if ( NFILT_SEDMODEL == 0  && !USE_TESTMODE ) {
     sprintf(c1err,"No filters defined ?!?!?!? " );
     sprintf(c2err,"Need to call init_filter_SEDMODEL");
@@ -301,10 +317,21 @@ int init_genmag_SIMSED(char *VERSION      // SIMSED version
   NZBIN  = REDSHIFT_SEDMODEL.NZBIN ;
   NLAMPOW_SEDMODEL = 0 ;
 
+  // table read from binary is mapped instead of malloc+fread
+  MMAP_SEDMODEL_FLUXTABLE = 
+    ( SIMSED_BINARY_INFO.RDFLAG_FLUX && SIMSED_MMAP.USE );
+
   malloc_FLUXTABLE_SEDMODEL ( NFILT_SEDMODEL, NZBIN, NLAMPOW_SEDMODEL, 
 			      SEDMODEL.MXDAY, SEDMODEL.NSURFACE );
   fflush(stdout);
 
+  // map SED.BINARY; read cursor starts after header read above
+  if ( SIMSED_BINARY_INFO.RDFLAG_SED && SIMSED_MMAP.USE ) {
+    SIMSED_MMAP.BASE_SED   = 
+      mmap_SIMSED_BINARY(bin1File, &SIMSED_MMAP.SIZE_SED, MADV_SEQUENTIAL);
+    SIMSED_MMAP.OFFSET_SED = (size_t)ftell(fpbin1) ;
+  }
+
   // ------- Now read the spectral templates -----------
 
   for ( ised = 1 ; ised <= SEDMODEL.NSURFACE ; ised++ ) {
@@ -317,7 +344,7 @@ int init_genmag_SIMSED(char *VERSION      // SIMSED version
 
     if ( SIMSED_BINARY_INFO.RDFLAG_SED ) {
       // read from binary file
-      fread(sedFile, sizeof(sedFile), 1, fpbin1 );
+      fread_SEDBINARY(sedFile, sizeof(sedFile), 1, fpbin1, bin1File);
       if ( strcmp(tmpFile,sedFile) != 0 ) {
 	printf("\n\n");
 	printf("BINARY   SED File: '%s' \n", sedFile );
@@ -330,8 +357,10 @@ int init_genmag_SIMSED(char *VERSION      // SIMSED version
       printf("  Read %s SED surface from binary file : \n", sedcomment);
       fflush(stdout);
 
-      fread( &NSEDBINARY, sizeof(int   ),   1,        fpbin1 );
-      fread( SEDBINARY,   sizeof(float ), NSEDBINARY, fpbin1 );
+      fread_SEDBINARY(&NSEDBINARY, sizeof(int  ), 1,          
+		      fpbin1, bin1File);
+      fread_SEDBINARY(SEDBINARY,   sizeof(float), NSEDBINARY, 
+		      fpbin1, bin1File);
       pack_SEDBINARY(-1);  // transfer SEDBINARY to TEMP_SEDMODEL struct
 
     } else {      
@@ -405,6 +434,11 @@ int init_genmag_SIMSED(char *VERSION      // SIMSED version
   if ( SIMSED_BINARY_INFO.WRFLAG_SED || SIMSED_BINARY_INFO.RDFLAG_SED ) 
     {  fclose(fpbin1);  }
 
+  if ( SIMSED_MMAP.BASE_SED != NULL ) {
+    munmap(SIMSED_MMAP.BASE_SED, SIMSED_MMAP.SIZE_SED);
+    SIMSED_MMAP.BASE_SED = NULL ;
+  }
+
 
   // write binary integral-flux table to current directory;
   // saves lots of init-time when reading this back
@@ -660,7 +694,7 @@ void read_SIMSED_TABBINARY(FILE *fp, char *binFile) {
   if ( LZOK  &&  LZSAME == 0 ) {
     printf("  Re-allocate memory with larger redshift range from table. \n");
     fflush(stdout);
-    free(PTR_SEDMODEL_FLUXTABLE) ;
+    if ( !MMAP_SEDMODEL_FLUXTABLE ) { free(PTR_SEDMODEL_FLUXTABLE) ; }
     malloc_FLUXTABLE_SEDMODEL ( NFILT_SEDMODEL, REDSHIFT_SEDMODEL.NZBIN,
 				NLAMPOW_SEDMODEL, SEDMODEL.MXDAY, 
 				SEDMODEL.NSURFACE );
@@ -698,6 +732,37 @@ void read_SIMSED_TABBINARY(FILE *fp, char *binFile) {
   }
 
   // ------------
+  // Oct 2026: map table directly from binary file; table starts at
+  //   current file position. Fall back to fread if map fails.
+  if ( MMAP_SEDMODEL_FLUXTABLE ) {
+    size_t OFFSET = (size_t)ftell(fp);
+    char  *BASE   = mmap_SIMSED_BINARY(binFile, &SIMSED_MMAP.SIZE_TAB,
+				       MADV_RANDOM);
+    bool   ALIGN  = ( OFFSET % sizeof(float) == 0 );
+    bool   SIZEOK = ( OFFSET + ISIZE_SEDMODEL_FLUXTABLE <= 
+		      SIMSED_MMAP.SIZE_TAB );
+
+    if ( BASE != NULL && !SIZEOK ) {
+      sprintf(c1err,"Binary file size = %zu bytes, but need %zu bytes.",
+	      SIMSED_MMAP.SIZE_TAB, OFFSET + ISIZE_SEDMODEL_FLUXTABLE);
+      sprintf(c2err,"Try deleting %s", binFile );
+      errmsg(SEV_FATAL, 0, fnam, c1err, c2err ); 
+    }
+
+    if ( BASE != NULL && ALIGN ) {
+      SIMSED_MMAP.BASE_TAB   = BASE ;
+      PTR_SEDMODEL_FLUXTABLE = (float*)(BASE + OFFSET) ;
+      printf("\t mmap entire flux table (read-only, shared pages).\n");
+      fflush(stdout);
+      return ;
+    }
+
+    // mmap failed or table not aligned -> legacy malloc + fread
+    if ( BASE != NULL ) { munmap(BASE, SIMSED_MMAP.SIZE_TAB); }
+    MMAP_SEDMODEL_FLUXTABLE = false ;
+    PTR_SEDMODEL_FLUXTABLE  = (float*)malloc(ISIZE_SEDMODEL_FLUXTABLE);
+  }
+
   // read entire flux table
   printf("\t Read entire flux table ... "); fflush(stdout);
   fread(PTR_SEDMODEL_FLUXTABLE, ISIZE_SEDMODEL_FLUXTABLE, 1, fp);
@@ -710,6 +775,95 @@ void read_SIMSED_TABBINARY(FILE *fp, char *binFile) {
 
 
 
+// ****************************************************************
+char *mmap_SIMSED_BINARY(char *binFile, size_t *SIZE, int ADVICE) {
+
+  // Created Oct 2026
+  // Map binFile read-only and return pointer to start of file;
+  // return NULL (after warning) if map fails so that caller can
+  // fall back to fread.
+  // MAP_PRIVATE + PROT_READ pages are shared with every other
+  // process mapping the same file, and are read from disk on first
+  // access. ADVICE is passed to madvise: MADV_RANDOM for the flux
+  // table (no read-ahead of unused SEDs/redshifts), MADV_SEQUENTIAL
+  // for SED.BINARY.
+  //
+  // Output *SIZE = file size in bytes.
+
+  int    fd ;
+  char   *BASE ;
+  struct stat statbuf ;
+  char fnam[] = "mmap_SIMSED_BINARY" ;
+
+  // ------------ BEGIN -------------
+
+  *SIZE = 0 ;
+  fd = open(binFile, O_RDONLY);
+  if ( fd < 0 ) { 
+    sprintf(c1err,"Cannot open %s for mmap", binFile);
+    errmsg(SEV_WARN, 0, fnam, c1err, "Will use fread."); 
+    return(NULL); 
+  }
+
+  if ( fstat(fd, &statbuf) != 0 || statbuf.st_size == 0 ) 
+    { close(fd); return(NULL); }
+
+  BASE = (char*) mmap(NULL, (size_t)statbuf.st_size, PROT_READ, 
+		      MAP_PRIVATE, fd, 0);
+  close(fd); // mapping remains valid after close
+
+  if ( BASE == MAP_FAILED ) {
+    sprintf(c1err,"mmap failed for %s", binFile);
+    errmsg(SEV_WARN, 0, fnam, c1err, "Will use fread."); 
+    return(NULL);
+  }
+
+  madvise(BASE, (size_t)statbuf.st_size, ADVICE);
+  *SIZE = (size_t)statbuf.st_size ;
+  return(BASE);
+
+} // end mmap_SIMSED_BINARY
+
+// ****************************************************************
+void fread_SEDBINARY(void *ptr, size_t size, size_t n, FILE *fp,
+		     char *binFile) {
+
+  // Created Oct 2026
+  // Read n items from SED.BINARY; copy from mmap'ed file if
+  // available, else fread from fp. After each copy, consumed pages
+  // are dropped from this process so that only one SED is resident.
+
+  size_t NBYTE = size * n ;
+  size_t PAGESIZE, PAGE0, PAGE1 ;
+  char fnam[] = "fread_SEDBINARY" ;
+
+  // ------------ BEGIN -------------
+
+  if ( SIMSED_MMAP.BASE_SED == NULL ) 
+    { fread(ptr, size, n, fp);  return; }
+
+  if ( SIMSED_MMAP.OFFSET_SED + NBYTE > SIMSED_MMAP.SIZE_SED ) {
+    sprintf(c1err,"Cannot read %zu bytes at offset %zu (size=%zu)",
+	    NBYTE, SIMSED_MMAP.OFFSET_SED, SIMSED_MMAP.SIZE_SED);
+    sprintf(c2err,"Try deleting %s", binFile);
+    errmsg(SEV_FATAL, 0, fnam, c1err, c2err ); 
+  }
+
+  memcpy(ptr, SIMSED_MMAP.BASE_SED + SIMSED_MMAP.OFFSET_SED, NBYTE);
+
+  // release whole pages before the new cursor
+  PAGESIZE = (size_t)sysconf(_SC_PAGESIZE);
+  PAGE0    = (SIMSED_MMAP.OFFSET_SED / PAGESIZE) * PAGESIZE ;
+  SIMSED_MMAP.OFFSET_SED += NBYTE ;
+  PAGE1    = (SIMSED_MMAP.OFFSET_SED / PAGESIZE) * PAGESIZE ;
+  if ( PAGE1 > PAGE0 ) 
+    { madvise(SIMSED_MMAP.BASE_SED + PAGE0, PAGE1-PAGE0, MADV_DONTNEED); }
+
+  return ;
+
+} // end fread_SEDBINARY
+
+
 // ****************************************************************
 int read_SIMSED_INFO(char *PATHMODEL) {
 
@@ -1698,6 +1852,12 @@ double interp_flux_SIMSED(
     + check option to use WGT column to select ISED. 
       Beware for WGT option because input *lumipar is the ISED index,
       not the WGT value, so don't update *lumipar = WGT.  
+
+   Oct 2026:
+    + move corner search to set_corners_SIMSED, and cache corners
+      and weights in INTERP_SIMSED_CORNERS. The O(NSURFACE) corner
+      search is now done once per event instead of once per epoch
+      and filter.
    
   -------------------------------------------------- */
 
@@ -1709,12 +1869,11 @@ double interp_flux_SIMSED(
   int pars[INTERP_SIMSED_MAX_DIM];
   int pars_baggage[INTERP_SIMSED_MAX_BAGGAGE_PARS];
   int i, j, k, ISED, num_dims, num_pars_baggage;
-  int found_corner, index, ipar_model, NPAR, ipar, ipar_user ;
+  int ipar_model, NPAR, ipar, ipar_user ;
   int flag, NGRIDONLY, NMATCH=0;
   int ISED_MIN=1, ISED_MAX = SEDMODEL.NSURFACE ;
 
-  double Sinterp, left_min_diff, right_min_diff;
-  double diff, diff0, diff1, parval, range, term;
+  double Sinterp, diff, parval, range, term;
 
   char fnam[] = "interp_flux_SIMSED";
 
@@ -1841,14 +2000,93 @@ double interp_flux_SIMSED(
   }
 
 
+  // Oct 2026: corner SEDs and weights depend only on the interp params,
+  // so find them once per event and reuse for every epoch and filter.
+  if ( !match_corners_SIMSED(iflag, lumipar, num_dims, pars) ) {
+    set_corners_SIMSED(iflag, iparmap, lumipar, num_dims, pars, 
+		       num_pars_baggage);
+  }
+
+  /*
+   * Interpolation; each corner flux-integral is weighted by
+   * the distance to the opposite corner.
+   */
+  Sinterp = 0.0 ;
+  for (i = 0; i < INTERP_SIMSED_CORNERS.NCORNER; i++) {
+    ISED     = INTERP_SIMSED_CORNERS.ISED[i] ;
+    term     = get_flux_SEDMODEL(ISED, 0, ifilt_obs, z, Trest);
+    Sinterp += INTERP_SIMSED_CORNERS.WGT[i] * term ;
+  }
+  ISED_SEDMODEL = INTERP_SIMSED_CORNERS.ISED[0];
+
+  // fill baggage parameters in lumipar array
+
+  for(k = 0; k < num_pars_baggage; k++) {
+    ipar_user = num_dims + k ;
+    lumipar[ipar_user] = INTERP_SIMSED_CORNERS.PARVAL_BAGGAGE[k]; // RK
+  }
+
+
+  return(Sinterp) ;
+  
+} // end of interp_flux_SIMSED
+
+
+// ****************************************************
+bool match_corners_SIMSED(int *iflag, double *lumipar, 
+			  int num_dims, int *pars) {
+
+  // Created Oct 2026
+  // Return true if cached corners in INTERP_SIMSED_CORNERS were
+  // computed for the same interp params and same param flags.
+
+  int ipar, i ;
+
+  // ----------- BEGIN ------------
+
+  if ( INTERP_SIMSED_CORNERS.NDIM != num_dims ) { return false; }
+
+  for ( ipar=0; ipar < SEDMODEL.NPAR ; ipar++ ) {
+    if ( INTERP_SIMSED_CORNERS.IFLAG[ipar] != iflag[ipar] ) 
+      { return false; }
+  }
+
+  for ( i=0; i < num_dims; i++ ) {
+    if ( INTERP_SIMSED_CORNERS.LUMIPAR[i] != lumipar[pars[i]] ) 
+      { return false; }
+  }
+
+  return true ;
+
+} // end match_corners_SIMSED
+
+
+// ****************************************************
+void set_corners_SIMSED(int *iflag, int *iparmap, double *lumipar, 
+			int num_dims, int *pars, int num_pars_baggage) {
+
+  // Created Oct 2026
+  // [code moved from interp_flux_SIMSED, written by B.Diemer]
+  // Find the 2^num_dims SEDs at the corners of the hypercube
+  // surrounding the interp params, and store corner SED index
+  // and normalized distance-weight in INTERP_SIMSED_CORNERS.
+  // Interpolated baggage params are also stored since they
+  // depend only on the corner weights.
+
+  int verbose = 0 ;
+  int i, j, k, found_corner, index, ipar_model, ISED ;
+  double left_min_diff, right_min_diff, diff, diff0, diff1 ;
+  double vol, wgt ;
+  char fnam[] = "set_corners_SIMSED" ;
+
+  // ----------- BEGIN ------------
+
   /*
    * Define arrays which depend upon the number of dimensions
    */
   int sheet_size[num_dims][2];
   double hypercube[num_dims][2];
   int bits[num_dims];
-  double pars_baggage_interp[num_pars_baggage];
-  double pars_baggage_term[num_pars_baggage];
 
   /*
    Find indexes bracketing values; for each dimension, 
@@ -2036,84 +2274,47 @@ double interp_flux_SIMSED(
     }
 
   /*
-   * Interpolation; each corner represents a distance-weighted term.
+   * Each corner weight is the product over dimensions of the distance
+   * to the opposite sheet, divided by the volume of the hypercube.
    */
-  Sinterp = 0;
-  
-  for(k = 0; k < num_pars_baggage; k++)
-    {
-      pars_baggage_interp[k] = 0;
-    }
+  vol = 1.0 ;
+  for (i = 0; i < num_dims; i++)
+    { vol *= (hypercube[i][1] - hypercube[i][0]); }
 
-  for (i = 0; i < num_corners; i++)
-    {
-      /*
-       * Set 0/1 bit for each dimension, corresponding to the lower and upper
-       * index on the cube in coordinate space.
-       */
-      for (j = 0; j < num_dims; j++)
-	{
-	  bits[j] = ((i & dual_bits_SIMSED[j]) != 0);
-	}
-      
-      /*
-       * Set term to data point in question; 
-       * multiply term by distance weightings for each
-       * dimension.
-       */
-      term = get_flux_SEDMODEL(corners[i] + 1, 0, ifilt_obs, z, Trest);
-      ISED_SEDMODEL = corners[0]+1;
-      
-      for(k = 0; k < num_pars_baggage; k++)
-	{
-	  ipar_model = iparmap[num_dims+k]; // RK
-	  pars_baggage_term[k] = 
-	    SEDMODEL.PARVAL[corners[i] + 1][ipar_model]; // RK
-	}
-      
-      for (j = 0; j < num_dims; j++)
-	{
-	  term = term * fabs(lumipar[pars[j]] - hypercube[j][1 - bits[j]]);
-	  
-	  for(k = 0; k < num_pars_baggage; k++)
-	    {
-	      pars_baggage_term[k] = pars_baggage_term[k] * fabs(lumipar[pars[j]] - hypercube[j][1 - bits[j]]);
-	    }
-	}
-      
-      Sinterp = Sinterp + term;
+  for(k = 0; k < num_pars_baggage; k++)
+    { INTERP_SIMSED_CORNERS.PARVAL_BAGGAGE[k] = 0.0 ; }
 
-      for(k = 0; k < num_pars_baggage; k++)
-	{
-	  pars_baggage_interp[k] = pars_baggage_interp[k] + pars_baggage_term[k];
-	}
-    }
-  
-  /*
-   * Divide by the volume of the hypercube in coordinate space.
-   */
-  for (i = 0; i < num_dims; i++)
-    {
-      Sinterp = Sinterp / (hypercube[i][1] - hypercube[i][0]);
+  for (i = 0; i < num_corners; i++) {
 
-      for(k = 0; k < num_pars_baggage; k++)
-	{
-	  pars_baggage_interp[k] = pars_baggage_interp[k] / (hypercube[i][1] - hypercube[i][0]);
-	}
+    wgt = 1.0 ;
+    for (j = 0; j < num_dims; j++) {
+      bits[j] = ((i & dual_bits_SIMSED[j]) != 0);
+      wgt    *= fabs(lumipar[pars[j]] - hypercube[j][1 - bits[j]]);
     }
+    wgt /= vol ;
 
+    ISED = corners[i] + 1 ;
+    INTERP_SIMSED_CORNERS.ISED[i] = ISED ;
+    INTERP_SIMSED_CORNERS.WGT[i]  = wgt ;
 
-  // fill baggage parameters in lumipar array
-
-  for(k = 0; k < num_pars_baggage; k++) {
-    ipar_user = num_dims + k ;
-    lumipar[ipar_user] = pars_baggage_interp[k]; // RK
+    for(k = 0; k < num_pars_baggage; k++) {
+      ipar_model = iparmap[num_dims+k]; // RK
+      INTERP_SIMSED_CORNERS.PARVAL_BAGGAGE[k] += 
+	wgt * SEDMODEL.PARVAL[ISED][ipar_model] ;
+    }
   }
 
+  // store key for match_corners_SIMSED
+  INTERP_SIMSED_CORNERS.NDIM    = num_dims ;
+  INTERP_SIMSED_CORNERS.NCORNER = num_corners ;
+  for (i = 0; i < SEDMODEL.NPAR; i++) 
+    { INTERP_SIMSED_CORNERS.IFLAG[i] = iflag[i]; }
+  for (i = 0; i < num_dims; i++) 
+    { INTERP_SIMSED_CORNERS.LUMIPAR[i] = lumipar[pars[i]]; }
 
-  return(Sinterp) ;
-  
-} // end of interp_flux_SIMSED
+  return ;
+
+} // end set_corners_SIMSED
 
 
 // ****************************************************
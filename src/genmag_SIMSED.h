@@ -12,6 +12,7 @@
 #define OPTMASK_INIT_SIMSED_BINARY    1  // make binary file(s) if not there
 #define OPTMASK_INIT_SIMSED_BINARY1   2  // force creation of SED.BINARY
 #define OPTMASK_INIT_SIMSED_BINARY2   4  // force create flux-table binary
+#define OPTMASK_INIT_SIMSED_NOMMAP    8  // fread binaries instead of mmap
 #define OPTMASK_INIT_SIMSED_TESTMODE  64 // used by SIMSED_check program
 #define OPTMASK_INIT_SIMSED_BATCH    128 // batch mode -> abort on stale binary
 
@@ -27,6 +28,7 @@ char SIMSED_INFO_FILENAME_FULL[MXPATHLEN] ;
 #define INTERP_SIMSED_INVALID_CORNER -1
 #define INTERP_SIMSED_START_DIFF  1.0E8
 #define INTERP_SIMSED_DELTA       1.0E-8
+#define INTERP_SIMSED_MAX_CORNER  256  // 2^INTERP_SIMSED_MAX_DIM
 
 #define BINARYFLAG_KCORFILENAME 1  // 1 => read/write/check kcor filename
 
@@ -71,6 +73,28 @@ struct {
  
 } SIMSED_BINARY_INFO ;
 
+// Oct 2026: read-only memory maps of the SED and flux-table binaries.
+// Mapped pages live in the page cache and are shared among all sim
+// jobs on a node; flux-table pages are faulted in only when accessed.
+struct {
+  bool   USE ;                  // T => mmap binaries in read mode
+  char   *BASE_SED, *BASE_TAB ; // start of mapped SED & flux-table files
+  size_t SIZE_SED,  SIZE_TAB ;  // size (bytes) of mapped files
+  size_t OFFSET_SED ;           // read cursor in mapped SED.BINARY
+} SIMSED_MMAP ;
+
+// Oct 2026: corner SEDs and weights for multi-param interpolation.
+// Weights depend only on the interp params, so they are computed once
+// per event and reused for every epoch and filter.
+struct {
+  int    NDIM, NCORNER ;
+  int    IFLAG[MXPAR_SEDMODEL] ;             // param flags used for key
+  double LUMIPAR[INTERP_SIMSED_MAX_DIM] ;    // interp params used for key
+  int    ISED[INTERP_SIMSED_MAX_CORNER] ;    // SED index at each corner
+  double WGT[INTERP_SIMSED_MAX_CORNER] ;     // weight per corner; sum=1
+  double PARVAL_BAGGAGE[INTERP_SIMSED_MAX_BAGGAGE_PARS]; // interp baggage
+} INTERP_SIMSED_CORNERS ;
+
 /**********************************************
    Function Declarations
 **********************************************/
@@ -98,6 +122,10 @@ void open_TABBINARY(char *fileName, bool force_create,
 
 void read_SIMSED_TABBINARY(FILE *fp, char *binFile);
 
+char *mmap_SIMSED_BINARY(char *binFile, size_t *SIZE, int ADVICE);
+void fread_SEDBINARY(void *ptr, size_t size, size_t n, FILE *fp, 
+		     char *binFile);
+
 void genmag_SIMSED(int OPTMASK, int ifilt, double x0, 
 		   int NLUMIPAR, int *iflagpar, int *iparmap, double *lumipar,
 		   double RV_host, double AV_host, double mwebv, double z, 
@@ -107,6 +135,11 @@ void genmag_SIMSED(int OPTMASK, int ifilt, double x0,
 double interp_flux_SIMSED(int *iflagpar, int *iparmap, double *lumipar, 
 			  int ifilt_obs, double z, double Trest );
 
+bool match_corners_SIMSED(int *iflag, double *lumipar, 
+			  int num_dims, int *pars);
+void set_corners_SIMSED(int *iflag, int *iparmap, double *lumipar, 
+			int num_dims, int *pars, int num_pars_baggage);
+
 double nextgrid_flux_SIMSED(int *iflagpar, int *iparmap, double *lumipar, 
 			    int ifilt_obs, double z, double Trest );
 
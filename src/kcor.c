@@ -109,6 +109,10 @@
 
  Mar 28 2025; allow command-line override for SPECTROGRAPH
 
+ Oct 2026: new NTHREAD key (and command-line override) splits the
+           KCOR grid over pthreads by (AV,z) block. Each cell is computed
+           exactly as in serial mode, so output is byte-identical.
+
 ****************************************************/
 
 #include "fitsio.h"
@@ -121,6 +125,11 @@
 //#include "genmag_SEDtools.h"
 #include "sntools_spectrograph.h"
 
+#define USE_THREAD   // Oct 2026: pthread option for KCOR grid
+#ifdef USE_THREAD
+#include <pthread.h>
+#endif
+
 
 // =================================================
 // =================== MAIN ========================
@@ -261,6 +270,8 @@ void  print_kcor_help(void) {
     "AV_RANGE:   -6.0  6.0 " , 
     "AV_BINSIZE:  0.5    # increase for faster kcor generation ",
     "AV_OPTION:   2      # 2->proper integration over filter",
+    "",
+    "NTHREAD:     4      # split KCOR grid over 4 threads (same output)",
     0
   };
 
@@ -403,6 +414,7 @@ int rd_input(void) {
   INPUTS.TREF_EXPLODE = -19.0 ;
 
   INPUTS.NLAMBIN_FT = 0;
+  INPUTS.NTHREAD    = 1;
 
   for ( ifilt=0; ifilt < MXFILTDEF; ifilt++ ) {
     FILTER[ifilt].MASKFRAME   = 0;
@@ -714,6 +726,9 @@ int rd_input(void) {
     if ( strcmp(c_get,"AV_OPTION:")==0 )  
       { readint ( fp_input, 1, &INPUTS.AV_OPTION );  }  
 
+    if ( strcmp(c_get,"NTHREAD:")==0 )  
+      { readint ( fp_input, 1, &INPUTS.NTHREAD );  }  
+
 
     if ( strcmp(c_get,"LAMBDA_RANGE:")==0 )  {
       readfloat ( fp_input, 2, xlim4 );
@@ -1285,6 +1300,7 @@ void kcor_input_override(int OPT) {
   // Feb 2019: read FILTER_OOB
   // Jan 15 2021: check ZPOFF_FILE
   // Mar 28 2025: check SPECTROGRAPH
+  // Oct 2026: check NTHREAD
 
   int i, ilast, iuse ;
   char tmpName[60], tmpFile[MXPATHLEN] ;
@@ -1379,6 +1395,10 @@ void kcor_input_override(int OPT) {
       i++ ; sscanf(ARGV_LIST[i] , "%d", &INPUTS.NLAMBIN_FT ); 
     }
 
+    if ( strcmp( ARGV_LIST[i], "NTHREAD" ) == 0 ) {
+      i++ ; sscanf(ARGV_LIST[i] , "%d", &INPUTS.NTHREAD ); 
+    }
+
     if ( strcmp( ARGV_LIST[i], "SN_TYPE" ) == 0 ) {
       i++ ; sscanf(ARGV_LIST[i] , "%s", INPUTS.SN_TYPE ); 
     }
@@ -3310,26 +3330,43 @@ int kcor_grid (void) {
   // Nov 12, 2010: loop over NKCOR+KCOR_EXTRA to get synthetic
   //               'magobs' for the rest-frame filters that are
   //               needed by snana.
+  //
+  // Oct 2026: move (AV,z,epoch) loops into kcor_grid_block and
+  //    optionally distribute contiguous (AV,z) blocks over NTHREAD
+  //    pthreads. Cells are independent and each is evaluated exactly
+  //    as in serial mode, so the stored tables (and FITS output) do
+  //    not depend on NTHREAD.
   // -------------------------------------------------
 
    char ctmp[20]
      ,  fnam[] = "kcor_grid"
      ;
 
-   int  ikcor, OPT, ifilt_rest, ifilt_obs ;
-   int  i_epoch, i_z, i_av, i_ebv, FLAG_MAGOBS, NZBIN ;
-   
-   double 
-     z, epoch, av, dum, kcor, kcormin, kcormax
-     ,err, ovp, magobs[MXMWEBV+2], magtmp, dxt, debv
-     ; 
+   int  ikcor, ifilt_rest, ifilt_obs, i_av, NZBIN ;
+   int  nthread = INPUTS.NTHREAD ;
+   int  t, NCELL, NCELL_per_thread ;
+   double av, dum, kcormin, kcormax ; 
 
-   /* -------------------- BEGIN ------------------ */
+#ifdef USE_THREAD
+   int  rc, NERR ;
+   pthread_t thread[MXTHREAD_KCOR];
+#endif
+   KCOR_GRID_THREAD_DEF thread_grid[MXTHREAD_KCOR];
 
-   OPT = 0;
+   /* -------------------- BEGIN ------------------ */
 
-   printf("\n  ***** START LOOPING for KCOR GRID ***** \n" );
+   if ( nthread < 1 ) { nthread = 1; }
+   if ( nthread > MXTHREAD_KCOR ) {
+     sprintf(c1err,"NTHREAD=%d exceeds bound", nthread);
+     sprintf(c2err,"MXTHREAD_KCOR=%d", MXTHREAD_KCOR);
+     errmsg(SEV_FATAL, 0, fnam, c1err, c2err);  
+   }
+#ifndef USE_THREAD
+   nthread = 1;
+#endif
 
+   printf("\n  ***** START LOOPING for KCOR GRID (NTHREAD=%d) ***** \n",
+	  nthread );
 
    for ( ikcor=1; ikcor <= NKCOR + NKCOR_EXTRA ; ikcor++ ) {
        
@@ -3351,107 +3388,200 @@ int kcor_grid (void) {
 
       printf("  Compute %s %s for '%s' (rest) => '%s' (obs) \n",
 	     ctmp, KCORSYM[ikcor], KCORLIST[ikcor][0], KCORLIST[ikcor][1] );
+
+      printf("\t AV = ");
+      for ( i_av=1;  i_av<=INPUTS.NBIN_AV;   i_av++ ) {
+	dum    = (double)(i_av-1) ;
+	av     = INPUTS.AV_MIN + dum * INPUTS.AV_BINSIZE;
+	printf("%4.2f ", av);
+      }
+      fflush(stdout);
+
+      // split (AV,z) cells into contiguous blocks; one block per thread
+      NCELL            = INPUTS.NBIN_AV * NZBIN ;
+      NCELL_per_thread = (NCELL + nthread - 1) / nthread ;
+
+      for ( t = 0; t < nthread; t++ ) {
+	thread_grid[t].id_thread  = t ;
+	thread_grid[t].ikcor      = ikcor ;
+	thread_grid[t].ifilt_rest = ifilt_rest ;
+	thread_grid[t].ifilt_obs  = ifilt_obs ;
+	thread_grid[t].NZBIN      = NZBIN ;
+	thread_grid[t].icell_min  = t * NCELL_per_thread ;
+	thread_grid[t].icell_max  = (t+1) * NCELL_per_thread ;
+	if ( thread_grid[t].icell_max > NCELL ) 
+	  { thread_grid[t].icell_max = NCELL; }
+
+	if ( nthread == 1 ) 
+	  { kcor_grid_block(&thread_grid[t]); }
+#ifdef USE_THREAD
+	else {
+	  rc = pthread_create(&thread[t], NULL, kcor_grid_block,
+			      &thread_grid[t] );
+	  if ( rc != 0 ) {
+	    sprintf(c1err,"pthread_create returned %d for t=%d", rc, t);
+	    sprintf(c2err,"ikcor=%d (%s)", ikcor, KCORSYM[ikcor] );
+	    errmsg(SEV_FATAL, 0, fnam, c1err, c2err);  
+	  }
+	}
+#endif
+      } // end t loop over threads
+
+#ifdef USE_THREAD
+      if ( nthread > 1 ) {
+	NERR = 0 ;
+	for ( t = 0; t < nthread; t++ ) {
+	  rc = pthread_join(thread[t], NULL);
+	  if ( rc != 0 ) {
+	    NERR++ ;
+	    printf(" ERROR: thread return errcode=%d for t=%d\n", rc,t); 
+	  }
+	}
+	if ( NERR > 0 ) {
+	  sprintf(c1err,"%d thread return code errors", NERR);
+	  sprintf(c2err,"ikcor=%d (%s)", ikcor, KCORSYM[ikcor] );
+	  errmsg(SEV_FATAL, 0, fnam, c1err, c2err);  
+	}
+      }
+#endif
+
+      // min/max is order-independent, so merge is deterministic
       kcormin = 999999. ;
       kcormax = -99999. ;
+      for ( t = 0; t < nthread; t++ ) {
+	if ( thread_grid[t].kcormax > kcormax ) 
+	  { kcormax = thread_grid[t].kcormax; }
+	if ( thread_grid[t].kcormin < kcormin ) 
+	  { kcormin = thread_grid[t].kcormin; }
+      }
 
-      printf("\t AV = ");
+      printf(" \n\t %s min/max = %6.3f/%6.3f \n", 
+	     KCORSYM[ikcor], kcormin, kcormax);
 
+   }     // end of ikcor loop 
+     
 
-      // now loop over redshift and epoch 
+   return SUCCESS;
 
-      for ( i_av=1;  i_av<=INPUTS.NBIN_AV;   i_av++ ) {
 
-	  dum    = (double)(i_av-1) ;
-	  av     = INPUTS.AV_MIN + dum * INPUTS.AV_BINSIZE;
+} // end of kcor_grid
 
-          printf("%4.2f ", av);
-	  fflush(stdout);
 
-	for ( i_z=1;   i_z <= NZBIN ; i_z++ ) {
+// *************************************************
+void *kcor_grid_block(void *thread) {
+
+  // Created Oct 2026
+  // Fill KCOR grid and observer mags for cells 
+  // icell_min <= icell < icell_max of one ikcor, where
+  // icell = (i_av-1)*NZBIN + (i_z-1). Called directly for NTHREAD=1,
+  // or via pthread_create. Cells of different blocks write to
+  // disjoint elements of R4KCOR_GRID, SNSED.R4MAG_OBS and
+  // SNSED.MW_dXT_dEBV; global inputs are read-only here.
+  // Error strings are local since c1err,c2err are shared globals.
+
+  KCOR_GRID_THREAD_DEF *thread_grid = (KCOR_GRID_THREAD_DEF *)thread;
+  int ikcor      = thread_grid->ikcor ;
+  int ifilt_rest = thread_grid->ifilt_rest ;
+  int ifilt_obs  = thread_grid->ifilt_obs ;
+  int NZBIN      = thread_grid->NZBIN ;
+
+  int  OPT = 0 ;
+  int  icell, i_epoch, i_z, i_av, i_ebv, FLAG_MAGOBS ;
+  double z, epoch, av, dum, kcor, kcormin, kcormax ;
+  double err, ovp, magobs[MXMWEBV+2], magtmp, dxt, debv ;
+  char msg1[200], msg2[200];
+  char fnam[] = "kcor_grid_block" ;
 
-	  dum   = (double)(i_z-1) ;
-	  z     = INPUTS.REDSHIFT_MIN + dum * INPUTS.REDSHIFT_BINSIZE;
+  // ----------- BEGIN ------------
 
-	  for ( i_epoch=1; i_epoch<= SNSED.NEPOCH; i_epoch++ ) {
+  kcormin = 999999. ;
+  kcormax = -99999. ;
 
-	    epoch = SNSED.EPOCH[i_epoch];  
+  for ( icell = thread_grid->icell_min; icell < thread_grid->icell_max;
+	icell++ ) {
 
-	    R4KCOR_GRID.REDSHIFT[ikcor][i_av][i_z][i_epoch]  = (float)z ;
-	    R4KCOR_GRID.EPOCH[ikcor][i_av][i_z][i_epoch]     = (float)epoch ;
+    i_av  = icell / NZBIN + 1 ;
+    i_z   = icell % NZBIN + 1 ;
 
-	    // check if these obs mags have already been computed
-	    if ( SNSED.R4MAG_OBS[0][ifilt_obs][i_av][i_z][i_epoch] == NULLVAL )
-	      { FLAG_MAGOBS = 1 ; }
-	    else
-	      { FLAG_MAGOBS = 0; }
+    dum   = (double)(i_av-1) ;
+    av    = INPUTS.AV_MIN + dum * INPUTS.AV_BINSIZE;
 
-            kcor_eval( OPT
-		       ,av, z, epoch
-		       ,ifilt_rest, ifilt_obs 
-		       ,FLAG_MAGOBS
-		       ,&kcor, &err, &ovp, magobs        // return values
-		       );
+    dum   = (double)(i_z-1) ;
+    z     = INPUTS.REDSHIFT_MIN + dum * INPUTS.REDSHIFT_BINSIZE;
 
-	    if ( kcor > kcormax ) { kcormax = kcor ; }
-	    if ( kcor < kcormin ) { kcormin = kcor ; }
-
-	    // if kcor is outside valid range, then set it to really
-	    // crazy NULLVAL so that sim & fitter know to ignore it
-	    if ( kcor > KCORMAX_VALID ) { kcor = NULLVAL ; }
-	    if ( kcor < KCORMIN_VALID ) { kcor = NULLVAL ; }
-
-	    // 6/08/2009: check for nan 
-	    if ( isnan(kcor) ) {
-	      sprintf(c1err,"kcor=%f  for z=%6.3f T=%6.3f  av=%6.3f",
-		      kcor, z, epoch, av);
-	      sprintf(c2err,"ifilt_[rest,obs]=%d,%d (%s,%s) FLAG_MAGOBS=%d"
-		      ,ifilt_rest, ifilt_obs
-		      ,FILTER[ifilt_rest].name
-		      ,FILTER[ifilt_obs].name
-		      ,FLAG_MAGOBS);
-	      errmsg(SEV_FATAL, 0, fnam, c1err, c2err);  
-	    }
-
-	    R4KCOR_GRID.VALUE[ikcor][i_av][i_z][i_epoch] = (float)kcor ;
-
-	    // Feb 2007: store observer mags with array of MW E(B-V)
-	    if ( FLAG_MAGOBS > 0 ) {
-	      for ( i_ebv = 0; i_ebv <= MXMWEBV; i_ebv++ ) {
-		magtmp = magobs[i_ebv];
-		if ( isnan(magtmp) ) {
-		  sprintf(c1err,"magobs=%f for i_ebv=%d z=%6.3f T=%6.2f",
-			  magtmp, i_ebv, z, epoch );
-		  sprintf(c2err,"ifilt_[rest,obs]=%d,%d", 
-			  ifilt_rest, ifilt_obs);
-		  errmsg(SEV_FATAL, 0, fnam, c1err, c2err);  
-
-		}
-
-		SNSED.R4MAG_OBS[i_ebv][ifilt_obs][i_av][i_z][i_epoch] = 
-		  (float)magtmp;
-	      }
-	      // store d(mag)/d(xtmw) based on first two bins
-	      dxt   = *(magobs + 1) - *(magobs + 0) ;
-	      debv = MWEBV_LIST[1] -  MWEBV_LIST[0]  ;
-	      SNSED.MW_dXT_dEBV[ifilt_obs][i_av][i_z][i_epoch] = 
-		(dxt/debv);
-	    }
-	    
-
-	  } // end of i_epoch loop 
-	}  // end of i_z loop 
-      }   // end if i_av loop
+    for ( i_epoch=1; i_epoch<= SNSED.NEPOCH; i_epoch++ ) {
 
-      printf(" \n\t %s min/max = %6.3f/%6.3f \n", 
-	     KCORSYM[ikcor], kcormin, kcormax);
+      epoch = SNSED.EPOCH[i_epoch];  
 
-   }     // end of ikcor loop 
-     
+      R4KCOR_GRID.REDSHIFT[ikcor][i_av][i_z][i_epoch]  = (float)z ;
+      R4KCOR_GRID.EPOCH[ikcor][i_av][i_z][i_epoch]     = (float)epoch ;
 
-   return SUCCESS;
+      // check if these obs mags have already been computed
+      if ( SNSED.R4MAG_OBS[0][ifilt_obs][i_av][i_z][i_epoch] == NULLVAL )
+	{ FLAG_MAGOBS = 1 ; }
+      else
+	{ FLAG_MAGOBS = 0; }
+
+      kcor_eval( OPT
+		 ,av, z, epoch
+		 ,ifilt_rest, ifilt_obs 
+		 ,FLAG_MAGOBS
+		 ,&kcor, &err, &ovp, magobs        // return values
+		 );
+
+      if ( kcor > kcormax ) { kcormax = kcor ; }
+      if ( kcor < kcormin ) { kcormin = kcor ; }
+
+      // if kcor is outside valid range, then set it to really
+      // crazy NULLVAL so that sim & fitter know to ignore it
+      if ( kcor > KCORMAX_VALID ) { kcor = NULLVAL ; }
+      if ( kcor < KCORMIN_VALID ) { kcor = NULLVAL ; }
+
+      // 6/08/2009: check for nan 
+      if ( isnan(kcor) ) {
+	sprintf(msg1,"kcor=%f  for z=%6.3f T=%6.3f  av=%6.3f",
+		kcor, z, epoch, av);
+	sprintf(msg2,"ifilt_[rest,obs]=%d,%d (%s,%s) FLAG_MAGOBS=%d"
+		,ifilt_rest, ifilt_obs
+		,FILTER[ifilt_rest].name
+		,FILTER[ifilt_obs].name
+		,FLAG_MAGOBS);
+	errmsg(SEV_FATAL, 0, fnam, msg1, msg2);  
+      }
+
+      R4KCOR_GRID.VALUE[ikcor][i_av][i_z][i_epoch] = (float)kcor ;
+
+      // Feb 2007: store observer mags with array of MW E(B-V)
+      if ( FLAG_MAGOBS > 0 ) {
+	for ( i_ebv = 0; i_ebv <= MXMWEBV; i_ebv++ ) {
+	  magtmp = magobs[i_ebv];
+	  if ( isnan(magtmp) ) {
+	    sprintf(msg1,"magobs=%f for i_ebv=%d z=%6.3f T=%6.2f",
+		    magtmp, i_ebv, z, epoch );
+	    sprintf(msg2,"ifilt_[rest,obs]=%d,%d", 
+		    ifilt_rest, ifilt_obs);
+	    errmsg(SEV_FATAL, 0, fnam, msg1, msg2);  
+	  }
 
+	  SNSED.R4MAG_OBS[i_ebv][ifilt_obs][i_av][i_z][i_epoch] = 
+	    (float)magtmp;
+	}
+	// store d(mag)/d(xtmw) based on first two bins
+	dxt   = *(magobs + 1) - *(magobs + 0) ;
+	debv = MWEBV_LIST[1] -  MWEBV_LIST[0]  ;
+	SNSED.MW_dXT_dEBV[ifilt_obs][i_av][i_z][i_epoch] = 
+	  (dxt/debv);
+      }
 
-} // end of kcor_grid
+    } // end of i_epoch loop 
+  }  // end of icell loop 
+
+  thread_grid->kcormin = kcormin ;
+  thread_grid->kcormax = kcormax ;
+
+  return NULL ;
+
+} // end kcor_grid_block
 
 
 
@@ -19,6 +19,9 @@
   Nov 15 2020: IVERSION_KCOR -> 4 (was 3) for reading SURVEY key
 
   May 31 2024:  set all MXLAM_XXX values to common MXLAMBIN_SNANA (from sntools.h)
+
+  Oct 2026: add INPUTS.NTHREAD and KCOR_GRID_THREAD_DEF for pthread
+            split of KCOR grid.
     
 
 ********************************************************/
@@ -39,6 +42,7 @@ bool REQUIRE_SURVEY_KCOR = true ; // flip to require SURVEY in kcor-input
 #define MXMWEBV      4    // max number of MW E(B-V) bins
 #define MXPRIMARY    6    // max number of primary standards
 #define MXCHAR_FILENAME 200
+#define MXTHREAD_KCOR   64    // max number of threads for KCOR grid
 
 #define MXSED  MXLAM_SN*MXEP // max flattened array size for lam x epoch
 
@@ -142,6 +146,8 @@ struct INPUTS {
 
   int NLAMBIN_FT; // Number of Fourier Transform bins (must be power of 2)
 
+  int NTHREAD ;   // (I) number of pthreads for KCOR grid (default=1)
+
 } INPUTS ;
 
 
@@ -178,6 +184,13 @@ typedef struct {
   double TRANS_MAX_RATIO;
 } OOB_DEF; // out-of-band transmission
 
+// each KCOR_GRID thread fills a contiguous block of (AV,z) cells
+typedef struct {
+  int    id_thread, ikcor, ifilt_rest, ifilt_obs, NZBIN ;
+  int    icell_min, icell_max ;   // cell = (i_av-1)*NZBIN + (i_z-1)
+  double kcormin, kcormax ;       // (O) per-thread min/max
+} KCOR_GRID_THREAD_DEF ;
+
 
 int   IEPOCH_SNPEAK[MXFILTDEF] ;   // epoch index at SN peak (t=0)
 int   IEPOCH_SN15DAY[MXFILTDEF]  ;
@@ -398,6 +411,7 @@ void  set_store_lambda_range(void);
 int   malloc_ini(void);
 int   kcor_out(void) ;
 int   kcor_grid(void) ;
+void *kcor_grid_block(void *thread);
 void  primarymag_zp(int iprim);  // integrated fluxes, mags, and zero points/
 void  primarymag_zp2(int iprim);
 void  primarymag_summary(int iprim); 
@@ -11,6 +11,9 @@
              Jan 2014: separate trigger code into sntools_trigger.c[h]
              Jan 2017: add SPECTROGRAPH 
              Aug 2017: refactor SIMLIB_read 
+             Oct 2026: optional EARLY_REJECT_OPT stage with peak-only mags
+             Oct 2026: optional RANGEN_PHILOX counter-based random generator
+             Oct 2026: distances and dV/dz from z-grid table (COSMO_ZGRID)
 
  ---------------------------------------------------------
 
@@ -74,6 +77,7 @@
 int main(int argc, char **argv) {
 
   int ilc, istat, i  ;
+  char REJECT_STAGE[40];
   char fnam[] = "main"; 
 
   // ------------- BEGIN --------------
@@ -110,6 +114,7 @@ int main(int argc, char **argv) {
   rewrite_HOSTLIB_DRIVER();
 
   // init random number generator, and store first random.
+  set_RANGEN_PHILOX(INPUTS.RANGEN_PHILOX > 0);
   if ( GENLC.IFLAG_GENSOURCE != IFLAG_GENGRID  ) 
     { init_random_seed(INPUTS.ISEED, INPUTS.NSTREAM_RAN); }
 
@@ -259,8 +264,10 @@ int main(int argc, char **argv) {
 
     if ( INPUTS.TRACE_MAIN  ) { dmp_trace_main("02", ilc) ; }
 
-    if ( GENLC.IFLAG_GENSOURCE != IFLAG_GENGRID ) 
-      { fill_RANLISTs(); }      // init list of random numbers for each SN    
+    if ( GENLC.IFLAG_GENSOURCE != IFLAG_GENGRID ) {
+      set_EVENT_PHILOX(INPUTS.JOBID, NGENLC_TOT); // Oct 2026
+      fill_RANLISTs();      // init list of random numbers for each SN    
+    }
 
     gen_event_driver(ilc); 
 
@@ -309,6 +316,12 @@ int main(int argc, char **argv) {
     }
 
 
+    // optional cuts with peak-only mags before full LC (Oct 2026)
+    if ( gen_EARLY_REJECT(REJECT_STAGE) ) {
+      gen_event_reject(&ilc, &GENLC.SIMFILE_AUX, REJECT_STAGE);
+      goto GENEFF; 
+    }
+
     if ( INPUTS.TRACE_MAIN ) { dmp_trace_main("07", ilc) ; }
     GENMAG_DRIVER();   // July 2016
 
@@ -317,6 +330,12 @@ int main(int argc, char **argv) {
       goto GENEFF;
     }
 
+    // optional cuts with full mags before spectra & fluxes (Oct 2026)
+    if ( gen_EARLY_REJECT_FLUX(REJECT_STAGE) ) {
+      gen_event_reject(&ilc, &GENLC.SIMFILE_AUX, REJECT_STAGE);
+      goto GENEFF; 
+    }
+
     if ( INPUTS.TRACE_MAIN ) { dmp_trace_main("08", ilc) ; }
 
     // generate spectra before broadband fluxes in case TEXPOSE
@@ -524,6 +543,10 @@ void simEnd(SIMFILE_AUX_DEF *SIMFILE_AUX) {
   print_banner(BANNER);
   printf("\t (%d lightcurves requested => %d were written) \n",
 	 INPUTS.NGEN, NGENLC_WRITE );
+  if ( INPUTS.EARLY_REJECT_OPT > 0 ) {
+    printf("\t (%d rejects before full light curve or fluxes) \n",
+	   NGEN_REJECT.EARLY );
+  }
 
   // Aug 2023: write CPUTIME (proc all and per event)
 
@@ -830,6 +853,7 @@ void set_user_defaults(void) {
 #else
   INPUTS.NSTREAM_RAN = 2 ; // June 6 2020 (2nd stream for spectro noise)
 #endif
+  INPUTS.RANGEN_PHILOX = 0 ;
 
   INPUTS.NGEN_SCALE         =  1.0 ;
   INPUTS.NGEN_SCALE_NON1A   =  1.0 ;
@@ -1261,6 +1285,7 @@ void set_user_defaults(void) {
 
   HOSTLIB_NBR_WRITE.SEPNBR_MAX = 10.0; // +HOSTNBR keeps neighbors within 10''
   HOSTLIB_NBR_WRITE.NNBR_WRITE_MAX  = 10;   // write up to 10 NBRs
+  HOSTLIB_NBR_WRITE.NTHREAD         = 1;    // pthreads for +HOSTNBR
   //  HOSTLIB_NBR.MXCHAR_NBR_LIST = 80;   // max string-length of list
 
   // define polynom function of ztrue for zSN-zGAL tolerance.
@@ -1324,6 +1349,7 @@ void set_user_defaults(void) {
   }
 
   INPUTS.APPLY_SEARCHEFF_OPT    = 0 ;  // evaluate, but NOT applys
+  INPUTS.EARLY_REJECT_OPT       = 0 ;
   INPUTS.EFFERR_STOPGEN         = 0.0002 ; // stop when effic error <= this
 
   // ------
@@ -2130,6 +2156,9 @@ int parse_input_key_driver(char **WORDS, int keySource ) {
   else if ( keyMatchSim(1,"NSTREAM_RAN", WORDS[0],keySource) ) {
     N++;  sscanf(WORDS[N], "%d", &INPUTS.NSTREAM_RAN );
   } 
+  else if ( keyMatchSim(1,"RANGEN_PHILOX", WORDS[0],keySource) ) {
+    N++;  sscanf(WORDS[N], "%d", &INPUTS.RANGEN_PHILOX );
+  } 
   else if ( keyMatchSim(1,"RANLIST_START_GENSMEAR", WORDS[0],keySource) ) {
     N++;  sscanf(WORDS[N], "%d", &INPUTS.RANLIST_START_GENSMEAR );
   }
@@ -2612,6 +2641,9 @@ int parse_input_key_driver(char **WORDS, int keySource ) {
   else if ( keyMatchSim(1, "APPLY_SEARCHEFF_OPT",  WORDS[0],keySource) ) {
     N++;  sscanf(WORDS[N], "%d", &INPUTS.APPLY_SEARCHEFF_OPT );
   }
+  else if ( keyMatchSim(1, "EARLY_REJECT_OPT",  WORDS[0],keySource) ) {
+    N++;  sscanf(WORDS[N], "%d", &INPUTS.EARLY_REJECT_OPT );
+  }
   else if ( keyMatchSim(1, "APPLY_DETECT_SINGLE",  WORDS[0],keySource) ) {
     N++;  sscanf(WORDS[N], "%d", &INPUTS_SEARCHEFF.APPLY_DETECT_SINGLE );
   }
@@ -3875,6 +3907,9 @@ int parse_input_HOSTLIB(char **WORDS, int keySource ) {
   else if ( keyMatchSim( 1, "NNBR_WRITE_MAX", WORDS[0], keySource ) ) {
     N++; sscanf(WORDS[N], "%d", &HOSTLIB_NBR_WRITE.NNBR_WRITE_MAX );
   }
+  else if ( keyMatchSim( 1, "NTHREAD_HOSTNBR", WORDS[0], keySource ) ) {
+    N++; sscanf(WORDS[N], "%d", &HOSTLIB_NBR_WRITE.NTHREAD );
+  }
 
   else if ( keyMatchSim( 1, "+HOSTAPPEND", WORDS[0], keySource ) ) {
     INPUTS.HOSTLIB_MSKOPT += HOSTLIB_MSKOPT_APPEND ; // append info
@@ -7051,8 +7086,8 @@ void prep_user_input(void) {
 
   printf(" \n" );
 
-  printf("\t Random number seed: %d  (NSTREAM=%d)\n", 
-	 INPUTS.ISEED, INPUTS.NSTREAM_RAN );
+  printf("\t Random number seed: %d  (NSTREAM=%d, PHILOX=%d)\n", 
+	 INPUTS.ISEED, INPUTS.NSTREAM_RAN, INPUTS.RANGEN_PHILOX );
 
   printf("\t Gen-Range for RA(deg)  : %8.3f to %8.3f \n", 
 	 INPUTS.GENRANGE_RA[0], INPUTS.GENRANGE_RA[1] );
@@ -7380,9 +7415,12 @@ void prep_user_cosmology(void) {
   // Call init_HzFUN_INFO to either store user-input cosmology params,
   // or to read z,H(z) from 2-column input file.
   //
+  // Oct 2026: tabulate distance integral on z-grid (INPUTS.COSMO_ZGRID).
+  //           For H(z) map, grid ZMAX <= min(map zmax, GENRANGE_REDSHIFT max)
  
   double cosPar[NCOSPAR_HzFUN];
   char  *HzFUN_FILE = INPUTS.HzFUN_FILE ;
+  double ZMAX_ZGRID = ZMAX_ZGRID_DEFAULT ;
   int ipar;
   char fnam[] = "prep_user_cosmology";
 
@@ -7399,6 +7437,20 @@ void prep_user_cosmology(void) {
   init_HzFUN_INFO(VBOSE, cosPar, HzFUN_FILE, 
 		  &INPUTS.HzFUN_INFO ); // <== returned 
 
+  // tabulate distance integral once; beyond ZMAX, integral is extended.
+  // H(z) map is undefined beyond its last z-bin, so clamp ZMAX.
+  if ( INPUTS.HzFUN_INFO.USE_MAP ) {
+    int    Nzbin    = INPUTS.HzFUN_INFO.Nzbin_MAP ;
+    double zmax_map = INPUTS.HzFUN_INFO.zCMB_MAP[Nzbin-1] ;
+    double zmax_gen = INPUTS.GENRANGE_REDSHIFT[1] ;
+    ZMAX_ZGRID = zmax_map ;
+    if ( zmax_gen > 0.0 && zmax_gen < ZMAX_ZGRID ) { ZMAX_ZGRID = zmax_gen; }
+  }
+
+  init_COSMO_ZGRID(ZMAX_ZGRID, DZBIN_ZGRID_DEFAULT, 
+		   &INPUTS.HzFUN_INFO, &INPUTS.COSMO_ZGRID);
+  test_COSMO_ZGRID(&INPUTS.COSMO_ZGRID);
+
   return;
 
 } // end prep_user_cosmology
@@ -8607,8 +8659,8 @@ void init_DNDZ_Rate(void) {
   Z1 = INPUTS.GENRANGE_REDSHIFT[1] ;
 
   OPT_DVDZ = 0;
-  ZVint[0] = dVdz_integral( OPT_DVDZ, Z0, &INPUTS.HzFUN_INFO );
-  ZVint[1] = dVdz_integral( OPT_DVDZ, Z1, &INPUTS.HzFUN_INFO );
+  ZVint[0] = dVdz_integral_ZGRID( OPT_DVDZ, Z0, &INPUTS.COSMO_ZGRID);
+  ZVint[1] = dVdz_integral_ZGRID( OPT_DVDZ, Z1, &INPUTS.COSMO_ZGRID);
 
   // compute solid angle for stripe 82
   dphi   = INPUTS.GENRANGE_RA[1]   - INPUTS.GENRANGE_RA[0] ;
@@ -8629,8 +8681,8 @@ void init_DNDZ_Rate(void) {
 
   // compute average <z> wgted by volume
   OPT_DVDZ = 1;  // z-wgted option
-  ZVtmp[0] = dVdz_integral( OPT_DVDZ, Z0, &INPUTS.HzFUN_INFO);  
-  ZVtmp[1] = dVdz_integral( OPT_DVDZ, Z1, &INPUTS.HzFUN_INFO);
+  ZVtmp[0] = dVdz_integral_ZGRID( OPT_DVDZ, Z0, &INPUTS.COSMO_ZGRID);  
+  ZVtmp[1] = dVdz_integral_ZGRID( OPT_DVDZ, Z1, &INPUTS.COSMO_ZGRID);
 
   /*
   printf(" xxx %s: ZVint = %f, %f \n", fnam, ZVint[0], ZVint[1] );
@@ -8810,7 +8862,7 @@ void init_DNDZ_Rate(void) {
   if ( DNDZFLAG ) {
     ztmp = Z0 ;   ctmp_pec1a[0] = 0 ;
     while ( ztmp <= Z1 ) {
-      dVdz_tmp = dVdz (ztmp, &INPUTS.HzFUN_INFO);
+      dVdz_tmp = dVdz_ZGRID(ztmp, &INPUTS.COSMO_ZGRID);
       rtmp1 = genz_wgt(ztmp,&INPUTS.RATEPAR) ;   
       rtmp2 = genz_wgt(ztmp,&INPUTS.RATEPAR_PEC1A) ; 
       rtmp  = rtmp1 + rtmp2 ;
@@ -8991,6 +9043,7 @@ void init_simvar(void) {
   NGEN_REJECT.CUTWIN    = 0;
   NGEN_REJECT.NEPOCH    = 0;
   NGEN_REJECT.CRAZYFLUX = 0;  
+  NGEN_REJECT.EARLY     = 0;
 
   GENLC.MWEBV           = 0.0 ;
   GENLC.MWEBV_ERR       = 0.0 ;
@@ -11611,15 +11664,20 @@ double GENSPEC_SMEAR(int imjd, double LAMMIN, double LAMMAX ) {
   //  Fix bug from v10_78 where GRAN_T no longer followed correlated option.
   //
   // Nov 10 2021: store LAMRANGE_VALID[imjd][0:1]
+  // Oct 2026: collect valid lambda bins and get true SNR with one call
+  //           to getSNR_spectrograph_array.
 
   int    NBLAM = INPUTS_SPECTRO.NBIN_LAM ;
   int    MEMD  = NBLAM * sizeof(double);
+  int    MEMI  = NBLAM * sizeof(int);
 
   GENPOLY_DEF *GENPOLY_SCALE_SNR = &INPUTS.SPECTROGRAPH_OPTIONS.GENPOLY_SCALE_SNR;
 
-  int    ilam, ILAM_MIN=99999, ILAM_MAX=-9, NBLAM_USE=0 ;
+  int    ilam, i, ILAM_MIN=99999, ILAM_MAX=-9, NBLAM_USE=0 ;
   double GENFLUX, GENFLUXERR, GENFLUXERR_T, GENMAG, LAMAVG ;
   double *SNR_TRUE_LIST,   SNR_TRUE, *ERRFRAC_T_LIST, ERRFRAC_T ; 
+  int    *ILAM_USE_LIST ;
+  double *GENMAG_USE_LIST, *SNR_USE_LIST, *ERRFRAC_T_USE_LIST ;
 
   double  TEXPOSE_S  = GENSPEC.TEXPOSE_LIST[imjd] ;
   double  TEXPOSE_T  = GENSPEC.TEXPOSE_TEMPLATE ;
@@ -11637,8 +11695,12 @@ double GENSPEC_SMEAR(int imjd, double LAMMIN, double LAMMAX ) {
 
   // - - - - - -
 
-  SNR_TRUE_LIST   = (double*) malloc( MEMD ) ;
-  ERRFRAC_T_LIST  = (double*) malloc( MEMD ) ;
+  SNR_TRUE_LIST      = (double*) malloc( MEMD ) ;
+  ERRFRAC_T_LIST     = (double*) malloc( MEMD ) ;
+  ILAM_USE_LIST      = (int   *) malloc( MEMI ) ;
+  GENMAG_USE_LIST    = (double*) malloc( MEMD ) ;
+  SNR_USE_LIST       = (double*) malloc( MEMD ) ;
+  ERRFRAC_T_USE_LIST = (double*) malloc( MEMD ) ;
  
   for(ilam=0; ilam < NBLAM; ilam++ ) {
 
@@ -11673,10 +11735,10 @@ double GENSPEC_SMEAR(int imjd, double LAMMIN, double LAMMAX ) {
       ERRFRAC_T = 0.0 ;
     }
     else {
-      // nominal usage
-      SNR_TRUE =
-	getSNR_spectrograph(ilam, TEXPOSE_S, TEXPOSE_T, ALLOW_TEXTRAP, GENMAG,
-			    &ERRFRAC_T);  // template frac of error
+      // nominal usage: store bin for getSNR_spectrograph_array below
+      SNR_TRUE  = -9.0 ;
+      ERRFRAC_T =  0.0 ;
+      GENMAG_USE_LIST[NBLAM_USE] = GENMAG ;
     }
 
     SNR_TRUE_LIST[ilam]  = SNR_TRUE ;
@@ -11685,6 +11747,7 @@ double GENSPEC_SMEAR(int imjd, double LAMMIN, double LAMMAX ) {
     // apply lambda smear to distribute GENFLUX over lambda bins 
     GENSPEC_LAMSMEAR(imjd, ilam, GENFLUX );
 
+    ILAM_USE_LIST[NBLAM_USE] = ilam ;
     NBLAM_USE++ ;
 
   } // end ilam  
@@ -11692,6 +11755,19 @@ double GENSPEC_SMEAR(int imjd, double LAMMIN, double LAMMAX ) {
 
   if ( NBLAM_USE == 0 ) { goto DONE ; }
 
+  // get true SNR in all used lambda bins (template frac of error too)
+  if ( !DO_SEDMODEL ) {
+    getSNR_spectrograph_array(NBLAM_USE, ILAM_USE_LIST, 
+			      TEXPOSE_S, TEXPOSE_T, ALLOW_TEXTRAP, 
+			      GENMAG_USE_LIST, 
+			      SNR_USE_LIST, ERRFRAC_T_USE_LIST );
+    for(i=0; i < NBLAM_USE; i++ ) {
+      ilam = ILAM_USE_LIST[i];
+      SNR_TRUE_LIST[ilam]  = SNR_USE_LIST[i];
+      ERRFRAC_T_LIST[ilam] = ERRFRAC_T_USE_LIST[i];
+    }
+  }
+
   // - - - - - - - - - - - - - - 
   // after smearing flux in neighbor bins, loop again over wavelegth
   // and apply Poisson noise.
@@ -11758,6 +11834,10 @@ double GENSPEC_SMEAR(int imjd, double LAMMIN, double LAMMAX ) {
  DONE:
   free(SNR_TRUE_LIST);
   free(ERRFRAC_T_LIST);
+  free(ILAM_USE_LIST);
+  free(GENMAG_USE_LIST);
+  free(SNR_USE_LIST);
+  free(ERRFRAC_T_USE_LIST);
 
   return(SNR_SPEC) ;
 
@@ -16821,6 +16901,7 @@ double gen_dLmag(double zCMB, double zHEL, double vPEC, double GLON, double GLAT
 
   // Returns lumi-distance mag with input cosmology
   // Note that INPUTS.H0 ~ 70 km/s/Mpc, and H0 -> ~2E-18
+  // Oct 2026: use z-grid table instead of integral for each event
 
   double mu ;
   if ( zCMB <= 1.0E-10 ) { return 0.0 ; }  // avoid inf, May 2013
@@ -16830,7 +16911,8 @@ double gen_dLmag(double zCMB, double zHEL, double vPEC, double GLON, double GLAT
     INPUTS.ANISOTROPY_INFO.GLAT = GLAT;
   }
 
-  mu = dLmag (zCMB, zHEL, vPEC, &INPUTS.HzFUN_INFO, &INPUTS.ANISOTROPY_INFO );
+  mu = dLmag_ZGRID(zCMB, zHEL, vPEC, &INPUTS.COSMO_ZGRID, 
+		    &INPUTS.ANISOTROPY_INFO );
 
   return(mu) ;
 
@@ -16917,7 +16999,7 @@ double genz_hubble ( double zmin, double zmax, RATEPAR_DEF *RATEPAR ) {
 	w = eval_GENPOLY(z, &RATEPAR->MODEL_ZPOLY, fnam) ; 
       }
       else {
-	w = dVdz (z, &INPUTS.HzFUN_INFO);
+	w = dVdz_ZGRID(z, &INPUTS.COSMO_ZGRID);
 	w /= (1.0+z);
 	w *= genz_wgt(z,RATEPAR) ;
       }
@@ -16972,7 +17054,7 @@ double genz_hubble ( double zmin, double zmax, RATEPAR_DEF *RATEPAR ) {
   }
   else {
     // physical distribution
-    w    = dVdz (zran, &INPUTS.HzFUN_INFO);
+    w    = dVdz_ZGRID(zran, &INPUTS.COSMO_ZGRID);
     w   /= (1.0+zran);  
     w   *= genz_wgt(zran,RATEPAR);
     if ( w > RATEPAR->ZGENWGT_MAX )  { RATEPAR->ZGENWGT_MAX = w ; }
@@ -17114,7 +17196,7 @@ double SNcount_model(double zMIN, double zMAX, RATEPAR_DEF *RATEPAR ) {
 
   for ( iz=1; iz <= NBZ; iz++ ) {
     ztmp   = zMIN + dz * ((double)iz - 0.5 ) ;
-    vtmp   = dVdz (ztmp, &INPUTS.HzFUN_INFO);
+    vtmp   = dVdz_ZGRID(ztmp, &INPUTS.COSMO_ZGRID);
     rtmp   = genz_wgt(ztmp,RATEPAR) ;   // rate * user-rewegt fudge
     tmp    = rtmp * vtmp / ( 1.0 + ztmp );
     SNsum += tmp ;
@@ -26337,18 +26419,11 @@ int gen_TRIGGER_PEAKMAG_SPEC(void) {
   //
   // Jun 2 2018: bail out for LCLIB model because PEAKMAG is ill-defined.
 
-  int  LFIND_SPEC=0, NEP_PEAKONLY=0, iep  ;
-  int  MEMI  = (GENLC.NEPOCH+1) * sizeof(int);
-  int  MEMD  = (GENLC.NEPOCH+1) * sizeof(double);
+  // Oct 2026: move epoch save/restore to GENLC_PEAKEPOCHS
+
+  int  LFIND_SPEC=0 ;
   int  DOSPEC = (INPUTS.APPLY_SEARCHEFF_OPT & 2) ;
   double EFF ;
-
-  struct {
-    int NEPOCH, *IFILT_OBS, *ISPEAK;
-    double *MJD, *TOBS, *TREST ;
-  } GENLC_ORIG ;
-
-
   char fnam[] = "gen_TRIGGER_PEAKMAG_SPEC" ;
 
   // -------------- BEGIN ----------------
@@ -26365,58 +26440,232 @@ int gen_TRIGGER_PEAKMAG_SPEC(void) {
   if ( INDEX_GENMODEL == MODEL_LCLIB ) // Jun 2 2018
     { return(1); }
 
-  GENLC_ORIG.NEPOCH      = GENLC.NEPOCH;
-  GENLC_ORIG.IFILT_OBS   = (int*)malloc ( MEMI ) ; 
-  GENLC_ORIG.ISPEAK      = (int*)malloc ( MEMI ) ;
-  GENLC_ORIG.MJD         = (double*)malloc( MEMD ) ;
-  GENLC_ORIG.TOBS        = (double*)malloc( MEMD ) ;
-  GENLC_ORIG.TREST       = (double*)malloc( MEMD ) ;
+  GENLC_PEAKEPOCHS(+1);
+  GENMAG_DRIVER(); 
+  LOAD_SEARCHEFF_DATA();
+  LFIND_SPEC = gen_SEARCHEFF_SPEC(GENLC.CID, &EFF) ;  // return EFF 
+  GENLC_PEAKEPOCHS(-1);
 
-  for(iep=1; iep <= GENLC_ORIG.NEPOCH ; iep++ ) {
-    GENLC_ORIG.ISPEAK[iep]    = GENLC.OBSFLAG_PEAK[iep] ;
-    GENLC_ORIG.IFILT_OBS[iep] = GENLC.IFILT_OBS[iep] ;
-    GENLC_ORIG.MJD[iep]       = GENLC.MJD[iep];
-    GENLC_ORIG.TOBS[iep]      = GENLC.epoch_obs[iep];  
-    GENLC_ORIG.TREST[iep]     = GENLC.epoch_rest[iep] ;
+  return(LFIND_SPEC) ;
 
-    if ( GENLC_ORIG.ISPEAK[iep] == 0 ) { continue ; }
-    NEP_PEAKONLY++ ;
-    GENLC.OBSFLAG_PEAK[NEP_PEAKONLY]       = GENLC_ORIG.ISPEAK[iep] ;
-    GENLC.IFILT_OBS[NEP_PEAKONLY]    = GENLC_ORIG.IFILT_OBS[iep] ;
-    GENLC.MJD[NEP_PEAKONLY]          = GENLC_ORIG.MJD[iep] ;
-    GENLC.epoch_obs[NEP_PEAKONLY]   = GENLC_ORIG.TOBS[iep] ;
-    GENLC.epoch_rest[NEP_PEAKONLY]  = GENLC_ORIG.TREST[iep] ;
-  }
+} // end gen_TRIGGER_PEAKMAG_SPEC
 
 
-  GENLC.NEPOCH = NEP_PEAKONLY;
-  GENMAG_DRIVER(); 
-  LOAD_SEARCHEFF_DATA();
-  LFIND_SPEC = gen_SEARCHEFF_SPEC(GENLC.CID, &EFF) ;  // return EFF 
-    
-  GENLC.NEPOCH = GENLC_ORIG.NEPOCH ; // always needed for init_event_GENLC
+// *********************************************
+void GENLC_PEAKEPOCHS(int OPT) {
+
+  // Created Oct 2026 [code moved from gen_TRIGGER_PEAKMAG_SPEC]
+  // OPT = +1 -> save nominal epochs in GENLC_EPOCH_ORIG and keep
+  //             only peak epochs so that GENMAG_DRIVER is fast.
+  // OPT = -1 -> restore nominal epochs and free memory.
+
+  int  NEPOCH = GENLC.NEPOCH;
+  int  MEMI   = (NEPOCH+1) * sizeof(int);
+  int  MEMD   = (NEPOCH+1) * sizeof(double);
+  int  NEP_PEAKONLY = 0, iep ;
+
+  // -------------- BEGIN ----------------
 
-  // check to restore ALL epochs
-  if ( LFIND_SPEC ) {
+  if ( OPT > 0 ) {
+    GENLC_EPOCH_ORIG.NEPOCH      = NEPOCH;
+    GENLC_EPOCH_ORIG.IFILT_OBS   = (int*)malloc ( MEMI ) ; 
+    GENLC_EPOCH_ORIG.ISPEAK      = (int*)malloc ( MEMI ) ;
+    GENLC_EPOCH_ORIG.MJD         = (double*)malloc( MEMD ) ;
+    GENLC_EPOCH_ORIG.TOBS        = (double*)malloc( MEMD ) ;
+    GENLC_EPOCH_ORIG.TREST       = (double*)malloc( MEMD ) ;
+
+    for(iep=1; iep <= NEPOCH ; iep++ ) {
+      GENLC_EPOCH_ORIG.ISPEAK[iep]    = GENLC.OBSFLAG_PEAK[iep] ;
+      GENLC_EPOCH_ORIG.IFILT_OBS[iep] = GENLC.IFILT_OBS[iep] ;
+      GENLC_EPOCH_ORIG.MJD[iep]       = GENLC.MJD[iep];
+      GENLC_EPOCH_ORIG.TOBS[iep]      = GENLC.epoch_obs[iep];  
+      GENLC_EPOCH_ORIG.TREST[iep]     = GENLC.epoch_rest[iep] ;
+
+      if ( GENLC_EPOCH_ORIG.ISPEAK[iep] == 0 ) { continue ; }
+      NEP_PEAKONLY++ ;
+      GENLC.OBSFLAG_PEAK[NEP_PEAKONLY] = GENLC_EPOCH_ORIG.ISPEAK[iep] ;
+      GENLC.IFILT_OBS[NEP_PEAKONLY]    = GENLC_EPOCH_ORIG.IFILT_OBS[iep] ;
+      GENLC.MJD[NEP_PEAKONLY]          = GENLC_EPOCH_ORIG.MJD[iep] ;
+      GENLC.epoch_obs[NEP_PEAKONLY]    = GENLC_EPOCH_ORIG.TOBS[iep] ;
+      GENLC.epoch_rest[NEP_PEAKONLY]   = GENLC_EPOCH_ORIG.TREST[iep] ;
+    }
+    GENLC.NEPOCH = NEP_PEAKONLY;
+  }
+  else {
+    GENLC.NEPOCH = GENLC_EPOCH_ORIG.NEPOCH ;
     for(iep=1; iep <= GENLC.NEPOCH ; iep++ ) {
-      GENLC.OBSFLAG_PEAK[iep]  = GENLC_ORIG.ISPEAK[iep];
-      GENLC.IFILT_OBS[iep]     = GENLC_ORIG.IFILT_OBS[iep] ;
-      GENLC.MJD[iep]           = GENLC_ORIG.MJD[iep];
-      GENLC.epoch_obs[iep]     = GENLC_ORIG.TOBS[iep]  ;
-      GENLC.epoch_rest[iep]    = GENLC_ORIG.TREST[iep] ;
+      GENLC.OBSFLAG_PEAK[iep]  = GENLC_EPOCH_ORIG.ISPEAK[iep];
+      GENLC.IFILT_OBS[iep]     = GENLC_EPOCH_ORIG.IFILT_OBS[iep] ;
+      GENLC.MJD[iep]           = GENLC_EPOCH_ORIG.MJD[iep];
+      GENLC.epoch_obs[iep]     = GENLC_EPOCH_ORIG.TOBS[iep]  ;
+      GENLC.epoch_rest[iep]    = GENLC_EPOCH_ORIG.TREST[iep] ;
     }
+    free(GENLC_EPOCH_ORIG.IFILT_OBS);
+    free(GENLC_EPOCH_ORIG.ISPEAK);
+    free(GENLC_EPOCH_ORIG.MJD);
+    free(GENLC_EPOCH_ORIG.TOBS);
+    free(GENLC_EPOCH_ORIG.TREST);
   }
 
+  return ;
 
-  free(GENLC_ORIG.IFILT_OBS);
-  free(GENLC_ORIG.ISPEAK);
-  free(GENLC_ORIG.MJD);
-  free(GENLC_ORIG.TOBS);
-  free(GENLC_ORIG.TREST);
+} // end GENLC_PEAKEPOCHS
 
-  return(LFIND_SPEC) ;
 
-} // end gen_TRIGGER_PEAKMAG_SPEC
+// *********************************************
+int gen_EARLY_REJECT(char *REJECT_STAGE) {
+
+  // Created Oct 2026
+  // Optional stage (sim-input EARLY_REJECT_OPT) to reject events
+  // using peak-only mags before generating mags, spectra and fluxes
+  // for every epoch. Returns 1 if event fails and loads REJECT_STAGE
+  // with the same stage name that would be used after the full LC
+  // is generated, so that reject counters are unchanged.
+  //
+  //  MASK_EARLY_REJECT_GENMAG:    GENMAG_CUT on peakmag_obs. Exact since
+  //                               GENMAG_CUT uses only peak epochs, and
+  //                               GENMAG reject comes before the
+  //                               CRAZYFLUX, NEPOCH & SEARCHEFF rejects.
+  //
+  // Trigger (SEARCHEFF) cuts are not applied here because a bound
+  // from peak mags is not strictly conservative, and an early
+  // SEARCHEFF reject would hide the CRAZYFLUX & NEPOCH rejects;
+  // see gen_EARLY_REJECT_FLUX for trigger cuts using all epochs.
+  //
+  // Returns 0 if event passes or if stage is not used.
+
+  int  OPT        = INPUTS.EARLY_REJECT_OPT ;
+  int  DO_GENMAG  = ( OPT & MASK_EARLY_REJECT_GENMAG    );
+
+  // -------------- BEGIN ----------------
+
+  REJECT_STAGE[0] = 0 ;
+
+  if ( !DO_GENMAG ) { return(0); }
+
+  if ( GENLC.IFLAG_GENSOURCE == IFLAG_GENGRID  ) { return(0); }
+  if ( INDEX_GENMODEL == MODEL_LCLIB )           { return(0); }
+
+  GENLC_PEAKEPOCHS(+1);
+  GENMAG_DRIVER(); 
+  GENLC_PEAKEPOCHS(-1);
+
+  if ( GENMAG_CUT() == 0 ) 
+    { sprintf(REJECT_STAGE,"GENMAG");  NGEN_REJECT.EARLY++ ;  return(1); }
+
+  return(0) ;
+
+} // end gen_EARLY_REJECT
+
+
+// *********************************************
+int gen_EARLY_REJECT_FLUX(char *REJECT_STAGE) {
+
+  // Created Oct 2026
+  // Optional stage (sim-input EARLY_REJECT_OPT) called after 
+  // GENMAG_DRIVER to reject events before generating spectra
+  // and fluxes. Rejects are made only when the outcome of the
+  // later stages is certain, and REJECT_STAGE is loaded with the
+  // stage that would reject the event after fluxes are generated.
+  //
+  //  NOBS_MODEL:  number of epochs with defined model mag. If 0, 
+  //    NOBS_MODELFLUX=0 and event fails "NEPOCH" after GENFLUX_DRIVER.
+  //
+  //  MASK_EARLY_REJECT_SEARCHEFF: "SEARCHEFF" reject if
+  //    + SIMLIB epoch count is below trigger MINOBS, or
+  //    + pipeline efficiency bound (EFFMAX_PIPELINE_DETECT) is zero
+  //      in every band for mags fainter than brightest epoch mag.
+  //
+  //  MASK_EARLY_REJECT_ZCUT: "CUTWIN" reject on CUTWIN_REDSHIFT_TRUE;
+  //    only if SEARCHEFF is not applied, since otherwise the event 
+  //    could fail either SEARCHEFF or CUTWIN.
+  //
+  // Trigger & z cuts require at least one epoch with model mag
+  // and SKYSIG>0 so that NOBS_MODELFLUX>0 and the NEPOCH reject
+  // cannot happen. Stage is skipped for options that write
+  // flux-dependent info for rejected events, and for AGN model
+  // where CRAZYFLUX is a reject instead of abort.
+  //
+  // Returns 0 if event passes or if stage is not used.
+
+  int  OPT        = INPUTS.EARLY_REJECT_OPT ;
+  int  DO_SEARCH  = ( OPT & MASK_EARLY_REJECT_SEARCHEFF );
+  int  DO_ZCUT    = ( OPT & MASK_EARLY_REJECT_ZCUT      );
+  int  APPLY_OPT  = INPUTS.APPLY_SEARCHEFF_OPT ;
+  int  NEPOCH     = GENLC.NEPOCH ;
+  int  NOBS_MODEL = 0, NOBS_NOISE = 0 ;
+  int  ep, ifilt, ifilt_obs, NFILT_EFF = 0 ;
+  bool IS_UNDEFINED ;
+  double genmag, ZTRUE, MAGMIN[MXFILTINDX] ;
+
+  // -------------- BEGIN ----------------
+
+  REJECT_STAGE[0] = 0 ;
+
+  if ( !DO_SEARCH && !DO_ZCUT ) { return(0); }
+
+  if ( GENLC.IFLAG_GENSOURCE == IFLAG_GENGRID  )     { return(0); }
+  if ( INDEX_GENMODEL == MODEL_AGN )                 { return(0); }
+  if ( GENLC.NGEN_SIMLIB_ID >= SIMLIB_MXGEN_LIBID )  { return(0); }
+  if ( INPUTS.OPT_FUDGE_SNRMAX > 0 )                 { return(0); }
+  if ( INPUTS.IFLAG_SIMGEN_DUMPALL )                 { return(0); }
+  if ( INPUTS_STRONGLENS.USE_FLAG )                  { return(0); }
+
+  // find brightest model mag per band, and count epochs with model
+  for(ifilt_obs=0; ifilt_obs < MXFILTINDX; ifilt_obs++ ) 
+    { MAGMIN[ifilt_obs] = MAG_UNDEFINED ; }
+
+  for(ep=1; ep <= NEPOCH; ep++ ) {
+    if ( !GENLC.OBSFLAG_GEN[ep] ) { continue; }
+    genmag       = GENLC.genmag_obs[ep] ;
+    IS_UNDEFINED = ( genmag == MAG_UNDEFINED );
+    if ( INPUTS.SPECTROGRAPH_OPTIONS.LAMBIN_SED_TRUE > 0.01 ) 
+      { if ( genmag == MAG_ZEROFLUX ) { IS_UNDEFINED = true; } }
+    if ( IS_UNDEFINED ) { continue; }
+
+    NOBS_MODEL++ ;
+    if ( SIMLIB_OBS_GEN.SKYSIG[ep] > 0.0 ) { NOBS_NOISE++ ; }
+
+    ifilt_obs = GENLC.IFILT_OBS[ep] ;
+    if ( genmag < MAGMIN[ifilt_obs] ) { MAGMIN[ifilt_obs] = genmag; }
+  }
+
+  if ( NOBS_MODEL == 0 ) 
+    { sprintf(REJECT_STAGE,"NEPOCH");  NGEN_REJECT.EARLY++ ;  return(1); }
+
+  if ( NOBS_NOISE == 0 ) { return(0); }
+
+  // - - - - - trigger - - - - - 
+  if ( DO_SEARCH && APPLY_OPT > 0 ) {
+
+    if ( NEPOCH < INPUTS_SEARCHEFF.MINOBS ) 
+      { sprintf(REJECT_STAGE,"SEARCHEFF");  NGEN_REJECT.EARLY++; return(1); }
+
+    // with NMJD=0, trigger does not require any detection
+    if ( INPUTS_SEARCHEFF.NMAP_DETECT > 0 && SEARCHEFF_LOGIC.NMJD > 0 ) {
+      for ( ifilt=0; ifilt < GENLC.NFILTDEF_OBS; ifilt++ ) {
+	ifilt_obs = GENLC.IFILTMAP_OBS[ifilt];
+	if ( MAGMIN[ifilt_obs] == MAG_UNDEFINED ) { continue; }
+	if ( EFFMAX_PIPELINE_DETECT(ifilt_obs,MAGMIN[ifilt_obs]) > 0.0 )
+	  { NFILT_EFF++ ; }
+      }
+      if ( NFILT_EFF == 0 ) 
+	{ sprintf(REJECT_STAGE,"SEARCHEFF"); NGEN_REJECT.EARLY++; return(1); }
+    }
+  }
+
+  // - - - - - redshift cut - - - - - 
+  if ( DO_ZCUT && APPLY_OPT == 0 && 
+       INPUTS.APPLY_CUTWIN_OPT > 0 && INPUTS.APPLY_CUTWIN_OPT != 3 ) {
+    ZTRUE  = GENLC.REDSHIFT_CMB;
+    if ( ZTRUE < INPUTS.CUTWIN_REDSHIFT_TRUE[0] || 
+	 ZTRUE > INPUTS.CUTWIN_REDSHIFT_TRUE[1] )
+      { sprintf(REJECT_STAGE,"CUTWIN");  NGEN_REJECT.EARLY++ ;  return(1); }
+  }
+
+  return(0) ;
+
+} // end gen_EARLY_REJECT_FLUX
 
 
 // ==========================================
@@ -26535,10 +26784,13 @@ void GENFLUX_DRIVER(void) {
   //           e.g., correlations for anomalous host noise.
   //
   // Oct 1 2023: for GENGRID, set  GENLC.NOBS_MODELFLUX = GENLC.NEPOCH
+  //
+  // Oct 2026: load per-event SoA epoch buffer (FLUXNOISE_BUF) and
+  //           call noise calc & apply once per event.
 
   int NEPOCH = GENLC.NEPOCH ;
   int MEM    = (NEPOCH+1)*sizeof(FLUXNOISE_DEF);
-  int epoch, icov;
+  int epoch, icov, o ;
   int VBOSE_CALC  = 0 ; 
   int VBOSE_FUDGE = 0 ;
   int VBOSE_APPLY = 0 ;
@@ -26552,6 +26804,9 @@ void GENFLUX_DRIVER(void) {
   GENLC.FLUXNOISE = (FLUXNOISE_DEF*) malloc(MEM);
   NGENFLUX_DRIVER++ ;
 
+  // load buffer of generated epochs
+  load_FLUXNOISE_BUF();
+
   // generate randoms for each epopch and filter
   // Avoid calling randoms twice when running both legacy gen_smearFlux
   // and refactored code here.
@@ -26562,37 +26817,35 @@ void GENFLUX_DRIVER(void) {
     COVINFO_FLUXERRMODEL[icov].NOBS_NOCUT = 0 ; 
   }
 
-
   for ( epoch = 1; epoch <= GENLC.NEPOCH; epoch++ ) {
-
     GENLC.flux[epoch]         = NULLFLOAT ; 
     GENLC.fluxerr_data[epoch] = NULLFLOAT ;     
     GENLC.FLUXNOISE[epoch].IFILT_OBS = -888 ;
+  }
+
+  gen_fluxNoise_calc(VBOSE_CALC);
 
-    if ( !GENLC.OBSFLAG_GEN[epoch]  )  { continue ; }
-    gen_fluxNoise_calc(epoch,VBOSE_CALC, &GENLC.FLUXNOISE[epoch]);
+  // evaluate FLUXERRMODEL maps for all epochs
+  gen_fluxNoise_FLUXERRMAP();
 
-    // check noise fudge-options; diagonal COV only
-    gen_fluxNoise_fudge_diag(epoch, VBOSE_FUDGE, &GENLC.FLUXNOISE[epoch]);
+  // check noise fudge-options; diagonal COV only
+  for(o=0; o < FLUXNOISE_BUF.NOBS; o++ ) {
+    gen_fluxNoise_fudge_diag(o, VBOSE_FUDGE);
 
+    epoch = FLUXNOISE_BUF.EPOCH[o] ;
     if ( VBOSE_CALC ) 
       { dumpLine_fluxNoise("NEW", epoch, &GENLC.FLUXNOISE[epoch] );  }
-
-  } // end epoch loop
-
+  }
 
   // check for optional flux covariance in FLUXERRMODEL_FILE maps
   gen_fluxNoise_driver_cov();
 
-  
   // apply random noise to each flux
-  for ( epoch = 1; epoch <= GENLC.NEPOCH; epoch++ ) {
-    if ( !GENLC.OBSFLAG_GEN[epoch]  )  { continue ; }
-    gen_fluxNoise_apply(epoch, VBOSE_APPLY, &GENLC.FLUXNOISE[epoch] );
+  gen_fluxNoise_apply(VBOSE_APPLY);
 
-    // set flags for saturation, undefined ...
-    set_GENFLUX_FLAGS(epoch);
-  }
+  // set flags for saturation, undefined ...
+  for(o=0; o < FLUXNOISE_BUF.NOBS; o++ ) 
+    { set_GENFLUX_FLAGS(FLUXNOISE_BUF.EPOCH[o]); }
 
   // monitor covariance separately for S,T,F components, and each band.
   if ( (INPUTS.FLUXERRMODEL_OPTMASK & MASK_MONITORCOV_FLUXERRMODEL)>0 )
@@ -26605,6 +26858,143 @@ void GENFLUX_DRIVER(void) {
 } // end GENFLUX_DRIVER
 
 
+// *****************************************
+void load_FLUXNOISE_BUF(void) {
+
+  // Created Oct 2026
+  // Load per-event SoA buffer FLUXNOISE_BUF for generated epochs
+  // (OBSFLAG_GEN) with observing conditions and true mags.
+  // Indices that depend only on BAND and FIELD (template field,
+  // FLUXERRMAP, REDCOV) are evaluated only when BAND or FIELD changes.
+
+  FLUXNOISE_BUF_DEF *BUF = &FLUXNOISE_BUF ;
+  int  NEPOCH   = GENLC.NEPOCH ;
+  bool USE_MAP  = ( NMAP_FLUXERRMODEL > 0 ) ;
+  int  ep, o=0, ifilt_obs, ifilt_last = -9 ;
+  int  IFIELD = 0, IMAP = -9, ICOV = -9 ;
+  bool NEW_FIELD, NEW_BAND ;
+  char band[2], *FIELD, *FIELD_LAST = NULL ;
+  char fnam[] = "load_FLUXNOISE_BUF" ;
+
+  // ------------ BEGIN ------------
+
+  malloc_FLUXNOISE_BUF(NEPOCH);
+
+  for ( ep = 1; ep <= NEPOCH; ep++ ) {
+    if ( !GENLC.OBSFLAG_GEN[ep] ) { continue ; }
+
+    ifilt_obs = GENLC.IFILT_OBS[ep] ;
+    FIELD     = GENLC.FIELDNAME[ep] ;
+    NEW_FIELD = ( FIELD_LAST == NULL || strcmp(FIELD,FIELD_LAST) != 0 );
+    NEW_BAND  = ( ifilt_obs != ifilt_last );
+
+    if ( NEW_FIELD ) {
+      IFIELD = IFIELD_OVP_SIMLIB(1,FIELD);
+      if ( IFIELD < 0 ) { IFIELD = 0; } // Nov 2016: for GAURAN_TEMPLATE
+    }
+
+    if ( USE_MAP && (NEW_FIELD || NEW_BAND) ) {
+      sprintf(band, "%c", FILTERSTRING[ifilt_obs] );
+      IMAP = INDEX_MAP_FLUXERRMODEL(band, FIELD, fnam);
+      if ( NREDCOV_FLUXERRMODEL > 0 ) 
+	{ ICOV = INDEX_REDCOV_FLUXERRMODEL(band, FIELD, 2, fnam); }
+    }
+    FIELD_LAST = FIELD;  ifilt_last = ifilt_obs ;
+
+    BUF->EPOCH[o]              = ep ;
+    BUF->IFILT_OBS[o]          = ifilt_obs ;
+    BUF->IFIELD_OVP[o]         = IFIELD ;
+    BUF->IMAP_FLUXERRMAP[o]    = IMAP ;
+    BUF->INDEX_REDCOV[o]       = ICOV ;
+
+    BUF->MJD[o]                = SIMLIB_OBS_GEN.MJD[ep] ;
+    BUF->ZPT[o]                = SIMLIB_OBS_GEN.ZPTADU[ep] ;
+    BUF->ZPTERR[o]             = SIMLIB_OBS_GEN.ZPTERR[ep] ;
+    BUF->CCDGAIN[o]            = SIMLIB_OBS_GEN.CCDGAIN[ep] ;
+    BUF->SKYSIG[o]             = SIMLIB_OBS_GEN.SKYSIG[ep] ;
+    BUF->READNOISE[o]          = SIMLIB_OBS_GEN.READNOISE[ep] ;
+    BUF->PSFSIG1[o]            = SIMLIB_OBS_GEN.PSFSIG1[ep] ; // pixels
+    BUF->PIXSIZE[o]            = SIMLIB_OBS_GEN.PIXSIZE[ep] ;
+    BUF->NEA[o]                = SIMLIB_OBS_GEN.NEA[ep] ;
+    BUF->TEMPLATE_SKYSIG[o]    = SIMLIB_OBS_GEN.TEMPLATE_SKYSIG[ep] ;
+    BUF->TEMPLATE_READNOISE[o] = SIMLIB_OBS_GEN.TEMPLATE_READNOISE[ep] ;
+    BUF->TEMPLATE_ZPT[o]       = SIMLIB_OBS_GEN.TEMPLATE_ZPT[ep] ;
+
+    BUF->GENMAG[o]             = GENLC.genmag_obs[ep] ;
+    BUF->GENMAG_T[o]           = GENLC.genmag_obs_template[ifilt_obs];//LCLIB
+    o++ ;
+  }
+
+  BUF->NOBS = o ;
+
+  return ;
+
+} // end load_FLUXNOISE_BUF
+
+
+// *****************************************
+void malloc_FLUXNOISE_BUF(int NOBS) {
+
+  // Created Oct 2026
+  // Extend FLUXNOISE_BUF arrays if NOBS exceeds current size.
+  // Arrays are kept between events.
+
+  FLUXNOISE_BUF_DEF *BUF = &FLUXNOISE_BUF ;
+  int MXOBS, MEMI, MEMD, MEMP, MEMR ;
+
+  // ------------ BEGIN ------------
+
+  if ( NOBS <= BUF->MXOBS ) { return ; }
+
+  MXOBS = NOBS + 100 ;
+  MEMI  = MXOBS * sizeof(int);
+  MEMD  = MXOBS * sizeof(double);
+  MEMP  = MXOBS * NPAR_FLUXERRMAP_REQUIRE * sizeof(double);
+  MEMR  = (2*MXOBS + MXFILTINDX*MXFIELD_OVP) * sizeof(double);
+
+  BUF->EPOCH           = (int*) realloc(BUF->EPOCH,           MEMI);
+  BUF->IFILT_OBS       = (int*) realloc(BUF->IFILT_OBS,       MEMI);
+  BUF->IFIELD_OVP      = (int*) realloc(BUF->IFIELD_OVP,      MEMI);
+  BUF->IMAP_FLUXERRMAP = (int*) realloc(BUF->IMAP_FLUXERRMAP, MEMI);
+  BUF->INDEX_REDCOV    = (int*) realloc(BUF->INDEX_REDCOV,    MEMI);
+
+  BUF->MJD        = (double*) realloc(BUF->MJD,        MEMD);
+  BUF->ZPT        = (double*) realloc(BUF->ZPT,        MEMD);
+  BUF->ZPTERR     = (double*) realloc(BUF->ZPTERR,     MEMD);
+  BUF->CCDGAIN    = (double*) realloc(BUF->CCDGAIN,    MEMD);
+  BUF->SKYSIG     = (double*) realloc(BUF->SKYSIG,     MEMD);
+  BUF->READNOISE  = (double*) realloc(BUF->READNOISE,  MEMD);
+  BUF->PSFSIG1    = (double*) realloc(BUF->PSFSIG1,    MEMD);
+  BUF->PIXSIZE    = (double*) realloc(BUF->PIXSIZE,    MEMD);
+  BUF->NEA        = (double*) realloc(BUF->NEA,        MEMD);
+  BUF->GENMAG     = (double*) realloc(BUF->GENMAG,     MEMD);
+  BUF->GENMAG_T   = (double*) realloc(BUF->GENMAG_T,   MEMD);
+  BUF->TEMPLATE_SKYSIG    = (double*) realloc(BUF->TEMPLATE_SKYSIG,   MEMD);
+  BUF->TEMPLATE_READNOISE = (double*) realloc(BUF->TEMPLATE_READNOISE,MEMD);
+  BUF->TEMPLATE_ZPT       = (double*) realloc(BUF->TEMPLATE_ZPT,      MEMD);
+
+  BUF->FLUX_SRC   = (double*) realloc(BUF->FLUX_SRC,   MEMD);
+  BUF->FLUX_TSRC  = (double*) realloc(BUF->FLUX_TSRC,  MEMD);
+  BUF->SQSIG_SKY  = (double*) realloc(BUF->SQSIG_SKY,  MEMD);
+  BUF->SQSIG_CCD  = (double*) realloc(BUF->SQSIG_CCD,  MEMD);
+  BUF->SQSIG_TSKY = (double*) realloc(BUF->SQSIG_TSKY, MEMD);
+  BUF->NADU_over_Npe    = (double*) realloc(BUF->NADU_over_Npe,    MEMD);
+  BUF->Npe_over_FLUXCAL = (double*) realloc(BUF->Npe_over_FLUXCAL, MEMD);
+
+  BUF->ERRPARLIST      = (double*) realloc(BUF->ERRPARLIST,      MEMP);
+  BUF->FLUXCALERR_IN   = (double*) realloc(BUF->FLUXCALERR_IN,   MEMD);
+  BUF->FLUXCALERR_TRUE = (double*) realloc(BUF->FLUXCALERR_TRUE, MEMD);
+  BUF->FLUXCALERR_DATA = (double*) realloc(BUF->FLUXCALERR_DATA, MEMD);
+
+  BUF->GAURAN     = (double*) realloc(BUF->GAURAN,     MEMR);
+
+  BUF->MXOBS = MXOBS ;
+
+  return ;
+
+} // end malloc_FLUXNOISE_BUF
+
+
 // *****************************************
 void gen_fluxNoise_randoms(void) {
 
@@ -26618,38 +27008,49 @@ void gen_fluxNoise_randoms(void) {
   //
   // Feb 14 2018: set GENLC.RANGauss_NOISE_ZP[ep] 
   //
+  // Oct 2026: all randoms for the event are drawn in one call
+  //   (getRan_GaussList) into FLUXNOISE_BUF.GAURAN, in the same
+  //   order as before so that random sequence is unchanged.
 
+  FLUXNOISE_BUF_DEF *BUF = &FLUXNOISE_BUF ;
+  int    NOBS = BUF->NOBS ;
   double RAN1, RAN2;
-  int ep, ifilt, ifilt_obs, ifield;
+  int o, ep, ifilt, ifilt_obs, ifield, NRAN, iran ;
   char fnam[] = "gen_fluxNoise_randoms" ;
 
   // -------------- BEGIN --------------
 
   if ( GENLC.IFLAG_GENSOURCE == IFLAG_GENGRID  ) { return ; }
 
-  // one random per epoch
-  for ( ep = 1; ep <= GENLC.NEPOCH; ep++ )  {  
+  // 2 randoms per generated epoch, then one per filter & field overlap.
+  // Un-used epochs are skipped so that randoms stay synced with
+  // previous (10_33g) snana version.
+  NRAN = 2*NOBS ;
+  for ( ifilt=0; ifilt < GENLC.NFILTDEF_SIMLIB; ifilt++ ) {
+    ifilt_obs =  GENLC.IFILTMAP_SIMLIB[ifilt] ;
+    if ( GENLC.DOFILT[ifilt_obs] ) { NRAN += MXFIELD_OVP; }
+  }
+  getRan_GaussList(1, NRAN, BUF->GAURAN);
 
-    ifilt_obs = GENLC.IFILT_OBS[ep] ;    
+  for ( ep = 1; ep <= GENLC.NEPOCH; ep++ )  {  
     GENLC.RANGauss_NOISE_SEARCH[ep] = -99999. ;  
     GENLC.RANGauss_NOISE_FUDGE[ep]  = -99999. ;  
     GENLC.RANGauss_NOISE_ZP[ep]     = -99999. ;  
+  }
 
-    // skip un-used epochs so that randoms stay synced with
-    // previous (10_33g) snana version.
-    if ( !GENLC.OBSFLAG_GEN[ep]  ) { continue ; }
-
-    // load randoms into global
-    RAN1 = getRan_Gauss(1) ;  
-    RAN2 = getRan_Gauss(1) ;  
+  // load randoms into global
+  for ( o = 0; o < NOBS; o++ ) {
+    ep   = BUF->EPOCH[o] ;
+    RAN1 = BUF->GAURAN[2*o] ;
+    RAN2 = BUF->GAURAN[2*o+1] ;
     GENLC.RANGauss_NOISE_SEARCH[ep] = RAN1;
     GENLC.RANGauss_NOISE_ZP[ep]     = RAN2; // Jan 2020; soon to be obsolete
     GENLC.RANGauss_NOISE_FUDGE[ep]  = RAN2; // for refactored GENFLUX_DRIVER
-
-  } // end ep loop
+  } 
 
 
   // one random per filter (for template noise) and field overlap
+  iran = 2*NOBS ;
   for ( ifilt=0; ifilt < GENLC.NFILTDEF_SIMLIB; ifilt++ ) {
     ifilt_obs =  GENLC.IFILTMAP_SIMLIB[ifilt] ;
 
@@ -26661,7 +27062,8 @@ void gen_fluxNoise_randoms(void) {
     if ( GENLC.DOFILT[ifilt_obs] == 0 ) { continue ; }
    
     for(ifield=0; ifield < MXFIELD_OVP; ifield++ ) {      
-      GENLC.RANGauss_NOISE_TEMPLATE[ifield][ifilt_obs] = getRan_Gauss(1) ; 
+      GENLC.RANGauss_NOISE_TEMPLATE[ifield][ifilt_obs] = BUF->GAURAN[iran];
+      iran++ ;
     } 
     
   }
@@ -26672,248 +27074,299 @@ void gen_fluxNoise_randoms(void) {
 
 
 // *************************************
-void gen_fluxNoise_calc(int epoch, int vbose, FLUXNOISE_DEF *FLUXNOISE) {
+void gen_fluxNoise_calc(int vbose) {
 
   // Created Dec 27 2019
-  // Calculate Poisson noise (ie., sigma_flux) for epoch index 'ep'
-  // and store calculated errors in FLUXNOISE struct.
+  // Calculate Poisson noise (ie., sigma_flux) for each generated
+  // epoch and store calculated errors in GENLC.FLUXNOISE[ep].
   // Units are p.e.
   // Do not include error fudges here, and do not apply errors here.
-
-  int ifilt_obs      = GENLC.IFILT_OBS[epoch] ;
-  //  int ifilt          = GENLC.IFILTINVMAP_OBS[ifilt_obs] ; // sparse index
-
-  double  mjd        = SIMLIB_OBS_GEN.MJD[epoch] ;
-  double  pixsize    = SIMLIB_OBS_GEN.PIXSIZE[epoch] ;
-  double  ccdgain    = SIMLIB_OBS_GEN.CCDGAIN[epoch] ;
-  double  skysig     = SIMLIB_OBS_GEN.SKYSIG[epoch] ;
-  double  readnoise  = SIMLIB_OBS_GEN.READNOISE[epoch] ;
-  double  psfsig1    = SIMLIB_OBS_GEN.PSFSIG1[epoch] ; // pixels
-  double  psfsig2    = SIMLIB_OBS_GEN.PSFSIG2[epoch] ;
-  double  psfratio   = SIMLIB_OBS_GEN.PSFRATIO[epoch] ;
-  double  nea        = SIMLIB_OBS_GEN.NEA[epoch] ;
-  double  zpt        = SIMLIB_OBS_GEN.ZPTADU[epoch] ;
-  double  zpterr     = SIMLIB_OBS_GEN.ZPTERR[epoch] ;
-  double  template_skysig     = SIMLIB_OBS_GEN.TEMPLATE_SKYSIG[epoch] ; 
-  double  template_readnoise  = SIMLIB_OBS_GEN.TEMPLATE_READNOISE[epoch] ; 
-  double  template_zpt        = SIMLIB_OBS_GEN.TEMPLATE_ZPT[epoch] ;
-
-  double  genmag     = GENLC.genmag_obs[epoch];
-  double  genmag_T   = GENLC.genmag_obs_template[ifilt_obs]; // for LCLIB
-
-  int    OVP, NERR=0;
-
-  double ZPTDIF_ADU, NADU_over_FLUXCAL, Npe_over_FLUXCAL, NADU_over_Npe ;
-  double sqsig_noZ, sqsig_true, sqsig_data, sqsig_mon, flux_T, arg;
-  double fluxsn_adu, fluxsn_pe, fluxmon_pe=0.0 ;
-  double area_bg, psfsig_arcsec ;
-  double sqerr_ccd_pe, skysig_tmp_pe, sqerr_sky_pe, sqerr_zp_pe;
-  double fluxgal_pe, galmag=0.0 ;
-  double template_sqerr_sky_pe, template_sqerr_ccd_pe, template_sqerr_pe;
-  double SNR_CALC_S, SNR_CALC_ST, SNR_CALC_SZT, SQSIG_CALC, SNR_MON ;
-  char band[2];
+  //
+  // Oct 2026: loop over epochs in FLUXNOISE_BUF; zero-point, source,
+  //   sky and template noise are computed as loops over arrays.
+
+  FLUXNOISE_BUF_DEF *BUF = &FLUXNOISE_BUF ;
+  int    NOBS = BUF->NOBS ;
+  int    o, ep, ifilt_obs, OVP, NERR ;
+
+  double zpt, ccdgain, nea, NADU_over_FLUXCAL, arg ;
+  double sqsig_noZ, sqsig_true, sqsig_data, sqsig_mon, flux_T ;
+  double fluxsn_pe, fluxmon_pe=0.0 ;
+  double psfsig_arcsec, skysig_pe, sqerr_sky_pe, sqerr_ccd_pe, sqerr_zp_pe;
+  double fluxgal_pe, galmag ;
+  double template_sqerr_pe, template_zpt, zfac ;
+  double SNR_CALC_S, SNR_CALC_ST, SNR_CALC_SZT, SNR_MON ;
+  FLUXNOISE_DEF *FLUXNOISE ;
   char fnam[] = "gen_fluxNoise_calc" ;
 
   // ------------- begin ---------------
 
   if ( GENLC.IFLAG_GENSOURCE == IFLAG_GENGRID  ) { return ; }
 
-  sprintf(band, "%c", FILTERSTRING[ifilt_obs] );
-
-  NERR=0;
-  if ( zpt     < 10.0   ) { NERR++ ; }
-  if ( psfsig1 < 0.0001 ) { NERR++ ; }
-  if ( skysig  < 0.0001 ) { NERR++ ; } 
-  if ( NERR > 0 ) {
-    sprintf(c1err,"%d invalid observing conditions for ep=%d, band=%s",
-	    NERR, epoch, band);
-    sprintf(c2err,"mjd=%.3f zpt=%.2f, psf=%.3f, skysig=%.2f", 
-	    mjd, zpt, psfsig1, skysig);
-    errmsg(SEV_FATAL, 0, fnam, c1err, c2err ); 
-  }
-
-  // compute zp in photo-electrons 
-  ZPTDIF_ADU        = zpt - ZEROPOINT_FLUXCAL_DEFAULT ;
-  NADU_over_FLUXCAL = pow( TEN , 0.4*ZPTDIF_ADU) ;
-  Npe_over_FLUXCAL  = NADU_over_FLUXCAL * ccdgain;
-  NADU_over_Npe     = NADU_over_FLUXCAL/Npe_over_FLUXCAL ;  
-
-  flux_T   = 0.0 ;
-  if ( genmag_T < 90.0 ) {
-    arg     = 0.4 * ( zpt - genmag_T );
-    flux_T  = pow(10.0,arg) / NADU_over_Npe ; 
+  // check observing conditions
+  for ( o = 0; o < NOBS; o++ ) {
+    NERR=0;
+    if ( BUF->ZPT[o]     < 10.0   ) { NERR++ ; }
+    if ( BUF->PSFSIG1[o] < 0.0001 ) { NERR++ ; }
+    if ( BUF->SKYSIG[o]  < 0.0001 ) { NERR++ ; } 
+    if ( NERR > 0 ) {
+      sprintf(c1err,"%d invalid observing conditions for ep=%d, band=%c",
+	      NERR, BUF->EPOCH[o], FILTERSTRING[BUF->IFILT_OBS[o]] );
+      sprintf(c2err,"mjd=%.3f zpt=%.2f, psf=%.3f, skysig=%.2f", 
+	      BUF->MJD[o], BUF->ZPT[o], BUF->PSFSIG1[o], BUF->SKYSIG[o]);
+      errmsg(SEV_FATAL, 0, fnam, c1err, c2err ); 
+    }
   }
 
+  // compute zp in photo-electrons, source flux and search-run 
+  // sky & CCD noise integrated over effective aperture (NEA)
+  for ( o = 0; o < NOBS; o++ ) {
+    zpt      = BUF->ZPT[o] ;
+    ccdgain  = BUF->CCDGAIN[o] ;
+    nea      = BUF->NEA[o] ;
 
-  // use search-run zero-point to convert mag -> flux.
-  arg           = 0.4 * ( zpt - genmag );
-  fluxsn_adu    = pow(10.0,arg);         // flux in ADUs
-  fluxsn_pe     = fluxsn_adu * ccdgain ; // flux in pe
-  
-  // compute optional signal for monitor mag
-  if ( INPUTS.MAGMONITOR_SNR > 10 ) {
-    double magmon = (double)INPUTS.MAGMONITOR_SNR ;
-    arg           = 0.4 * ( zpt - magmon );
-    fluxmon_pe    = ccdgain * pow(10.0,arg); 
-  }
+    NADU_over_FLUXCAL        = pow( TEN , 0.4*(zpt-ZEROPOINT_FLUXCAL_DEFAULT));
+    BUF->Npe_over_FLUXCAL[o] = NADU_over_FLUXCAL * ccdgain;
+    BUF->NADU_over_Npe[o]    = NADU_over_FLUXCAL/BUF->Npe_over_FLUXCAL[o] ;
 
-  // get effective aperture  area (pixels)
-  area_bg       = nea; // Feb 28 2021
-  psfsig_arcsec = pixsize * sqrt(area_bg/(2.0*TWOPI))  ; 
+    // use search-run zero-point to convert mag -> flux.
+    BUF->FLUX_SRC[o] = pow(10.0, 0.4*(zpt - BUF->GENMAG[o])) * ccdgain ;
 
-  // get total sky noise for search run; includes sky & CCD noise
-  skysig_tmp_pe = skysig * ccdgain ;  // convert ADU -> pe per pixel
-  sqerr_sky_pe = area_bg * (skysig_tmp_pe*skysig_tmp_pe);
-  sqerr_ccd_pe = area_bg * (readnoise*readnoise) ;  // in Npe
+    skysig_pe        = BUF->SKYSIG[o] * ccdgain ; // ADU -> pe per pixel
+    BUF->SQSIG_SKY[o] = nea * (skysig_pe*skysig_pe);
+    BUF->SQSIG_CCD[o] = nea * (BUF->READNOISE[o]*BUF->READNOISE[o]) ;
 
-  // non-linearity ??
+    flux_T   = 0.0 ;
+    if ( BUF->GENMAG_T[o] < 90.0 ) {
+      arg     = 0.4 * ( zpt - BUF->GENMAG_T[o] );
+      flux_T  = pow(10.0,arg) / BUF->NADU_over_Npe[o] ; 
+    }
+    BUF->FLUX_TSRC[o] = flux_T ;
+  }
 
   // add sky-noise from template, integrated over effective aperture 
-  template_sqerr_sky_pe = template_sqerr_ccd_pe = 0.0 ;
-  template_sqerr_pe = 0.0 ;
-
-  if ( SIMLIB_TEMPLATE.USEFLAG && template_skysig > 0.0 ) {
+  for ( o = 0; o < NOBS; o++ ) {
+    BUF->SQSIG_TSKY[o] = 0.0 ;
+    if ( !SIMLIB_TEMPLATE.USEFLAG || BUF->TEMPLATE_SKYSIG[o] <= 0.0 ) 
+      { continue ; }
 
+    zpt          = BUF->ZPT[o] ;
+    template_zpt = BUF->TEMPLATE_ZPT[o] ;
     if ( template_zpt < 10.0 ) {
       sprintf(c1err,"Invalid template_zpt(%c)=%f for  LIBID=%d at MJD=%.3f", 
-	      FILTERSTRING[ifilt_obs], template_zpt, GENLC.SIMLIB_ID, mjd );
+	      FILTERSTRING[BUF->IFILT_OBS[o]], template_zpt, 
+	      GENLC.SIMLIB_ID, BUF->MJD[o] );
       sprintf(c2err,"Need TEMPLATE_ZPT to scale template noise.");
       errmsg(SEV_FATAL, 0, fnam, c1err, c2err) ; 
     }
 
-    skysig_tmp_pe = template_skysig * ccdgain ;  // convert sigma in ADU -> pe.
-    template_sqerr_sky_pe = area_bg * (skysig_tmp_pe*skysig_tmp_pe) ;
-    template_sqerr_ccd_pe = area_bg * (template_readnoise*template_readnoise);
+    ccdgain      = BUF->CCDGAIN[o] ;
+    nea          = BUF->NEA[o] ;
+    skysig_pe    = BUF->TEMPLATE_SKYSIG[o] * ccdgain ;  // ADU -> pe.
+    sqerr_sky_pe = nea * (skysig_pe*skysig_pe) ;
+    sqerr_ccd_pe = nea * (BUF->TEMPLATE_READNOISE[o] *
+			  BUF->TEMPLATE_READNOISE[o]) ;
 
     // scale template noise to the search image
-    double zparg, zfac;
-    zparg = 0.8*(zpt - template_zpt); // Feb 2 2017 bug fix
-    zfac  = pow(TEN, zparg);
-    template_sqerr_sky_pe *= zfac ;
-    template_sqerr_ccd_pe *= zfac ;
-    template_sqerr_pe = template_sqerr_sky_pe + template_sqerr_ccd_pe ;
-
-  }
-
-  // -------------------------------------------
-  // galaxy noise from photo-stats
-  fluxgal_pe = 0.0;
-  OVP = INPUTS.SMEARFLAG_HOSTGAL & SMEARMASK_HOSTGAL_PHOT ;
-  if ( OVP > 0 ) {
-    // get galmag over NEA
-    galmag        = interp_GALMAG_HOSTLIB(ifilt_obs, psfsig_arcsec );
-    arg           = 0.4 * ( zpt - galmag );
-    fluxgal_pe    = ccdgain * pow(10.0,arg);   // effec-aper flux in pe.
+    zfac = pow(TEN, 0.8*(zpt - template_zpt)); // Feb 2 2017 bug fix
+    sqerr_sky_pe *= zfac ;
+    sqerr_ccd_pe *= zfac ;
+    BUF->SQSIG_TSKY[o] = sqerr_sky_pe + sqerr_ccd_pe ;
   }
 
+  // - - - - - - - - - - - - - - -   
+  // host-galaxy noise, optional ZP smearing, and sum in quadrature
+  for ( o = 0; o < NOBS; o++ ) {
+
+    ep        = BUF->EPOCH[o] ;
+    ifilt_obs = BUF->IFILT_OBS[o] ;
+    zpt       = BUF->ZPT[o] ;
+    ccdgain   = BUF->CCDGAIN[o] ;
+    nea       = BUF->NEA[o] ;
+    fluxsn_pe = BUF->FLUX_SRC[o] ;
+    flux_T    = BUF->FLUX_TSRC[o] ;
+    sqerr_sky_pe      = BUF->SQSIG_SKY[o] ;
+    sqerr_ccd_pe      = BUF->SQSIG_CCD[o] ;
+    template_sqerr_pe = BUF->SQSIG_TSKY[o] ;
+    FLUXNOISE         = &GENLC.FLUXNOISE[ep] ;
+
+    // compute optional signal for monitor mag
+    if ( INPUTS.MAGMONITOR_SNR > 10 ) {
+      double magmon = (double)INPUTS.MAGMONITOR_SNR ;
+      arg           = 0.4 * ( zpt - magmon );
+      fluxmon_pe    = ccdgain * pow(10.0,arg); 
+    }
+
+    // galaxy noise from photo-stats
+    psfsig_arcsec = BUF->PIXSIZE[o] * sqrt(nea/(2.0*TWOPI))  ; 
+    fluxgal_pe = galmag = 0.0;
+    OVP = INPUTS.SMEARFLAG_HOSTGAL & SMEARMASK_HOSTGAL_PHOT ;
+    if ( OVP > 0 ) {
+      // get galmag over NEA
+      galmag        = interp_GALMAG_HOSTLIB(ifilt_obs, psfsig_arcsec );
+      arg           = 0.4 * ( zpt - galmag );
+      fluxgal_pe    = ccdgain * pow(10.0,arg);   // effec-aper flux in pe.
+    }
+
+    // check option ZP smearing 
+    sqerr_zp_pe = 0.0 ;
+    if ( INPUTS.SMEARFLAG_ZEROPT > 0 ) {
+      double relerr, err;
+      relerr  = pow(TEN, 0.4*BUF->ZPTERR[o]) - 1.0 ;
+      err     = (fluxsn_pe-flux_T) * relerr ;    
+      sqerr_zp_pe = err*err;
+    }
+
+    // add up SN flux error (photo-electrons^2) in quadrature
+    // Do not include ZPerr nor correlated template noise here.
+    sqsig_noZ
+      = fluxsn_pe        // signal stat-error
+      + fluxgal_pe       // square of host galaxy stat-error
+      + sqerr_sky_pe     // sky-err from search run
+      + sqerr_ccd_pe     // CCD read noise (added Dec 13, 2010)
+      ;
 
-  // check option ZP smearing 
-  sqerr_zp_pe = 0.0 ;
-  if ( INPUTS.SMEARFLAG_ZEROPT > 0 ) {
-    double relerr, err;
-    relerr  = pow(TEN, 0.4*zpterr) - 1.0 ;
-    err     = (fluxsn_pe-flux_T) * relerr ;    
-    sqerr_zp_pe = err*err;
-  }
+    if ( INPUTS.SIMGEN_DUMP_NOISE ) {
+      double xep = (double)ep ;
+      double noise_par_list[6] =
+	{ xep, fluxsn_pe, fluxgal_pe, sqerr_sky_pe, sqerr_ccd_pe, nea  } ;
+      wr_SIMGEN_DUMP_NOISE(FLAG_PROCESS_UPDATE, &GENLC.SIMFILE_AUX, 
+			   noise_par_list) ;
+    }
 
-  // --------------------
-  // add up SN flux error (photo-electrons^2) in quadrature
-  // Do not include ZPerr nor correlated template noise here.
-  sqsig_noZ
-    = fluxsn_pe        // signal stat-error
-    + fluxgal_pe       // square of host galaxy stat-error
-    + sqerr_sky_pe     // sky-err from search run
-    + sqerr_ccd_pe     // CCD read noise (added Dec 13, 2010)
-    ;
+    sqsig_true = sqsig_noZ ;
+    sqsig_data = sqsig_noZ ;
 
+    // Check options to include ZPerr in true and reported flux-error.
+    // Note that correlated template noise is not included here.
+    if ( (INPUTS.SMEARFLAG_ZEROPT & 1) > 0 ) 
+      { sqsig_true += sqerr_zp_pe; }
   
-  if ( INPUTS.SIMGEN_DUMP_NOISE ) {
-    double xep = (double)epoch ;
-    double noise_par_list[6] =
-      { xep, fluxsn_pe, fluxgal_pe, sqerr_sky_pe, sqerr_ccd_pe, nea  } ;
-    wr_SIMGEN_DUMP_NOISE(FLAG_PROCESS_UPDATE, &GENLC.SIMFILE_AUX, noise_par_list) ;
-  }
+    if ( (INPUTS.SMEARFLAG_ZEROPT & 2) > 0 ) 
+      { sqsig_data += sqerr_zp_pe; }  // reported error includes zperr
 
-  
-  sqsig_true = sqsig_noZ ;
-  sqsig_data = sqsig_noZ ;
+    SNR_MON = 0.0 ;
+    if ( INPUTS.MAGMONITOR_SNR > 10 ) {
+      sqsig_mon = (sqsig_data - fluxsn_pe + fluxmon_pe + template_sqerr_pe);
+      SNR_MON = fluxmon_pe / sqrt(sqsig_mon);
+    }
 
-  // Check options to include ZPerr in true and reported flux-error.
-  // Note that correlated template noise is not included here.
+    // calculated ERROR and SNR are for error fudges 
+    SNR_CALC_SZT  = fluxsn_pe / sqrt(sqsig_data + template_sqerr_pe);
+    SNR_CALC_ST   = fluxsn_pe / sqrt(sqsig_noZ  + template_sqerr_pe);
+    SNR_CALC_S    = fluxsn_pe / sqrt(sqsig_noZ); 
 
-  
-  if ( (INPUTS.SMEARFLAG_ZEROPT & 1) > 0 ) 
-    { sqsig_true += sqerr_zp_pe; }
-  
-  
-  if ( (INPUTS.SMEARFLAG_ZEROPT & 2) > 0 ) 
-    { sqsig_data += sqerr_zp_pe; }  // reported error includes zperr
-  
+    // - - - - - - - - - - - - - - -   
+    // load info in output structure
 
-  SNR_MON = 0.0 ;
-  if ( INPUTS.MAGMONITOR_SNR > 10 ) {
-    sqsig_mon = (sqsig_data - fluxsn_pe + fluxmon_pe + template_sqerr_pe);
-    SNR_MON = fluxmon_pe / sqrt(sqsig_mon);
-  }
+    FLUXNOISE->SQSIG_SRC       = fluxsn_pe ; // image source noise
+    FLUXNOISE->SQSIG_TSRC      = flux_T ;    // template source noise (LCLIB)
+    FLUXNOISE->SQSIG_SKY       = sqerr_sky_pe + sqerr_ccd_pe ;
+    FLUXNOISE->SQSIG_TSKY      = template_sqerr_pe ; // template sky noise
+    FLUXNOISE->SQSIG_ZP        = sqerr_zp_pe;  
+    FLUXNOISE->SQSIG_HOST_PHOT = fluxgal_pe ;
 
-  // calculated ERROR and SNR are for error fudges 
-  SQSIG_CALC    = sqsig_data + template_sqerr_pe ;
-  SNR_CALC_SZT  = fluxsn_pe / sqrt(sqsig_data + template_sqerr_pe);
-  SNR_CALC_ST   = fluxsn_pe / sqrt(sqsig_noZ  + template_sqerr_pe);
-  SNR_CALC_S    = fluxsn_pe / sqrt(sqsig_noZ); 
+    FLUXNOISE->SQSIG_CALC_TRUE[TYPE_FLUXNOISE_S]    = sqsig_noZ ;
+    FLUXNOISE->SQSIG_CALC_TRUE[TYPE_FLUXNOISE_SZ]   = sqsig_true ;
+    FLUXNOISE->SQSIG_CALC_TRUE[TYPE_FLUXNOISE_T]    = template_sqerr_pe;
+    FLUXNOISE->SQSIG_CALC_TRUE[TYPE_FLUXNOISE_Z]    = sqerr_zp_pe;
+    FLUXNOISE->SQSIG_CALC_TRUE[TYPE_FLUXNOISE_F]    = 0.0 ;
 
-  // - - - - - - - - - - - - - - -   
-  // load info in output structure
+    FLUXNOISE->SQSIG_CALC_TRUE[TYPE_FLUXNOISE_SUM]  = 
+      FLUXNOISE->SQSIG_CALC_TRUE[TYPE_FLUXNOISE_SZ] +
+      FLUXNOISE->SQSIG_CALC_TRUE[TYPE_FLUXNOISE_T]  ;
 
-  FLUXNOISE->SQSIG_SRC       = fluxsn_pe ; // image source noise
-  FLUXNOISE->SQSIG_TSRC      = flux_T ;    // template source noise (LCLIB)
-  FLUXNOISE->SQSIG_SKY       = sqerr_sky_pe + sqerr_ccd_pe ;
-  FLUXNOISE->SQSIG_TSKY      = template_sqerr_pe ; // template sky noise
-  FLUXNOISE->SQSIG_ZP        = sqerr_zp_pe;  
-  FLUXNOISE->SQSIG_HOST_PHOT = fluxgal_pe ;
+    int itype;
+    for(itype=0; itype < NTYPE_FLUXNOISE ; itype++ )  { 
+      FLUXNOISE->SQSIG_FUDGE_TRUE[itype] = 0.0 ;
+      FLUXNOISE->SQSIG_FINAL_TRUE[itype] = FLUXNOISE->SQSIG_CALC_TRUE[itype]; 
+    }
 
-  FLUXNOISE->SQSIG_CALC_TRUE[TYPE_FLUXNOISE_S]    = sqsig_noZ ;
-  FLUXNOISE->SQSIG_CALC_TRUE[TYPE_FLUXNOISE_SZ]   = sqsig_true ;
-  FLUXNOISE->SQSIG_CALC_TRUE[TYPE_FLUXNOISE_T]    = template_sqerr_pe;
-  FLUXNOISE->SQSIG_CALC_TRUE[TYPE_FLUXNOISE_Z]    = sqerr_zp_pe;
-  FLUXNOISE->SQSIG_CALC_TRUE[TYPE_FLUXNOISE_F]    = 0.0 ;
+    FLUXNOISE->SQSIG_CALC_DATA   = sqsig_data + template_sqerr_pe;
+    FLUXNOISE->SQSIG_FUDGE_DATA  = 0.0 ;
+    FLUXNOISE->SQSIG_FINAL_DATA  = sqsig_data + template_sqerr_pe;
 
+    FLUXNOISE->SNR_CALC_S          = SNR_CALC_S ;
+    FLUXNOISE->SNR_CALC_ST         = SNR_CALC_ST ;
+    FLUXNOISE->SNR_CALC_SZT        = SNR_CALC_SZT ;
 
-  FLUXNOISE->SQSIG_CALC_TRUE[TYPE_FLUXNOISE_SUM]  = 
-    FLUXNOISE->SQSIG_CALC_TRUE[TYPE_FLUXNOISE_SZ] +
-    FLUXNOISE->SQSIG_CALC_TRUE[TYPE_FLUXNOISE_T]  ;
+    FLUXNOISE->SNR_CALC_MON        = SNR_MON  ;
+    FLUXNOISE->SNR_FINAL_MON       = SNR_MON  ;
 
-  int itype;
-  for(itype=0; itype < NTYPE_FLUXNOISE ; itype++ )  { 
-    FLUXNOISE->SQSIG_FUDGE_TRUE[itype] = 0.0 ;
-    FLUXNOISE->SQSIG_FINAL_TRUE[itype] = FLUXNOISE->SQSIG_CALC_TRUE[itype]; 
-  }
+    FLUXNOISE->NEA                 = nea ;
+    FLUXNOISE->GALMAG_NEA          = galmag ;
+    FLUXNOISE->Npe_over_FLUXCAL    = BUF->Npe_over_FLUXCAL[o] ;
+    FLUXNOISE->NADU_over_Npe       = BUF->NADU_over_Npe[o] ;
+    FLUXNOISE->INDEX_REDCOV        = -9 ;
+
+    FLUXNOISE->IFILT_OBS = ifilt_obs;
+    sprintf(FLUXNOISE->BAND, "%c", FILTERSTRING[ifilt_obs] );
+
+  } // end o loop
 
-  FLUXNOISE->SQSIG_CALC_DATA   = sqsig_data + template_sqerr_pe;
-  FLUXNOISE->SQSIG_FUDGE_DATA  = 0.0 ;
-  FLUXNOISE->SQSIG_FINAL_DATA  = sqsig_data + template_sqerr_pe;
+  return;
 
-  FLUXNOISE->SNR_CALC_S          = SNR_CALC_S ;
-  FLUXNOISE->SNR_CALC_ST         = SNR_CALC_ST ;
-  FLUXNOISE->SNR_CALC_SZT        = SNR_CALC_SZT ;
+} // end gen_fluxNoise_calc
 
-  FLUXNOISE->SNR_CALC_MON        = SNR_MON  ;
-  FLUXNOISE->SNR_FINAL_MON       = SNR_MON  ;
 
-  FLUXNOISE->NEA                 = area_bg ;
-  FLUXNOISE->GALMAG_NEA          = galmag ;
-  FLUXNOISE->Npe_over_FLUXCAL    = Npe_over_FLUXCAL;
-  FLUXNOISE->NADU_over_Npe       = NADU_over_Npe ;
+// ********************************************************
+void gen_fluxNoise_FLUXERRMAP(void) {
+
+  // Created Oct 2026
+  // Evaluate FLUXERRMODEL maps for all generated epochs in one call
+  // to get_FLUXERRMODEL_BATCH, using map index from load_FLUXNOISE_BUF.
+  // Map inputs depend only on gen_fluxNoise_calc, and outputs
+  // FLUXNOISE_BUF.FLUXCALERR_[TRUE,DATA] are used in 
+  // gen_fluxNoise_fudge_diag. [code moved from gen_fluxNoise_fudge_diag]
+
+  FLUXNOISE_BUF_DEF *BUF = &FLUXNOISE_BUF ;
+  int    NOBS = BUF->NOBS ;
+  int    NPAR = NPAR_FLUXERRMAP_REQUIRE ;
+  int    o, ep, ifilt_obs ;
+  double *ERRPARLIST, LOGSNR, SBmag, SIG_CALC ;
+  FLUXNOISE_DEF *FLUXNOISE ;
 
-  FLUXNOISE->IFILT_OBS = ifilt_obs;
-  sprintf(FLUXNOISE->BAND,"%s",band);
+  // ------------ BEGIN ----------
 
-  return;
+  if ( NMAP_FLUXERRMODEL == 0 ) { return ; }
 
-} // end gen_fluxNoise_calc
+  for ( o = 0; o < NOBS; o++ ) {
+    ep         = BUF->EPOCH[o] ;
+    ifilt_obs  = BUF->IFILT_OBS[o] ;
+    FLUXNOISE  = &GENLC.FLUXNOISE[ep] ;
+    ERRPARLIST = &BUF->ERRPARLIST[o*NPAR] ;
+
+    SBmag = SNHOSTGAL.SB_MAG[ifilt_obs];
+    if ( SBmag > 32.0 ) { SBmag = 32.0; }    // to limit fluxerrmap size
+
+    LOGSNR = log10(FLUXNOISE->SNR_CALC_SZT); 
+    if ( LOGSNR < -0.9 ) { LOGSNR = -0.9 ; }
+
+    ERRPARLIST[IPAR_FLUXERRMAP_MJD]    = BUF->MJD[o];
+    ERRPARLIST[IPAR_FLUXERRMAP_PSF]    = 
+      (BUF->PSFSIG1[o]/BUF->PIXSIZE[o])*2.3548; // sigma(pix)->FWHM(arcsec)
+    ERRPARLIST[IPAR_FLUXERRMAP_SKYSIG] = BUF->SKYSIG[o];  // ADU/pixel
+    ERRPARLIST[IPAR_FLUXERRMAP_ZP]     = BUF->ZPT[o];     // observed ZP, ADU
+    ERRPARLIST[IPAR_FLUXERRMAP_LOGSNR] = LOGSNR ;
+    ERRPARLIST[IPAR_FLUXERRMAP_SBMAG]  = SBmag ;
+    ERRPARLIST[IPAR_FLUXERRMAP_GALMAG] = FLUXNOISE->GALMAG_NEA ;
+    ERRPARLIST[IPAR_FLUXERRMAP_SNSEP]  = SNHOSTGAL.SNSEP ;
+
+    // pass FLUXCAL units to fluxErrModel in case of additive term.
+    SIG_CALC              = sqrt(FLUXNOISE->SQSIG_CALC_DATA);
+    BUF->FLUXCALERR_IN[o] = SIG_CALC/FLUXNOISE->Npe_over_FLUXCAL ;
+  }
+
+  get_FLUXERRMODEL_BATCH(NOBS, BUF->IMAP_FLUXERRMAP, BUF->FLUXCALERR_IN,
+			 NPAR, BUF->ERRPARLIST,                // (I)
+			 BUF->FLUXCALERR_TRUE, BUF->FLUXCALERR_DATA); // (O)
+
+  return ;
+
+} // end gen_fluxNoise_FLUXERRMAP
 
 // ********************************************************
-void  gen_fluxNoise_fudge_diag(int epoch, int VBOSE, FLUXNOISE_DEF *FLUXNOISE){
+void  gen_fluxNoise_fudge_diag(int o, int VBOSE) {
 
   // Created Dec 27, 2019
   // Compute diagonal error fudges, if specified 
@@ -26924,15 +27377,20 @@ void  gen_fluxNoise_fudge_diag(int epoch, int VBOSE, FLUXNOISE_DEF *FLUXNOISE){
   //  it was using undefined SQSCALE.
   //
   // Apr 14 2021: abort of SQSIG_F<0 (happens if err scale < 1)
+  //
+  // Oct 2026: pass index o of FLUXNOISE_BUF; FLUXERRMAP values are
+  //    evaluated for all epochs in gen_fluxNoise_FLUXERRMAP.
 
-  int    ifilt_obs  = GENLC.IFILT_OBS[epoch] ;
+  FLUXNOISE_BUF_DEF *BUF = &FLUXNOISE_BUF ;
+  int    epoch      = BUF->EPOCH[o] ;
+  FLUXNOISE_DEF *FLUXNOISE = &GENLC.FLUXNOISE[epoch] ;
+  int    ifilt_obs  = BUF->IFILT_OBS[o] ;
   char   *FIELD     = GENLC.FIELDNAME[epoch] ;
 
-  double  MJD       = SIMLIB_OBS_GEN.MJD[epoch] ;
-  double  SKYSIG    = SIMLIB_OBS_GEN.SKYSIG[epoch] ;
-  double  PSFSIG1   = SIMLIB_OBS_GEN.PSFSIG1[epoch] ; // pixels
-  double  ZPADU     = SIMLIB_OBS_GEN.ZPTADU[epoch] ;
-  double  PIXSIZE   = SIMLIB_OBS_GEN.PIXSIZE[epoch];
+  double  MJD       = BUF->MJD[o] ;
+  double  SKYSIG    = BUF->SKYSIG[o] ;
+  double  PSFSIG1   = BUF->PSFSIG1[o] ; // pixels
+  double  ZPADU     = BUF->ZPT[o] ;
 
   long long GALID           = SNHOSTGAL.GALID ;
   double SBmag              = SNHOSTGAL.SB_MAG[ifilt_obs];
@@ -26941,9 +27399,6 @@ void  gen_fluxNoise_fudge_diag(int epoch, int VBOSE, FLUXNOISE_DEF *FLUXNOISE){
   double Npe_over_FLUXCAL   = FLUXNOISE->Npe_over_FLUXCAL;
   double NEA                = FLUXNOISE->NEA;
   
-  double SQSIG_CALC         = FLUXNOISE->SQSIG_CALC_DATA;
-  double SIG_CALC           = sqrt(SQSIG_CALC);
-  double SNR_CALC_SZT       = FLUXNOISE->SNR_CALC_SZT ;
   double SNR_CALC_ST        = FLUXNOISE->SNR_CALC_ST ;
   //  double SNR_CALC_S         = FLUXNOISE->SNR_CALC_S ;
 
@@ -27001,29 +27456,11 @@ void  gen_fluxNoise_fudge_diag(int epoch, int VBOSE, FLUXNOISE_DEF *FLUXNOISE){
  
   // Feb 2018: fudge error from FLUXERRMODEL. Should replace _legacy codes.
   if ( NMAP_FLUXERRMODEL > 0 ) {
-    double ERRPARLIST[MXPAR_FLUXERRMAP];
-    double LOGSNR = log10(SNR_CALC_SZT); 
-    double PSF_FWHM = (PSFSIG1/PIXSIZE)*2.3548; // sigma(pix) -> FWHM(arcsec)
-    int OPT = 0;
-    if ( LOGSNR < -0.9 ) { LOGSNR = -0.9 ; }
-    ERRPARLIST[IPAR_FLUXERRMAP_MJD]    = MJD;
-    ERRPARLIST[IPAR_FLUXERRMAP_PSF]    = PSF_FWHM;  // FWHM, arcsec
-    ERRPARLIST[IPAR_FLUXERRMAP_SKYSIG] = SKYSIG;    // ADU/pixel
-    ERRPARLIST[IPAR_FLUXERRMAP_ZP]     = ZPADU;     // observed ZP, ADU
-    ERRPARLIST[IPAR_FLUXERRMAP_LOGSNR] = LOGSNR ;
-    ERRPARLIST[IPAR_FLUXERRMAP_SBMAG]  = SBmag ;
-    ERRPARLIST[IPAR_FLUXERRMAP_GALMAG] = GALMAG_NEA ;
-    ERRPARLIST[IPAR_FLUXERRMAP_SNSEP]  = SNSEP ;
-    
-    // pass FLUXCAL units to fluxErrModel in case of additive term.
-    double FLUXCALERR_in  = SIG_CALC/Npe_over_FLUXCAL ;
-    double FLUXCALERR_TRUE;  // generated error
-    double FLUXCALERR_DATA ; // reported error in data file
+    // map values from gen_fluxNoise_FLUXERRMAP
+    double FLUXCALERR_in   = BUF->FLUXCALERR_IN[o] ;
+    double FLUXCALERR_TRUE = BUF->FLUXCALERR_TRUE[o];  // generated error
+    double FLUXCALERR_DATA = BUF->FLUXCALERR_DATA[o];  // reported error
 
-    get_FLUXERRMODEL(OPT, FLUXCALERR_in, BAND, FIELD,      // (I)
-		     NPAR_FLUXERRMAP_REQUIRE, ERRPARLIST,  // (I)
-		     &FLUXCALERR_TRUE, &FLUXCALERR_DATA) ; // (O)
-    
     SCALE   = FLUXCALERR_TRUE/FLUXCALERR_in ; 
     if ( SCALE == 1.00 ) 
       { SCALE = 1.001; } // avoid error "matrix not pos def" (Nov 2022)
@@ -27055,7 +27492,7 @@ void  gen_fluxNoise_fudge_diag(int epoch, int VBOSE, FLUXNOISE_DEF *FLUXNOISE){
     // keep track of NOBS per covariance matrix
     FLUXNOISE->INDEX_REDCOV = -9 ;
     if ( NREDCOV_FLUXERRMODEL > 0 ) {
-      ICOV = INDEX_REDCOV_FLUXERRMODEL(BAND,FIELD,2,fnam);      
+      ICOV = BUF->INDEX_REDCOV[o] ;  // from load_FLUXNOISE_BUF
       COVINFO_FLUXERRMODEL[ICOV].NOBS++ ;
       FLUXNOISE->INDEX_REDCOV = ICOV;
     }
@@ -27236,18 +27673,20 @@ void gen_fluxNoise_fudge_cov(int icov) {
   // GENLC.NEPOCH total epochs, so watch indices.
   //
   // Sep 3 2023: make sparse list of epochs for speed.
+  // Oct 2026: 
+  //   Replace per-event Cholesky decomp of NOBS x NOBS matrix with
+  //   cached analytic factor for each REDCOV (get_GAURANCORR_REDCOV).
+  //   Since COV = sqrt(SQSIG_F[i]*SQSIG_F[j])*REDCOV, the SIG_F factor
+  //   cancels in GAURAN_NEW and only the REDCOV structure matters.
+  //   CPU is O(NOBS) instead of O(NOBS^3).
 
   int  NOBS = COVINFO_FLUXERRMODEL[icov].NOBS ;
   int  MEMD0 = NOBS*sizeof(double);
-  int  MEMD1 = NOBS*sizeof(double*);
   int  NEPOCH  = GENLC.NEPOCH ;
-  int  TYPE_F  = TYPE_FLUXNOISE_F ;  // fudge noise
 
-  int  ep, iep0, iep1, indx_1D, IFILT_OBS, INDEX_REDCOV, NEPOCH_USE=0 ;
-  int  obs0, obs1, o, *epMAP;
-  double *covFlux_1D, **covCholesky_2D ;
-  double SQSIG_FUDGE[2] ;
-  double SIGxSIG, REDCOV, COV, SNR ;
+  int  ep, iep0, IFILT_OBS, INDEX_REDCOV, NEPOCH_USE=0 ;
+  int  o, *epMAP;
+  double SNR ;
   int LDMP = 0 ; 
   char fnam[] = "gen_fluxNoise_fudge_cov" ;
 
@@ -27285,104 +27724,34 @@ void gen_fluxNoise_fudge_cov(int icov) {
 
   if ( NOBS == 0 ) { free(epMAP); return; } // avoid crash on zero-size matrix below
 
-  /* xxx
-  if ( SIMLIB_HEADER.LIBID == 1273 ) {
-    printf(" xxx %s: NEP_USE=%d for LIBID=%d \n",
-	   fnam, NEPOCH_USE, SIMLIB_HEADER.LIBID ); fflush(stdout);
-  }
-  */
-
-  covFlux_1D     = (double*) malloc (NOBS*NOBS * sizeof(double) ) ;
-  covCholesky_2D = (double**)malloc(MEMD1) ;
-  for(o=0; o < NOBS; o++ ) { covCholesky_2D[o] = (double*) malloc(MEMD0); }
-
-  // - - - - - - 
-  for(obs0=0; obs0 < NOBS; obs0++ ) {
-
-    iep0 = epMAP[obs0] ; // iep0 is original GENLC epoch index
-
-    for(obs1=0; obs1 <= obs0; obs1++ ) {
-
-      iep1 = epMAP[obs1];
-
-      REDCOV  = COVINFO_FLUXERRMODEL[icov].REDCOV;
-      if ( obs0 == obs1 ) { REDCOV = 1.0 ; }
-
-      SQSIG_FUDGE[0] = GENLC.FLUXNOISE[iep0].SQSIG_FINAL_TRUE[TYPE_F];
-      SQSIG_FUDGE[1] = GENLC.FLUXNOISE[iep1].SQSIG_FINAL_TRUE[TYPE_F];
-      SIGxSIG  = sqrt(SQSIG_FUDGE[0] * SQSIG_FUDGE[1]) ;
-      COV      = SIGxSIG * REDCOV ;
-            
-      indx_1D = obs1*NOBS + obs0 ;
-      covFlux_1D[indx_1D] = COV;
-
-      indx_1D = obs0*NOBS + obs1 ;
-      covFlux_1D[indx_1D] = COV;
-
-      if ( LDMP ) {
-	printf(" xxx iep[0,1]=%2d,%2d  obs[0,1]=%2d,%2d  indx_1D=%3d  "
-	       "COV=%.1f\n",
-	       iep0, iep1, obs0, obs1, indx_1D, COV); fflush(stdout);
-	fflush(stdout);
-      }
-
-
-    }  // end obs1
-  }  // end obs0
-
-
-  if(LDMP) { dumpCovMat_fluxNoise(icov, NOBS, covFlux_1D); }
-
   // - - - - - - - - - - - - - - - - - - - - -
-  // do Cholesky decomp ...
-  double *flux_scatter, GAURAN, GAURAN_ORIG, GAURAN_NEW, SIG_F ;
-  gsl_matrix_view chk;
+  // correlate randoms using cached Cholesky factor
+  double *GAURAN_LIST, *GAURANCORR_LIST ;
+  GAURAN_LIST     = (double*) malloc( MEMD0 );
+  GAURANCORR_LIST = (double*) malloc( MEMD0 );
 
-  flux_scatter = (double*) malloc( MEMD0 );
-  chk  = gsl_matrix_view_array ( covFlux_1D, NOBS, NOBS); 
-  gsl_linalg_cholesky_decomp ( &chk.matrix )  ; // <== slowest step, beware
-  
-  for(obs0=0; obs0 < NOBS; obs0++ ) {  
-    flux_scatter[obs0] = 0.0 ;
+  for(o=0; o < NOBS; o++ ) 
+    { ep = epMAP[o];  GAURAN_LIST[o] = GENLC.RANGauss_NOISE_FUDGE[ep]; }
 
-    for(obs1=0; obs1 < NOBS; obs1++ ) {
-      covCholesky_2D[obs0][obs1] = 0.0 ;
-      if ( obs0 <= obs1 ) {
-	covCholesky_2D[obs0][obs1] = gsl_matrix_get(&chk.matrix,obs0,obs1); 
-      }
+  get_GAURANCORR_REDCOV(icov, NOBS, GAURAN_LIST, GAURANCORR_LIST);
 
-      covCholesky_2D[obs1][obs0] = 0.0 ;
-      if ( obs1 <= obs0 ) {
-	covCholesky_2D[obs1][obs0] = gsl_matrix_get(&chk.matrix,obs1,obs0); 
-      }
-     
-      ep = epMAP[obs1];  GAURAN  = GENLC.RANGauss_NOISE_FUDGE[ep] ; 
-      flux_scatter[obs0] += (GAURAN * covCholesky_2D[obs1][obs0]) ;
+  if ( LDMP ) {
+    for(o=0; o < NOBS; o++ ) {
+      printf(" xxx obs=%3d ep=%3d  GAURAN(orig,corr) = %7.4f, %7.4f\n",
+	     o, epMAP[o], GAURAN_LIST[o], GAURANCORR_LIST[o] );
     }
+    fflush(stdout);
   }
-
   
   // modify independent RANGauss_FUDGE. 
   // Obs with SNR<2 are left with diag cov that is not correlated with 
   // other observations.
-  
   for(o=0; o < NOBS; o++ ) {
-    ep             = epMAP[o];
-    SIG_F          = sqrt(GENLC.FLUXNOISE[ep].SQSIG_FINAL_TRUE[TYPE_F]);
-    GAURAN_ORIG    = GENLC.RANGauss_NOISE_FUDGE[ep] ; 
-    GAURAN_NEW     = flux_scatter[o]/SIG_F ;
-    GENLC.RANGauss_NOISE_FUDGE[ep] = GAURAN_NEW ;
+    ep  = epMAP[o];
+    GENLC.RANGauss_NOISE_FUDGE[ep] = GAURANCORR_LIST[o] ;
   } // end o loop
 
-
-
-  // free matrix memory.
-  free(covFlux_1D);
-
-  for(o=0; o < NOBS; o++ ) { free(covCholesky_2D[o]); }
-  free(covCholesky_2D);
-
-  free(epMAP);  free(flux_scatter);
+  free(epMAP);  free(GAURAN_LIST);  free(GAURANCORR_LIST);
 
   return ;
 
@@ -27390,28 +27759,20 @@ void gen_fluxNoise_fudge_cov(int icov) {
 
 
 // *********************a****************
-void gen_fluxNoise_apply(int epoch, int vbose, FLUXNOISE_DEF *FLUXNOISE) {
+void gen_fluxNoise_apply(int vbose) {
   
   // Created Dec 2019
   // apply random flux shifts 
+  //
+  // Oct 2026: loop over all epochs in FLUXNOISE_BUF
 
-  char  *FIELD     = GENLC.FIELDNAME[epoch] ;
-
-  int   ifilt_obs    = FLUXNOISE->IFILT_OBS;
-  char  *BAND        = FLUXNOISE->BAND;
-  double fluxTrue    = FLUXNOISE->SQSIG_SRC ;          // p.e.
-  double fluxgal     = FLUXNOISE->SQSIG_HOST_PHOT ;
-  
-  double SQSIG_S     = FLUXNOISE->SQSIG_FINAL_TRUE[TYPE_FLUXNOISE_S];
-  double SQSIG_SZ    = FLUXNOISE->SQSIG_FINAL_TRUE[TYPE_FLUXNOISE_SZ];
-  double SQSIG_T     = FLUXNOISE->SQSIG_FINAL_TRUE[TYPE_FLUXNOISE_T];
-  double SQSIG_F     = FLUXNOISE->SQSIG_FINAL_TRUE[TYPE_FLUXNOISE_F];
-  double SIG_S       = sqrt(SQSIG_S);  // search image
-  double SIG_SZ      = sqrt(SQSIG_SZ);  // search image + zp err
-  double SIG_T       = sqrt(SQSIG_T);  // template
-  double SIG_F       = sqrt(SQSIG_F);  // fudge noise
-
-  int    ifield, OVP ;
+  FLUXNOISE_BUF_DEF *BUF = &FLUXNOISE_BUF ;
+  int    NOBS = BUF->NOBS ;
+  FLUXNOISE_DEF *FLUXNOISE ;
+  int    o, epoch, ifilt_obs, ifield, OVP ;
+  char   *BAND ;
+  double fluxTrue, fluxgal ;
+  double SQSIG_S, SQSIG_SZ, SQSIG_T, SQSIG_F, SIG_S, SIG_SZ, SIG_T, SIG_F ;
   double GAURAN_SZ=0.0, GAURAN_T=0.0, GAURAN_F=0.0, GAURAN_S=0.0 ;
   double SHIFT_SZ,  SHIFT_T,  SHIFT_F, SHIFT_S ;
   double fluxObs, flux_T, z ;
@@ -27420,176 +27781,193 @@ void gen_fluxNoise_apply(int epoch, int vbose, FLUXNOISE_DEF *FLUXNOISE) {
 
   // ----------- BEGIN -----------
 
-  if ( ifilt_obs < 0 || ifilt_obs > MXFILTINDX ) {
-    sprintf(c1err,"Undefined IFILT_OBS=%d for ep=%d CID=%d .",
-	    ifilt_obs, epoch, GENLC.CID);
-    sprintf(c2err,"Probably a code bug.");
-    errmsg(SEV_FATAL, 0, fnam, c1err, c2err) ; 
-  }
+  for ( o = 0; o < NOBS; o++ ) {
+
+    epoch       = BUF->EPOCH[o] ;
+    FLUXNOISE   = &GENLC.FLUXNOISE[epoch] ;
+    ifilt_obs   = FLUXNOISE->IFILT_OBS;
+    BAND        = FLUXNOISE->BAND;
+    fluxTrue    = FLUXNOISE->SQSIG_SRC ;          // p.e.
+    fluxgal     = FLUXNOISE->SQSIG_HOST_PHOT ;
+
+    SQSIG_S     = FLUXNOISE->SQSIG_FINAL_TRUE[TYPE_FLUXNOISE_S];
+    SQSIG_SZ    = FLUXNOISE->SQSIG_FINAL_TRUE[TYPE_FLUXNOISE_SZ];
+    SQSIG_T     = FLUXNOISE->SQSIG_FINAL_TRUE[TYPE_FLUXNOISE_T];
+    SQSIG_F     = FLUXNOISE->SQSIG_FINAL_TRUE[TYPE_FLUXNOISE_F];
+    SIG_S       = sqrt(SQSIG_S);  // search image
+    SIG_SZ      = sqrt(SQSIG_SZ);  // search image + zp err
+    SIG_T       = sqrt(SQSIG_T);  // template
+    SIG_F       = sqrt(SQSIG_F);  // fudge noise
+
+    if ( ifilt_obs < 0 || ifilt_obs > MXFILTINDX ) {
+      sprintf(c1err,"Undefined IFILT_OBS=%d for ep=%d CID=%d .",
+  	    ifilt_obs, epoch, GENLC.CID);
+      sprintf(c2err,"Probably a code bug.");
+      errmsg(SEV_FATAL, 0, fnam, c1err, c2err) ; 
+    }
 
-  ifield        = IFIELD_OVP_SIMLIB(1,FIELD);
-  if ( ifield < 0 ) { ifield=0; }   // Nov 2016: needed for GAURAN_TEMPLATE
+    ifield = BUF->IFIELD_OVP[o] ;  // Nov 2016: >=0 needed for GAURAN_TEMPLATE
 
 
-  // strip off previuously generated Gaussian randoms
-  GAURAN_SZ = GAURAN_F = GAURAN_T = 0.0 ;
-  if ( INPUTS.SMEARFLAG_FLUX > 0 ) {     
-    GAURAN_S   = GENLC.RANGauss_NOISE_SEARCH[epoch] ; 
-    GAURAN_SZ  = GENLC.RANGauss_NOISE_SEARCH[epoch] ; 
-    GAURAN_F   = GENLC.RANGauss_NOISE_FUDGE[epoch] ; 
-    //    GAURAN_Z   = GENLC.RANGauss_NOISE_ZP[epoch] ; 
-    GAURAN_T   = GENLC.RANGauss_NOISE_TEMPLATE[ifield][ifilt_obs] ;
-  }
+    // strip off previuously generated Gaussian randoms
+    GAURAN_SZ = GAURAN_F = GAURAN_T = 0.0 ;
+    if ( INPUTS.SMEARFLAG_FLUX > 0 ) {     
+      GAURAN_S   = GENLC.RANGauss_NOISE_SEARCH[epoch] ; 
+      GAURAN_SZ  = GENLC.RANGauss_NOISE_SEARCH[epoch] ; 
+      GAURAN_F   = GENLC.RANGauss_NOISE_FUDGE[epoch] ; 
+      //    GAURAN_Z   = GENLC.RANGauss_NOISE_ZP[epoch] ; 
+      GAURAN_T   = GENLC.RANGauss_NOISE_TEMPLATE[ifield][ifilt_obs] ;
+    }
 
-  SHIFT_SZ = SIG_SZ * GAURAN_SZ ; // independent part of search image
-  SHIFT_S  = SIG_S  * GAURAN_S  ; // for monitor only
-  SHIFT_T  = SIG_T  * GAURAN_T ;  // 100% correlated noise from template
-  SHIFT_F  = SIG_F  * GAURAN_F ;  // fudged noise, maybe with correlations
+    SHIFT_SZ = SIG_SZ * GAURAN_SZ ; // independent part of search image
+    SHIFT_S  = SIG_S  * GAURAN_S  ; // for monitor only
+    SHIFT_T  = SIG_T  * GAURAN_T ;  // 100% correlated noise from template
+    SHIFT_F  = SIG_F  * GAURAN_F ;  // fudged noise, maybe with correlations
 
-  // store each shift to monitor later.
-  FLUXNOISE->FLUX_SHIFT_TRUE[TYPE_FLUXNOISE_S]  = SHIFT_S ;
-  FLUXNOISE->FLUX_SHIFT_TRUE[TYPE_FLUXNOISE_SZ] = SHIFT_SZ ;
-  FLUXNOISE->FLUX_SHIFT_TRUE[TYPE_FLUXNOISE_T]  = SHIFT_T ;
-  FLUXNOISE->FLUX_SHIFT_TRUE[TYPE_FLUXNOISE_F]  = SHIFT_F ;
+    // store each shift to monitor later.
+    FLUXNOISE->FLUX_SHIFT_TRUE[TYPE_FLUXNOISE_S]  = SHIFT_S ;
+    FLUXNOISE->FLUX_SHIFT_TRUE[TYPE_FLUXNOISE_SZ] = SHIFT_SZ ;
+    FLUXNOISE->FLUX_SHIFT_TRUE[TYPE_FLUXNOISE_T]  = SHIFT_T ;
+    FLUXNOISE->FLUX_SHIFT_TRUE[TYPE_FLUXNOISE_F]  = SHIFT_F ;
 
-  // - - - - - - - - - - -  -
-  // Sum the shifts to get observed flux. Note that 
-  //   * SIG_F != 0 only for FLUXERRMODEL_FILE option.
-  fluxObs  = fluxTrue + (SHIFT_SZ + SHIFT_T + SHIFT_F) ;
+    // - - - - - - - - - - -  -
+    // Sum the shifts to get observed flux. Note that 
+    //   * SIG_F != 0 only for FLUXERRMODEL_FILE option.
+    fluxObs  = fluxTrue + (SHIFT_SZ + SHIFT_T + SHIFT_F) ;
 
-  // - - - - - - - - - - -  -
+    // - - - - - - - - - - -  -
 
 
-  // check option for random template noise instead of default correlated noise
-  OVP = (INPUTS.SIMLIB_MSKOPT & SIMLIB_MSKOPT_RANDOM_TEMPLATENOISE);
-  if ( OVP ) {
-    SQSIG_TMP = SQSIG_SZ + SQSIG_T ;
-    SIG_TMP   = sqrt(SQSIG_TMP)   ;
-    fluxObs   = fluxTrue + (SIG_TMP*GAURAN_SZ);
-  }
+    // check option for random template noise instead of default correlated noise
+    OVP = (INPUTS.SIMLIB_MSKOPT & SIMLIB_MSKOPT_RANDOM_TEMPLATENOISE);
+    if ( OVP ) {
+      SQSIG_TMP = SQSIG_SZ + SQSIG_T ;
+      SIG_TMP   = sqrt(SQSIG_TMP)   ;
+      fluxObs   = fluxTrue + (SIG_TMP*GAURAN_SZ);
+    }
 
-  // Adjust reported error to be based on observed flux instead of true flux.  
-  double sqerr_ran ;
-  if ( fluxObs > 0 ) 
-    { sqerr_ran = (fluxObs - fluxTrue); }
-  else
-    { sqerr_ran = -fluxTrue; }
+    // Adjust reported error to be based on observed flux instead of true flux.  
+    double sqerr_ran ;
+    if ( fluxObs > 0 ) 
+      { sqerr_ran = (fluxObs - fluxTrue); }
+    else
+      { sqerr_ran = -fluxTrue; }
   
-  // update reported error in data file
-  double SIG_FINAL_TRUE  = sqrt(FLUXNOISE->SQSIG_FINAL_DATA); // local use
+    // update reported error in data file
+    double SIG_FINAL_TRUE  = sqrt(FLUXNOISE->SQSIG_FINAL_DATA); // local use
 
-  SQSIG_TMP = FLUXNOISE->SQSIG_FINAL_DATA + sqerr_ran;
-  FLUXNOISE->SQSIG_FINAL_DATA = SQSIG_TMP ;
-  FLUXNOISE->SIG_FINAL_DATA   = sqrt(SQSIG_TMP) ;
-  FLUXNOISE->SQSIG_RAN        = sqerr_ran ;
+    SQSIG_TMP = FLUXNOISE->SQSIG_FINAL_DATA + sqerr_ran;
+    FLUXNOISE->SQSIG_FINAL_DATA = SQSIG_TMP ;
+    FLUXNOISE->SIG_FINAL_DATA   = sqrt(SQSIG_TMP) ;
+    FLUXNOISE->SQSIG_RAN        = sqerr_ran ;
 
 
 
-  // check option to ignore source & host error in reported error
-  // (SMP-like)
-  if ( (INPUTS.SMEARFLAG_FLUX & 2) > 0 ) {
-    SQSIG_TMP  = FLUXNOISE->SQSIG_FINAL_DATA - (fluxTrue + fluxgal) ;
-    FLUXNOISE->SQSIG_FINAL_DATA  = SQSIG_TMP ;
-    FLUXNOISE->SIG_FINAL_DATA    = sqrt(SQSIG_TMP) ;    
-  }
+    // check option to ignore source & host error in reported error
+    // (SMP-like)
+    if ( (INPUTS.SMEARFLAG_FLUX & 2) > 0 ) {
+      SQSIG_TMP  = FLUXNOISE->SQSIG_FINAL_DATA - (fluxTrue + fluxgal) ;
+      FLUXNOISE->SQSIG_FINAL_DATA  = SQSIG_TMP ;
+      FLUXNOISE->SIG_FINAL_DATA    = sqrt(SQSIG_TMP) ;    
+    }
 
 
-  // --------------------------------------------
-  // Check optional template flux to subtract (for LCLIB model).
-  // Beware that coherent template fluctuations are not included,
-  // so deep templates are assumed.
-  // This template-flux subtraction is done at the very end so that
-  // search-soure noise is included.
-  flux_T   = FLUXNOISE->SQSIG_TSRC ;
-  if ( flux_T > 1.0E-9 ) {
-    fluxObs       -= flux_T ;  // obs flux; can be pos or neg
-    fluxTrue      -= flux_T ;  // true flux without fluctuations
+    // --------------------------------------------
+    // Check optional template flux to subtract (for LCLIB model).
+    // Beware that coherent template fluctuations are not included,
+    // so deep templates are assumed.
+    // This template-flux subtraction is done at the very end so that
+    // search-soure noise is included.
+    flux_T   = FLUXNOISE->SQSIG_TSRC ;
+    if ( flux_T > 1.0E-9 ) {
+      fluxObs       -= flux_T ;  // obs flux; can be pos or neg
+      fluxTrue      -= flux_T ;  // true flux without fluctuations
 
-    // update SNR_CALC
-    SCALE_TMP      = ( fluxTrue / ( fluxTrue + flux_T) ) ;
-    FLUXNOISE->SNR_CALC_SZT *= SCALE_TMP ;
-    FLUXNOISE->SNR_CALC_ST  *= SCALE_TMP ;
-    FLUXNOISE->SNR_CALC_S   *= SCALE_TMP ;
-  }
+      // update SNR_CALC
+      SCALE_TMP      = ( fluxTrue / ( fluxTrue + flux_T) ) ;
+      FLUXNOISE->SNR_CALC_SZT *= SCALE_TMP ;
+      FLUXNOISE->SNR_CALC_ST  *= SCALE_TMP ;
+      FLUXNOISE->SNR_CALC_S   *= SCALE_TMP ;
+    }
 
 
-  // - - - - - - - - - - - - - - - - - - - 
-  // Jan 2018: check for saturation. NPE > 0 --> saturation
-  int npe_above_sat = npe_above_saturation(epoch,fluxTrue+fluxgal);
-  GENLC.npe_above_sat[epoch] = npe_above_sat ;
-  if ( npe_above_sat > 0 ) {
-    fluxObs = 0.0 ;     SIG_TMP = FLUXCALERR_SATURATE ;
-    FLUXNOISE->SQSIG_FINAL_DATA = SIG_TMP * SIG_TMP ;
-    FLUXNOISE->SIG_FINAL_DATA   = SIG_TMP;
-  }
+    // - - - - - - - - - - - - - - - - - - - 
+    // Jan 2018: check for saturation. NPE > 0 --> saturation
+    int npe_above_sat = npe_above_saturation(epoch,fluxTrue+fluxgal);
+    GENLC.npe_above_sat[epoch] = npe_above_sat ;
+    if ( npe_above_sat > 0 ) {
+      fluxObs = 0.0 ;     SIG_TMP = FLUXCALERR_SATURATE ;
+      FLUXNOISE->SQSIG_FINAL_DATA = SIG_TMP * SIG_TMP ;
+      FLUXNOISE->SIG_FINAL_DATA   = SIG_TMP;
+    }
 
-  // ---------------------------------------------
-  // load global GENLC array.
-  // ---------------------------------------------
+    // ---------------------------------------------
+    // load global GENLC array.
+    // ---------------------------------------------
 
 
-  double NADU_over_Npe       = FLUXNOISE->NADU_over_Npe;
-  //  double Npe_over_FLUXCAL    = FLUXNOISE->Npe_over_FLUXCAL;
-  double legacy_flux         = GENLC.flux[epoch];
-  double legacy_fluxerr_data = GENLC.fluxerr_data[epoch];
+    double NADU_over_Npe       = FLUXNOISE->NADU_over_Npe;
+    //  double Npe_over_FLUXCAL    = FLUXNOISE->Npe_over_FLUXCAL;
+    double legacy_flux         = GENLC.flux[epoch];
+    double legacy_fluxerr_data = GENLC.fluxerr_data[epoch];
 
-  GENLC.flux[epoch]         = fluxObs * NADU_over_Npe ;  
-  GENLC.fluxerr_data[epoch] = FLUXNOISE->SIG_FINAL_DATA * NADU_over_Npe;
+    GENLC.flux[epoch]         = fluxObs * NADU_over_Npe ;  
+    GENLC.fluxerr_data[epoch] = FLUXNOISE->SIG_FINAL_DATA * NADU_over_Npe;
 
 
-  // store true SNR without fluctuations (used later to force SNRMAX)
-  GENLC.trueSNR[epoch] =  fluxTrue/SIG_FINAL_TRUE;
+    // store true SNR without fluctuations (used later to force SNRMAX)
+    GENLC.trueSNR[epoch] =  fluxTrue/SIG_FINAL_TRUE;
 
-  // store coherent template error.
-  GENLC.template_err[epoch] = NADU_over_Npe * SIG_T ;
+    // store coherent template error.
+    GENLC.template_err[epoch] = NADU_over_Npe * SIG_T ;
 
-  // store SNR of fixed monitor mag
-  GENLC.SNR_MON[epoch]  = FLUXNOISE->SNR_FINAL_MON ;
+    // store SNR of fixed monitor mag
+    GENLC.SNR_MON[epoch]  = FLUXNOISE->SNR_FINAL_MON ;
   
-  // keep track of epoch with max SNR (Jun 2018)
-  SNR_CALC              = FLUXNOISE->SNR_CALC_SZT; 
-  GENLC.SNR_CALC[epoch] = SNR_CALC ;
-  if (SNR_CALC > GENLC.SNRMAX_GLOBAL) { 
-    GENLC.SNRMAX_GLOBAL = SNR_CALC;  
-    GENLC.IEPOCH_SNRMAX_GLOBAL = epoch;  
+    // keep track of epoch with max SNR (Jun 2018)
+    SNR_CALC              = FLUXNOISE->SNR_CALC_SZT; 
+    GENLC.SNR_CALC[epoch] = SNR_CALC ;
+    if (SNR_CALC > GENLC.SNRMAX_GLOBAL) { 
+      GENLC.SNRMAX_GLOBAL = SNR_CALC;  
+      GENLC.IEPOCH_SNRMAX_GLOBAL = epoch;  
     
-    // Dec 2021: store max redshift with SNR>5 (diagnostic only)
-    z = GENLC.REDSHIFT_CMB ;
-    if ( GENLC.SNRMAX_GLOBAL > 5.0 && z > GENLC.REDSHIFT_MAX_SNR5 ) {
-      { GENLC.REDSHIFT_MAX_SNR5 = z; }
+      // Dec 2021: store max redshift with SNR>5 (diagnostic only)
+      z = GENLC.REDSHIFT_CMB ;
+      if ( GENLC.SNRMAX_GLOBAL > 5.0 && z > GENLC.REDSHIFT_MAX_SNR5 ) {
+        { GENLC.REDSHIFT_MAX_SNR5 = z; }
+      }
     }
-  }
 
   
-  if ( vbose ) {
-    double flux         = GENLC.flux[epoch];
-    double fluxerr_data = GENLC.fluxerr_data[epoch];
-    double ratio_flux   = flux/legacy_flux;
-    double ratio_err    = fluxerr_data/legacy_fluxerr_data;
-    double ratio_tol    = 0.005;
-    char starFlux[2]=" ", starErr[2]=" " ;
-    if ( fabs(ratio_flux-1.0)>ratio_tol ) { sprintf(starFlux,"*"); }
-    if ( fabs(ratio_err -1.0)>ratio_tol ) { sprintf(starErr, "*"); }
+    if ( vbose ) {
+      double flux         = GENLC.flux[epoch];
+      double fluxerr_data = GENLC.fluxerr_data[epoch];
+      double ratio_flux   = flux/legacy_flux;
+      double ratio_err    = fluxerr_data/legacy_fluxerr_data;
+      double ratio_tol    = 0.005;
+      char starFlux[2]=" ", starErr[2]=" " ;
+      if ( fabs(ratio_flux-1.0)>ratio_tol ) { sprintf(starFlux,"*"); }
+      if ( fabs(ratio_err -1.0)>ratio_tol ) { sprintf(starErr, "*"); }
 
-    printf(" xxx %s(%3d-%s) NEW/OLD flux=%7.2f/%7.2f=%7.4f%s  "
-	   "err=%6.2f/%6.2f=%.4f%s\n"
-	   ,"apply", epoch, BAND
-	   ,flux, legacy_flux, ratio_flux, starFlux
-	   ,fluxerr_data, legacy_fluxerr_data, ratio_err, starErr );
-    fflush(stdout);
+      printf(" xxx %s(%3d-%s) NEW/OLD flux=%7.2f/%7.2f=%7.4f%s  "
+  	   "err=%6.2f/%6.2f=%.4f%s\n"
+  	   ,"apply", epoch, BAND
+  	   ,flux, legacy_flux, ratio_flux, starFlux
+  	   ,fluxerr_data, legacy_fluxerr_data, ratio_err, starErr );
+      fflush(stdout);
 	   
-  }
+    }
 
-  // check for really crazy flux values
-  check_crazyFlux(epoch, FLUXNOISE);
+    // check for really crazy flux values
+    check_crazyFlux(epoch, FLUXNOISE);
   
-  if ( epoch == -7 ) 
-    { dumpEpoch_fluxNoise_apply(fnam,epoch,FLUXNOISE); }
+    if ( epoch == -7 ) 
+      { dumpEpoch_fluxNoise_apply(fnam,epoch,FLUXNOISE); }
 
+  } // end o loop
 
   return ;
 
-
 } // end gen_fluxNoise_apply
 
 
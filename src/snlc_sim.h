@@ -150,6 +150,11 @@ int WRFLAG_noSPEC ;    // Apr 2024
 #define SIMLIB_SKYSIG_SQASEC   "ADU_PER_SQARCSEC"   // option
 
 #define SIMLIB_MXGEN_LIBID 1000
+
+// bit-mask options for EARLY_REJECT_OPT (Oct 2026)
+#define MASK_EARLY_REJECT_GENMAG     1 // GENRANGE_PEAKMAG cut on peak mags
+#define MASK_EARLY_REJECT_SEARCHEFF  2 // NEPOCH & pipeline bound before fluxes
+#define MASK_EARLY_REJECT_ZCUT       4 // CUTWIN_REDSHIFT_TRUE before fluxes
 #define SIMLIB_MSKOPT_REPEAT_UNTIL_ACCEPT      2 // force each LIBID to accept
 #define SIMLIB_MSKOPT_QUIT_NOREWIND            4 // quit after one pass
 #define SIMLIB_MSKOPT_RANDOM_TEMPLATENOISE     8 // random template noise
@@ -444,6 +449,38 @@ typedef struct {
 } MONITOR_REDCOV_FLUXNOISE_DEF ;
 
 
+// Oct 2026: per-event structure-of-arrays (SoA) epoch buffer so that
+// flux-noise functions in GENFLUX_DRIVER run as loops over arrays.
+// Index is o=0 to NOBS-1 over generated epochs (OBSFLAG_GEN);
+// EPOCH[o] is the GENLC epoch index. Buffer grows as needed.
+typedef struct {
+  int     NOBS, MXOBS ;
+  int     *EPOCH, *IFILT_OBS ;
+  int     *IFIELD_OVP ;        // index for template randoms
+  int     *IMAP_FLUXERRMAP ;   // FLUXERRMAP index, or -9
+  int     *INDEX_REDCOV ;      // REDCOV index, or -9
+
+  // observing conditions copied from SIMLIB_OBS_GEN
+  double  *MJD, *ZPT, *ZPTERR, *CCDGAIN, *SKYSIG, *READNOISE ;
+  double  *PSFSIG1, *PIXSIZE, *NEA ;
+  double  *TEMPLATE_SKYSIG, *TEMPLATE_READNOISE, *TEMPLATE_ZPT ;
+  double  *GENMAG, *GENMAG_T ;
+
+  // noise terms (p.e.) from gen_fluxNoise_calc
+  double  *FLUX_SRC, *FLUX_TSRC, *SQSIG_SKY, *SQSIG_CCD, *SQSIG_TSKY ;
+  double  *NADU_over_Npe, *Npe_over_FLUXCAL ;
+
+  // FLUXERRMAP inputs and outputs (FLUXCAL units)
+  double  *ERRPARLIST ;        // MXPAR_FLUXERRMAP per obs
+  double  *FLUXCALERR_IN, *FLUXCALERR_TRUE, *FLUXCALERR_DATA ;
+
+  // Gaussian randoms: 2 per obs, then template randoms
+  double  *GAURAN ;
+} FLUXNOISE_BUF_DEF ;
+
+FLUXNOISE_BUF_DEF FLUXNOISE_BUF ;
+
+
 // Nov 2021: define struct for interpolating host photo-z resolution vs z
 //   Sim input key is HOSTLIB_GENZPHOT_FUDGEMAP: <STRING>
 typedef struct {    // HOSTLIB_GENZPHOT_FUDGEMAP_DEF
@@ -675,6 +712,7 @@ struct INPUTS {
   unsigned int ISEED;         // random seed
   unsigned int ISEED_ORIG;    // for readme output
   int          NSTREAM_RAN;   // number of independent random streams
+  int          RANGEN_PHILOX; // 1 -> counter-based Philox generator (Oct 2026)
 
   int    RANLIST_START_GENSMEAR;  // to pick different genSmear randoms
 
@@ -686,6 +724,7 @@ struct INPUTS {
   double MUSHIFT;      // coherent MU shift at all redshifts (Oct 2020)
   char   HzFUN_FILE[MXPATHLEN];  // 2 column file with zCMB H(z,theory)
   HzFUN_INFO_DEF HzFUN_INFO;     // store cosmo theory info here.
+  COSMO_ZGRID_DEF COSMO_ZGRID;   // z-grid table of distance integral
   ANISOTROPY_INFO_DEF ANISOTROPY_INFO ;
 
   double GENRANGE_RA[2];        // RA range (deg) to generate
@@ -927,6 +966,9 @@ struct INPUTS {
   int GENPERFECT;   // 1 => perfect lightcurves with x1000 photostats
   int APPLY_SEARCHEFF_OPT ;   // bit 0,1,2 => trigger, spec, zhost
 
+  // early rejection using peak-only mags, before full LC (Oct 2026)
+  int   EARLY_REJECT_OPT ;     // see MASK_EARLY_REJECT_XXX above
+
   // define Gaussian sigmas to assign random syst error(s) during init stage
   INPUTS_RANSYSTPAR_DEF RANSYSTPAR ;
 
@@ -1467,8 +1509,15 @@ struct NGEN_REJECT {
   int CUTWIN ;
   int NEPOCH ;   // counts NEPOCH < NEPOCH_MIN
   int CRAZYFLUX ;
+  int EARLY ;    // subset rejected before full LC or fluxes
 } NGEN_REJECT ;
 
+// nominal epochs saved while generating mags for peak epochs only
+struct {
+  int NEPOCH, *IFILT_OBS, *ISPEAK;
+  double *MJD, *TOBS, *TREST ;
+} GENLC_EPOCH_ORIG ;
+
 
 // valid Z-range with defined rest-frame model for each obs-filter
 // (for README comment only)
@@ -2070,18 +2119,24 @@ void    gen_conditions(void);  // generate conditions for each field
 //int    gen_PEAKMAG_SPEC_TRIGGER(void); // call GENMAG_DRIVER for peak only
 int    gen_TRIGGER_PEAKMAG_SPEC(void); // call GENMAG_DRIVER for peak only
 int    gen_TRIGGER_zHOST(void);        // evaluate zHOST trigger early
+int    gen_EARLY_REJECT(char *REJECT_STAGE); // peak-only cuts before full LC
+int    gen_EARLY_REJECT_FLUX(char *REJECT_STAGE); // cuts before fluxes
+void   GENLC_PEAKEPOCHS(int OPT);      // +1->keep peak epochs, -1->restore
 
 void   GENMAG_DRIVER(void);    // driver to generate true mags
 void   DUMP_GENMAG_DRIVER(void);
 void   GENFLUX_DRIVER(void);   // driver to generate observed fluxes
 
 void   set_GENFLUX_FLAGS(int ep);
+void   load_FLUXNOISE_BUF(void);
+void   malloc_FLUXNOISE_BUF(int NOBS);
 void   gen_fluxNoise_randoms(void);
-void   gen_fluxNoise_calc(int ep, int vbose, FLUXNOISE_DEF *FLUXNOISE);
-void   gen_fluxNoise_fudge_diag(int ep, int vbose, FLUXNOISE_DEF *FLUXNOISE);
+void   gen_fluxNoise_calc(int vbose);
+void   gen_fluxNoise_FLUXERRMAP(void);
+void   gen_fluxNoise_fudge_diag(int o, int vbose);
 void   gen_fluxNoise_fudge_cov(int icov);
 void   gen_fluxNoise_driver_cov(void);
-void   gen_fluxNoise_apply(int ep, int vbose, FLUXNOISE_DEF *FLUXNOISE);
+void   gen_fluxNoise_apply(int vbose);
 void   dumpLine_fluxNoise(char *fnam, int ep, FLUXNOISE_DEF *FLUXNOISE);
 void   dumpEpoch_fluxNoise_apply(char *fnam, int ep, FLUXNOISE_DEF *FLUXNOISE);
 void   dumpCovMat_fluxNoise(int icov, int NOBS, double *COV);
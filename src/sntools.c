@@ -6841,6 +6841,9 @@ void init_random_seed(int ISEED, int NSTREAM) {
   // Init random seed(s) 
   // NSTREAM = 1 -> one random stream and regular init with srandom()
   // NSTREAM = 2 -> two independent streams, use srandom_r
+  //
+  // Oct 2026: if set_RANGEN_PHILOX(true) was called, init counter-based
+  //           Philox streams instead of srandom/srandom_r.
 
   GENRAN_INFO.NSTREAM = NSTREAM ;
   int i ;
@@ -6850,7 +6853,13 @@ void init_random_seed(int ISEED, int NSTREAM) {
 
   // ----------- BEGIN ----------------
 
-  if ( NSTREAM == 1 ) 
+  if ( GENRAN_INFO.USE_PHILOX ) {
+    // key word 1 = JOBID*(MXSTREAM_RAN+1) is for RANLISTs; 
+    // streams use the next MXSTREAM_RAN key values.
+    GENRAN_INFO.ISEED_PHILOX  = (uint32_t)ISEED ;
+    set_EVENT_PHILOX(0,0);
+  }
+  else if ( NSTREAM == 1 ) 
     {   srandom(ISEED); }
   else {
 
@@ -6898,8 +6907,14 @@ void fill_RANLISTs(void) {
   //
   // Jun 9 2018: use unix_getRan_Flat1() call.
   // Jun 4 2020: change function name from init_RANLIST -> fill_RANLISTs
-
-  int ilist, istore, NLIST_RAN;
+  // Oct 2026: for Philox option, each list is filled from counter
+  //           block (IEVENT,IFILL,ilist) so that randoms depend only on
+  //           seed, JOBID and event index (see set_EVENT_PHILOX).
+
+  int ilist, istore, NLIST_RAN, IFILL;
+  PHILOX_STREAM_DEF LIST_STREAM ;
+  uint32_t KEY1 ;
+  uint64_t CTR ;
   char fnam[] = "fill_RANLISTs" ;
 
   // ---------------- BEGIN ----------------
@@ -6918,6 +6933,31 @@ void fill_RANLISTs(void) {
 
   sumstat_RANLISTs(0);
 
+  if ( GENRAN_INFO.USE_PHILOX ) {
+    IFILL = GENRAN_INFO.IFILL_PHILOX ;
+    if ( IFILL >= MXFILL_RANLIST_PHILOX ) {
+      sprintf(c1err,"IFILL=%d exceeds bound for IEVENT=%lld", 
+	      IFILL, (long long)GENRAN_INFO.IEVENT_PHILOX );
+      sprintf(c2err,"Check MXFILL_RANLIST_PHILOX = %d", 
+	      MXFILL_RANLIST_PHILOX );
+      errmsg(SEV_FATAL, 0, fnam, c1err, c2err );
+    }
+    KEY1 = GENRAN_INFO.JOBID_PHILOX * (MXSTREAM_RAN+1) ;
+    for (ilist = 1; ilist <= NLIST_RAN; ilist++ ) {
+      CTR = ( (uint64_t)GENRAN_INFO.IEVENT_PHILOX * MXFILL_RANLIST_PHILOX 
+	      + IFILL ) * (MXLIST_RAN+1) + ilist ;
+      CTR *= NBLOCK_RANLIST_PHILOX ;
+      init_PHILOX_STREAM(&LIST_STREAM, GENRAN_INFO.ISEED_PHILOX, KEY1, CTR);
+      GENRAN_INFO.NSTORE_RAN[ilist] = 0 ;
+      for ( istore=0; istore < MXSTORE_RAN; istore++ ) {
+	GENRAN_INFO.RANSTORE[ilist][istore] = 
+	  getRan_Flat1_PHILOX(&LIST_STREAM);
+      }
+    }
+    GENRAN_INFO.IFILL_PHILOX++ ;
+    return ;
+  }
+
   for (ilist = 1; ilist <= NLIST_RAN; ilist++ ) {
     // fill new list of randoms
     GENRAN_INFO.NSTORE_RAN[ilist] = 0 ;
@@ -6980,11 +7020,15 @@ double unix_getRan_Flat1(int istream) {
   // Return random between 0 and 1.
   //
   // Jul 30 2020: check pre-proc flag ONE_RANDOM_STREAM
+  // Oct 2026: check Philox option
 
   int NSTREAM = GENRAN_INFO.NSTREAM ;
   int JRAN ;
   char fnam[] = "unix_getRan_Flat1";
   // ------------ BEGIN ----------------
+  if ( GENRAN_INFO.USE_PHILOX ) 
+    { return getRan_Flat1_PHILOX(&GENRAN_INFO.PHILOX_STREAM[istream]); }
+
   if ( NSTREAM == 1 )  { 
     JRAN = random(); 
   }
@@ -7022,6 +7066,14 @@ double getRan_Gauss(int ilist) {
   return G ;
 }  // end of getRan_Gauss
 
+void getRan_GaussList(int ilist, int NRAN, double *RANLIST) {
+  // Created Oct 2026
+  // Load RANLIST with NRAN Gaussian randoms from "ilist" in one call;
+  // sequence is the same as NRAN calls to getRan_Gauss(ilist).
+  int i;
+  for(i=0; i < NRAN; i++ ) { RANLIST[i] = getRan_Gauss(ilist); }
+} // end getRan_GaussList
+
 
 double unix_getRan_Gauss(int istream) {
   // Created Jun 4 2020
@@ -7038,6 +7090,9 @@ double unix_getRan_Gauss(int istream) {
     sprintf(c2err,"Check call to init_random_seed." );
     errmsg(SEV_FATAL, 0, fnam, c1err, c2err );
   }
+  if ( GENRAN_INFO.USE_PHILOX ) 
+    { return getRan_Gauss_PHILOX(&GENRAN_INFO.PHILOX_STREAM[istream]); }
+
   V1 = 2.0 * unix_getRan_Flat1(istream) - 1.0;
   V2 = 2.0 * unix_getRan_Flat1(istream) - 1.0;
   R  = V1*V1 + V2*V2 ;
@@ -7047,6 +7102,209 @@ double unix_getRan_Gauss(int istream) {
   return G ;
 } // end unix_getRan_Gauss
 
+
+// =====================================================
+//
+//   Philox4x32-10 counter-based generator (Salmon et al, 2011)
+//   and ziggurat Gaussian (Marsaglia & Tsang, 2000).
+//
+// =====================================================
+
+void set_RANGEN_PHILOX(bool USE) {
+  // Created Oct 2026
+  // Call before init_random_seed to select Philox generator.
+  GENRAN_INFO.USE_PHILOX = USE ;
+  if ( USE ) { init_ZIGGURAT(); }
+} // end set_RANGEN_PHILOX
+
+// ***********************************
+void init_PHILOX_STREAM(PHILOX_STREAM_DEF *STREAM, uint32_t KEY0,
+			uint32_t KEY1, uint64_t CTR) {
+  // Created Oct 2026
+  STREAM->KEY[0]      = KEY0 ;
+  STREAM->KEY[1]      = KEY1 ;
+  STREAM->CTR         = CTR ;
+  STREAM->NOUT_USED   = 4 ;                  // force new block
+  STREAM->NGAUSS_USED = MXBUF_GAUSS_PHILOX ; // force buffer fill
+} // end init_PHILOX_STREAM
+
+// ***********************************
+void set_EVENT_PHILOX(int JOBID, int64_t IEVENT) {
+
+  // Created Oct 2026
+  // Call at the start of each event to position the Philox RANLISTs
+  // and streams. JOBID (split-job index, 0 for interactive) goes into
+  // the key, and IEVENT sets the counter, so that each event's randoms
+  // depend only on (ISEED, JOBID, IEVENT).
+
+  uint32_t KEY1 ;
+  int i;
+
+  // ----------- BEGIN ------------
+
+  if ( !GENRAN_INFO.USE_PHILOX ) { return; }
+
+  GENRAN_INFO.JOBID_PHILOX  = (uint32_t)JOBID ;
+  GENRAN_INFO.IEVENT_PHILOX = IEVENT ;
+  GENRAN_INFO.IFILL_PHILOX  = 0 ;
+
+  KEY1 = GENRAN_INFO.JOBID_PHILOX * (MXSTREAM_RAN+1) ;
+  for(i=0; i < MXSTREAM_RAN; i++ ) {
+    init_PHILOX_STREAM(&GENRAN_INFO.PHILOX_STREAM[i], 
+		       GENRAN_INFO.ISEED_PHILOX, KEY1+i+1,
+		       (uint64_t)IEVENT * NBLOCK_EVENT_PHILOX );
+  }
+
+  return ;
+
+} // end set_EVENT_PHILOX
+
+// ***********************************
+void philox4x32_10(uint32_t *CTR, uint32_t *KEY, uint32_t *OUT) {
+
+  // Created Oct 2026
+  // Philox4x32 with 10 rounds: OUT[4] = bijection of CTR[4] under KEY[2].
+
+  const uint32_t M0 = 0xD2511F53, M1 = 0xCD9E8D57 ;
+  const uint32_t W0 = 0x9E3779B9, W1 = 0xBB67AE85 ;
+  uint32_t c0=CTR[0], c1=CTR[1], c2=CTR[2], c3=CTR[3];
+  uint32_t k0=KEY[0], k1=KEY[1];
+  uint64_t p0, p1 ;
+  int round;
+
+  for(round=0; round < 10; round++ ) {
+    p0 = (uint64_t)M0 * c0 ;
+    p1 = (uint64_t)M1 * c2 ;
+    c0 = (uint32_t)(p1 >> 32) ^ c1 ^ k0 ;
+    c2 = (uint32_t)(p0 >> 32) ^ c3 ^ k1 ;
+    c1 = (uint32_t)p1 ;
+    c3 = (uint32_t)p0 ;
+    k0 += W0 ;  k1 += W1 ;
+  }
+
+  OUT[0] = c0;  OUT[1] = c1;  OUT[2] = c2;  OUT[3] = c3;
+
+} // end philox4x32_10
+
+// ***********************************
+uint32_t getRan_uint32_PHILOX(PHILOX_STREAM_DEF *STREAM) {
+  // Created Oct 2026
+  uint32_t CTR[4] ;
+  if ( STREAM->NOUT_USED >= 4 ) {
+    CTR[0] = (uint32_t)(STREAM->CTR) ;
+    CTR[1] = (uint32_t)(STREAM->CTR >> 32) ;
+    CTR[2] = CTR[3] = 0 ;
+    philox4x32_10(CTR, STREAM->KEY, STREAM->OUT);
+    STREAM->CTR++ ;
+    STREAM->NOUT_USED = 0 ;
+  }
+  return STREAM->OUT[STREAM->NOUT_USED++] ;
+} // end getRan_uint32_PHILOX
+
+double getRan_Flat1_PHILOX(PHILOX_STREAM_DEF *STREAM) {
+  // Created Oct 2026
+  // return flat random strictly inside (0,1)
+  const double XNORM = 1.0 / 4294967296.0 ; // 1/2^32
+  return ( (double)getRan_uint32_PHILOX(STREAM) + 0.5 ) * XNORM ;
+} // end getRan_Flat1_PHILOX
+
+double getRan_Gauss_PHILOX(PHILOX_STREAM_DEF *STREAM) {
+  // Created Oct 2026
+  if ( STREAM->NGAUSS_USED >= MXBUF_GAUSS_PHILOX ) 
+    { fill_GAUSS_BUF_PHILOX(STREAM); }
+  return STREAM->GAUSS_BUF[STREAM->NGAUSS_USED++] ;
+} // end getRan_Gauss_PHILOX
+
+void fill_GAUSS_BUF_PHILOX(PHILOX_STREAM_DEF *STREAM) {
+  // Created Oct 2026
+  int i;
+  for(i=0; i < MXBUF_GAUSS_PHILOX; i++ ) 
+    { STREAM->GAUSS_BUF[i] = getRan_Gauss_ZIGGURAT(STREAM); }
+  STREAM->NGAUSS_USED = 0 ;
+} // end fill_GAUSS_BUF_PHILOX
+
+
+// ***********************************
+#define NLAYER_ZIGGURAT 128
+#define RTAIL_ZIGGURAT  3.442619855899
+struct {
+  bool     INIT ;
+  uint32_t KN[NLAYER_ZIGGURAT] ;
+  double   WN[NLAYER_ZIGGURAT], FN[NLAYER_ZIGGURAT] ;
+} ZIGGURAT ;
+
+void init_ZIGGURAT(void) {
+
+  // Created Oct 2026
+  // Tables for 128-layer ziggurat (Marsaglia & Tsang 2000).
+
+  const double M1 = 2147483648.0 ;  // 2^31
+  const double VN = 9.91256303526217e-3 ; // area of each layer
+  double dn = RTAIL_ZIGGURAT, tn = dn, q ;
+  int i;
+
+  // ----------- BEGIN ------------
+
+  if ( ZIGGURAT.INIT ) { return; }
+
+  q = VN / exp(-0.5*dn*dn);
+  ZIGGURAT.KN[0] = (uint32_t)( (dn/q) * M1 );
+  ZIGGURAT.KN[1] = 0 ;
+  ZIGGURAT.WN[0] = q/M1 ;
+  ZIGGURAT.WN[NLAYER_ZIGGURAT-1] = dn/M1 ;
+  ZIGGURAT.FN[0] = 1.0 ;
+  ZIGGURAT.FN[NLAYER_ZIGGURAT-1] = exp(-0.5*dn*dn) ;
+
+  for(i=NLAYER_ZIGGURAT-2; i >= 1; i-- ) {
+    dn = sqrt( -2.0 * log(VN/dn + exp(-0.5*dn*dn)) );
+    ZIGGURAT.KN[i+1] = (uint32_t)( (dn/tn) * M1 );
+    tn = dn ;
+    ZIGGURAT.FN[i] = exp(-0.5*dn*dn);
+    ZIGGURAT.WN[i] = dn/M1 ;
+  }
+
+  ZIGGURAT.INIT = true ;
+
+} // end init_ZIGGURAT
+
+double getRan_Gauss_ZIGGURAT(PHILOX_STREAM_DEF *STREAM) {
+
+  // Created Oct 2026
+  // Return unit Gaussian random using ziggurat method with
+  // uniform 32-bit randoms from Philox STREAM.
+  // Layer index is from the low 7 bits, sign+magnitude from 
+  // the full signed word.
+
+  int32_t  hz ;
+  uint32_t iz, uhz ;
+  double   x, y ;
+
+  // ----------- BEGIN ------------
+
+  while ( 1 ) {
+    hz  = (int32_t)getRan_uint32_PHILOX(STREAM);
+    iz  = (uint32_t)hz & (NLAYER_ZIGGURAT-1) ;
+    uhz = ( hz < 0 ) ? (uint32_t)(-(int64_t)hz) : (uint32_t)hz ;
+    x   = (double)hz * ZIGGURAT.WN[iz] ;
+    if ( uhz < ZIGGURAT.KN[iz] ) { return x; }  // ~99% of calls
+
+    if ( iz == 0 ) {
+      // tail beyond RTAIL
+      do {
+	x = -log(getRan_Flat1_PHILOX(STREAM)) / RTAIL_ZIGGURAT ;
+	y = -log(getRan_Flat1_PHILOX(STREAM)) ;
+      } while ( y+y < x*x ) ;
+      return ( hz > 0 ) ? (RTAIL_ZIGGURAT + x) : -(RTAIL_ZIGGURAT + x) ;
+    }
+
+    // wedge between layers
+    y = ZIGGURAT.FN[iz] + 
+      getRan_Flat1_PHILOX(STREAM) * (ZIGGURAT.FN[iz-1] - ZIGGURAT.FN[iz]);
+    if ( y < exp(-0.5*x*x) ) { return x; }
+  }
+
+} // end getRan_Gauss_ZIGGURAT
+
 double getRan_GaussClip(int ilist, double ranGmin, double ranGmax ) {
   // Created Aug 2016
   double ranG ;
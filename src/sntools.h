@@ -53,6 +53,7 @@
 #include <string.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <unistd.h>
 #include <time.h>
 #include <math.h>
@@ -234,6 +235,22 @@ char FILTERSTRING[MXFILTINDX] ;
 #define MXSTREAM_RAN    2  // max number of independent streams
 #define BUFSIZE_RAN   256
 
+// Oct 2026: optional counter-based Philox4x32-10 generator.
+// Each stream has a key and a block counter, so jump-ahead is just
+// a counter shift. Gaussians are from ziggurat, buffered per stream.
+#define MXBUF_GAUSS_PHILOX  1024
+#define NBLOCK_RANLIST_PHILOX 256  // Philox blocks per RANLIST (4*256 > MXSTORE_RAN)
+#define MXFILL_RANLIST_PHILOX 8192 // max fill_RANLISTs calls per event
+#define NBLOCK_EVENT_PHILOX   16777216 // 2^24 stream blocks per event
+typedef struct {
+  uint32_t KEY[2];
+  uint64_t CTR ;          // block counter; each block -> 4 uint32
+  uint32_t OUT[4] ;       // current block
+  int      NOUT_USED ;    // number of OUT[] already used (4 -> new block)
+  double   GAUSS_BUF[MXBUF_GAUSS_PHILOX] ;
+  int      NGAUSS_USED ;  // number of GAUSS_BUF already used
+} PHILOX_STREAM_DEF ;
+
 struct {
   int     NSTREAM ; // number of srandom streams (legacy is 1)
   double  RANSTORE[MXLIST_RAN+1][MXSTORE_RAN] ;
@@ -261,6 +278,16 @@ struct {
   double NWRAP_SUM[MXLIST_RAN+1] ;
   double NWRAP_SUMSQ[MXLIST_RAN+1] ;
 
+  // Philox option (Oct 2026): key is (ISEED, JOBID+stream) and counter
+  // is from event index, so that randoms for each event do not depend
+  // on other events, and split jobs never share a random sequence.
+  bool     USE_PHILOX ;
+  uint32_t ISEED_PHILOX ;
+  uint32_t JOBID_PHILOX ;    // split-job index (0 for interactive)
+  int64_t  IEVENT_PHILOX ;   // event index (see set_EVENT_PHILOX)
+  int      IFILL_PHILOX ;    // number of fill_RANLISTs for this event
+  PHILOX_STREAM_DEF PHILOX_STREAM[MXSTREAM_RAN];
+
 } GENRAN_INFO ;
 
 
@@ -898,9 +925,22 @@ void   sumstat_RANLISTs(int FLAG);
 double unix_getRan_Flat1(int istream) ;
 double unix_getRan_Gauss(int istream);
 
+void   set_RANGEN_PHILOX(bool USE);
+void   init_PHILOX_STREAM(PHILOX_STREAM_DEF *STREAM, uint32_t KEY0,
+			  uint32_t KEY1, uint64_t CTR);
+void   set_EVENT_PHILOX(int JOBID, int64_t IEVENT);
+void   philox4x32_10(uint32_t *CTR, uint32_t *KEY, uint32_t *OUT);
+uint32_t getRan_uint32_PHILOX(PHILOX_STREAM_DEF *STREAM);
+double getRan_Flat1_PHILOX(PHILOX_STREAM_DEF *STREAM);
+double getRan_Gauss_PHILOX(PHILOX_STREAM_DEF *STREAM);
+void   fill_GAUSS_BUF_PHILOX(PHILOX_STREAM_DEF *STREAM);
+void   init_ZIGGURAT(void);
+double getRan_Gauss_ZIGGURAT(PHILOX_STREAM_DEF *STREAM);
+
 double getRan_Flat(int ilist, double *range);  //return rnmd on range[0-1]
 double getRan_Flat1(int ilist);          // return 0 < random  < 1
 double getRan_Gauss(int ilist);   // return Gauss randon (sigma=1)
+void   getRan_GaussList(int ilist, int NRAN, double *RANLIST); // NRAN at once
 double getRan_GaussClip(int ilist, double ranGmin, double ranGmax);
 double getRan_GaussAsym(double siglo, double sighi, double peakinterval);
 int    getRan_Poisson(double mean);
@@ -32,6 +32,12 @@
   The maps are prepared in a set of "prepare_kcor_table_XXX" functions, 
   and they are evaluated in a set of "eval_kcor_table_XXX functions. 
 
+  Oct 2026: eval_kcor_table_XXX use a KCOR_FASTMAP (see init_kcor_fastmap)
+  with precomputed strides and direct uniform-bin indexing; only the
+  continuous dims are interpolated (filter dims are exact indices).
+  Agrees with interp_GRIDMAP to ~1E-12. New eval_kcor_table_XXX_list 
+  functions evaluate all epochs of a light curve in one call.
+
 ***************************************************/
 
 #include "fitsio.h"
@@ -2462,6 +2468,8 @@ void prepare_kcor_table_LCMAG(void) {
 		      TEMP_KCOR_ARRAY, &TEMP_KCOR_ARRAY[NDIM_INP],
 		      &KCOR_TABLE.GRIDMAP_LCMAG); // <== returned
 
+  init_kcor_fastmap(&KCOR_TABLE.GRIDMAP_LCMAG, 3, &KCOR_TABLE.FASTMAP_LCMAG);
+
   printf("\t Allocate %.1f/%.1f MB of GRIDMAP/temp memory for %s\n", 
 	 KCOR_TABLE.GRIDMAP_LCMAG.MEMORY, temp_mem, MAPNAME);
   fflush(stdout);
@@ -2522,6 +2530,8 @@ void prepare_kcor_table_MWXT(void) {
 		      OPT_EXTRAP_KCOR, TEMP_KCOR_ARRAY, &TEMP_KCOR_ARRAY[NDIM_INP],
 		      &KCOR_TABLE.GRIDMAP_MWXT); // <== returned
 
+  init_kcor_fastmap(&KCOR_TABLE.GRIDMAP_MWXT, 3, &KCOR_TABLE.FASTMAP_MWXT);
+
   printf("\t Allocate %.1f/%.1f MB of GRIDMAP/temp memory for %s\n", 
 	 KCOR_TABLE.GRIDMAP_MWXT.MEMORY, temp_mem, MAPNAME );
   fflush(stdout);
@@ -2611,6 +2621,8 @@ void prepare_kcor_table_AVWARP(void) {
 		      TEMP_KCOR_ARRAY, &TEMP_KCOR_ARRAY[NDIM_INP],
 		      &KCOR_TABLE.GRIDMAP_AVWARP); // <== returned
 
+  init_kcor_fastmap(&KCOR_TABLE.GRIDMAP_AVWARP, 2, &KCOR_TABLE.FASTMAP_AVWARP);
+
   printf("\t Allocate %.1f/%.1f MB of GRIDMAP/temp memory for %s\n", 
 	 KCOR_TABLE.GRIDMAP_AVWARP.MEMORY, temp_mem, MAPNAME );
   fflush(stdout);
@@ -2659,6 +2671,9 @@ double fit_AVWARP(int ifiltdef_a, int ifiltdef_b, double T, double C) {
   double DIF_COLOR_LIST[MXITER_FIT_AVWARP], DAV_DCOLOR_LIST[MXITER_FIT_AVWARP];
 
   double lc_mag_a, lc_mag_b, lc_color_best, lc_color_min, lc_color_max;
+  int    IFILTDEF_LIST6[6] = 
+    { ifiltdef_a, ifiltdef_b, ifiltdef_a, ifiltdef_b, ifiltdef_a, ifiltdef_b };
+  double T_LIST6[6] = { T, T, T, T, T, T }, AV_LIST6[6], MAG_LIST6[6];
   double av_min_dump, av_max_dump, AVRANGE_LOCAL[2];
   double lamavg_min, lamavg_max, lamavg;
 
@@ -2717,19 +2732,16 @@ double fit_AVWARP(int ifiltdef_a, int ifiltdef_b, double T, double C) {
   while ( fabs(dif_color) > dif_color_converge ) {
     iter++ ;
 
-    // get color at current av_best
-    lc_mag_a = eval_kcor_table_LCMAG ( ifiltdef_a, T, z, av_best );
-    lc_mag_b = eval_kcor_table_LCMAG ( ifiltdef_b, T, z, av_best );
-    lc_color_best = lc_mag_a - lc_mag_b ;
-
-    // store color at av_min & max
-    lc_mag_a = eval_kcor_table_LCMAG ( ifiltdef_a, T, z, av_min ) ;
-    lc_mag_b = eval_kcor_table_LCMAG ( ifiltdef_b, T, z, av_min ) ;
-    lc_color_min = lc_mag_a - lc_mag_b ;
-
-    lc_mag_a = eval_kcor_table_LCMAG ( ifiltdef_a, T, z, av_max ) ;
-    lc_mag_b = eval_kcor_table_LCMAG ( ifiltdef_b, T, z, av_max ) ;
-    lc_color_max = lc_mag_a - lc_mag_b ;
+    // get color at current av_best, and store color at av_min & max;
+    // Oct 2026: one batched call for the 6 mags
+    AV_LIST6[0] = AV_LIST6[1] = av_best ;
+    AV_LIST6[2] = AV_LIST6[3] = av_min ;
+    AV_LIST6[4] = AV_LIST6[5] = av_max ;
+    eval_kcor_table_LCMAG_list(6, IFILTDEF_LIST6, T_LIST6, z, AV_LIST6,
+			       MAG_LIST6);
+    lc_color_best = MAG_LIST6[0] - MAG_LIST6[1] ;
+    lc_color_min  = MAG_LIST6[2] - MAG_LIST6[3] ;
+    lc_color_max  = MAG_LIST6[4] - MAG_LIST6[5] ;
 
     av_min_dump = av_min ;
     av_max_dump = av_max ;
@@ -2884,6 +2896,8 @@ void prepare_kcor_table_KCOR(void) {
 		      OPT_EXTRAP_KCOR, TEMP_KCOR_ARRAY, &TEMP_KCOR_ARRAY[NDIM_INP],
 		      &KCOR_TABLE.GRIDMAP_KCOR); // <== returned
 
+  init_kcor_fastmap(&KCOR_TABLE.GRIDMAP_KCOR, 3, &KCOR_TABLE.FASTMAP_KCOR);
+
   printf("\t Allocate %.1f/%.1f MB of GRIDMAP/temp memory for %s\n", 
 	 KCOR_TABLE.GRIDMAP_KCOR.MEMORY, temp_mem, MAPNAME );
   fflush(stdout);
@@ -2895,6 +2909,186 @@ void prepare_kcor_table_KCOR(void) {
 
 } // end prepare_kcor_table_KCOR
 
+
+// ==============================================
+void init_kcor_fastmap(GRIDMAP_DEF *GRIDMAP, int NDIM_CONT, 
+		       KCOR_FASTMAP_DEF *FASTMAP) {
+
+  // Created Oct 2026
+  // Copy binning of input *GRIDMAP into *FASTMAP, compute 1D strides
+  // (same convention as init_1DINDEX: first dim is fastest) and
+  // store a dense copy of the function so that evaluation needs
+  // neither get_1DINDEX nor INVMAP. The first NDIM_CONT dims are
+  // interpolated; the remaining dims are integer filter indices.
+
+  int NDIM    = GRIDMAP->NDIM ;
+  int MAPSIZE = GRIDMAP->NROW ;
+  int idim, j, icorner, OFFSET ;
+  char fnam[] = "init_kcor_fastmap" ;
+
+  // ----------- BEGIN -------------
+
+  if ( NDIM > NKDIM_KCOR || (1 << NDIM_CONT) > MXCORNER_KCOR_FASTMAP ) {
+    sprintf(c1err,"Invalid NDIM=%d or NDIM_CONT=%d for GRIDMAP ID=%d",
+	    NDIM, NDIM_CONT, GRIDMAP->ID);
+    sprintf(c2err,"Check NKDIM_KCOR=%d and MXCORNER_KCOR_FASTMAP=%d",
+	    NKDIM_KCOR, MXCORNER_KCOR_FASTMAP);
+    errmsg(SEV_FATAL, 0, fnam, c1err, c2err);
+  }
+
+  FASTMAP->NDIM      = NDIM ;
+  FASTMAP->NDIM_CONT = NDIM_CONT ;
+
+  for(idim=0; idim < NDIM; idim++ ) {
+    FASTMAP->NBIN[idim]   = GRIDMAP->NBIN[idim];
+    FASTMAP->VALMIN[idim] = GRIDMAP->VALMIN[idim];
+    FASTMAP->VALMAX[idim] = GRIDMAP->VALMAX[idim];
+    FASTMAP->VALBIN[idim] = GRIDMAP->VALBIN[idim];
+    if ( idim == 0 ) 
+      { FASTMAP->STRIDE[idim] = 1; }
+    else
+      { FASTMAP->STRIDE[idim] = 
+	  FASTMAP->STRIDE[idim-1] * FASTMAP->NBIN[idim-1]; }
+  }
+
+  // offset of each cell corner w.r.t. lower corner; a single-bin
+  // dim has no upper neighbor, so its corner bit does not move.
+  FASTMAP->NCORNER = 1 << NDIM_CONT ;
+  for(icorner=0; icorner < FASTMAP->NCORNER; icorner++ ) {
+    OFFSET = 0 ;
+    for(idim=0; idim < NDIM_CONT; idim++ ) {
+      if ( (icorner & (1<<idim)) && FASTMAP->NBIN[idim] > 1 ) 
+	{ OFFSET += FASTMAP->STRIDE[idim]; }
+    }
+    FASTMAP->CORNER_OFFSET[icorner] = OFFSET ;
+  }
+
+  // free previous copy if map is rebuilt
+  if ( FASTMAP->FUNVAL != NULL ) { free(FASTMAP->FUNVAL); }
+  FASTMAP->FUNVAL = (double*) malloc( MAPSIZE * sizeof(double) );
+  for(j=0; j < MAPSIZE; j++ ) 
+    { FASTMAP->FUNVAL[j] = GRIDMAP->FUNVAL[0][GRIDMAP->INVMAP[j]]; }
+
+  return ;
+
+} // end init_kcor_fastmap
+
+
+// ==============================================
+int get_ifilt_kcor_fastmap(FILTERCAL_DEF *FILTERCAL, int ifiltdef, 
+			   char *frame, char *callFun) {
+
+  // Created Oct 2026
+  // Return sparse filter index for absolute index ifiltdef;
+  // abort if ifiltdef is out of bounds or filter is not defined.
+  // frame is "rest" or "obs" for error message.
+
+  int  ifilt = -9 ;
+  char fnam[] = "get_ifilt_kcor_fastmap" ;
+
+  // ----------- BEGIN -------------
+
+  if ( ifiltdef >= 0 && ifiltdef < MXFILT_CALIB ) 
+    { ifilt = FILTERCAL->IFILTDEF_INV[ifiltdef]; }
+
+  if ( ifilt < 0 || ifilt >= FILTERCAL->NFILTDEF ) {
+    sprintf(c1err,"Invalid sparse index ifilt=%d for ifiltdef_%s=%d",
+	    ifilt, frame, ifiltdef);
+    sprintf(c2err,"%s-frame filter is not defined (callFun=%s)", 
+	    frame, callFun);
+    errmsg(SEV_FATAL, 0, fnam, c1err, c2err);    
+  }
+
+  return ifilt ;
+
+} // end get_ifilt_kcor_fastmap
+
+
+// ==============================================
+void locate_kcor_fastmap(KCOR_FASTMAP_DEF *FASTMAP, int idim, double VAL,
+			 int *IGRID, double *FRAC) {
+
+  // Created Oct 2026
+  // For continuous dimension idim, return lower grid index *IGRID and
+  // fractional cell location *FRAC (0-1) using uniform-bin direct
+  // indexing. Edge tolerance and extrapolation (snap to edge; 
+  // OPT_EXTRAP_KCOR) follow interp_GRIDMAP so that results agree.
+
+  double TMPMIN   = FASTMAP->VALMIN[idim];
+  double TMPMAX   = FASTMAP->VALMAX[idim];
+  double TMPBIN   = FASTMAP->VALBIN[idim];
+  double TMPRANGE = TMPMAX - TMPMIN ;
+  double EPSILON  = 1.0E-8 ;
+  double TMPVAL   = VAL, TMPDIF, XNBIN ;
+  int    igrid ;
+
+  // ----------- BEGIN -------------
+
+  if ( FASTMAP->NBIN[idim] <= 1 || TMPBIN == 0.0 ) 
+    { *IGRID = 0;  *FRAC = 0.0;  return; }
+
+  TMPMAX += (1.0E-14*TMPRANGE);
+  TMPMIN -= (1.0E-14*TMPRANGE);
+
+  if ( TMPVAL < TMPMIN ) { TMPVAL = TMPMIN + (TMPRANGE*1.0E-12); }
+  if ( TMPVAL > TMPMAX ) { TMPVAL = TMPMAX - (TMPRANGE*1.0E-12); }
+
+  TMPDIF  = TMPVAL - TMPMIN ;
+  if ( (TMPMAX - TMPVAL)/TMPRANGE < EPSILON  )  
+    { XNBIN = (TMPDIF - TMPRANGE*EPSILON)/TMPBIN ; }
+  else 
+    { XNBIN = (TMPDIF + TMPRANGE*EPSILON)/TMPBIN ; }
+
+  igrid  = (int)(XNBIN);
+  *IGRID = igrid ;
+  *FRAC  = TMPDIF/TMPBIN - (double)igrid ;
+
+  return ;
+
+} // end locate_kcor_fastmap
+
+
+// ==============================================
+double interp_kcor_fastmap(KCOR_FASTMAP_DEF *FASTMAP, int *IGRID, 
+			   double *FRAC, int *IFILT) {
+
+  // Created Oct 2026
+  // Return multi-linear interpolation on cell with lower corner 
+  // IGRID[0:NDIM_CONT-1] and fractional location FRAC[], for 
+  // integer indices IFILT[0:NDIM-NDIM_CONT-1] in remaining dims.
+
+  int NDIM      = FASTMAP->NDIM ;
+  int NDIM_CONT = FASTMAP->NDIM_CONT ;
+  int idim, icorner, BASE = 0 ;
+  double WGT, WGT_SUM = 0.0, CORNER_WGTSUM = 0.0 ;
+  double *FUNVAL ;
+
+  // ----------- BEGIN -------------
+
+  for(idim=0; idim < NDIM_CONT; idim++ ) 
+    { BASE += IGRID[idim] * FASTMAP->STRIDE[idim]; }
+  for(idim=NDIM_CONT; idim < NDIM; idim++ ) 
+    { BASE += IFILT[idim-NDIM_CONT] * FASTMAP->STRIDE[idim]; }
+
+  FUNVAL = &FASTMAP->FUNVAL[BASE] ;
+
+  for(icorner=0; icorner < FASTMAP->NCORNER; icorner++ ) {
+    WGT = 1.0 ;
+    for(idim=0; idim < NDIM_CONT; idim++ ) {
+      if ( icorner & (1<<idim) ) 
+	{ WGT *= FRAC[idim] ; }
+      else
+	{ WGT *= (1.0 - FRAC[idim]) ; }
+    }
+    CORNER_WGTSUM += WGT ;
+    WGT_SUM       += WGT * FUNVAL[FASTMAP->CORNER_OFFSET[icorner]] ;
+  }
+
+  return WGT_SUM/CORNER_WGTSUM ;
+
+} // end interp_kcor_fastmap
+
+
 int nearest_ifiltdef_rest(int OPT, int IFILTDEF, int RANK_WANT, double z, 
 			  char *callFun, double *LAMDIF_MIN ) {
 
@@ -3297,41 +3491,62 @@ double eval_kcor_table_LCMAG(int ifiltdef_rest, double Trest, double z, double A
 
   // Created Nov 2022
   // Return rest-frame mag for input Test, z, AV(warp)
+  // Oct 2026: evaluate with fast map via eval_kcor_table_LCMAG_list
+
+  double LCMAG = 0.0 ;
+  eval_kcor_table_LCMAG_list(1, &ifiltdef_rest, &Trest, z, &AVwarp, &LCMAG);
+  return LCMAG;
 
-  GRIDMAP_DEF   *KCOR_GRIDMAP = &KCOR_TABLE.GRIDMAP_LCMAG ;
-  FILTERCAL_DEF *FILTERCAL    = &CALIB_INFO.FILTERCAL_REST;
-  int            ifilt_r      = FILTERCAL->IFILTDEF_INV[ifiltdef_rest];
-  int           NFILTDEF_REST = FILTERCAL->NFILTDEF;
-  int istat ;
-  double LCMAG = 0.0, GRIDVAL_LIST[4] ;
-  char fnam[] = "eval_kcor_table_LCMAG" ;
+} // end eval_kcor_table_LCMAG
+
+double eval_kcor_table_lcmag__(int *ifiltdef_rest, double *Trest,
+                               double *z, double *AVwarp) {
+  return eval_kcor_table_LCMAG(*ifiltdef_rest, *Trest, *z, *AVwarp);
+}
+
+void eval_kcor_table_LCMAG_list(int NOBS, int *ifiltdef_rest_list, 
+				double *Trest_list, double z, 
+				double *AVwarp_list, double *LCMAG_list) {
+
+  // Created Oct 2026
+  // Batched LCMAG evaluation for NOBS epochs of one light curve.
+  // Redshift cell is located once; Trest and AVwarp per epoch.
+
+  KCOR_FASTMAP_DEF *FASTMAP   = &KCOR_TABLE.FASTMAP_LCMAG ;
+  FILTERCAL_DEF    *FILTERCAL = &CALIB_INFO.FILTERCAL_REST;
+  int   o, ifilt_r, IGRID[N4DIM_KCOR] ;
+  double FRAC[N4DIM_KCOR];
+  char fnam[] = "eval_kcor_table_LCMAG_list" ;
 
   // --------------- BEGIN ------------
 
+  locate_kcor_fastmap(FASTMAP, KDIM_z, z, &IGRID[KDIM_z], &FRAC[KDIM_z]);
 
-  if ( ifilt_r < 0 || ifilt_r >= NFILTDEF_REST ) {
-    sprintf(c1err,"Invalid sparse index ifilt_r=%d for ifiltdef_r=%d",
-	    ifilt_r, ifiltdef_rest);
-    sprintf(c2err,"Rest frame filter is not defined");
-    errmsg(SEV_FATAL, 0, fnam, c1err, c2err);    
-  }
+  for(o=0; o < NOBS; o++ ) {
+    ifilt_r = get_ifilt_kcor_fastmap(FILTERCAL, ifiltdef_rest_list[o],
+				     "rest", fnam);
 
-  GRIDVAL_LIST[0] = Trest;
-  GRIDVAL_LIST[1] = z;
-  GRIDVAL_LIST[2] = AVwarp ;
-  GRIDVAL_LIST[3] = (double)ifilt_r ;
-  
-  istat = interp_GRIDMAP(KCOR_GRIDMAP, GRIDVAL_LIST, &LCMAG);
+    locate_kcor_fastmap(FASTMAP, KDIM_T, Trest_list[o], 
+			&IGRID[KDIM_T], &FRAC[KDIM_T]);
+    locate_kcor_fastmap(FASTMAP, KDIM_AV, AVwarp_list[o], 
+			&IGRID[KDIM_AV], &FRAC[KDIM_AV]);
 
-  return LCMAG;
+    LCMAG_list[o] = interp_kcor_fastmap(FASTMAP, IGRID, FRAC, &ifilt_r);
+  }
 
-} // end eval_kcor_table_LCMAG
+  return ;
 
-double eval_kcor_table_lcmag__(int *ifiltdef_rest, double *Trest,
-                               double *z, double *AVwarp) {
-  return eval_kcor_table_LCMAG(*ifiltdef_rest, *Trest, *z, *AVwarp);
+} // end eval_kcor_table_LCMAG_list
+
+void eval_kcor_table_lcmag_list__(int *NOBS, int *ifiltdef_rest_list, 
+				  double *Trest_list, double *z, 
+				  double *AVwarp_list, double *LCMAG_list) {
+  eval_kcor_table_LCMAG_list(*NOBS, ifiltdef_rest_list, Trest_list, *z,
+			     AVwarp_list, LCMAG_list);
 }
 
+
+// ==========================================================
 double eval_kcor_table_MWXT(int ifiltdef_obs, double Trest, double z, double AVwarp,
                      double MWEBV, double RV, int OPT_MWCOLORLAW) {
 
@@ -3340,34 +3555,13 @@ double eval_kcor_table_MWXT(int ifiltdef_obs, double Trest, double z, double AVw
   // If RV or OPT_MWCOLORAW is different than what was used
   // to produce kcor/calib file, compute corretion based on
   // central wavelength of band.
+  // Oct 2026: evaluate with fast map via eval_kcor_table_MWXT_list
 
-  GRIDMAP_DEF   *KCOR_GRIDMAP = &KCOR_TABLE.GRIDMAP_MWXT ;
-  FILTERCAL_DEF *FILTERCAL    = &CALIB_INFO.FILTERCAL_OBS;
-  int            ifilt_o      = FILTERCAL->IFILTDEF_INV[ifiltdef_obs];
-  int            NFILTDEF_OBS = FILTERCAL->NFILTDEF;
-  int istat ;
-  double MWXT = 0.0, GRIDVAL_LIST[4] ;
-  char fnam[] = "eval_kcor_table_MWXT";
-
-  // --------------- BEGIN ------------
-
-  if ( ifilt_o < 0 || ifilt_o >= NFILTDEF_OBS ) {
-    sprintf(c1err,"Invalid sparse index ifilt_o=%d for ifiltdef_obs=%d",
-	    ifilt_o, ifiltdef_obs);
-    sprintf(c2err,"Obs frame filter is not defined");
-    errmsg(SEV_FATAL, 0, fnam, c1err, c2err);    
-  }
-
-  GRIDVAL_LIST[0] = Trest;
-  GRIDVAL_LIST[1] = z;
-  GRIDVAL_LIST[2] = AVwarp;
-  GRIDVAL_LIST[3] = (double)ifilt_o ;
-  
-  interp_GRIDMAP(KCOR_GRIDMAP, GRIDVAL_LIST, &MWXT); 
-
-  MWXT *= MWEBV;
-
+  double MWXT = 0.0 ;
+  eval_kcor_table_MWXT_list(1, &ifiltdef_obs, &Trest, z, &AVwarp, MWEBV,
+			    &MWXT);
   return MWXT ;
+
 } // end eval_kcor_table_MWXT
 
 
@@ -3378,6 +3572,48 @@ double eval_kcor_table_mwxt__(int *ifiltdef_obs, double *Trest,
 			      *MWEBV, *RV, *OPT_MWCOLORLAW);
 }
 
+void eval_kcor_table_MWXT_list(int NOBS, int *ifiltdef_obs_list, 
+			       double *Trest_list, double z, 
+			       double *AVwarp_list, double MWEBV, 
+			       double *MWXT_list) {
+
+  // Created Oct 2026
+  // Batched MWXT evaluation for NOBS epochs of one light curve.
+
+  KCOR_FASTMAP_DEF *FASTMAP   = &KCOR_TABLE.FASTMAP_MWXT ;
+  FILTERCAL_DEF    *FILTERCAL = &CALIB_INFO.FILTERCAL_OBS;
+  int   o, ifilt_o, IGRID[N4DIM_KCOR] ;
+  double FRAC[N4DIM_KCOR];
+  char fnam[] = "eval_kcor_table_MWXT_list";
+
+  // --------------- BEGIN ------------
+
+  locate_kcor_fastmap(FASTMAP, KDIM_z, z, &IGRID[KDIM_z], &FRAC[KDIM_z]);
+
+  for(o=0; o < NOBS; o++ ) {
+    ifilt_o = get_ifilt_kcor_fastmap(FILTERCAL, ifiltdef_obs_list[o],
+				     "obs", fnam);
+
+    locate_kcor_fastmap(FASTMAP, KDIM_T, Trest_list[o], 
+			&IGRID[KDIM_T], &FRAC[KDIM_T]);
+    locate_kcor_fastmap(FASTMAP, KDIM_AV, AVwarp_list[o], 
+			&IGRID[KDIM_AV], &FRAC[KDIM_AV]);
+
+    MWXT_list[o] = MWEBV * interp_kcor_fastmap(FASTMAP, IGRID, FRAC, &ifilt_o);
+  }
+
+  return ;
+
+} // end eval_kcor_table_MWXT_list
+
+void eval_kcor_table_mwxt_list__(int *NOBS, int *ifiltdef_obs_list, 
+				 double *Trest_list, double *z, 
+				 double *AVwarp_list, double *MWEBV, 
+				 double *MWXT_list) {
+  eval_kcor_table_MWXT_list(*NOBS, ifiltdef_obs_list, Trest_list, *z,
+			    AVwarp_list, *MWEBV, MWXT_list);
+}
+
 // ==========================================================
 double eval_kcor_table_AVWARP(int ifiltdef_a, int ifiltdef_b, 
 			      double mag_a, double mag_b, 
@@ -3394,49 +3630,80 @@ double eval_kcor_table_AVWARP(int ifiltdef_a, int ifiltdef_b,
   //
   // Output istat: 0=> OK, -1 => lower AVwarp bound, +1 => upper AVwarp limit
   //
-  // NOT_DONE
+  // Oct 2026: evaluate with fast map via eval_kcor_table_AVWARP_list
 
-  GRIDMAP_DEF  *KCOR_GRIDMAP = &KCOR_TABLE.GRIDMAP_AVWARP ;
-  int ifilt_a            = CALIB_INFO.FILTERCAL_REST.IFILTDEF_INV[ifiltdef_a];
-  int ifilt_b            = CALIB_INFO.FILTERCAL_REST.IFILTDEF_INV[ifiltdef_b];
-  double   AVwarp = 0.0 ;
-  double C, GRIDVAL_LIST[4];
-  bool LDMP = CALIB_OPTIONS.DUMP_AVWARP;
-  char fnam[] = "eval_kcor_table_AVwarp" ;
+  double AVwarp = 0.0 ;
+  eval_kcor_table_AVWARP_list(1, &ifiltdef_a, &ifiltdef_b, &mag_a, &mag_b,
+			      &Trest, istat, &AVwarp);
+  return AVwarp;
 
-  // -------------- BEGIN ------------
+} // end eval_kcor_table_AVwarp
 
-  *istat = 0 ;
-  // return on crazy value
-  if ( mag_a >  40.0 || mag_b >  40.0 ) { return AVwarp; }
-  if ( Trest < -19.0 || Trest > 200.0 ) { return AVwarp; }
+double eval_kcor_table_avwarp__(int *ifiltdef_a, int *ifiltdef_b,
+                                double *mag_a,double *mag_b,
+                                double *Trest, int *istat) {
+  return eval_kcor_table_AVWARP(*ifiltdef_a, *ifiltdef_b, *mag_a, *mag_b,
+				*Trest, istat);
+}
 
-  // define color 
-  C = mag_a - mag_b ;
+void eval_kcor_table_AVWARP_list(int NOBS, int *ifiltdef_a_list, 
+				 int *ifiltdef_b_list,
+				 double *mag_a_list, double *mag_b_list,
+				 double *Trest_list, int *istat_list, 
+				 double *AVwarp_list) {
 
-  GRIDVAL_LIST[0] = Trest;
-  GRIDVAL_LIST[1] = C;
-  GRIDVAL_LIST[2] = (double)ifilt_b ;
-  GRIDVAL_LIST[3] = (double)ifilt_a ;
-  
-  interp_GRIDMAP(KCOR_GRIDMAP, GRIDVAL_LIST, &AVwarp);
+  // Created Oct 2026
+  // Batched AVWARP evaluation; see eval_kcor_table_AVWARP for
+  // definition of each input and output.
 
+  KCOR_FASTMAP_DEF *FASTMAP    = &KCOR_TABLE.FASTMAP_AVWARP ;
   KCOR_BININFO_DEF *BININFO_AV = &CALIB_INFO.BININFO_AV;
+  FILTERCAL_DEF    *FILTERCAL  = &CALIB_INFO.FILTERCAL_REST;
+  int    o, IGRID[2], IFILT[2] ;
+  double FRAC[2], AVwarp, mag_a, mag_b, Trest, C ;
+  char fnam[] = "eval_kcor_table_AVWARP_list" ;
 
-  if ( AVwarp <= (BININFO_AV->RANGE[0]+1.0E-6) ) 
-    { AVwarp = BININFO_AV->RANGE[0];  *istat = -1; }
-  if ( AVwarp >= (BININFO_AV->RANGE[1]-1.0E-6) ) 
-    { AVwarp = BININFO_AV->RANGE[1];  *istat = +1; }
+  // -------------- BEGIN ------------
 
-  return AVwarp;
+  for(o=0; o < NOBS; o++ ) {
+    mag_a = mag_a_list[o];  mag_b = mag_b_list[o];  Trest = Trest_list[o];
+    istat_list[o] = 0 ;  AVwarp_list[o] = AVwarp = 0.0 ;
 
-} // end eval_kcor_table_AVwarp
+    // skip crazy value
+    if ( mag_a >  40.0 || mag_b >  40.0 ) { continue; }
+    if ( Trest < -19.0 || Trest > 200.0 ) { continue; }
 
-double eval_kcor_table_avwarp__(int *ifiltdef_a, int *ifiltdef_b,
-                                double *mag_a,double *mag_b,
-                                double *Trest, int *istat) {
-  return eval_kcor_table_AVWARP(*ifiltdef_a, *ifiltdef_b, *mag_a, *mag_b,
-				*Trest, istat);
+    // define color 
+    C = mag_a - mag_b ;
+
+    IFILT[0] = get_ifilt_kcor_fastmap(FILTERCAL, ifiltdef_b_list[o], 
+				      "rest", fnam);
+    IFILT[1] = get_ifilt_kcor_fastmap(FILTERCAL, ifiltdef_a_list[o], 
+				      "rest", fnam);
+    locate_kcor_fastmap(FASTMAP, 0, Trest, &IGRID[0], &FRAC[0]);
+    locate_kcor_fastmap(FASTMAP, 1, C,     &IGRID[1], &FRAC[1]);
+    AVwarp = interp_kcor_fastmap(FASTMAP, IGRID, FRAC, IFILT);
+
+    if ( AVwarp <= (BININFO_AV->RANGE[0]+1.0E-6) ) 
+      { AVwarp = BININFO_AV->RANGE[0];  istat_list[o] = -1; }
+    if ( AVwarp >= (BININFO_AV->RANGE[1]-1.0E-6) ) 
+      { AVwarp = BININFO_AV->RANGE[1];  istat_list[o] = +1; }
+
+    AVwarp_list[o] = AVwarp ;
+  }
+
+  return ;
+
+} // end eval_kcor_table_AVWARP_list
+
+void eval_kcor_table_avwarp_list__(int *NOBS, int *ifiltdef_a_list, 
+				   int *ifiltdef_b_list,
+				   double *mag_a_list, double *mag_b_list,
+				   double *Trest_list, int *istat_list, 
+				   double *AVwarp_list) {
+  eval_kcor_table_AVWARP_list(*NOBS, ifiltdef_a_list, ifiltdef_b_list,
+			      mag_a_list, mag_b_list, Trest_list, 
+			      istat_list, AVwarp_list);
 }
 
 
@@ -3444,27 +3711,49 @@ double eval_kcor_table_avwarp__(int *ifiltdef_a, int *ifiltdef_b,
 double eval_kcor_table_KCOR(int ifiltdef_rest, int ifiltdef_obs, double Trest,
 			    double z,double AVwarp) {
 
-
-  int ifilt_r = CALIB_INFO.FILTERCAL_REST.IFILTDEF_INV[ifiltdef_rest];
-  int ifilt_o = CALIB_INFO.FILTERCAL_OBS.IFILTDEF_INV[ifiltdef_obs];
-  GRIDMAP_DEF *KCOR_GRIDMAP =  &KCOR_TABLE.GRIDMAP_KCOR ;
+  // Oct 2026: evaluate with fast map via eval_kcor_table_KCOR_list
 
   double KCOR = 0.0 ; // kcor value return-arg
-  double GRIDVAL_LIST[10];
-  char fnam[] = "eval_kcor_table_KCOR" ;
+  eval_kcor_table_KCOR_list(1, &ifiltdef_rest, &ifiltdef_obs, &Trest, z, 
+			    &AVwarp, &KCOR);
+  return KCOR;
+
+} // end eval_kcor_table_KCOR
+
+void eval_kcor_table_KCOR_list(int NOBS, int *ifiltdef_rest_list, 
+			       int *ifiltdef_obs_list, double *Trest_list, 
+			       double z, double *AVwarp_list, 
+			       double *KCOR_list) {
+
+  // Created Oct 2026
+  // Batched KCOR evaluation for NOBS epochs of one light curve.
+
+  KCOR_FASTMAP_DEF *FASTMAP = &KCOR_TABLE.FASTMAP_KCOR ;
+  FILTERCAL_DEF *FILTERCAL_REST = &CALIB_INFO.FILTERCAL_REST;
+  FILTERCAL_DEF *FILTERCAL_OBS  = &CALIB_INFO.FILTERCAL_OBS;
+  int    o, IGRID[N4DIM_KCOR], IFILT[2] ;
+  double FRAC[N4DIM_KCOR];
+  char fnam[] = "eval_kcor_table_KCOR_list" ;
 
   // ------------- BEGIN ---------------
-  
-  GRIDVAL_LIST[0] = Trest;
-  GRIDVAL_LIST[1] = z;
-  GRIDVAL_LIST[2] = AVwarp;
-  GRIDVAL_LIST[3] = (double)ifilt_r ;
-  GRIDVAL_LIST[4] = (double)ifilt_o ;
-  
-  interp_GRIDMAP(KCOR_GRIDMAP, GRIDVAL_LIST, &KCOR); 
 
-  return KCOR;
+  locate_kcor_fastmap(FASTMAP, KDIM_z, z, &IGRID[KDIM_z], &FRAC[KDIM_z]);
+
+  for(o=0; o < NOBS; o++ ) {
+    IFILT[0] = get_ifilt_kcor_fastmap(FILTERCAL_REST, ifiltdef_rest_list[o],
+				      "rest", fnam);
+    IFILT[1] = get_ifilt_kcor_fastmap(FILTERCAL_OBS, ifiltdef_obs_list[o],
+				      "obs", fnam);
+    locate_kcor_fastmap(FASTMAP, KDIM_T, Trest_list[o], 
+			&IGRID[KDIM_T], &FRAC[KDIM_T]);
+    locate_kcor_fastmap(FASTMAP, KDIM_AV, AVwarp_list[o], 
+			&IGRID[KDIM_AV], &FRAC[KDIM_AV]);
+    KCOR_list[o] = interp_kcor_fastmap(FASTMAP, IGRID, FRAC, IFILT);
+  }
+
+  return ;
+
+} // end eval_kcor_table_KCOR_list
 
-} // end eval_kcor_table_KCOR
 
 // ===== END =====
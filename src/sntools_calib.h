@@ -176,11 +176,30 @@ struct CALIB_INFO {
 
 double **TEMP_KCOR_ARRAY;
 
+// Oct 2026: fast evaluator for KCOR GRIDMAPs. First NDIM_CONT dims
+// (Trest,z,AV or Trest,C) are multi-linear on uniform bins; remaining
+// dims are integer filter indices that are looked up directly.
+#define MXCORNER_KCOR_FASTMAP 8  // 2^(max continuous dims)
+typedef struct {
+  int    NDIM, NDIM_CONT ;
+  int    NBIN[NKDIM_KCOR];
+  int    STRIDE[NKDIM_KCOR];     // 1D offset per unit index in each dim
+  double VALMIN[NKDIM_KCOR], VALMAX[NKDIM_KCOR], VALBIN[NKDIM_KCOR];
+  int    NCORNER;
+  int    CORNER_OFFSET[MXCORNER_KCOR_FASTMAP]; // 1D offset of cell corners
+  double *FUNVAL ;               // dense copy vs. 1D index (no INVMAP)
+} KCOR_FASTMAP_DEF ;
+
 struct {
   GRIDMAP_DEF GRIDMAP_LCMAG;
   GRIDMAP_DEF GRIDMAP_MWXT;
   GRIDMAP_DEF GRIDMAP_AVWARP ;
   GRIDMAP_DEF GRIDMAP_KCOR;
+
+  KCOR_FASTMAP_DEF FASTMAP_LCMAG;
+  KCOR_FASTMAP_DEF FASTMAP_MWXT;
+  KCOR_FASTMAP_DEF FASTMAP_AVWARP;
+  KCOR_FASTMAP_DEF FASTMAP_KCOR;
 } KCOR_TABLE ;
 
 
@@ -285,6 +304,14 @@ void prepare_kcor_table_MWXT(void);
 void prepare_kcor_table_AVWARP(void);
 double fit_AVWARP(int ifiltdef_a, int ifiltdef_b, double T, double C);
 void prepare_kcor_table_KCOR(void);
+void init_kcor_fastmap(GRIDMAP_DEF *GRIDMAP, int NDIM_CONT, 
+		       KCOR_FASTMAP_DEF *FASTMAP);
+int  get_ifilt_kcor_fastmap(FILTERCAL_DEF *FILTERCAL, int ifiltdef,
+			    char *frame, char *callFun);
+void locate_kcor_fastmap(KCOR_FASTMAP_DEF *FASTMAP, int idim, double VAL,
+			 int *IGRID, double *FRAC);
+double interp_kcor_fastmap(KCOR_FASTMAP_DEF *FASTMAP, int *IGRID, 
+			   double *FRAC, int *IFILT);
 
 int nearest_ifiltdef_rest( int opt, int ifiltdef, int rank, double z, char *callFun,
 			   double *lamdif_min );
@@ -326,6 +353,39 @@ double eval_kcor_table_avwarp__(int *ifiltdef_a, int *ifiltdef_b,
 double eval_kcor_table_KCOR(int ifiltdef_rest, int ifiltdef_obs, double Trest, 
 			    double z, double AVwarp);
 
+// batched versions: all epochs of one light curve (common z) in one call
+void eval_kcor_table_LCMAG_list(int NOBS, int *ifiltdef_rest_list, 
+				double *Trest_list, double z, 
+				double *AVwarp_list, double *LCMAG_list);
+void eval_kcor_table_lcmag_list__(int *NOBS, int *ifiltdef_rest_list, 
+				  double *Trest_list, double *z, 
+				  double *AVwarp_list, double *LCMAG_list);
+
+void eval_kcor_table_MWXT_list(int NOBS, int *ifiltdef_obs_list, 
+			       double *Trest_list, double z, 
+			       double *AVwarp_list, double MWEBV, 
+			       double *MWXT_list);
+void eval_kcor_table_mwxt_list__(int *NOBS, int *ifiltdef_obs_list, 
+				 double *Trest_list, double *z, 
+				 double *AVwarp_list, double *MWEBV, 
+				 double *MWXT_list);
+
+void eval_kcor_table_AVWARP_list(int NOBS, int *ifiltdef_a_list, 
+				 int *ifiltdef_b_list,
+				 double *mag_a_list, double *mag_b_list,
+				 double *Trest_list, int *istat_list, 
+				 double *AVwarp_list);
+void eval_kcor_table_avwarp_list__(int *NOBS, int *ifiltdef_a_list, 
+				   int *ifiltdef_b_list,
+				   double *mag_a_list, double *mag_b_list,
+				   double *Trest_list, int *istat_list, 
+				   double *AVwarp_list);
+
+void eval_kcor_table_KCOR_list(int NOBS, int *ifiltdef_rest_list, 
+			       int *ifiltdef_obs_list, double *Trest_list, 
+			       double z, double *AVwarp_list, 
+			       double *KCOR_list);
+
 void get_kcor_zrange(double *zmin, double *zmax, double *zbin);
 void get_kcor_zrange__(double *zmin, double *zmax, double *zbin);
 
@@ -532,13 +532,31 @@ double dLmag ( double zCMB, double zHEL, double vPEC,
   //
   // Feb 2023: pass ANISOTROPY_INFO to enable anistropy models
   // Jan 2024: add vPEC relativistic beaming
+  // Oct 2026: move DL->mu part to dLmag_rz
 
-  bool  DO_VPEC_COR = true; // default should be true
-  double rz, dl, arg, mu, zero=0.0 ;
+  double rz, zero=0.0 ;
   char fnam[] = "dLmag";
   
   // ----------- BEGIN -----------
   rz     = Hzinv_integral(zero,zCMB,HzFUN_INFO) ;
+  return dLmag_rz(rz, zCMB, zHEL, vPEC, HzFUN_INFO, ANISOTROPY_INFO);
+
+}  // end of dLmag
+
+
+// ******************************************
+double dLmag_rz(double rz, double zCMB, double zHEL, double vPEC, 
+		HzFUN_INFO_DEF *HzFUN_INFO, 
+		ANISOTROPY_INFO_DEF *ANISOTROPY_INFO) {
+
+  // Created Oct 2026 [code moved from dLmag]
+  // Return dLmag for input rz = Hzinv_integral(0,zCMB), so that rz
+  // can be computed either by integration or from z-grid table.
+
+  bool  DO_VPEC_COR = true; // default should be true
+  double dl, arg, mu ;
+
+  // ----------- BEGIN -----------
   rz    *= (1.0E6*PC_km);  // H -> 1/sec units
   dl     = ( 1.0 + zHEL ) * rz ; 
 
@@ -554,7 +572,7 @@ double dLmag ( double zCMB, double zHEL, double vPEC,
   }
 
   return mu ;
-}  // end of dLmag
+}  // end of dLmag_rz
 
 
 // ===============================================
@@ -599,6 +617,282 @@ double dLmag_anisotropic (double mu_isotropic, double zCMB, double zHEL, double
 } // end dLmag_anisotropic
 
 
+// =====================================================
+//
+//   z-grid table of distance integral
+//
+// =====================================================
+
+void init_COSMO_ZGRID(double ZMAX, double DZBIN, HzFUN_INFO_DEF *HzFUN_INFO,
+		      COSMO_ZGRID_DEF *ZGRID) {
+
+  // Created Oct 2026
+  // Tabulate E(z)^{-1} = H0/H(z) and its cumulative integral
+  //   DC(z) = int_0^z dz'/E(z')
+  // on a uniform z-grid with bin size DZBIN up to ZMAX.
+  // Each DC bin is integrated with Simpson's rule, and DC(z) is
+  // later evaluated with cubic Hermite interpolation using
+  // dDC/dz = EINV at each node. Beyond ZMAX, the integral is
+  // extended numerically from the last node.
+  //
+  // Input ZGRID must be zero-initialized before first call;
+  // arrays are re-used if large enough.
+
+  double H0 = HzFUN_INFO->COSPAR_LIST[ICOSPAR_HzFUN_H0];
+  int    NZBIN, iz, MEMD ;
+  double z0, z1, zmid, f0, fmid, f1 ;
+  char fnam[] = "init_COSMO_ZGRID" ;
+
+  // ------------ BEGIN -------------
+
+  if ( ZMAX <= 0.0 || DZBIN <= 0.0 ) {
+    sprintf(c1err,"Invalid ZMAX=%f or DZBIN=%f", ZMAX, DZBIN);
+    sprintf(c2err,"Both must be > 0");
+    errmsg(SEV_FATAL, 0, fnam, c1err, c2err);
+  }
+
+  NZBIN = (int)ceil( ZMAX/DZBIN - 1.0E-9 );
+  if ( NZBIN < 10 ) { NZBIN = 10; }
+
+  if ( ZGRID->NZBIN_ALLOC < NZBIN ) {
+    MEMD = (NZBIN+1) * sizeof(double);
+    ZGRID->EINV = (double*) realloc(ZGRID->EINV, MEMD);
+    ZGRID->DC   = (double*) realloc(ZGRID->DC,   MEMD);
+    ZGRID->NZBIN_ALLOC = NZBIN ;
+  }
+
+  ZGRID->NZBIN      = NZBIN ;
+  ZGRID->DZBIN      = ZMAX / (double)NZBIN ;
+  ZGRID->ZMAX       = ZMAX ;
+  ZGRID->HzFUN_INFO = *HzFUN_INFO ;
+
+  ZGRID->EINV[0] = H0 / Hzfun(0.0, HzFUN_INFO);
+  ZGRID->DC[0]   = 0.0 ;
+
+  for(iz=0; iz < NZBIN; iz++ ) {
+    z0   = ZGRID->DZBIN * (double)iz ;
+    z1   = ZGRID->DZBIN * (double)(iz+1) ;
+    if ( iz == NZBIN-1 ) { z1 = ZMAX; } // avoid round-off beyond H(z) map
+    zmid = 0.5 * (z0 + z1);
+    f0   = ZGRID->EINV[iz];
+    fmid = H0 / Hzfun(zmid, HzFUN_INFO);
+    f1   = H0 / Hzfun(z1,   HzFUN_INFO);
+    ZGRID->EINV[iz+1] = f1 ;
+    ZGRID->DC[iz+1]   = ZGRID->DC[iz] + (z1-z0)*(f0 + 4.0*fmid + f1)/6.0;
+  }
+
+  return ;
+
+} // end init_COSMO_ZGRID
+
+
+// ******************************************
+double Ezinv_integral_ZGRID(double z, COSMO_ZGRID_DEF *ZGRID) {
+
+  // Created Oct 2026
+  // Return int_0^z dz'/E(z') from z-grid table (no curvature, no c/H0).
+
+  int    NZBIN = ZGRID->NZBIN ;
+  double DZBIN = ZGRID->DZBIN ;
+  double H0    = ZGRID->HzFUN_INFO.COSPAR_LIST[ICOSPAR_HzFUN_H0];
+  double t, t2, t3, h00, h10, h01, h11, sum, dz, ztmp ;
+  int    iz, Nzbin ;
+
+  // ------------ BEGIN -------------
+
+  if ( z <= 0.0 ) { return 0.0 ; }
+
+  if ( z >= ZGRID->ZMAX ) {
+    // extend beyond table with Simpson integration from last node
+    sum   = ZGRID->DC[NZBIN] ;
+    Nzbin = (int)ceil( (z - ZGRID->ZMAX)/DZBIN );
+    if ( Nzbin < 1 ) { return sum; }
+    dz    = (z - ZGRID->ZMAX) / (double)Nzbin ;
+    for(iz=0; iz < Nzbin; iz++ ) {
+      ztmp = ZGRID->ZMAX + dz*(double)iz ;
+      sum += dz * ( 1.0/Hzfun(ztmp,          &ZGRID->HzFUN_INFO) +
+		    4.0/Hzfun(ztmp+0.5*dz,   &ZGRID->HzFUN_INFO) +
+		    1.0/Hzfun(ztmp+dz,       &ZGRID->HzFUN_INFO) ) * H0/6.0;
+    }
+    return sum ;
+  }
+
+  // cubic Hermite interpolation within bin
+  iz = (int)( z / DZBIN );
+  if ( iz >= NZBIN ) { iz = NZBIN-1; }
+  t   = (z - DZBIN*(double)iz) / DZBIN ;
+  t2  = t*t;  t3 = t2*t;
+  h00 =  2.0*t3 - 3.0*t2 + 1.0 ;
+  h10 =      t3 - 2.0*t2 + t ;
+  h01 = -2.0*t3 + 3.0*t2 ;
+  h11 =      t3 -     t2 ;
+
+  sum = 
+    h00 * ZGRID->DC[iz]   + h10 * DZBIN * ZGRID->EINV[iz] +
+    h01 * ZGRID->DC[iz+1] + h11 * DZBIN * ZGRID->EINV[iz+1] ;
+
+  return sum ;
+
+} // end Ezinv_integral_ZGRID
+
+
+// ******************************************
+double Hzinv_ZGRID(double z, COSMO_ZGRID_DEF *ZGRID) {
+
+  // Created Oct 2026
+  // Same as Hzinv_integral(0,z), but using z-grid table.
+
+  double H0 = ZGRID->HzFUN_INFO.COSPAR_LIST[ICOSPAR_HzFUN_H0];
+  double OM = ZGRID->HzFUN_INFO.COSPAR_LIST[ICOSPAR_HzFUN_OM];
+  double OL = ZGRID->HzFUN_INFO.COSPAR_LIST[ICOSPAR_HzFUN_OL];
+  double sum, Hzinv, KAPPA, SQRT_KAPPA ;
+
+  // ------------ BEGIN -------------
+
+  sum = Ezinv_integral_ZGRID(z, ZGRID);
+
+  KAPPA      = 1.0 - OM - OL ; 
+  SQRT_KAPPA = sqrt(fabs(KAPPA));
+
+  if ( KAPPA < -0.00001 ) 
+    { Hzinv = sin( SQRT_KAPPA * sum ) / SQRT_KAPPA ; }
+  else if ( KAPPA > 0.00001 ) 
+    { Hzinv = sinh( SQRT_KAPPA * sum ) / SQRT_KAPPA ; }
+  else
+    { Hzinv = sum ; }
+
+  return (Hzinv * LIGHT_km / H0 ) ;
+
+} // end Hzinv_ZGRID
+
+
+void Hzinv_ZGRID_array(int NZ, double *z_list, COSMO_ZGRID_DEF *ZGRID,
+		       double *rz_list) {
+  // Created Oct 2026: array version of Hzinv_ZGRID
+  int iz;
+  for(iz=0; iz < NZ; iz++ ) 
+    { rz_list[iz] = Hzinv_ZGRID(z_list[iz], ZGRID); }
+} // end Hzinv_ZGRID_array
+
+
+// ******************************************
+double dLmag_ZGRID(double zCMB, double zHEL, double vPEC, 
+		   COSMO_ZGRID_DEF *ZGRID, 
+		   ANISOTROPY_INFO_DEF *ANISOTROPY_INFO) {
+
+  // Created Oct 2026
+  // Same as dLmag, but using z-grid table for distance integral.
+  double rz = Hzinv_ZGRID(zCMB, ZGRID);
+  return dLmag_rz(rz, zCMB, zHEL, vPEC, &ZGRID->HzFUN_INFO, ANISOTROPY_INFO);
+} // end dLmag_ZGRID
+
+
+void dLmag_ZGRID_array(int NZ, double *zCMB_list, double *zHEL_list, 
+		       double *vPEC_list, COSMO_ZGRID_DEF *ZGRID, 
+		       ANISOTROPY_INFO_DEF *ANISOTROPY_INFO, double *MU_list) {
+  // Created Oct 2026: array version of dLmag_ZGRID
+  int iz;
+  for(iz=0; iz < NZ; iz++ ) {
+    MU_list[iz] = dLmag_ZGRID(zCMB_list[iz], zHEL_list[iz], vPEC_list[iz],
+			      ZGRID, ANISOTROPY_INFO);
+  }
+} // end dLmag_ZGRID_array
+
+
+// ******************************************
+double dVdz_ZGRID(double z, COSMO_ZGRID_DEF *ZGRID) {
+  // Created Oct 2026: same as dVdz, but using z-grid table.
+  double r = Hzinv_ZGRID(z, ZGRID);
+  double H = Hzfun(z, &ZGRID->HzFUN_INFO);
+  return LIGHT_km * r * r / H ;
+} // end dVdz_ZGRID
+
+
+// ******************************************
+double dVdz_integral_ZGRID(int OPT, double zmax, COSMO_ZGRID_DEF *ZGRID) {
+
+  // Created Oct 2026
+  // Same as dVdz_integral, but using z-grid table.
+
+  double sum, dz, ztmp, wz ;
+  int Nzbin, iz;
+
+  // ---- BEGIN ----------
+
+  Nzbin = (int)( zmax * 1000.0 ) ;
+  if ( Nzbin < 10 ) { Nzbin = 10 ; }
+  dz   = zmax / (float)Nzbin ; 
+  sum  = 0.0;
+
+  for ( iz=0; iz < Nzbin; iz++ ) {
+    ztmp = dz * ((double)iz + 0.5) ;
+    wz   = 1.0;
+    if ( OPT == 1 ) { wz = ztmp; }
+    sum += wz * dVdz_ZGRID(ztmp, ZGRID);
+  }
+
+  sum *= dz ;
+  return sum ;
+
+} // end dVdz_integral_ZGRID
+
+
+// ******************************************
+void test_COSMO_ZGRID(COSMO_ZGRID_DEF *ZGRID) {
+
+  // Created Oct 2026
+  // Compare z-grid distances with direct integration for a few
+  // redshifts (including beyond ZMAX), and abort if dLmag differs
+  // by more than TOLMU_ZGRID or dV/dz by more than fractional 1E-5.
+  // For H(z) map, skip redshifts beyond ZMAX since map may end there.
+
+  ANISOTROPY_INFO_DEF ANISO ;
+  HzFUN_INFO_DEF *HzFUN_INFO = &ZGRID->HzFUN_INFO ;
+  double z, mu_grid, mu_int, dv_grid, dv_int ;
+  double dmu, dv, dmu_max = 0.0, dv_max = 0.0 ;
+  double z_list[] = { 0.0011, 0.0137, 0.0873, 0.2501, 0.6667, 1.2345,
+		      2.0011, 3.3333 } ;
+  int NZ = sizeof(z_list)/sizeof(double);
+  int iz ;
+  char fnam[] = "test_COSMO_ZGRID" ;
+
+  // ------------ BEGIN -------------
+
+  ANISO.USE_FLAG = false ;
+
+  for(iz=0; iz <= NZ; iz++ ) {
+    if ( iz < NZ ) { z = z_list[iz]; }
+    else           { z = ZGRID->ZMAX + 0.1234 ; }
+    if ( HzFUN_INFO->USE_MAP && z > ZGRID->ZMAX ) { continue; }
+
+    mu_grid = dLmag_ZGRID(z, z, 0.0, ZGRID, &ANISO);
+    mu_int  = dLmag(z, z, 0.0, HzFUN_INFO, &ANISO);
+    dv_grid = dVdz_ZGRID(z, ZGRID);
+    dv_int  = dVdz(z, HzFUN_INFO);
+
+    dmu = fabs(mu_grid - mu_int);
+    dv  = fabs(dv_grid/dv_int - 1.0);
+    if ( dmu > dmu_max ) { dmu_max = dmu; }
+    if ( dv  > dv_max  ) { dv_max  = dv;  }
+  }
+
+  printf("   %s: max |dmu| = %.2e mag, max |dV/dz ratio-1| = %.2e "
+	 "(ZMAX=%.2f, DZBIN=%.4f)\n",
+	 fnam, dmu_max, dv_max, ZGRID->ZMAX, ZGRID->DZBIN);
+  fflush(stdout);
+
+  if ( dmu_max > TOLMU_ZGRID || dv_max > 1.0E-5 ) {
+    sprintf(c1err,"z-grid distances differ from integration: "
+	    "max|dmu|=%.3e, max|dV/dz ratio-1|=%.3e", dmu_max, dv_max);
+    sprintf(c2err,"Check DZBIN=%f in init_COSMO_ZGRID", ZGRID->DZBIN);
+    errmsg(SEV_FATAL, 0, fnam, c1err, c2err);
+  }
+
+  return ;
+
+} // end test_COSMO_ZGRID
+
+
 
 // ===================================
 double q_dipole_V04(double zHEL, ANISOTROPY_INFO_DEF *ANISOTROPY_INFO){
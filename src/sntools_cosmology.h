@@ -3,6 +3,9 @@
 
      cosmology theory functions: H(z), MU(z) ...
 
+     Oct 2026: add COSMO_ZGRID_DEF to tabulate distance integral
+               on a fine z-grid (see init_COSMO_ZGRID).
+
 ********************************************************/
 
 #define ICOSPAR_HzFUN_H0  0
@@ -26,6 +29,21 @@ typedef struct {
 } HzFUN_INFO_DEF ;
 
 
+// Oct 2026: tabulated comoving-distance integral on a fine z-grid,
+// computed once per cosmology and interpolated for each redshift.
+#define DZBIN_ZGRID_DEFAULT   0.002  // z-grid bin size
+#define ZMAX_ZGRID_DEFAULT    4.0    // max z of grid; extend beyond
+#define TOLMU_ZGRID           1.0E-5 // self-test tolerance on dLmag (mag)
+
+typedef struct {
+  int    NZBIN, NZBIN_ALLOC ;
+  double ZMAX, DZBIN ;
+  HzFUN_INFO_DEF HzFUN_INFO ; // cosmology used to fill table
+  double *EINV ;    // H0/H(z) at each z node
+  double *DC ;      // int_0^z [H0/H(z')] dz'  (dimensionless, no curvature)
+} COSMO_ZGRID_DEF ;
+
+
 // hard-wired params from 1808.04597 (Colin et al 2023)
 #define ANISOTROPY_MODEL_qm  -0.157
 #define ANISOTROPY_MODEL_qd  -8.03
@@ -74,6 +92,25 @@ double dLmag_anisotropic (double mu_isotropic, double zCMB, double zHEL, double
                           HzFUN_INFO_DEF *HzFUN_INFO,
                           ANISOTROPY_INFO_DEF *ANISOTROPY_INFO  );
 
+double dLmag_rz(double rz, double zCMB, double zHEL, double vPEC, 
+		HzFUN_INFO_DEF *HzFUN_INFO, 
+		ANISOTROPY_INFO_DEF *ANISOTROPY_INFO);
+
+void   init_COSMO_ZGRID(double ZMAX, double DZBIN, HzFUN_INFO_DEF *HzFUN_INFO,
+			COSMO_ZGRID_DEF *ZGRID);
+double Ezinv_integral_ZGRID(double z, COSMO_ZGRID_DEF *ZGRID);
+double Hzinv_ZGRID(double z, COSMO_ZGRID_DEF *ZGRID);
+void   Hzinv_ZGRID_array(int NZ, double *z_list, COSMO_ZGRID_DEF *ZGRID,
+			 double *rz_list);
+double dLmag_ZGRID(double zCMB, double zHEL, double vPEC, 
+		   COSMO_ZGRID_DEF *ZGRID, ANISOTROPY_INFO_DEF *ANISOTROPY_INFO);
+void   dLmag_ZGRID_array(int NZ, double *zCMB_list, double *zHEL_list, 
+			 double *vPEC_list, COSMO_ZGRID_DEF *ZGRID, 
+			 ANISOTROPY_INFO_DEF *ANISOTROPY_INFO, double *MU_list);
+double dVdz_ZGRID(double z, COSMO_ZGRID_DEF *ZGRID);
+double dVdz_integral_ZGRID(int OPT, double zmax, COSMO_ZGRID_DEF *ZGRID);
+void   test_COSMO_ZGRID(COSMO_ZGRID_DEF *ZGRID);
+
 double zcmb_dLmag_invert(double MU, HzFUN_INFO_DEF *HzFUN_INFO, 
 			 ANISOTROPY_INFO_DEF *ANISOTROPY_INFO); 
 
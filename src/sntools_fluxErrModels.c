@@ -11,6 +11,13 @@
   Mar 16 2019: 
     refactor INIT_FLUXERRMODEL to use read_GRIDMAP, and to read OPT_EXTRAP.
 
+  Oct 2026:
+    + cached analytic Cholesky factor for each REDCOV matrix
+      (see get_GAURANCORR_REDCOV) to replace per-event decomposition.
+    + remember last BAND/FIELD match in INDEX_MAP_FLUXERRMODEL.
+    + get_FLUXERRMODEL_BATCH to evaluate maps for all epochs of
+      an event, with map index resolved by caller.
+
 ****************************************************/
 
 
@@ -544,6 +551,12 @@ int load_REDCOV_FLUXERRMODEL(char *ITEM_REDCOV, char *FIELD) {
   COVINFO_FLUXERRMODEL[NREDCOV].ALL_FIELD = 
     ( strcmp(ptr_FIELDGRP,ALL_STRING) == 0 );
 
+  COVINFO_FLUXERRMODEL[NREDCOV].NCHOL         = 0 ;
+  COVINFO_FLUXERRMODEL[NREDCOV].MXCHOL        = 0 ;
+  COVINFO_FLUXERRMODEL[NREDCOV].CHOL_DIAG     = NULL ;
+  COVINFO_FLUXERRMODEL[NREDCOV].CHOL_OFFDIAG  = NULL ;
+  COVINFO_FLUXERRMODEL[NREDCOV].SUMSQ_OFFDIAG = 0.0 ;
+
   // keep track of which bands are used, and abort if any
   // band is used more than once.
   NBAND_TMP = strlen(ptr_BANDLIST) ;
@@ -733,9 +746,9 @@ void get_FLUXERRMODEL(int OPT, double FLUXERR_IN, char *BAND, char *FIELD,
 
   //  int NMAP      = NMAP_FLUXERRMODEL; 
   int NSPARSE[MXMAP_FLUXERRMAP];
-  int IDMAP, istat, isp, imap, NVAR, IVAR, ivar, MASK_APPLY ;
+  int IDMAP, isp, imap, NVAR, IVAR, ivar ;
   int LDMP = (OPT & 512) ;
-  double FLUXERR_TMP, errModelVal, parList[MXPAR_FLUXERRMAP] ;
+  double errModelVal, parList[MXPAR_FLUXERRMAP] ;
   char *VARNAMES, tmpString[40], cparList[200] ;
   char fnam[] = "get_FLUXERRMODEL";
 
@@ -777,12 +790,11 @@ void get_FLUXERRMODEL(int OPT, double FLUXERR_IN, char *BAND, char *FIELD,
     errmsg(SEV_FATAL, 0, fnam, c1err, c2err ); 
   }
 
-  // load correct variables for this map;
   // errModelVal is the error scale from map
   IDMAP = IDGRIDMAP_FLUXERRMODEL_OFFSET + imap ;
-  load_parList_FLUXERRMAP(imap, PARLIST, parList);
 
   if ( LDMP ) {
+    load_parList_FLUXERRMAP(imap, PARLIST, parList);
     cparList[0] = 0 ;
     NVAR      = FLUXERRMAP[imap].NVAR ;
     for(ivar=0; ivar < NVAR-1; ivar++ ) { 
@@ -798,20 +810,94 @@ void get_FLUXERRMODEL(int OPT, double FLUXERR_IN, char *BAND, char *FIELD,
 
   }
 
-  istat = interp_GRIDMAP( &FLUXERRMAP[imap].MAP, parList, &errModelVal);
+  errModelVal = eval_FLUXERRMAP(imap, FLUXERR_IN, PARLIST,
+				FLUXERR_TRUE, FLUXERR_DATA);
   
-  if ( LDMP || istat<0 ) {
+  if ( LDMP ) {
     printf(" xxx     %s  :  errModelVal=%.3f\n",  cparList, errModelVal);
     fflush(stdout) ;
   }
   
+
+  if ( LDMP ) {
+    printf(" xxx FLUXERR[IN,TRUE,DATA] = %.3f, %.3f, %.3f \n",
+	   FLUXERR_IN, *FLUXERR_TRUE, *FLUXERR_DATA );
+    //  debugexit(fnam); 
+
+  }
+
+
+  return ;
+
+} // end get_FLUXERRMODEL
+
+
+// =======================================================
+void get_FLUXERRMODEL_BATCH(int NOBS, int *IMAP_LIST, double *FLUXERR_IN,
+			    int NPAR, double *PARLIST,
+			    double *FLUXERR_TRUE, double *FLUXERR_DATA ) {
+
+  // Created Oct 2026
+  // Batch version of get_FLUXERRMODEL for NOBS observations.
+  // IMAP_LIST[o] is the map index from INDEX_MAP_FLUXERRMODEL, resolved
+  // by the caller once per BAND/FIELD; IMAP_LIST[o] < 0 -> no map.
+  // Map parameters for obs o are PARLIST[o*NPAR + IPAR_FLUXERRMAP_XXX].
+  // Outputs FLUXERR_TRUE[o] and FLUXERR_DATA[o] are the same as from
+  // get_FLUXERRMODEL.
+
+  int o, imap ;
+  char fnam[] = "get_FLUXERRMODEL_BATCH" ;
+
+  // ----------- BEGIN -------------
+
+  if ( NPAR != NPAR_FLUXERRMAP_REQUIRE ) {
+    sprintf(c1err,"NPAR=%d but expected %d", NPAR, NPAR_FLUXERRMAP_REQUIRE );
+    sprintf(c2err,"grep IPAR_FLUXERRMAP "
+	    "$SNANA_DIR/src/sntools_fluxErrModels.h");
+    errmsg(SEV_FATAL, 0, fnam, c1err, c2err ); 
+  }
+
+  for(o=0; o < NOBS; o++ ) {
+    imap = IMAP_LIST[o];
+    if ( NMAP_FLUXERRMODEL == 0 || imap < 0 ) 
+      { FLUXERR_TRUE[o] = FLUXERR_DATA[o] = FLUXERR_IN[o]; continue; }
+
+    eval_FLUXERRMAP(imap, FLUXERR_IN[o], &PARLIST[o*NPAR],
+		    &FLUXERR_TRUE[o], &FLUXERR_DATA[o] );
+  }
+
+  return ;
+
+} // end get_FLUXERRMODEL_BATCH
+
+
+// =======================================================
+double eval_FLUXERRMAP(int imap, double FLUXERR_IN, double *PARLIST,
+		       double *FLUXERR_TRUE, double *FLUXERR_DATA ) {
+
+  // Created Oct 2026 [code moved from get_FLUXERRMODEL]
+  // Interpolate FLUXERRMAP[imap] at PARLIST and apply to FLUXERR_IN.
+  // Returns map value (errModelVal).
+
+  int    MASK_APPLY = FLUXERRMAP[imap].MASK_APPLY ;
+  int    istat ;
+  double errModelVal, FLUXERR_TMP, parList[MXPAR_FLUXERRMAP] ;
+  char   fnam[] = "eval_FLUXERRMAP" ;
+
+  // ----------- BEGIN -------------
+
+  *FLUXERR_TRUE = FLUXERR_IN ;
+  *FLUXERR_DATA = FLUXERR_IN ;
+
+  load_parList_FLUXERRMAP(imap, PARLIST, parList);
+  istat = interp_GRIDMAP( &FLUXERRMAP[imap].MAP, parList, &errModelVal);
+
   if ( istat < 0 ) {
-    sprintf(c1err,"Cannot interpolate FLUXERRMAP");
+    sprintf(c1err,"Cannot interpolate FLUXERRMAP %s", FLUXERRMAP[imap].NAME);
     sprintf(c2err,"Need to extend range of map.");
     errmsg(SEV_FATAL, 0, fnam, c1err, c2err ); 
   }
   
-  MASK_APPLY = FLUXERRMAP[imap].MASK_APPLY ;
   if ( ( MASK_APPLY & MASK_APPLY_SIM_FLUXERRMAP)> 0 ) {
     FLUXERR_TMP  = *FLUXERR_TRUE ;
     *FLUXERR_TRUE = apply_FLUXERRMODEL(imap, errModelVal, FLUXERR_TMP);
@@ -823,19 +909,10 @@ void get_FLUXERRMODEL(int OPT, double FLUXERR_IN, char *BAND, char *FIELD,
     *FLUXERR_DATA  = apply_FLUXERRMODEL(imap, errModelVal, FLUXERR_TMP);
     *FLUXERR_DATA *= FLUXERRMAP[imap].SCALE_FLUXERR_DATA;
   }
-  
 
-  if ( LDMP ) {
-    printf(" xxx FLUXERR[IN,TRUE,DATA] = %.3f, %.3f, %.3f \n",
-	   FLUXERR_IN, *FLUXERR_TRUE, *FLUXERR_DATA );
-    //  debugexit(fnam); 
+  return errModelVal ;
 
-  }
-
-
-  return ;
-
-} // end get_FLUXERRMODEL
+} // end eval_FLUXERRMAP
 
 
 // fortran wrapper
@@ -875,14 +952,24 @@ int INDEX_MAP_FLUXERRMODEL(char *BAND, char *FIELD, char *FUNCALL) {
   // For input BAND and FIELD, return index of map for FLUXERRMODEL.
   // FUNCALL is calling function, and used only for error message.
 
+  // Oct 2026: remember last BAND/FIELD since consecutive calls 
+  //           (epochs) usually have the same BAND and FIELD.
+
   int NMAP = NMAP_FLUXERRMODEL; 
   int  imap, IMAP=-9, NMATCH=0 ;
   bool MATCH_BAND, MATCH_FIELD;
   char *tmpString ;
+  static int  IMAP_LAST = -9 ;
+  static char BAND_LAST[20] = "", FIELD_LAST[MXCHAR_STRING_REDCOV] = "" ;
   char fnam[] = "INDEX_MAP_FLUXERRMODEL" ;
 
   // ------------ BEGIN ---------
 
+  bool USE_LAST = ( FIELD != NULL );
+
+  if ( USE_LAST && strcmp(BAND,BAND_LAST)==0 && strcmp(FIELD,FIELD_LAST)==0 ) 
+    { return(IMAP_LAST); }
+
   for(imap=0; imap < NMAP; imap++ ) {
     MATCH_BAND = MATCH_FIELD = false ;
 
@@ -913,6 +1000,14 @@ int INDEX_MAP_FLUXERRMODEL(char *BAND, char *FIELD, char *FUNCALL) {
     sprintf(c2err,"Calling function is %s", FUNCALL);
     errmsg(SEV_FATAL, 0, fnam, c1err, c2err ); 
   }
+
+  USE_LAST = USE_LAST && 
+    ( strlen(BAND) < 20 && strlen(FIELD) < MXCHAR_STRING_REDCOV );
+  if ( USE_LAST ) {
+    sprintf(BAND_LAST,  "%s", BAND);
+    sprintf(FIELD_LAST, "%s", FIELD);
+    IMAP_LAST = IMAP ;
+  }
   
   return(IMAP) ;
 
@@ -962,6 +1057,94 @@ int INDEX_REDCOV_FLUXERRMODEL(char *BAND, char *FIELD, int OPT_FIELD,
 } // end of INDEX_REDCOV_FLUXERRMODEL
 
 
+// ==========================================================
+void extend_CHOLESKY_REDCOV(int icov, int NOBS) {
+
+  // Created Oct 2026
+  // Extend cached Cholesky factor L of the NOBS x NOBS matrix with 
+  // unit diagonal and constant off-diagonal REDCOV; i.e.,
+  //    M = (1-REDCOV)*I + REDCOV*ones .
+  // By symmetry, L[i][j] for i>j depends only on j, and the first 
+  // NCHOL rows do not depend on NOBS. With S_j = sum_{k<j} c_k^2,
+  //    d_j = sqrt(1 - S_j)   and   c_j = (REDCOV - S_j)/d_j .
+  // The cost is O(NOBS) once per icov, instead of O(NOBS^3) per event.
+
+  int    NCHOL  = COVINFO_FLUXERRMODEL[icov].NCHOL ;
+  int    MXCHOL = COVINFO_FLUXERRMODEL[icov].MXCHOL ;
+  double REDCOV = COVINFO_FLUXERRMODEL[icov].REDCOV ;
+  double SUMSQ  = COVINFO_FLUXERRMODEL[icov].SUMSQ_OFFDIAG ;
+  int    j, MEMD ;
+  double SQDIAG, DIAG, OFFDIAG ;
+  char fnam[] = "extend_CHOLESKY_REDCOV" ;
+
+  // ------------ BEGIN -------------
+
+  if ( NOBS <= NCHOL ) { return ; }
+
+  if ( NOBS > MXCHOL ) {
+    MXCHOL = NOBS + 100 ;
+    MEMD   = MXCHOL * sizeof(double);
+    COVINFO_FLUXERRMODEL[icov].CHOL_DIAG = 
+      (double*) realloc(COVINFO_FLUXERRMODEL[icov].CHOL_DIAG, MEMD);
+    COVINFO_FLUXERRMODEL[icov].CHOL_OFFDIAG = 
+      (double*) realloc(COVINFO_FLUXERRMODEL[icov].CHOL_OFFDIAG, MEMD);
+    COVINFO_FLUXERRMODEL[icov].MXCHOL = MXCHOL;
+  }
+
+  for(j=NCHOL; j < NOBS; j++ ) {
+    SQDIAG = 1.0 - SUMSQ ;
+    if ( SQDIAG <= 0.0 ) {
+      sprintf(c1err,"REDCOV=%.4f matrix not pos-def for NOBS=%d (%s)",
+	      REDCOV, j+1, COVINFO_FLUXERRMODEL[icov].BANDSTRING );
+      sprintf(c2err,"Check FLUXERRMODEL REDCOV keys.");
+      errmsg(SEV_FATAL, 0, fnam, c1err, c2err ); 
+    }
+    DIAG    = sqrt(SQDIAG);
+    OFFDIAG = (REDCOV - SUMSQ) / DIAG ;
+    COVINFO_FLUXERRMODEL[icov].CHOL_DIAG[j]    = DIAG ;
+    COVINFO_FLUXERRMODEL[icov].CHOL_OFFDIAG[j] = OFFDIAG ;
+    SUMSQ += (OFFDIAG*OFFDIAG) ;
+  }
+
+  COVINFO_FLUXERRMODEL[icov].NCHOL         = NOBS ;
+  COVINFO_FLUXERRMODEL[icov].SUMSQ_OFFDIAG = SUMSQ ;
+
+  return ;
+
+} // end extend_CHOLESKY_REDCOV
+
+
+// ==========================================================
+void get_GAURANCORR_REDCOV(int icov, int NOBS, double *GAURAN, 
+			   double *GAURANCORR) {
+
+  // Created Oct 2026
+  // For input list of NOBS independent unit Gaussian randoms (GAURAN),
+  // return correlated unit Gaussian randoms GAURANCORR = L * GAURAN,
+  // where L is the cached Cholesky factor for REDCOV matrix icov.
+  // Since a covariance matrix sqrt(S_i*S_j)*REDCOV has Cholesky factor
+  // diag(sqrt(S_i))*L, the per-epoch sigmas factor out.
+
+  int    o ;
+  double SUM_OFF = 0.0 ;
+  double *DIAG, *OFFDIAG ;
+
+  // ------------ BEGIN -------------
+
+  extend_CHOLESKY_REDCOV(icov, NOBS);
+  DIAG    = COVINFO_FLUXERRMODEL[icov].CHOL_DIAG ;
+  OFFDIAG = COVINFO_FLUXERRMODEL[icov].CHOL_OFFDIAG ;
+
+  for(o=0; o < NOBS; o++ ) {
+    GAURANCORR[o] = DIAG[o]*GAURAN[o] + SUM_OFF ;
+    SUM_OFF      += OFFDIAG[o]*GAURAN[o] ;
+  }
+
+  return ;
+
+} // end get_GAURANCORR_REDCOV
+
+
 // =========================================================
 double apply_FLUXERRMODEL(int imap, double errModelVal, double fluxErr) {
 
@@ -91,6 +91,12 @@ struct {
   int NOBS   ;       // number of obs for this covariance matrix (with cuts)
   int NOBS_NOCUT;    // no SNR cut
 
+  // cached Cholesky factor of unit-variance REDCOV matrix (Oct 2026):
+  // L[i][i] = CHOL_DIAG[i] and L[i][j<i] = CHOL_OFFDIAG[j];
+  // depends only on REDCOV, so it is extended as needed for larger NOBS.
+  int    NCHOL, MXCHOL ;
+  double *CHOL_DIAG, *CHOL_OFFDIAG, SUMSQ_OFFDIAG ;
+
 } COVINFO_FLUXERRMODEL[MXREDCOV_FLUXERRMAP];
 
 
@@ -123,8 +129,17 @@ void  get_FLUXERRMODEL(int OPT, double FLUXERR_IN, char *BAND, char *FIELD,
 void  get_fluxerrmodel__(int *OPT, double *FLUXERR_IN, char *BAND, char *FIELD, 
 			 int *NPAR, double *PARLIST, 
 			 double *FLUXERR_GEN, double *FLUXERR_DATA );
+void  get_FLUXERRMODEL_BATCH(int NOBS, int *IMAP_LIST, double *FLUXERR_IN,
+			     int NPAR, double *PARLIST,
+			     double *FLUXERR_GEN, double *FLUXERR_DATA );
+double eval_FLUXERRMAP(int imap, double FLUXERR_IN, double *PARLIST,
+		       double *FLUXERR_GEN, double *FLUXERR_DATA );
 
 void load_parList_FLUXERRMAP(int imap, double *PARLIST, double *parList) ;
 
 double apply_FLUXERRMODEL(int imap, double errModelVal, double FLUXERR_IN);
 
+void  extend_CHOLESKY_REDCOV(int icov, int NOBS);
+void  get_GAURANCORR_REDCOV(int icov, int NOBS, double *GAURAN, 
+			    double *GAURANCORR);
+
@@ -93,6 +93,13 @@
  Apr 13 2023: implement GROUPID match between SIMLIB and HOSTLIB
               (enable Large-scale structure)
 
+ Oct 2026: store host spec basis as contiguous matrix; host spectra
+           are coeff x basis GEMM, done in blocks of galaxies for
+           +HOSTMAGS rewrite.
+
+ Oct 2026: +HOSTNBR uses sky-cell index instead of DEC-sorted walk,
+           and optional NTHREAD splits galaxies over pthreads.
+
 =========================================================== */
 
 #include <stdio.h>
@@ -102,6 +109,7 @@
 #include <string.h>
 #include <time.h>
 #include <math.h>
+#include <gsl/gsl_cblas.h>
 
 #include "sntools.h"
 #include "sntools_cosmology.h"
@@ -115,6 +123,11 @@
 #include "sntools_spectrograph.h"
 #include "genmag_SEDtools.h"
 
+#define USE_THREAD   // Oct 2026: pthread option for +HOSTNBR
+#ifdef USE_THREAD
+#include <pthread.h>
+#endif
+
 // ==================================
 void INIT_HOSTLIB(void) {
 
@@ -2115,6 +2128,8 @@ void malloc_HOSTSPEC(int NBIN_WAVE, int ISPEC) {
   // malloc wave-dependent HOSTSPEC arrays.
   // If ISPEC < 0 , then malloc arrays that do not depend on ISPEC;
   // If ISPEC >= 0 then malloc FLAM_BASIS[ISPEC]
+  //
+  // Oct 2026: FLAM_BASIS[ISPEC] is a row of FLAM_BASIS_MATRIX
 
   int MEMD = NBIN_WAVE * sizeof(double);
   char fnam[] = "malloc_HOSTSPEC";
@@ -2127,9 +2142,19 @@ void malloc_HOSTSPEC(int NBIN_WAVE, int ISPEC) {
     HOSTSPEC.WAVE_MAX     = (double*) malloc(MEMD);
     HOSTSPEC.WAVE_BINSIZE = (double*) malloc(MEMD);
     HOSTSPEC.FLAM_EVT     = (double*) malloc(MEMD);
+    HOSTSPEC.FLAM_BASIS_MATRIX = (double*) malloc(MXSPECBASIS_HOSTLIB*MEMD);
+    HOSTSPEC.NBIN_WAVE_STRIDE  = NBIN_WAVE ;
   }
   else {
-    HOSTSPEC.FLAM_BASIS[ISPEC] = (double*) malloc(MEMD);
+    if ( ISPEC >= MXSPECBASIS_HOSTLIB || 
+	 NBIN_WAVE > HOSTSPEC.NBIN_WAVE_STRIDE ) {
+      sprintf(c1err,"Invalid ISPEC=%d or NBIN_WAVE=%d", ISPEC, NBIN_WAVE);
+      sprintf(c2err,"MXSPECBASIS_HOSTLIB=%d  NBIN_WAVE_STRIDE=%d",
+	      MXSPECBASIS_HOSTLIB, HOSTSPEC.NBIN_WAVE_STRIDE );
+      errmsg(SEV_FATAL, 0, fnam, c1err,c2err); 
+    }
+    HOSTSPEC.FLAM_BASIS[ISPEC] = 
+      &HOSTSPEC.FLAM_BASIS_MATRIX[ISPEC*HOSTSPEC.NBIN_WAVE_STRIDE] ;
   }
 
   return;
@@ -2330,27 +2355,27 @@ void genSpec_HOSTLIB(double zhel, double MWEBV, int DUMPFLAG,
   // Dec 17 2021: exclude last LAM bin from LAMBIN_CHECK test;
   //             -> avoids mysterious abort.
   //
+  // Oct 2026: rest-frame FLAM from genFlam_SPECBASIS_HOSTLIB (GEMM).
+  //
 
   int  NBLAM_SPECTRO    = INPUTS_SPECTRO.NBIN_LAM;
   double ABMAG_FORCE    = INPUTS.HOSTLIB_ABMAG_FORCE;
-  double ABMAG_SCALE    = 1.0/pow(10.0, 0.4*ABMAG_FORCE);
   bool   DO_ABMAG_FORCE = ( ABMAG_FORCE > -8.0 );
 
   int  NBLAM_BASIS     = HOSTSPEC.NBIN_WAVE; 
   bool IS_SPECBASIS    = HOSTSPEC.ITABLE == ITABLE_SPECBASIS ;
   bool IS_SPECDATA     = HOSTSPEC.ITABLE == ITABLE_SPECDATA ;
-  double FLAM_SCALE_POWZ1 = HOSTSPEC.FLAM_SCALE_POWZ1 ;
   int  IGAL        = SNHOSTGAL.IGAL ;
   double z1        = 1.0 + zhel;
   if ( DO_ABMAG_FORCE ) { z1 = 1.0 ; }
-  double znorm     = pow(z1,FLAM_SCALE_POWZ1) ;
   double hc8       = (double)hc;
 
   long long GALID;
   int  ilam, ilam_basis, ilam_last=-9, i, ivar_HOSTLIB, ivar ;
   int  ilam_near, NLAMSUM, LDMP=0;
-  int  ISPEC_MIN, ISPEC_MAX, IDSPEC;
-  double FLAM_TMP, FLAM_SUM, COEFF, FLUX_TMP, MWXT_FRAC, LAMOBS;
+  int  IDSPEC;
+  double COEFF_LIST[MXSPECBASIS_HOSTLIB];
+  double FLAM_TMP, COEFF, FLUX_TMP, MWXT_FRAC, LAMOBS;
   double LAMOBS_BIN, LAMOBS_MIN, LAMOBS_MAX, LAM_BASIS;
   double LAMREST_MIN, LAMREST_MAX ;
   double LAMMIN_TMP, LAMMAX_TMP, LAMBIN_TMP, LAMBIN_CHECK ;
@@ -2380,12 +2405,19 @@ void genSpec_HOSTLIB(double zhel, double MWEBV, int DUMPFLAG,
   }
 
   if ( IS_SPECBASIS ) {
-    // check all basis vectors
-    ISPEC_MIN = 0;  ISPEC_MAX = HOSTSPEC.NSPECBASIS;
+    // sum over all basis vectors
+    get_COEFF_SPECBASIS_HOSTLIB(IGAL, COEFF_LIST);
+    genFlam_SPECBASIS_HOSTLIB(1, COEFF_LIST, HOSTSPEC.FLAM_EVT);
+
+    for(i=0; i < HOSTSPEC.NSPECBASIS; i++ ) {
+      if ( DUMPFLAG && COEFF_LIST[i] > 0.0 ) {
+	printf(" xxx COEFF(%2d) = %le  (ivar_HOSTLIB=%d)\n", 
+	       i, COEFF_LIST[i], HOSTSPEC.IVAR_HOSTLIB[i] );
+      }
+    }
   }
   else {
     // pick out the one spectrum in IDSPECDATA column of HOSTLIB
-    ISPEC_MIN = 0;  ISPEC_MAX = 1;
     ivar_HOSTLIB = HOSTSPEC.IVAR_HOSTLIB[0];
     COEFF        = HOSTLIB.VALUE_ZSORTED[ivar_HOSTLIB][IGAL] ; 
     IDSPEC       = (int)COEFF ;
@@ -2396,39 +2428,12 @@ void genSpec_HOSTLIB(double zhel, double MWEBV, int DUMPFLAG,
       sprintf(c2err,"Valid IDSPEC range is 0 to %d", HOSTSPEC.NSPECDATA-1);
       errmsg(SEV_FATAL, 0, fnam, c1err, c2err); 
     }
+    memcpy(HOSTSPEC.FLAM_EVT, HOSTSPEC.FLAM_BASIS[IDSPEC],
+	   NBLAM_BASIS * sizeof(double) );
   }
 
-  // construct total rest-frame spectrum using specbasis/specdata binning
-  for(ilam_basis=0; ilam_basis < NBLAM_BASIS; ilam_basis++ ) {
-    FLAM_SUM     = 0.0 ;
-    LAM_BASIS    = HOSTSPEC.WAVE_CEN[ilam_basis]; // basis or data
-    for(i=ISPEC_MIN; i < ISPEC_MAX; i++ ) {
-
-      if ( IS_SPECBASIS ) { 
-	ivar_HOSTLIB = HOSTSPEC.IVAR_HOSTLIB[i];
-	COEFF        = HOSTLIB.VALUE_ZSORTED[ivar_HOSTLIB][IGAL] ; 
-	FLAM_TMP     = HOSTSPEC.FLAM_BASIS[i][ilam_basis] ;
-	FLAM_SUM    += ( COEFF * FLAM_TMP );
-      }
-      else {
-	FLAM_SUM   = HOSTSPEC.FLAM_BASIS[IDSPEC][ilam_basis] ; 
-      }
-      if ( DUMPFLAG && ilam_basis == 0 && COEFF > 0.0 ) {
-	printf(" xxx COEFF(%2d) = %le  (ivar_HOSTLIB=%d)\n", 
-	       i, COEFF, ivar_HOSTLIB );
-      }
-    }
-
-    // global scale for physical units
-    HOSTSPEC.FLAM_EVT[ilam_basis] = (FLAM_SUM * HOSTSPEC.FLAM_SCALE * znorm);
-
-    // May 2021: check force ABMAG (constant, NOT z-dependent)
-    if ( DO_ABMAG_FORCE ) {
-      FLAM_SUM = FNU_AB * LIGHT_A / (LAM_BASIS*LAM_BASIS) ;
-      HOSTSPEC.FLAM_EVT[ilam_basis] = FLAM_SUM * ABMAG_SCALE ;
-    }
-
-  } // end ilam_basis
+  // global scale for physical units
+  norm_FLAM_HOSTLIB(zhel, HOSTSPEC.FLAM_EVT);
 
 
   // ---------------
@@ -2556,6 +2561,75 @@ void genSpec_HOSTLIB(double zhel, double MWEBV, int DUMPFLAG,
 } // end genSpec_HOSTLIB
 
 
+// =========================================================
+void get_COEFF_SPECBASIS_HOSTLIB(int IGAL, double *COEFF_LIST) {
+  // Created Oct 2026
+  // Load spec-basis coefficients for z-sorted IGAL.
+  int i, ivar_HOSTLIB;
+  for(i=0; i < HOSTSPEC.NSPECBASIS; i++ ) {
+    ivar_HOSTLIB  = HOSTSPEC.IVAR_HOSTLIB[i];
+    COEFF_LIST[i] = HOSTLIB.VALUE_ZSORTED[ivar_HOSTLIB][IGAL] ; 
+  }
+} // end get_COEFF_SPECBASIS_HOSTLIB
+
+// =========================================================
+void genFlam_SPECBASIS_HOSTLIB(int NGAL, double *COEFF_MATRIX, 
+			       double *FLAM_MATRIX) {
+
+  // Created Oct 2026
+  // Unnormalized rest-frame host spectra for NGAL galaxies,
+  //   FLAM_MATRIX[NGAL x NBIN_WAVE] = 
+  //       COEFF_MATRIX[NGAL x NSPECBASIS] * FLAM_BASIS[NSPECBASIS x NBIN_WAVE]
+  // For each wave bin, sum is over basis index in the same order as
+  // the original scalar loop.
+
+  int NSPEC     = HOSTSPEC.NSPECBASIS ;
+  int NBIN_WAVE = HOSTSPEC.NBIN_WAVE ;
+
+  cblas_dgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans,
+	      NGAL, NBIN_WAVE, NSPEC, 
+	      1.0, COEFF_MATRIX, NSPEC, 
+	      HOSTSPEC.FLAM_BASIS_MATRIX, HOSTSPEC.NBIN_WAVE_STRIDE,
+	      0.0, FLAM_MATRIX, NBIN_WAVE );
+
+} // end genFlam_SPECBASIS_HOSTLIB
+
+// =========================================================
+void norm_FLAM_HOSTLIB(double zhel, double *FLAM) {
+
+  // Created Oct 2026 [code moved from genSpec_HOSTLIB]
+  // Apply global FLAM_SCALE (with z-dependence) to rest-frame FLAM,
+  // or replace with constant ABMAG_FORCE spectrum.
+
+  int    NBLAM_BASIS    = HOSTSPEC.NBIN_WAVE; 
+  double ABMAG_FORCE    = INPUTS.HOSTLIB_ABMAG_FORCE;
+  double ABMAG_SCALE    = 1.0/pow(10.0, 0.4*ABMAG_FORCE);
+  bool   DO_ABMAG_FORCE = ( ABMAG_FORCE > -8.0 );
+  double z1             = 1.0 + zhel;
+  if ( DO_ABMAG_FORCE ) { z1 = 1.0 ; }
+  double znorm          = pow(z1,HOSTSPEC.FLAM_SCALE_POWZ1) ;
+  double FLAM_SUM, LAM_BASIS ;
+  int    ilam_basis ;
+
+  // ---------- BEGIN -----------
+
+  for(ilam_basis=0; ilam_basis < NBLAM_BASIS; ilam_basis++ ) {
+
+    FLAM[ilam_basis] = (FLAM[ilam_basis] * HOSTSPEC.FLAM_SCALE * znorm);
+
+    // May 2021: check force ABMAG (constant, NOT z-dependent)
+    if ( DO_ABMAG_FORCE ) {
+      LAM_BASIS = HOSTSPEC.WAVE_CEN[ilam_basis]; 
+      FLAM_SUM  = FNU_AB * LIGHT_A / (LAM_BASIS*LAM_BASIS) ;
+      FLAM[ilam_basis] = FLAM_SUM * ABMAG_SCALE ;
+    }
+  }
+
+  return ;
+
+} // end norm_FLAM_HOSTLIB
+
+
 // ============================================
 void read_head_HOSTLIB(FILE *fp) {
 
@@ -10145,15 +10219,23 @@ void rewrite_HOSTLIB_plusMags(void) {
   // Beware that 'igal' is a redshift-sorted index for the other 
   // HOSTLIB functions, but here we use the original HOSTLIB order.
   // 
+  // Oct 2026: for SPECBASIS, compute rest-frame spectra for blocks of
+  //   NGAL_BLOCK_HOSTSPEC galaxies with one GEMM, and skip the
+  //   SPECTROGRAPH binning in genSpec_HOSTLIB that is not used here.
 
   int NGAL     = HOSTLIB.NGAL_STORE ;
   int NFILT    = NFILT_SEDMODEL ; 
   int NBIN_LAM = INPUTS_SPECTRO.NBIN_LAM ;
   int MEMD     = sizeof(double) * NBIN_LAM ;
+  int NSPEC    = HOSTSPEC.NSPECBASIS ;
+  int NBIN_WAVE = HOSTSPEC.NBIN_WAVE ;
+  bool DO_BLOCK = ( HOSTSPEC.ITABLE == ITABLE_SPECBASIS );
 
   int igal_unsort, igal_zsort, ifilt, ifilt_obs, ivar, DUMPFLAG=0, LENLINE ;
+  int iblock, NBLOCK=0, igal2 ;
   long long GALID ;
   double ZTRUE, MWEBV=0.0, mag, *GENFLUX_LIST, *GENMAG_LIST;
+  double *COEFF_BLOCK=NULL, *FLAM_BLOCK=NULL, *FLAM ;
   float  *MAG_STORE ;
 
   HOSTLIB_APPEND_DEF HOSTLIB_APPEND ;
@@ -10179,6 +10261,12 @@ void rewrite_HOSTLIB_plusMags(void) {
 
   MAG_STORE = (float*) malloc( (NFILT+1)*sizeof(float) );
 
+  if ( DO_BLOCK ) {
+    COEFF_BLOCK = (double*) malloc(NGAL_BLOCK_HOSTSPEC*NSPEC*sizeof(double));
+    FLAM_BLOCK  = (double*) malloc(NGAL_BLOCK_HOSTSPEC*NBIN_WAVE*
+				   sizeof(double));
+  }
+
   for(ifilt=0; ifilt <= NFILT; ifilt++ ) 
     { HOSTSPEC.NWARN_INTEG_HOSTMAG[ifilt] = 0 ; }
 
@@ -10201,20 +10289,38 @@ void rewrite_HOSTLIB_plusMags(void) {
     
     DUMPFLAG = ( GALID == GALID_DUMP );    
 
-    genSpec_HOSTLIB(ZTRUE,          // (I) helio redshift
-		    MWEBV,          // (I) Galactic extinction
-		    DUMPFLAG,       // (I) dump flag
-		    GENFLUX_LIST,   // (O) fluxGen per bin 
-		    GENMAG_LIST );  // (O) magGen per bin
+    if ( DO_BLOCK ) {
+      // at start of each block, GEMM for spectra of next NBLOCK galaxies
+      iblock = igal_unsort % NGAL_BLOCK_HOSTSPEC ;
+      if ( iblock == 0 ) {
+	NBLOCK = NGAL - igal_unsort ;
+	if ( NBLOCK > NGAL_BLOCK_HOSTSPEC ) { NBLOCK = NGAL_BLOCK_HOSTSPEC; }
+	for(igal2=0; igal2 < NBLOCK; igal2++ ) {
+	  get_COEFF_SPECBASIS_HOSTLIB(HOSTLIB.LIBINDEX_ZSORT[igal_unsort+igal2],
+				      &COEFF_BLOCK[igal2*NSPEC] );
+	}
+	genFlam_SPECBASIS_HOSTLIB(NBLOCK, COEFF_BLOCK, FLAM_BLOCK);
+      }
+      FLAM = &FLAM_BLOCK[iblock*NBIN_WAVE] ;
+      norm_FLAM_HOSTLIB(ZTRUE, FLAM);
+    }
+    else {
+      genSpec_HOSTLIB(ZTRUE,          // (I) helio redshift
+		      MWEBV,          // (I) Galactic extinction
+		      DUMPFLAG,       // (I) dump flag
+		      GENFLUX_LIST,   // (O) fluxGen per bin 
+		      GENMAG_LIST );  // (O) magGen per bin
 
-    // ignore GENFLUX_LIST & GENMAG_LIST returned by genSpec_HOSTLIB.
-    // Instead, integmag_hostSpec below uses global HOSTSPEC.FLAM_EVT 
-    // that is loaded in genSpec_HOSTLIB.
+      // ignore GENFLUX_LIST & GENMAG_LIST returned by genSpec_HOSTLIB.
+      // Instead, integmag_hostSpec below uses global HOSTSPEC.FLAM_EVT 
+      // that is loaded in genSpec_HOSTLIB.
+      FLAM = HOSTSPEC.FLAM_EVT ;
+    }
 
     LINE_APPEND[0] = 0;
     for ( ifilt=1; ifilt <= NFILT; ifilt++ ) {
       ifilt_obs = FILTER_SEDMODEL[ifilt].ifilt_obs;
-      mag       = integmag_hostSpec(ifilt_obs,ZTRUE,DUMPFLAG);
+      mag       = integmag_hostSpec_FLAM(ifilt_obs,ZTRUE,FLAM,DUMPFLAG);
       MAG_STORE[ifilt] = mag;
       sprintf(cval, " %6.3f", MAG_STORE[ifilt] );
       strcat(LINE_APPEND,cval);
@@ -10276,6 +10382,7 @@ void rewrite_HOSTLIB_plusMags(void) {
 
   // ------------------------------------
   free(GENFLUX_LIST); free(GENMAG_LIST); free(MAG_STORE);
+  if ( DO_BLOCK ) { free(COEFF_BLOCK); free(FLAM_BLOCK); }
 
   exit(0);
 
@@ -10286,10 +10393,20 @@ void rewrite_HOSTLIB_plusMags(void) {
 
 // ======================================
 double integmag_hostSpec(int IFILT_OBS, double z, int DUMPFLAG) {
-
   // Sep 2019
   // integrate global HOSTSPEC.FLAM_EVT over IFILT_OBS bandpass
   // and return synthetic mag for filter IFILT_OBS.
+  return integmag_hostSpec_FLAM(IFILT_OBS, z, HOSTSPEC.FLAM_EVT, DUMPFLAG);
+} // end integmag_hostSpec
+
+double integmag_hostSpec_FLAM(int IFILT_OBS, double z, double *FLAM_LIST,
+			      int DUMPFLAG) {
+
+  // Oct 2026: [code moved from integmag_hostSpec]
+  //   Integrate input rest-frame FLAM_LIST (on HOSTSPEC wave grid).
+  //   Filter wavelengths are increasing, so walk forward to find the
+  //   interp bin instead of a bin-search per filter wavelength; 
+  //   bin choice and interp arithmetic match interp_1DFUN.
 
   int     NBLAM_BASIS   = HOSTSPEC.NBIN_WAVE ;
   double *LAMCEN_BASIS  = HOSTSPEC.WAVE_CEN ;
@@ -10304,9 +10421,9 @@ double integmag_hostSpec(int IFILT_OBS, double z, int DUMPFLAG) {
   double hc8           = (double)hc;
   double z1            = 1.0 + z;
 
-  double TRANS, LAMOBS, LAMREST, FLAM, FSUM=0.0, mag=0.0 ;
+  double TRANS, LAMOBS, LAMREST, FLAM, FSUM=0.0, mag=0.0, frac ;
   double SUMTRANS_TOT=0.0, SUMTRANS_UNDEFINED=0.0 ;
-  int    ilamobs, NBLAM_UNDEFINED=0;
+  int    ilamobs, NBLAM_UNDEFINED=0, IBIN=0 ;
   char   comment[100];
   char   fnam[] = "integmag_hostSpec" ;
 
@@ -10323,8 +10440,19 @@ double integmag_hostSpec(int IFILT_OBS, double z, int DUMPFLAG) {
 
     if ( LAMOBS >= LAMMIN_BASIS  &&  LAMOBS <= LAMMAX_BASIS ) {
       // interpolate to get FLAM
-      FLAM = interp_1DFUN(OPT_INTERP_LINEAR, LAMREST, NBLAM_BASIS, LAMCEN_BASIS,
-			  HOSTSPEC.FLAM_EVT, comment );   
+      if ( LAMREST < LAMCEN_BASIS[0] || 
+	   LAMREST > LAMCEN_BASIS[NBLAM_BASIS-1] || NBLAM_BASIS < 2 ) {
+	// let interp_1DFUN handle edge cases and abort
+	FLAM = interp_1DFUN(OPT_INTERP_LINEAR, LAMREST, NBLAM_BASIS, 
+			    LAMCEN_BASIS, FLAM_LIST, comment );   
+      }
+      else {
+	if ( IBIN > 0 && LAMREST <= LAMCEN_BASIS[IBIN] ) { IBIN = 0; } 
+	while ( LAMREST > LAMCEN_BASIS[IBIN+1] ) { IBIN++ ; }
+	frac = (LAMREST - LAMCEN_BASIS[IBIN]) / 
+	  (LAMCEN_BASIS[IBIN+1] - LAMCEN_BASIS[IBIN]) ;
+	FLAM = FLAM_LIST[IBIN] + frac*(FLAM_LIST[IBIN+1] - FLAM_LIST[IBIN]);
+      }
     }
     else {
       FLAM  = 0.0 ;   
@@ -10371,7 +10499,7 @@ double integmag_hostSpec(int IFILT_OBS, double z, int DUMPFLAG) {
 
   return(mag) ;
 
-} // end integmag_hostSpec
+} // end integmag_hostSpec_FLAM
 
 
 // ===================================
@@ -10382,17 +10510,31 @@ void rewrite_HOSTLIB_plusNbr(void) {
   //
   // Beware that 'igal' is a redshift-sorted index for the other 
   // HOSTLIB functions, but here we use the original HOSTLIB order.
+  //
+  // Oct 2026: 
+  //  + sort galaxies by sky cell (was DEC) so that each neighbor search
+  //    only checks galaxies in adjacent cells; see find_NBR_HOSTLIB_plusNbr.
+  //  + optional NTHREAD splits igal_unsort into contiguous blocks;
+  //    per-thread counters are merged in thread order, so the output
+  //    does not depend on NTHREAD.
 
   int  NGAL        = HOSTLIB.NGAL_STORE;
   int  IVAR_RA     = HOSTLIB.IVAR_RA ;
   int  IVAR_DEC    = HOSTLIB.IVAR_DEC ;
   int  MEMD        = NGAL * sizeof(double);
   int  MEMI        = NGAL * sizeof(int);
+  int  nthread     = HOSTLIB_NBR_WRITE.NTHREAD ;
 
-  int   igal_unsort, igal_zsort, igal_DECsort  ;
+  int   t, nnbr, NGAL_per_thread ;
 
   HOSTLIB_APPEND_DEF HOSTLIB_APPEND;
-  char  *LINE_APPEND, MSG[200] ;
+  HOSTNBR_THREAD_DEF thread_nbr[MXTHREAD_HOSTNBR];
+  char  MSG[200] ;
+
+#ifdef USE_THREAD
+  int  rc, NERR ;
+  pthread_t thread[MXTHREAD_HOSTNBR];
+#endif
 
   // internal debug
   int  NGAL_DEBUG  = INPUTS.HOSTLIB_MAXREAD ;
@@ -10421,40 +10563,39 @@ void rewrite_HOSTLIB_plusNbr(void) {
     sprintf(c2err,"Check VARNAMES in HOSTLIB");
     errmsg(SEV_FATAL, 0, fnam, c1err, c2err); 
   }
+
+  if ( HOSTLIB_NBR_WRITE.SEPNBR_MAX <= 0.0 ) {
+    sprintf(c1err,"Invalid SEPNBR_MAX = %f arcsec", 
+	    HOSTLIB_NBR_WRITE.SEPNBR_MAX);
+    sprintf(c2err,"SEPNBR_MAX must be > 0");
+    errmsg(SEV_FATAL, 0, fnam, c1err, c2err); 
+  }
+
+  if ( nthread < 1 ) { nthread = 1; }
+  if ( nthread > MXTHREAD_HOSTNBR ) {
+    sprintf(c1err,"NTHREAD=%d exceeds bound", nthread);
+    sprintf(c2err,"MXTHREAD_HOSTNBR=%d", MXTHREAD_HOSTNBR);
+    errmsg(SEV_FATAL, 0, fnam, c1err, c2err);  
+  }
+#ifndef USE_THREAD
+  nthread = 1;
+#endif
   
-  printf("\t NGAL[READ,STORE] = %d, %d \n", 
-	 HOSTLIB.NGAL_READ, HOSTLIB.NGAL_STORE);
+  printf("\t NGAL[READ,STORE] = %d, %d   (NTHREAD=%d)\n", 
+	 HOSTLIB.NGAL_READ, HOSTLIB.NGAL_STORE, nthread );
 
   malloc_HOSTLIB_APPEND(NGAL, &HOSTLIB_APPEND);
 
-  LINE_APPEND = (char*) malloc (MXCHAR_LINE_HOSTLIB * sizeof(char) ) ;
-  HOSTLIB_NBR_WRITE.SKY_SORTED_DEC          = (double*) malloc(MEMD) ;
-  HOSTLIB_NBR_WRITE.SKY_SORTED_RA           = (double*) malloc(MEMD) ;
-  HOSTLIB_NBR_WRITE.SKY_SORTED_IGAL_zsort   = (int*) malloc(MEMI) ;
-  HOSTLIB_NBR_WRITE.SKY_SORTED_IGAL_DECsort = (int*) malloc(MEMI) ;
+  HOSTLIB_NBR_WRITE.SKY_SORTED_DEC           = (double*) malloc(MEMD) ;
+  HOSTLIB_NBR_WRITE.SKY_SORTED_RA            = (double*) malloc(MEMD) ;
+  HOSTLIB_NBR_WRITE.SKY_SORTED_ICELL         = (double*) malloc(MEMD) ;
+  HOSTLIB_NBR_WRITE.SKY_SORTED_IGAL_zsort    = (int*) malloc(MEMI) ;
+  HOSTLIB_NBR_WRITE.SKY_SORTED_IGAL_CELLsort = (int*) malloc(MEMI) ;
   HOSTLIB_NBR_WRITE.GALID_atNNBR_MAX = -9 ;
   HOSTLIB_NBR_WRITE.NNBR_MAX         =  0 ;
 
-
-  // sort by DEC to improve NBR-matching speed
-  int  ORDER_SORT = +1 ;
-  double *ptrDEC = HOSTLIB.VALUE_ZSORTED[IVAR_DEC] ; 
-  double *ptrRA  = HOSTLIB.VALUE_ZSORTED[IVAR_RA] ; 
-
-  sortDouble( NGAL, ptrDEC, ORDER_SORT, 
-	      HOSTLIB_NBR_WRITE.SKY_SORTED_IGAL_DECsort);
-  
-  // load new lists of RA & DEC sorted by DEC
-  for(igal_DECsort=0; igal_DECsort < NGAL; igal_DECsort++ ) {
-    igal_zsort = HOSTLIB_NBR_WRITE.SKY_SORTED_IGAL_DECsort[igal_DECsort];
-    HOSTLIB_NBR_WRITE.SKY_SORTED_DEC[igal_DECsort]      = ptrDEC[igal_zsort] ;
-    HOSTLIB_NBR_WRITE.SKY_SORTED_RA[igal_DECsort]       = ptrRA[igal_zsort] ;
-    HOSTLIB_NBR_WRITE.SKY_SORTED_IGAL_zsort[igal_zsort] = igal_DECsort ;
-    if ( igal_DECsort < -5 || igal_DECsort > NGAL+5 ) {
-      printf(" xxx igal_DECsort=%d  igal_zsort=%6d,  DEC = %9.5f \n",
-	     igal_DECsort, igal_zsort, ptrDEC[igal_zsort] ); fflush(stdout);
-    }
-  }
+  // sort by sky cell to improve NBR-matching speed
+  init_SKYCELL_HOSTLIB_plusNbr();
   
   // ----------------------------
   if ( NGAL_DEBUG < MXROW_HOSTLIB ) { NGAL = NGAL_DEBUG; }
@@ -10462,18 +10603,67 @@ void rewrite_HOSTLIB_plusNbr(void) {
   // init diagnistic counters (filled in get_LINE_APPEND_HOSTLIB_plusNbr)
   monitor_HOSTLIB_plusNbr(0,&HOSTLIB_APPEND); 
 
-  // loop over all galaxies and prepare string to append.
-  for(igal_unsort=0; igal_unsort < NGAL; igal_unsort++ ) {
-
-    // search for neighbors and fill line to append
-    get_LINE_APPEND_HOSTLIB_plusNbr(igal_unsort, LINE_APPEND);
-    
-    fflush(stdout);
-
-    sprintf(HOSTLIB_APPEND.LINE_APPEND[igal_unsort],"%s", LINE_APPEND);
-
-  } // end igal_unsort loop over all galaxies
+  // loop over all galaxies and prepare string to append;
+  // one contiguous block of galaxies per thread.
+  NGAL_per_thread = (NGAL + nthread - 1) / nthread ;
+
+  for ( t = 0; t < nthread; t++ ) {
+    thread_nbr[t].id_thread   = t ;
+    thread_nbr[t].NGAL        = NGAL ;
+    thread_nbr[t].igal_min    = t * NGAL_per_thread ;
+    thread_nbr[t].igal_max    = (t+1) * NGAL_per_thread ;
+    if ( thread_nbr[t].igal_max > NGAL ) 
+      { thread_nbr[t].igal_max = NGAL; }
+    thread_nbr[t].LINE_APPEND = HOSTLIB_APPEND.LINE_APPEND ;
+
+    if ( nthread == 1 ) 
+      { get_LINE_APPEND_HOSTLIB_plusNbr_block(&thread_nbr[t]); }
+#ifdef USE_THREAD
+    else {
+      rc = pthread_create(&thread[t], NULL, 
+			  get_LINE_APPEND_HOSTLIB_plusNbr_block,
+			  &thread_nbr[t] );
+      if ( rc != 0 ) {
+	sprintf(c1err,"pthread_create returned %d for t=%d", rc, t);
+	sprintf(c2err,"igal_unsort = %d to %d", 
+		thread_nbr[t].igal_min, thread_nbr[t].igal_max-1 );
+	errmsg(SEV_FATAL, 0, fnam, c1err, c2err);  
+      }
+    }
+#endif
+  } // end t loop over threads
+
+#ifdef USE_THREAD
+  if ( nthread > 1 ) {
+    NERR = 0 ;
+    for ( t = 0; t < nthread; t++ ) {
+      rc = pthread_join(thread[t], NULL);
+      if ( rc != 0 ) {
+	NERR++ ;
+	printf(" ERROR: thread return errcode=%d for t=%d\n", rc,t); 
+      }
+    }
+    if ( NERR > 0 ) {
+      sprintf(c1err,"%d thread return code errors", NERR);
+      sprintf(c2err,"Check +HOSTNBR with NTHREAD=%d", nthread);
+      errmsg(SEV_FATAL, 0, fnam, c1err, c2err);  
+    }
+  }
+#endif
 
+  // merge counters in thread order; strict '>' keeps the first GALID
+  // with NNBR_MAX, as in serial mode.
+  for ( t = 0; t < nthread; t++ ) {
+    if ( thread_nbr[t].NNBR_MAX > HOSTLIB_NBR_WRITE.NNBR_MAX ) {
+      HOSTLIB_NBR_WRITE.NNBR_MAX         = thread_nbr[t].NNBR_MAX ;
+      HOSTLIB_NBR_WRITE.GALID_atNNBR_MAX = thread_nbr[t].GALID_atNNBR_MAX;
+    }
+    for(nnbr=0; nnbr < 100; nnbr++ ) { 
+      HOSTLIB_NBR_WRITE.NGAL_PER_NNBR[nnbr] += 
+	thread_nbr[t].NGAL_PER_NNBR[nnbr] ; 
+    }
+    HOSTLIB_NBR_WRITE.NGAL_TRUNCATE += thread_nbr[t].NGAL_TRUNCATE ;
+  }
 
   // - - - - - - - - - - - - 
 
@@ -10509,109 +10699,326 @@ void rewrite_HOSTLIB_plusNbr(void) {
 
 
 // ==============================
-void get_LINE_APPEND_HOSTLIB_plusNbr(int igal_unsort, char *LINE_APPEND) {
+void init_SKYCELL_HOSTLIB_plusNbr(void) {
+
+  // Created Oct 2026
+  // Divide sky into DEC bands of height CELLSIZE_DEG >= SEPNBR_MAX,
+  // and divide each band into NCELL_BAND RA cells that are at least
+  // CELLSIZE_DEG wide on the sky. Then sort galaxies by global cell 
+  // index and load SKY_SORTED_[RA,DEC,ICELL,IGAL_CELLsort] in this order.
+  // Any neighbor within SEPNBR_MAX is thus in the same or adjacent
+  // DEC band, and within an RA-cell range computed from |DEC|.
+
+  int    NGAL         = HOSTLIB.NGAL_STORE;
+  int    IVAR_RA      = HOSTLIB.IVAR_RA ;
+  int    IVAR_DEC     = HOSTLIB.IVAR_DEC ;
+  double *ptrDEC      = HOSTLIB.VALUE_ZSORTED[IVAR_DEC] ; 
+  double *ptrRA       = HOSTLIB.VALUE_ZSORTED[IVAR_RA] ; 
+  double CELLSIZE_MIN = 1.0/3600.0 ; // limit NBAND for tiny SEPNBR_MAX
+  double CELLSIZE_DEG = 1.001 * HOSTLIB_NBR_WRITE.SEPNBR_MAX/3600.0 ;
+  int    ORDER_SORT   = +1 ;
+
+  int    NBAND, NCELL, iband, igal_zsort, igal_CELLsort ;
+  double DEC_LO, DEC_HI, DEC_EDGE, ICELL0, *ICELL_LIST ;
+  char fnam[] = "init_SKYCELL_HOSTLIB_plusNbr" ;
+
+  // ------------ BEGIN ------------
+
+  if ( CELLSIZE_DEG < CELLSIZE_MIN ) { CELLSIZE_DEG = CELLSIZE_MIN; }
+  NBAND = (int)ceil(180.0/CELLSIZE_DEG);
+
+  HOSTLIB_NBR_WRITE.CELLSIZE_DEG = CELLSIZE_DEG ;
+  HOSTLIB_NBR_WRITE.NBAND_DEC    = NBAND ;
+  HOSTLIB_NBR_WRITE.NCELL_BAND   = (int   *) malloc(NBAND*sizeof(int));
+  HOSTLIB_NBR_WRITE.ICELL0_BAND  = (double*) malloc(NBAND*sizeof(double));
+
+  ICELL0 = 0.0 ;
+  for(iband=0; iband < NBAND; iband++ ) {
+    DEC_LO   = -90.0 + CELLSIZE_DEG * (double)iband ;
+    DEC_HI   = DEC_LO + CELLSIZE_DEG ;
+    DEC_EDGE = ( fabs(DEC_LO) > fabs(DEC_HI) ) ? fabs(DEC_LO) : fabs(DEC_HI);
+    if ( DEC_EDGE > 90.0 ) { DEC_EDGE = 90.0; }
+    NCELL    = (int)( 360.0 * cos(DEC_EDGE*RADIAN) / CELLSIZE_DEG );
+    if ( NCELL < 1 ) { NCELL = 1; }
+    HOSTLIB_NBR_WRITE.NCELL_BAND[iband]  = NCELL ;
+    HOSTLIB_NBR_WRITE.ICELL0_BAND[iband] = ICELL0 ;
+    ICELL0 += (double)NCELL ;
+  }
+
+  printf("\t Sky-cell index: %d DEC bands, %.0f cells, cell size %.2f'' \n",
+	 NBAND, ICELL0, CELLSIZE_DEG*3600.0 );
+  fflush(stdout);
+
+  ICELL_LIST = (double*) malloc(NGAL*sizeof(double));
+  for(igal_zsort=0; igal_zsort < NGAL; igal_zsort++ ) {
+    ICELL_LIST[igal_zsort] = 
+      get_ICELL_HOSTLIB_plusNbr(ptrRA[igal_zsort], ptrDEC[igal_zsort]);
+  }
+
+  sortDouble( NGAL, ICELL_LIST, ORDER_SORT, 
+	      HOSTLIB_NBR_WRITE.SKY_SORTED_IGAL_CELLsort);
+  
+  // load new lists of RA & DEC sorted by sky cell
+  for(igal_CELLsort=0; igal_CELLsort < NGAL; igal_CELLsort++ ) {
+    igal_zsort = HOSTLIB_NBR_WRITE.SKY_SORTED_IGAL_CELLsort[igal_CELLsort];
+    HOSTLIB_NBR_WRITE.SKY_SORTED_DEC[igal_CELLsort]   = ptrDEC[igal_zsort] ;
+    HOSTLIB_NBR_WRITE.SKY_SORTED_RA[igal_CELLsort]    = ptrRA[igal_zsort] ;
+    HOSTLIB_NBR_WRITE.SKY_SORTED_ICELL[igal_CELLsort] = ICELL_LIST[igal_zsort];
+    HOSTLIB_NBR_WRITE.SKY_SORTED_IGAL_zsort[igal_zsort] = igal_CELLsort ;
+  }
+
+  free(ICELL_LIST);
+
+  return ;
+
+} // end init_SKYCELL_HOSTLIB_plusNbr
+
+
+// ==============================
+double get_ICELL_HOSTLIB_plusNbr(double RA, double DEC) {
+
+  // Created Oct 2026
+  // Return global sky-cell index (as double for sortDouble) 
+  // for input RA,DEC (deg).
+
+  double CELLSIZE_DEG = HOSTLIB_NBR_WRITE.CELLSIZE_DEG ;
+  int    NBAND        = HOSTLIB_NBR_WRITE.NBAND_DEC ;
+  int    iband, ira, NCELL ;
+  double RA360 ;
+
+  // ------------ BEGIN ------------
+
+  iband = (int)floor( (DEC + 90.0) / CELLSIZE_DEG );
+  if ( iband < 0      ) { iband = 0; }
+  if ( iband >= NBAND ) { iband = NBAND-1; }
+
+  NCELL = HOSTLIB_NBR_WRITE.NCELL_BAND[iband] ;
+  RA360 = fmod(RA,360.0);  if ( RA360 < 0.0 ) { RA360 += 360.0; }
+  ira   = (int)floor( RA360 * (double)NCELL / 360.0 );
+  if ( ira >= NCELL ) { ira = NCELL-1; }
+
+  return( HOSTLIB_NBR_WRITE.ICELL0_BAND[iband] + (double)ira ) ;
+
+} // end get_ICELL_HOSTLIB_plusNbr
+
+
+// ==============================
+int find_NBR_HOSTLIB_plusNbr(int igal_zsort, int MXNNBR,
+			     double *SEP_NBR_LIST, int *IGAL_ZSORT_LIST) {
+
+  // Created Oct 2026 [code moved from get_LINE_APPEND_HOSTLIB_plusNbr]
+  // For galaxy igal_zsort, return number of neighbors within SEPNBR_MAX
+  // (excluding itself), and load first MXNNBR of 
+  //   SEP_NBR_LIST    : separation (arcsec)
+  //   IGAL_ZSORT_LIST : zsort index of neighbor
+  // Only galaxies in adjacent sky cells are checked; the same 
+  // angSep cut as the legacy DEC-strip search selects the same set.
+  // Read-only use of globals so that this function is thread-safe.
+
+  double SEPNBR_MAX    = HOSTLIB_NBR_WRITE.SEPNBR_MAX ;
+  double CELLSIZE_DEG  = HOSTLIB_NBR_WRITE.CELLSIZE_DEG ;
+  int    NBAND         = HOSTLIB_NBR_WRITE.NBAND_DEC ;
+  double *SKY_ICELL    = HOSTLIB_NBR_WRITE.SKY_SORTED_ICELL ;
+  double ASEC_PER_DEG  = 3600.0 ;
+  double SEP_DEG       = SEPNBR_MAX / ASEC_PER_DEG ;
+  int    NGAL          = HOSTLIB.NGAL_STORE;
+  int    IVAR_RA       = HOSTLIB.IVAR_RA ;
+  int    IVAR_DEC      = HOSTLIB.IVAR_DEC ;
+
+  double RA_GAL, DEC_GAL, RA360, RA_NBR, DEC_NBR, SEP_NBR, SEP_DEC ;
+  double DEC_EDGE, arg, dRA, ICELL_RANGE[2][2] ;
+  int    NNBR = 0, iband, jband, NCELL, ira_lo, ira_hi, NRANGE, r ;
+  int    isort, ilo, ihi, imid, igal2_zsort ;
+  bool   ALLRA ;
+
+  // ------------ BEGIN -----------
+
+  RA_GAL   = HOSTLIB.VALUE_ZSORTED[IVAR_RA][igal_zsort] ;  
+  DEC_GAL  = HOSTLIB.VALUE_ZSORTED[IVAR_DEC][igal_zsort] ; 
+  RA360    = fmod(RA_GAL,360.0);  if ( RA360 < 0.0 ) { RA360 += 360.0; }
+
+  // max RA offset for sep <= SEPNBR_MAX, evaluated at largest |DEC|;
+  // from haversine, hav(dRA) <= hav(SEP)/cos^2(DEC_EDGE)
+  DEC_EDGE = fabs(DEC_GAL) + SEP_DEG ;
+  ALLRA    = ( DEC_EDGE >= 90.0 );
+  dRA      = 360.0 ;
+  if ( !ALLRA ) {
+    arg   = sin(0.5*SEP_DEG*RADIAN) / cos(DEC_EDGE*RADIAN) ;
+    if ( arg >= 1.0 ) 
+      { ALLRA = true; }
+    else
+      { dRA = 1.001 * 2.0*asin(arg)/RADIAN ; }
+  }
+
+  iband = (int)floor( (DEC_GAL + 90.0) / CELLSIZE_DEG );
+  if ( iband < 0      ) { iband = 0; }
+  if ( iband >= NBAND ) { iband = NBAND-1; }
+
+  for(jband = iband-1; jband <= iband+1; jband++ ) {
+    if ( jband < 0 || jband >= NBAND ) { continue; }
+    NCELL  = HOSTLIB_NBR_WRITE.NCELL_BAND[jband] ;
+    ira_lo = (int)floor( (RA360-dRA) * (double)NCELL / 360.0 );
+    ira_hi = (int)floor( (RA360+dRA) * (double)NCELL / 360.0 );
+
+    // store 1 or 2 ranges of global cell index (2 if RA wraps)
+    NRANGE = 1;
+    ICELL_RANGE[0][0] = (double)ira_lo ;
+    ICELL_RANGE[0][1] = (double)ira_hi ;
+    if ( ALLRA || ira_hi - ira_lo + 1 >= NCELL ) {
+      ICELL_RANGE[0][0] = 0.0 ;
+      ICELL_RANGE[0][1] = (double)(NCELL-1) ;
+    }
+    else if ( ira_lo < 0 ) {
+      NRANGE = 2;
+      ICELL_RANGE[0][0] = 0.0 ;
+      ICELL_RANGE[1][0] = (double)(ira_lo + NCELL) ;
+      ICELL_RANGE[1][1] = (double)(NCELL-1) ;
+    }
+    else if ( ira_hi >= NCELL ) {
+      NRANGE = 2;
+      ICELL_RANGE[0][1] = (double)(NCELL-1) ;
+      ICELL_RANGE[1][0] = 0.0 ;
+      ICELL_RANGE[1][1] = (double)(ira_hi - NCELL) ;
+    }
+
+    for(r=0; r < NRANGE; r++ ) {
+      ICELL_RANGE[r][0] += HOSTLIB_NBR_WRITE.ICELL0_BAND[jband] ;
+      ICELL_RANGE[r][1] += HOSTLIB_NBR_WRITE.ICELL0_BAND[jband] ;
+
+      // binary search for first sorted galaxy with ICELL >= min
+      ilo = 0;  ihi = NGAL ;
+      while ( ilo < ihi ) {
+	imid = (ilo + ihi) / 2 ;
+	if ( SKY_ICELL[imid] < ICELL_RANGE[r][0] ) 
+	  { ilo = imid + 1 ; }
+	else
+	  { ihi = imid ; }
+      }
+
+      for(isort = ilo; isort < NGAL; isort++ ) {
+	if ( SKY_ICELL[isort] > ICELL_RANGE[r][1] ) { break; }
+
+	igal2_zsort = HOSTLIB_NBR_WRITE.SKY_SORTED_IGAL_CELLsort[isort];
+	if ( igal2_zsort == igal_zsort ) { continue; }
+
+	RA_NBR    = HOSTLIB_NBR_WRITE.SKY_SORTED_RA[isort] ;  
+	DEC_NBR   = HOSTLIB_NBR_WRITE.SKY_SORTED_DEC[isort] ;  
+	SEP_DEC   = fabs(DEC_NBR - DEC_GAL)*ASEC_PER_DEG;
+	if ( SEP_DEC > SEPNBR_MAX ) { continue ; }
+
+	SEP_NBR = angSep(RA_GAL, DEC_GAL, RA_NBR, DEC_NBR, ASEC_PER_DEG);
+	if ( SEP_NBR > SEPNBR_MAX ) { continue ; }
+
+	if ( NNBR < MXNNBR ) {
+	  SEP_NBR_LIST[NNBR]    = SEP_NBR ;
+	  IGAL_ZSORT_LIST[NNBR] = igal2_zsort ;
+	}
+	NNBR++ ;
+      } // end isort
+    } // end r loop over cell ranges
+  } // end jband
+
+  return(NNBR) ;
+
+} // end find_NBR_HOSTLIB_plusNbr
+
+
+// ==============================
+void *get_LINE_APPEND_HOSTLIB_plusNbr_block(void *thread) {
+
+  // Created Oct 2026
+  // Fill HOSTLIB_APPEND.LINE_APPEND for igal_min <= igal_unsort < igal_max.
+  // Called directly for NTHREAD=1, or via pthread_create.
+
+  HOSTNBR_THREAD_DEF *thread_nbr = (HOSTNBR_THREAD_DEF *)thread;
+  int  igal_unsort, nnbr ;
+  char LINE_APPEND[MXCHAR_LINE_HOSTLIB];
+
+  // ----------- BEGIN ------------
+
+  thread_nbr->NNBR_MAX         = 0 ;
+  thread_nbr->GALID_atNNBR_MAX = -9 ;
+  thread_nbr->NGAL_TRUNCATE    = 0 ;
+  for(nnbr=0; nnbr < 100; nnbr++ ) { thread_nbr->NGAL_PER_NNBR[nnbr] = 0; }
+
+  for(igal_unsort = thread_nbr->igal_min; 
+      igal_unsort < thread_nbr->igal_max; igal_unsort++ ) {
+
+    // search for neighbors and fill line to append
+    get_LINE_APPEND_HOSTLIB_plusNbr(igal_unsort, LINE_APPEND, thread_nbr);
+    
+    fflush(stdout);
+
+    sprintf(thread_nbr->LINE_APPEND[igal_unsort],"%s", LINE_APPEND);
+  }
+
+  return NULL;
+
+} // end get_LINE_APPEND_HOSTLIB_plusNbr_block
+
+
+// ==============================
+void get_LINE_APPEND_HOSTLIB_plusNbr(int igal_unsort, char *LINE_APPEND,
+				     HOSTNBR_THREAD_DEF *thread_nbr) {
 
   // Return LINE_APPEND = original line for igal_unsort plus list of
   // neighbors.
+  //
+  // Oct 2026: neighbor search moved to find_NBR_HOSTLIB_plusNbr;
+  //   diagnostic counters are incremented in *thread_nbr.
 
 #define MXNNBR_STORE 200         // max number of neighbors to track
-  double SEPNBR_MAX      = HOSTLIB_NBR_WRITE.SEPNBR_MAX ;
   int    NNBR_WRITE_MAX  = HOSTLIB_NBR_WRITE.NNBR_WRITE_MAX ;
-  double ASEC_PER_DEG  = 3600.0 ;
 
   int  NGAL        = HOSTLIB.NGAL_STORE;
   int  IVAR_GALID  = HOSTLIB.IVAR_GALID;
-  int  IVAR_RA     = HOSTLIB.IVAR_RA ;
-  int  IVAR_DEC    = HOSTLIB.IVAR_DEC ;
   int  LDMP        = (igal_unsort < -3);
 
   double SEP_NBR_LIST[MXNNBR_STORE];
-  int    IGAL_LIST[MXNNBR_STORE];
+  int    IGAL_LIST[MXNNBR_STORE], IGAL_ZSORT_LIST[MXNNBR_STORE];
   long long GALID, GALID_NBR, GALID_LIST[MXNNBR_STORE] ;
-  double RA_GAL, DEC_GAL, RA_NBR, DEC_NBR, SEP_NBR, SEP_DEC;
-  int  igal_zsort, igal2_unsort, igal2_zsort, igal_DECsort ;
-  int  NNBR, NTRY, j, ISORT_CHANGE, isort, NPASS_DEC, LSTDOUT ;
-  char cval[20], cval2[20], LINE_STDOUT[200];;
+  double SEP_NBR ;
+  int  igal_zsort, igal2_zsort, inbr ;
+  int  NNBR, isort, LSTDOUT ;
+  char cval[20], cval2[20], LINE_STDOUT[200];
+  char msg1[200], msg2[200];
   char fnam[] = "get_LINE_APPEND_HOSTLIB_plusNbr";
 
   // ------------ BEGIN -----------
 
   igal_zsort   = HOSTLIB.LIBINDEX_ZSORT[igal_unsort];
-  igal_DECsort = HOSTLIB_NBR_WRITE.SKY_SORTED_IGAL_zsort[igal_zsort];
-  RA_GAL       = HOSTLIB.VALUE_ZSORTED[IVAR_RA][igal_zsort] ;  
-  DEC_GAL      = HOSTLIB.VALUE_ZSORTED[IVAR_DEC][igal_zsort] ; 
   GALID        = (long long)HOSTLIB.VALUE_ZSORTED[IVAR_GALID][igal_zsort] ;
-  
 
   if ( LDMP ) {
     printf("\n xxx ---------- %s DUMP ---------------- \n", fnam);
     printf(" xxx Input igal_unsort=%d  \n", igal_unsort);
-    printf(" xxx recover igal_zsort=%d,  igal_DECsort=%d \n", 
-	   igal_zsort, igal_DECsort );
+    printf(" xxx recover igal_zsort=%d \n", igal_zsort );
     fflush(stdout);
   }
 
-
   sprintf(LINE_APPEND,"-1");
   LINE_STDOUT[0] = 0 ;
-  NNBR = NTRY = 0 ; NPASS_DEC = 1;  ISORT_CHANGE=1;
-
-  while ( NPASS_DEC > 0 ) {
-    NPASS_DEC = 0;
-
-    for(j = -1; j <=1; j+=2 ) { // try both directions
-
-      NTRY++ ;
-      isort = igal_DECsort + j*ISORT_CHANGE;
-
-      if ( isort < 0  || isort >= NGAL ) { continue; }
-      igal2_zsort   = HOSTLIB_NBR_WRITE.SKY_SORTED_IGAL_DECsort[isort];
-      igal2_unsort  = HOSTLIB.LIBINDEX_UNSORT[igal2_zsort];
-
-      RA_NBR      = HOSTLIB_NBR_WRITE.SKY_SORTED_RA[isort] ;  
-      DEC_NBR     = HOSTLIB_NBR_WRITE.SKY_SORTED_DEC[isort] ;  
-      SEP_DEC     = fabs(DEC_NBR - DEC_GAL)*ASEC_PER_DEG;
-
-      /*      
-      if ( SEP_DEC < 1.0E8 ) {
-	printf("\t zzz igal2_zsort=%d  DEC_GAL/NBR=%f/%f  SEP=%.2f\n", 
-	       igal_zsort, DEC_GAL, DEC_NBR, SEP_DEC );
-      }
-      */
-
-      if ( SEP_DEC > SEPNBR_MAX ) { continue ; }
-      NPASS_DEC++ ;
-
-      /*
-      if ( LDMP ) {
-	printf("\t j=%2d, isort=%6d  igal2=%6d NPASS=%d  dDEC=%f\n",
-	       j, isort, igal2_unsort, NPASS_DEC, SEP_DEC); fflush(stdout);
-      }
-      */
-
-      SEP_NBR = angSep(RA_GAL, DEC_GAL, RA_NBR, DEC_NBR, ASEC_PER_DEG);
-      if ( SEP_NBR > SEPNBR_MAX ) { continue ; }
-      GALID_NBR = (long long)HOSTLIB.VALUE_ZSORTED[IVAR_GALID][igal2_zsort] ;
-      
-      SEP_NBR_LIST[NNBR] = SEP_NBR;
-      IGAL_LIST[NNBR]    = igal2_unsort;
-      GALID_LIST[NNBR]   = GALID_NBR;
-      NNBR++ ;
-      if ( NNBR > HOSTLIB_NBR_WRITE.NNBR_MAX ) { 
-	HOSTLIB_NBR_WRITE.NNBR_MAX = NNBR; 
-	HOSTLIB_NBR_WRITE.GALID_atNNBR_MAX = GALID;
-      }
-
-    } // end j loop over smaller/larger DEC
-
-    ISORT_CHANGE++ ;
-  } // end while
 
+  NNBR = find_NBR_HOSTLIB_plusNbr(igal_zsort, MXNNBR_STORE,
+				  SEP_NBR_LIST, IGAL_ZSORT_LIST);
   
   if ( NNBR >=  MXNNBR_STORE ) {
-    sprintf(c1err, "NNBR=%d exceeds MXNNBR_STORE=%d", NNBR, MXNNBR_STORE);
-    sprintf(c2err, "Try reducing SEPNBR_MAX");
-    errmsg(SEV_FATAL, 0, fnam, c1err, c2err); 
+    // local error strings since c1err,c2err are shared globals
+    sprintf(msg1, "NNBR=%d exceeds MXNNBR_STORE=%d", NNBR, MXNNBR_STORE);
+    sprintf(msg2, "Try reducing SEPNBR_MAX");
+    errmsg(SEV_FATAL, 0, fnam, msg1, msg2); 
+  }
+
+  for(inbr=0; inbr < NNBR; inbr++ ) {
+    igal2_zsort       = IGAL_ZSORT_LIST[inbr];
+    IGAL_LIST[inbr]   = HOSTLIB.LIBINDEX_UNSORT[igal2_zsort];
+    GALID_LIST[inbr]  = 
+      (long long)HOSTLIB.VALUE_ZSORTED[IVAR_GALID][igal2_zsort] ;
+  }
+
+  if ( NNBR > thread_nbr->NNBR_MAX ) { 
+    thread_nbr->NNBR_MAX         = NNBR; 
+    thread_nbr->GALID_atNNBR_MAX = GALID;
   }
 
   // - - - - - - - - - - - - - - - - - - 
@@ -10622,8 +11029,8 @@ void get_LINE_APPEND_HOSTLIB_plusNbr(int igal_unsort, char *LINE_APPEND) {
 
 
   if ( LDMP ) { 
-    printf("\n xxx %s DUMP igal_unsort=%d  NNBR=%d   NTRY=%d\n", 
-	   fnam, igal_unsort, NNBR, NTRY );
+    printf("\n xxx %s DUMP igal_unsort=%d  NNBR=%d \n", 
+	   fnam, igal_unsort, NNBR );
   }
 
   sortDouble( NNBR, SEP_NBR_LIST, ORDER_SORT, UNSORT ) ;
@@ -10676,17 +11083,17 @@ void get_LINE_APPEND_HOSTLIB_plusNbr(int igal_unsort, char *LINE_APPEND) {
     fflush(stdout);
   }
 
+  if ( NNBR < 100 ) { thread_nbr->NGAL_PER_NNBR[NNBR]++ ; }
+  if ( TRUNCATE   ) { thread_nbr->NGAL_TRUNCATE++ ; }
+
   if ( (igal_unsort % 10000) == 0 ) {
-    NNBR  = HOSTLIB_NBR_WRITE.NNBR_MAX ; 
-    GALID = HOSTLIB_NBR_WRITE.GALID_atNNBR_MAX;
+    NNBR  = thread_nbr->NNBR_MAX ; 
+    GALID = thread_nbr->GALID_atNNBR_MAX;
     printf("\t Processing igal %8d of %8d  (NNBR_MAX=%2d for GALID=%lld)\n", 
 	   igal_unsort, NGAL, NNBR, GALID );
     fflush(stdout);
   }
 
-  if ( NNBR < 100 ) { HOSTLIB_NBR_WRITE.NGAL_PER_NNBR[NNBR]++ ; }
-  if ( TRUNCATE   ) { HOSTLIB_NBR_WRITE.NGAL_TRUNCATE++ ; }
-
   return ;
 
 } // end get_LINE_APPEND_HOSTLIB_plusNbr
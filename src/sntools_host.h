@@ -28,6 +28,7 @@
  
  Aug 11 2023: MXROW_HOSTLIB -> 40M (was 10M)
  Oct 03 2023: MXROW_HOSTLIB -> 60M
+ Oct 2026: sky-cell index and NTHREAD for +HOSTNBR
 
 ==================================================== */
 
@@ -329,19 +330,41 @@ struct {
   double SEPNBR_MAX;     // optional command-line input (default=10 arcsec)
   int    NNBR_WRITE_MAX;  // idem for how many NBRs to write (default=10)
 
+  int    NTHREAD;         // idem for number of pthreads (default=1)
+
   // internal arrays for +HOSTNBR command-line option
   int    NNBR_MAX; // actual max of NNBR
   double *SKY_SORTED_DEC, *SKY_SORTED_RA ; 
   int    *SKY_SORTED_IGAL_zsort;
-  int    *SKY_SORTED_IGAL_DECsort;
+  int    *SKY_SORTED_IGAL_CELLsort;
   long long GALID_atNNBR_MAX;  
 
+  // Oct 2026: sky-cell index; DEC bands of height CELLSIZE_DEG, each 
+  // split into NCELL_BAND RA cells that are at least CELLSIZE_DEG wide.
+  double CELLSIZE_DEG ;
+  int    NBAND_DEC ;
+  int    *NCELL_BAND ;       // number of RA cells per DEC band
+  double *ICELL0_BAND ;      // global index of first cell in DEC band
+  double *SKY_SORTED_ICELL ; // global cell index, sorted
+
   // internal diagnostics for stdout dump
   int NGAL_PER_NNBR[100] ; // store histogram of NNBR distribution
   int NGAL_TRUNCATE;       // NGAL cliiped by NNBR_WRITE_MAX or MXCHAR
 
 } HOSTLIB_NBR_WRITE ;
 
+#define MXTHREAD_HOSTNBR  64   // max number of threads for +HOSTNBR
+
+// each +HOSTNBR thread finds neighbors for a contiguous block of 
+// igal_unsort, with its own diagnostic counters (Oct 2026)
+typedef struct {
+  int    id_thread, igal_min, igal_max, NGAL ;
+  int    NNBR_MAX ;
+  long long GALID_atNNBR_MAX ;
+  int    NGAL_PER_NNBR[100], NGAL_TRUNCATE ;
+  char   **LINE_APPEND ;  // pointer to HOSTLIB_APPEND.LINE_APPEND
+} HOSTNBR_THREAD_DEF ;
+
 
 struct {
   double ZWIN[2], RAWIN[2], DECWIN[2];
@@ -615,6 +638,8 @@ struct SNTABLEVAR_DEF {
 #define ITABLE_SPECBASIS 0
 #define ITABLE_SPECDATA  1
 
+#define NGAL_BLOCK_HOSTSPEC 64  // galaxies per FLAM block for +HOSTMAGS
+
 struct {
   int  ITABLE ;       // either SPECBASIS or SPECDATA (Feb 23 2021)
   char TABLENAME[12] ;   // "BASIS" or "DATA"
@@ -633,6 +658,11 @@ struct {
   double  FLAM_SCALE, FLAM_SCALE_POWZ1 ;
   double *WAVE_CEN, *WAVE_MIN, *WAVE_MAX, *WAVE_BINSIZE ; // rest-frame
   double *FLAM_BASIS[MXSPECBASIS_HOSTLIB];
+
+  // Oct 2026: FLAM_BASIS[i] points to row i of contiguous matrix
+  // so that spectra for a block of galaxies is one GEMM.
+  double *FLAM_BASIS_MATRIX ; // [ispec*NBIN_WAVE_STRIDE + ilam]
+  int     NBIN_WAVE_STRIDE ;  // number of wave bins malloced per row
   
   int NWARN_INTEG_HOSTMAG[MXFILTINDX];
 
@@ -807,6 +837,10 @@ void   genSpec_HOSTLIB(double zhel, double MWEBV, int DUMPFLAG,
 		       double *GENFLUX_LIST, double *GENMAG_LIST);
 
 void malloc_HOSTSPEC(int NBIN_WAVE, int ISPEC);
+void   get_COEFF_SPECBASIS_HOSTLIB(int IGAL, double *COEFF_LIST);
+void   genFlam_SPECBASIS_HOSTLIB(int NGAL, double *COEFF_MATRIX, 
+				 double *FLAM_MATRIX);
+void   norm_FLAM_HOSTLIB(double zhel, double *FLAM);
 
 // fetch_HOSTPAR function for GENMODEL (e.g., BYOSED)
 int fetch_HOSTPAR_GENMODEL(int OPT, char *NAMES_HOSTPAR, double *VAL_HOSTPAR);
@@ -816,10 +850,18 @@ void   malloc_HOSTLIB_APPEND(int NGAL, HOSTLIB_APPEND_DEF *HOSTLIB_APPEND);
 void   addComment_HOSTLIB_APPEND(char *COMMENT,
 				 HOSTLIB_APPEND_DEF *HOSTLIB_APPEND);
 void   rewrite_HOSTLIB_plusNbr(void) ;
-void   get_LINE_APPEND_HOSTLIB_plusNbr(int igal_unsort, char *LINE_APPEND);
+void   get_LINE_APPEND_HOSTLIB_plusNbr(int igal_unsort, char *LINE_APPEND,
+					HOSTNBR_THREAD_DEF *thread_nbr);
+void   *get_LINE_APPEND_HOSTLIB_plusNbr_block(void *thread);
+void   init_SKYCELL_HOSTLIB_plusNbr(void);
+double get_ICELL_HOSTLIB_plusNbr(double RA, double DEC);
+int    find_NBR_HOSTLIB_plusNbr(int igal_zsort, int MXNNBR,
+				double *SEP_NBR_LIST, int *IGAL_ZSORT_LIST);
 void   rewrite_HOSTLIB_plusMags(void);
 void   monitor_HOSTLIB_plusNbr(int OPT, HOSTLIB_APPEND_DEF *HOSTLIB_APPEND);
 double integmag_hostSpec(int IFILT_OBS, double z, int DUMPFLAG);
+double integmag_hostSpec_FLAM(int IFILT_OBS, double z, double *FLAM, 
+			      int DUMPFLAG);
 void   rewrite_HOSTLIB_plusAppend(char *append_file);
 
 
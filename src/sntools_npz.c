@@ -1,30 +1,524 @@
 // Created Apr 2025
-// Utilities to read/write python-style npz files 
-// Initial use is for wfit.c to read npz-formatted covariance file 
+// Utilities to read/write python-style npz files
+// Initial use is for wfit.c to read npz-formatted covariance file
 // from create_covariance.py.
 // Use package from https://github.com/rogersce/cnpy
+//
+// Oct 2026: replace cnpy::npz_load (which decompresses the whole file
+//   and then copies each array) with a streaming reader that fills the
+//   caller's double array directly:
+//    + stored npz member or plain .npy file -> mmap and convert
+//    + deflated npz member -> inflate in NBYTE_CHUNK_NPZ chunks
+//   Supported dtypes are f8, f4, i8, i4 (little endian).
 
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <unistd.h>
 #include <time.h>
 #include <math.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <zlib.h>
 
+#include "sntools.h"
 #include "sntools_npz.h"
-#include "cnpy.h"
 
-int read_npz_array(char *npz_file, double *array1d) {
+// internal struct to stream one npy array from npz or npy file
+typedef struct {
+  char      fileName[1000];
+  char      varName[100];
+  bool      IS_DEFLATE ;
+
+  // stored member or npy file: memory map
+  int            fd ;
+  unsigned char *MMAP_PTR ;
+  size_t         MMAP_SIZE ;
+  unsigned char *DATA_PTR ;   // start of array data in MMAP_PTR
+
+  // deflated member: stream
+  FILE          *fp ;
+  z_stream       ZSTREAM ;
+  unsigned char *INBUF ;
 
-  int size_array = 0;
-  char fnam[] = "read_npz_array" ;
+  // npy header info
+  char      TYPE ;        // f or i
+  int       WORD_SIZE ;   // bytes per value
+  bool      FORTRAN_ORDER ;
+  int       NDIM ;
+  long long SHAPE[MXDIM_NPY], NVAL ;
+} NPY_READER_DEF ;
+
+void open_npy_reader(char *npz_file, char *varname, NPY_READER_DEF *R);
+void close_npy_reader(NPY_READER_DEF *R);
+void parse_npy_header_string(char *header, NPY_READER_DEF *R);
+long long inflate_npy_bytes(NPY_READER_DEF *R, unsigned char *out,
+			    long long nbyte);
+void convert_npy_values(NPY_READER_DEF *R, unsigned char *src,
+			long long nval, double *dest);
+
+// ===============================================
+int read_npz_array(char *npz_file, double *array1d) {
 
-  // load the entire npz file
-  cnpy::npz_t  my_npz = cnpy::npz_load(npz_file);
+  // Apr 2025: read first array in npz file.
+  // Oct 2026: stream into array1d; caller must allocate array1d.
+  //   Use read_npz_array_size to get the size.
 
-  debugexit(fnam);
-  return size_array;
+  long long NVAL = read_npz_array_member(npz_file, (char*)"", -1, array1d);
+  return (int)NVAL ;
 
 } // read_npz_array
 
+
+// ===============================================
+long long read_npz_array_size(char *npz_file, char *varname,
+			      int *ndim, long long *shape) {
+
+  // Created Oct 2026
+  // Return number of values in npz member varname
+  // (or first member if varname is blank), and its shape.
+  // Only the npy header is read.
+
+  NPY_READER_DEF R ;
+  int i;
+  // ---------- BEGIN ----------
+
+  open_npy_reader(npz_file, varname, &R);
+  *ndim = R.NDIM ;
+  for(i=0; i < R.NDIM; i++ ) { shape[i] = R.SHAPE[i]; }
+  close_npy_reader(&R);
+
+  return R.NVAL ;
+
+} // end read_npz_array_size
+
+
+// ===============================================
+long long read_npz_array_member(char *npz_file, char *varname,
+				long long max_val, double *array1d) {
+
+  // Created Oct 2026
+  // Read npz member varname (or first member if varname is blank)
+  // directly into pre-allocated array1d, converting to double.
+  // Abort if number of values exceeds max_val (ignore if max_val<0).
+  // Function returns number of values read.
+
+  NPY_READER_DEF R ;
+  long long NVAL, NVAL_CHUNK, ival, nval, nbyte, N, i, j ;
+  unsigned char *CHUNK ;
+  double tmp;
+  char fnam[] = "read_npz_array_member" ;
+
+  // ---------- BEGIN ----------
+
+  open_npy_reader(npz_file, varname, &R);
+  NVAL = R.NVAL ;
+
+  if ( max_val >= 0 && NVAL > max_val ) {
+    sprintf(c1err,"NVAL=%lld exceeds max_val=%lld for '%s'",
+	    NVAL, max_val, R.varName);
+    sprintf(c2err,"Check %s", npz_file);
+    errmsg(SEV_FATAL, 0, fnam, c1err, c2err);
+  }
+
+  if ( !R.IS_DEFLATE ) {
+    // memory-mapped: convert directly from mapped pages
+    convert_npy_values(&R, R.DATA_PTR, NVAL, array1d);
+  }
+  else if ( R.TYPE == 'f' && R.WORD_SIZE == 8 ) {
+    // inflate straight into destination
+    nbyte = NVAL * 8 ;
+    if ( inflate_npy_bytes(&R, (unsigned char*)array1d, nbyte) != nbyte ) {
+      sprintf(c1err,"Truncated data for '%s'", R.varName);
+      sprintf(c2err,"Check %s", npz_file);
+      errmsg(SEV_FATAL, 0, fnam, c1err, c2err);
+    }
+  }
+  else {
+    // inflate chunks and convert each chunk
+    NVAL_CHUNK = NBYTE_CHUNK_NPZ / R.WORD_SIZE ;
+    CHUNK      = (unsigned char*) malloc(NBYTE_CHUNK_NPZ);
+    for(ival=0; ival < NVAL; ival += NVAL_CHUNK ) {
+      nval = NVAL - ival ;
+      if ( nval > NVAL_CHUNK ) { nval = NVAL_CHUNK; }
+      nbyte = nval * R.WORD_SIZE ;
+      if ( inflate_npy_bytes(&R, CHUNK, nbyte) != nbyte ) {
+	sprintf(c1err,"Truncated data for '%s' at value %lld",
+		R.varName, ival);
+	sprintf(c2err,"Check %s", npz_file);
+	errmsg(SEV_FATAL, 0, fnam, c1err, c2err);
+      }
+      convert_npy_values(&R, CHUNK, nval, &array1d[ival]);
+    }
+    free(CHUNK);
+  }
+
+  // transpose square 2D matrix stored in fortran order
+  if ( R.FORTRAN_ORDER && R.NDIM == 2 ) {
+    N = R.SHAPE[0];
+    if ( R.SHAPE[1] != N ) {
+      sprintf(c1err,"Cannot transpose %lld x %lld fortran-order array",
+	      R.SHAPE[0], R.SHAPE[1] );
+      sprintf(c2err,"Check '%s' in %s", R.varName, npz_file);
+      errmsg(SEV_FATAL, 0, fnam, c1err, c2err);
+    }
+    for(i=0; i < N; i++ ) {
+      for(j=i+1; j < N; j++ ) {
+	tmp = array1d[i*N+j];
+	array1d[i*N+j] = array1d[j*N+i];
+	array1d[j*N+i] = tmp;
+      }
+    }
+  }
+
+  close_npy_reader(&R);
+
+  return NVAL ;
+
+} // end read_npz_array_member
+
+
+// ===============================================
+void unpack_triu_array(int N, double *array1d) {
+
+  // Created Oct 2026
+  // Input array1d has N(N+1)/2 upper-triangle values (row-major)
+  // in its first elements, and is allocated for N*N values.
+  // Expand in place to full symmetric N x N matrix.
+  // Going backwards, packed index <= full index, so no value is
+  // overwritten before it is moved.
+
+  long long i, j, NN = N ;
+  long long ipack ;
+
+  // ---------- BEGIN ----------
+
+  for(i=NN-1; i >= 0; i-- ) {
+    for(j=NN-1; j >= i; j-- ) {
+      ipack = i*NN - (i*(i-1))/2 + (j-i) ;
+      array1d[i*NN+j] = array1d[ipack];
+    }
+  }
+
+  for(i=0; i < NN; i++ ) {
+    for(j=i+1; j < NN; j++ ) { array1d[j*NN+i] = array1d[i*NN+j]; }
+  }
+
+  return ;
+
+} // end unpack_triu_array
+
+
+// ===============================================
+void open_npy_reader(char *npz_file, char *varname, NPY_READER_DEF *R) {
+
+  // Created Oct 2026
+  // Open npz (zip) or npy file, locate member varname
+  // (first member if blank), parse npy header, and leave R positioned
+  // at the start of the array data. Stored members are memory-mapped;
+  // deflated members are opened for streaming inflate.
+
+  struct stat st;
+  unsigned char LH[30], EXTRA[1000] ;
+  char name[200], *header ;
+  uint16_t compr_method, name_len, extra_len, id, len ;
+  uint64_t compr_bytes, uncompr_bytes ;
+  long long offset = 0, data_offset, hdr_len, hdr_start ;
+  unsigned char *ptr, prefix[12];
+  int  k ;
+  bool FOUND = false, IS_NPY = false ;
+  char fnam[] = "open_npy_reader" ;
+
+  // ---------- BEGIN ----------
+
+  memset(R, 0, sizeof(NPY_READER_DEF));
+  sprintf(R->fileName, "%s", npz_file);
+  sprintf(R->varName,  "%s", varname);
+  R->fd = -1 ;
+
+  R->fp = fopen(npz_file, "rb");
+  if ( !R->fp ) {
+    sprintf(c1err,"Unable to open npz file");
+    sprintf(c2err,"%s", npz_file);
+    errmsg(SEV_FATAL, 0, fnam, c1err, c2err);
+  }
+
+  if ( fread(LH, 1, 6, R->fp) != 6 ) { LH[0] = 0; }
+  IS_NPY = ( LH[0] == 0x93 && strncmp((char*)&LH[1],"NUMPY",5) == 0 );
+
+  // - - - - - -
+  // loop over zip local headers to find member
+  while ( !IS_NPY && !FOUND ) {
+    fseek(R->fp, offset, SEEK_SET);
+    if ( fread(LH, 1, 30, R->fp) != 30 ) { break; }
+    if ( LH[0] != 'P' || LH[1] != 'K' || LH[2] != 0x03 || LH[3] != 0x04 )
+      { break; }
+
+    memcpy(&compr_method,  &LH[8],  2);
+    compr_bytes = uncompr_bytes = 0 ;
+    memcpy(&compr_bytes,   &LH[18], 4);
+    memcpy(&uncompr_bytes, &LH[22], 4);
+    memcpy(&name_len,      &LH[26], 2);
+    memcpy(&extra_len,     &LH[28], 2);
+
+    if ( name_len >= sizeof(name) || extra_len > sizeof(EXTRA) ) { break; }
+    if ( fread(name,  1, name_len,  R->fp) != name_len  ) { break; }
+    if ( fread(EXTRA, 1, extra_len, R->fp) != extra_len ) { break; }
+    name[name_len] = 0 ;
+    if ( strstr(name,".npy") != NULL ) { name[name_len-4] = 0; }
+
+    // zip64 extra field for members larger than 4 GB
+    for(k=0; k+4 <= extra_len; k += 4+len ) {
+      memcpy(&id,  &EXTRA[k],   2);
+      memcpy(&len, &EXTRA[k+2], 2);
+      if ( id == 0x0001 && len >= 16 ) {
+	memcpy(&uncompr_bytes, &EXTRA[k+4],  8);
+	memcpy(&compr_bytes,   &EXTRA[k+12], 8);
+      }
+    }
+
+    data_offset = offset + 30 + name_len + extra_len ;
+    FOUND = ( strlen(varname) == 0 || strcmp(name,varname) == 0 );
+    if ( FOUND ) {
+      sprintf(R->varName, "%s", name);
+      R->IS_DEFLATE = ( compr_method == 8 );
+      if ( compr_method != 0 && compr_method != 8 ) {
+	sprintf(c1err,"Unsupported zip compression method %d for '%s'",
+		compr_method, name);
+	sprintf(c2err,"Check %s", npz_file);
+	errmsg(SEV_FATAL, 0, fnam, c1err, c2err);
+      }
+      offset = data_offset ;
+    }
+    else
+      { offset = data_offset + (long long)compr_bytes ; }
+  }
+
+  if ( IS_NPY ) { FOUND = true; offset = 0; }
+
+  if ( !FOUND ) {
+    sprintf(c1err,"Could not find member '%s'", varname);
+    sprintf(c2err,"in %s", npz_file);
+    errmsg(SEV_FATAL, 0, fnam, c1err, c2err);
+  }
+
+  // - - - - - - - - -
+  if ( R->IS_DEFLATE ) {
+    fseek(R->fp, offset, SEEK_SET);
+    R->INBUF = (unsigned char*) malloc(NBYTE_CHUNK_NPZ);
+    R->ZSTREAM.zalloc   = Z_NULL;
+    R->ZSTREAM.zfree    = Z_NULL;
+    R->ZSTREAM.opaque   = Z_NULL;
+    R->ZSTREAM.avail_in = 0;
+    R->ZSTREAM.next_in  = Z_NULL;
+    if ( inflateInit2(&R->ZSTREAM, -MAX_WBITS) != Z_OK ) {
+      sprintf(c1err,"inflateInit2 failed for member '%s'", R->varName);
+      sprintf(c2err,"in %s", npz_file);
+      errmsg(SEV_FATAL, 0, fnam, c1err, c2err);
+    }
+
+    // npy prefix: magic(6) + version(2) + header_len (2 or 4 bytes)
+    inflate_npy_bytes(R, prefix, 10);
+    if ( prefix[6] >= 2 ) {
+      inflate_npy_bytes(R, &prefix[10], 2);
+      hdr_len = prefix[8] + 256*prefix[9] + 65536*prefix[10] +
+	16777216LL*prefix[11] ;
+    }
+    else
+      { hdr_len = prefix[8] + 256*prefix[9]; }
+
+    header = (char*) malloc(hdr_len+1);
+    inflate_npy_bytes(R, (unsigned char*)header, hdr_len);
+    header[hdr_len] = 0 ;
+    parse_npy_header_string(header, R);
+    free(header);
+  }
+  else {
+    // map entire file read-only; pages are loaded on demand
+    if ( fstat(fileno(R->fp), &st) != 0 ) {
+      sprintf(c1err,"fstat failed for member '%s'", R->varName);
+      sprintf(c2err,"in %s", npz_file);
+      errmsg(SEV_FATAL, 0, fnam, c1err, c2err);
+    }
+    R->MMAP_SIZE = (size_t)st.st_size ;
+    R->fd        = open(npz_file, O_RDONLY);
+    R->MMAP_PTR  = (unsigned char*) mmap(NULL, R->MMAP_SIZE, PROT_READ,
+					 MAP_PRIVATE, R->fd, 0);
+    if ( R->MMAP_PTR == MAP_FAILED ) {
+      sprintf(c1err,"mmap failed for member '%s'", R->varName);
+      sprintf(c2err,"in %s", npz_file);
+      errmsg(SEV_FATAL, 0, fnam, c1err, c2err);
+    }
+    madvise(R->MMAP_PTR, R->MMAP_SIZE, MADV_SEQUENTIAL);
+
+    ptr = R->MMAP_PTR + offset ;
+    if ( ptr[6] >= 2 ) {
+      hdr_start = 12;
+      hdr_len   = ptr[8] + 256*ptr[9] + 65536*ptr[10] + 16777216LL*ptr[11];
+    }
+    else
+      { hdr_start = 10;  hdr_len = ptr[8] + 256*ptr[9]; }
+
+    header = (char*) malloc(hdr_len+1);
+    memcpy(header, &ptr[hdr_start], hdr_len);
+    header[hdr_len] = 0 ;
+    parse_npy_header_string(header, R);
+    free(header);
+
+    R->DATA_PTR = ptr + hdr_start + hdr_len ;
+    if ( R->DATA_PTR + R->NVAL*R->WORD_SIZE > R->MMAP_PTR + R->MMAP_SIZE ) {
+      sprintf(c1err,"Truncated data for '%s'", R->varName);
+      sprintf(c2err,"Check %s", npz_file);
+      errmsg(SEV_FATAL, 0, fnam, c1err, c2err);
+    }
+  }
+
+  return ;
+
+} // end open_npy_reader
+
+
+// ===============================================
+void close_npy_reader(NPY_READER_DEF *R) {
+  // Created Oct 2026
+  if ( R->IS_DEFLATE )
+    { inflateEnd(&R->ZSTREAM);  free(R->INBUF); }
+  if ( R->MMAP_PTR ) { munmap(R->MMAP_PTR, R->MMAP_SIZE); }
+  if ( R->fd >= 0  ) { close(R->fd); }
+  if ( R->fp       ) { fclose(R->fp); }
+  return ;
+} // end close_npy_reader
+
+
+// ===============================================
+void parse_npy_header_string(char *header, NPY_READER_DEF *R) {
+
+  // Created Oct 2026
+  // Parse python dict in npy header; e.g.,
+  //  {'descr': '<f4', 'fortran_order': False, 'shape': (1000, 1000), }
+
+  char *ptr, *ptr_end, ENDIAN ;
+  char fnam[] = "parse_npy_header_string" ;
+
+  // ---------- BEGIN ----------
+
+  ptr = strstr(header, "'descr'");
+  if ( ptr ) { ptr = strchr(ptr+7, '\''); }
+  if ( !ptr ) {
+    sprintf(c1err,"Missing descr in npy header for '%s'", R->varName);
+    sprintf(c2err,"Check %s", R->fileName);
+    errmsg(SEV_FATAL, 0, fnam, c1err, c2err);
+  }
+  ENDIAN       = ptr[1];
+  R->TYPE      = ptr[2];
+  R->WORD_SIZE = atoi(&ptr[3]);
+
+  bool VALID_TYPE =
+    ( R->TYPE == 'f' && (R->WORD_SIZE == 8 || R->WORD_SIZE == 4) ) ||
+    ( R->TYPE == 'i' && (R->WORD_SIZE == 8 || R->WORD_SIZE == 4) ) ;
+  if ( ENDIAN == '>' || !VALID_TYPE ) {
+    sprintf(c1err,"Unsupported dtype '%c%c%d' for '%s'",
+	    ENDIAN, R->TYPE, R->WORD_SIZE, R->varName);
+    sprintf(c2err,"Valid dtypes are <f8, <f4, <i8, <i4");
+    errmsg(SEV_FATAL, 0, fnam, c1err, c2err);
+  }
+
+  ptr = strstr(header, "'fortran_order'");
+  R->FORTRAN_ORDER = ( ptr && strncmp(ptr+17,"True",4) == 0 );
+
+  R->NDIM = 0;  R->NVAL = 1;
+  ptr = strstr(header, "'shape'");
+  if ( ptr ) { ptr = strchr(ptr, '('); }
+  while ( ptr && *ptr != ')' ) {
+    ptr++ ;
+    if ( *ptr < '0' || *ptr > '9' ) { continue; }
+    if ( R->NDIM >= MXDIM_NPY ) { break; }
+    R->SHAPE[R->NDIM] = strtoll(ptr, &ptr_end, 10);
+    R->NVAL *= R->SHAPE[R->NDIM];
+    R->NDIM++ ;
+    ptr = ptr_end - 1 ;
+  }
+
+  return ;
+
+} // end parse_npy_header_string
+
+
+// ===============================================
+long long inflate_npy_bytes(NPY_READER_DEF *R, unsigned char *out,
+			    long long nbyte) {
+
+  // Created Oct 2026
+  // Inflate exactly nbyte bytes into *out, reading compressed input
+  // in NBYTE_CHUNK_NPZ chunks. zlib avail_out is 32 bits, so fill
+  // out in pieces of at most 1 GB. Return number of bytes inflated.
+
+  z_stream *ZS = &R->ZSTREAM ;
+  long long nbyte_done = 0, nbyte_piece ;
+  size_t nread ;
+  int  err = Z_OK ;
+
+  // ---------- BEGIN ----------
+
+  while ( nbyte_done < nbyte && err != Z_STREAM_END ) {
+
+    nbyte_piece = nbyte - nbyte_done ;
+    if ( nbyte_piece > 1073741824LL ) { nbyte_piece = 1073741824LL; }
+    ZS->next_out  = out + nbyte_done ;
+    ZS->avail_out = (uInt)nbyte_piece ;
+
+    while ( ZS->avail_out > 0 ) {
+      if ( ZS->avail_in == 0 ) {
+	nread = fread(R->INBUF, 1, NBYTE_CHUNK_NPZ, R->fp);
+	if ( nread == 0 ) { err = Z_STREAM_END; break; }
+	ZS->next_in  = R->INBUF ;
+	ZS->avail_in = (uInt)nread ;
+      }
+      err = inflate(ZS, Z_NO_FLUSH);
+      if ( err == Z_STREAM_END ) { break; }
+      if ( err != Z_OK && err != Z_BUF_ERROR ) { break; }
+    }
+
+    nbyte_done += ( nbyte_piece - ZS->avail_out );
+    if ( err != Z_OK && err != Z_STREAM_END && err != Z_BUF_ERROR )
+      { break; }
+  }
+
+  return nbyte_done ;
+
+} // end inflate_npy_bytes
+
+
+// ===============================================
+void convert_npy_values(NPY_READER_DEF *R, unsigned char *src,
+			long long nval, double *dest) {
+
+  // Created Oct 2026
+  // Convert nval little-endian values at src to double.
+
+  long long i ;
+  float     f4 ;
+  int32_t   i4 ;
+  int64_t   i8 ;
+
+  if ( R->TYPE == 'f' && R->WORD_SIZE == 8 )
+    { memcpy(dest, src, nval*8); }
+  else if ( R->TYPE == 'f' && R->WORD_SIZE == 4 ) {
+    for(i=0; i < nval; i++ )
+      { memcpy(&f4, &src[4*i], 4);  dest[i] = (double)f4; }
+  }
+  else if ( R->TYPE == 'i' && R->WORD_SIZE == 8 ) {
+    for(i=0; i < nval; i++ )
+      { memcpy(&i8, &src[8*i], 8);  dest[i] = (double)i8; }
+  }
+  else if ( R->TYPE == 'i' && R->WORD_SIZE == 4 ) {
+    for(i=0; i < nval; i++ )
+      { memcpy(&i4, &src[4*i], 4);  dest[i] = (double)i4; }
+  }
+
+  return ;
+
+} // end convert_npy_values
@@ -1,6 +1,13 @@
 // Created Apr 2025
 // Functions to read/write npz file used by python.
+//
+// Oct 2026: stream array members directly into caller's buffer;
+//   stored members (and plain .npy files) are memory-mapped, and
+//   deflated members are inflated in chunks with float32/int -> double
+//   conversion on the fly. Peak memory is ~1x the double array.
 
+#define MXDIM_NPY         8        // max number of dimensions in npy shape
+#define NBYTE_CHUNK_NPZ   1048576  // 1 MB chunks for inflate
 
 
 #ifdef __cplusplus
@@ -9,6 +16,12 @@ extern"C" {
 
   int read_npz_array(char *npz_file, double *array1d);
 
+  long long read_npz_array_size(char *npz_file, char *varname,
+				int *ndim, long long *shape);
+  long long read_npz_array_member(char *npz_file, char *varname,
+				  long long max_val, double *array1d);
+  void unpack_triu_array(int N, double *array1d);
+
   void  errmsg ( int isev, int iprompt, char *fnam, char *msg1, char *msg2 );
   void  print_banner ( const char *banner ) ;
   void  print_preAbort_banner(char *fnam);
@@ -19,5 +32,5 @@ extern"C" {
   int  IGNOREFILE(char *fileName);
 
 #ifdef __cplusplus
-}          
+}
 #endif
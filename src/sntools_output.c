@@ -76,6 +76,27 @@
  Nov 04 2023: add VBOSE arg to CDTOPDIR_OUTPUT to enable codes to
               suppress output for long batch jobs.
 
+ Oct 2026: SNTABLE_AUTOSTORE_READ uses a per-file CCID hash table
+           (uthash) instead of a linear strcmp scan; new handle API
+           (HANDLE_VARNAME_AUTOSTORE, SNTABLE_AUTOSTORE_READ_HANDLE)
+           resolves varName once for repeated reads.
+
+ Oct 2026: SNTABLE_READPREP_COLUMN allocates typed table-owned columns
+           (double, or interned char*) that are handed to the caller
+           after SNTABLE_READ_EXEC (see SNTABLE_COLUMN_[D,C]).
+           AUTOSTORE uses these columns so that string columns are
+           interned instead of malloc'ing MXCHAR_CCID per row.
+           Columns are used by AUTOSTORE, wfit (read_HD) and
+           combine_fitres. SALT2mu appends each file at an offset in
+           its own arrays, so it keeps SNTABLE_READPREP_VARDEF.
+
+ Oct 2026: TEXT, ROOT and HBOOK backends fill each row with one
+           load_READTABLE_ROW call that writes table-owned columns
+           directly (no per-cell load_READTABLE_POINTER calls).
+           SNTABLE_READPREP_COLUMN also supports float columns.
+
+ Oct 2026: new SNTABLE_READ_ROW to stream TEXT tables row by row.
+
 ************************************************/
 
 #include <stdio.h>
@@ -91,6 +112,23 @@
 // #include "sntools.h"
 #include "sndata.h"
 #include "sntools_output.h"
+#include "uthash.h"
+
+// Oct 2026: hash entry to find AUTOSTORE row from CCID;
+// key points to SNTABLE_AUTOSTORE[ifile].CCID[irow] (no copy).
+struct hash_autostore_def {
+  int  irow ;
+  char *name ;
+  UT_hash_handle hh ;
+} ;
+
+// Oct 2026: pool of unique strings for interned char columns.
+// Pool lives until end of job; repeated values share one copy.
+struct intern_string_def {
+  char *str ;
+  UT_hash_handle hh ;
+} ;
+struct intern_string_def *INTERN_STRING_POOL = NULL ;
 
 // include the package-specific code(s) here.
 #ifdef USE_HBOOK
@@ -1121,6 +1159,11 @@ int SNTABLE_READPREP(int IFILETYPE, char *TABLENAME) {
     READTABLE_POINTERS.ICAST_READ[ivar]     = -9 ;
     READTABLE_POINTERS.ICAST_STORE[ivar]    = -9 ;
     READTABLE_POINTERS.PTRINDEX[ivar]       = -9 ;
+    READTABLE_POINTERS.INTERN_C[0][ivar]    = false ;
+    READTABLE_POINTERS.INTERN_C[1][ivar]    = false ;
+    READTABLE_POINTERS.COLUMN_D[ivar]       = NULL ; // owned by caller
+    READTABLE_POINTERS.COLUMN_F[ivar]       = NULL ;
+    READTABLE_POINTERS.COLUMN_C[ivar]       = NULL ;
   }
 
   sprintf(TBNAME_LOCAL, "%s", TABLENAME);
@@ -1475,13 +1518,231 @@ void load_READTABLE_POINTER(int IROW, int IVAR, double DVAL, char *CVAL) {
     else if ( ICAST == ICAST_S )  // short int
       { READTABLE_POINTERS.PTRVAL_S[nptr][IVAR_TOT][IROW] = (int)DVAL ; }
     
-    else if ( ICAST == ICAST_C ) 
-      { sprintf(READTABLE_POINTERS.PTRVAL_C[nptr][IVAR_TOT][IROW],"%s",CVAL);}
+    else if ( ICAST == ICAST_C ) {
+      if ( READTABLE_POINTERS.INTERN_C[nptr][IVAR_TOT] ) 
+	{ READTABLE_POINTERS.PTRVAL_C[nptr][IVAR_TOT][IROW] = 
+	    intern_READTABLE_STRING(CVAL); }
+      else
+	{ sprintf(READTABLE_POINTERS.PTRVAL_C[nptr][IVAR_TOT][IROW],
+		  "%s",CVAL);}
+    }
   }
 
 } // end of load_READTABLE_POINTER
 
 
+// ===============================================================
+void load_READTABLE_ROW(int IROW, long double *DVAL_LIST, char **CVAL_LIST) {
+
+  // Created Oct 2026
+  // Bulk fill of one table row for all read-variables.
+  // Inputs:
+  //   IROW       : row or event number (starts at 0)
+  //   DVAL_LIST  : numeric value per absolute IVAR index (NVAR_TOT)
+  //   CVAL_LIST  : string value per absolute IVAR index (NVAR_TOT)
+  //
+  // Table-owned columns (SNTABLE_READPREP_COLUMN) are written directly;
+  // caller-owned pointers are filled according to ICAST_STORE.
+  // Replaces per-cell load_READTABLE_POINTER calls in each backend.
+  // long double preserves 64-bit integers read from TEXT tables.
+
+  int  NVAR_READ = READTABLE_POINTERS.NVAR_READ ;
+  int  i, IVAR_TOT, ICAST, NPTR, nptr ;
+  long double DVAL ;
+  char *CVAL ;
+  double *COL_D ;
+  float  *COL_F ;
+  char  **COL_C ;
+  char fnam[] = "load_READTABLE_ROW" ;
+
+  // ---------------- BEGIN ----------
+
+  // mxlen=0 -> no arrays to fill (e.g., dump mode)
+  if ( READTABLE_POINTERS.MXLEN == 0 ) { return ; }
+
+  // avoid over-writing user-define array bound
+  if ( IROW >= READTABLE_POINTERS.MXLEN ) {
+    sprintf(MSGERR1, "IROW=%d exceeds user-defined array bound (MXLEN=%d)",
+	    IROW, READTABLE_POINTERS.MXLEN ) ;
+    sprintf(MSGERR2, "for table '%s'", READTABLE_POINTERS.TABLENAME);
+    errmsg(SEV_FATAL, 0, fnam, MSGERR1, MSGERR2);
+    return ;
+  }
+
+  for ( i = 0; i < NVAR_READ; i++ ) {
+
+    IVAR_TOT = READTABLE_POINTERS.PTRINDEX[i] ; 
+    if ( IVAR_TOT < 0 || IVAR_TOT >= MXVAR_TABLE ) {
+      sprintf(MSGERR1,"Invalid PTRINDEX[%d] = %d", i, IVAR_TOT );
+      sprintf(MSGERR2,"PTRINDEX must be %d to %d", 0, MXVAR_TABLE-1 );
+      errmsg(SEV_FATAL, 0, fnam, MSGERR1, MSGERR2 );
+    }
+
+    ICAST = READTABLE_POINTERS.ICAST_STORE[IVAR_TOT] ;
+    NPTR  = READTABLE_POINTERS.NPTR[IVAR_TOT] ;
+    DVAL  = DVAL_LIST[IVAR_TOT] ;
+    CVAL  = CVAL_LIST[IVAR_TOT] ;
+
+    // table-owned column: write directly
+    COL_D = READTABLE_POINTERS.COLUMN_D[IVAR_TOT] ;
+    COL_F = READTABLE_POINTERS.COLUMN_F[IVAR_TOT] ;
+    COL_C = READTABLE_POINTERS.COLUMN_C[IVAR_TOT] ;
+    if ( NPTR == 1 && COL_D != NULL ) 
+      { COL_D[IROW] = (double)DVAL ;  continue ; }
+    if ( NPTR == 1 && COL_F != NULL ) 
+      { COL_F[IROW] = (float)DVAL ;  continue ; }
+    if ( NPTR == 1 && COL_C != NULL ) 
+      { COL_C[IROW] = intern_READTABLE_STRING(CVAL);  continue ; }
+
+    for(nptr=0; nptr < NPTR; nptr++ ) {
+      if ( ICAST == ICAST_D ) 
+	{ READTABLE_POINTERS.PTRVAL_D[nptr][IVAR_TOT][IROW] = (double)DVAL; }
+      else if ( ICAST == ICAST_F ) 
+	{ READTABLE_POINTERS.PTRVAL_F[nptr][IVAR_TOT][IROW] = (float)DVAL; }
+      else if ( ICAST == ICAST_I ) 
+	{ READTABLE_POINTERS.PTRVAL_I[nptr][IVAR_TOT][IROW] = (int)DVAL; }
+      else if ( ICAST == ICAST_S ) 
+	{ READTABLE_POINTERS.PTRVAL_S[nptr][IVAR_TOT][IROW] = 
+	    (short int)DVAL; }
+      else if ( ICAST == ICAST_L ) 
+	{ READTABLE_POINTERS.PTRVAL_L[nptr][IVAR_TOT][IROW] = 
+	    (long long int)DVAL; }
+      else if ( ICAST == ICAST_C && READTABLE_POINTERS.INTERN_C[nptr][IVAR_TOT])
+	{ READTABLE_POINTERS.PTRVAL_C[nptr][IVAR_TOT][IROW] = 
+	    intern_READTABLE_STRING(CVAL); }
+      else if ( ICAST == ICAST_C ) 
+	{ sprintf(READTABLE_POINTERS.PTRVAL_C[nptr][IVAR_TOT][IROW],
+		  "%s", CVAL); }
+      else {
+	sprintf(MSGERR1,"Unknown ICAST=%d  var[%d]=%s  nptr=%d", 
+		ICAST, IVAR_TOT, READTABLE_POINTERS.VARNAME[IVAR_TOT], nptr );
+	sprintf(MSGERR2,"See ICAST_  parameters in sntools_output.h");
+	errmsg(SEV_FATAL, 0, fnam, MSGERR1, MSGERR2 );
+      }
+    } // end nptr
+
+  } // end i loop over read-variables
+
+  return ;
+
+} // end of load_READTABLE_ROW
+
+
+// ===============================================================
+int SNTABLE_READPREP_COLUMN(char *VARLIST, int ICAST, int mxlen, 
+			    int optMask) {
+
+  // Created Oct 2026
+  // Same as SNTABLE_READPREP_VARDEF, except that the column array
+  // is allocated here instead of passed by the caller.
+  //   ICAST = ICAST_D -> double column
+  //   ICAST = ICAST_F -> float column
+  //   ICAST = ICAST_C -> char* column; each element points to an
+  //                      interned string (do not modify or free).
+  // After SNTABLE_READ_EXEC, fetch column with SNTABLE_COLUMN_[D,F,C];
+  // the caller then owns the array and can free() it (but not the
+  // interned strings).
+  //
+  // Function returns absolute IVAR index, or -1 if not found.
+
+  int  MEMD = mxlen * sizeof(double);
+  int  MEMF = mxlen * sizeof(float);
+  int  MEMC = mxlen * sizeof(char*);
+  int  IVAR, NPTR, i ;
+  char VARLIST_CAST[MXCHAR_VARLIST], VARLIST_LOCAL[MXCHAR_VARLIST];
+  char *ptrtok, *ptrcast, ccast[4], varTmp[MXCHAR_VARNAME+4] ;
+  void *ptr = NULL ;
+  char fnam[] = "SNTABLE_READPREP_COLUMN" ;
+
+  // ------------- BEGIN ------------
+
+  if ( ICAST == ICAST_D ) 
+    { sprintf(ccast,"D"); ptr = (void*)malloc(MEMD); }
+  else if ( ICAST == ICAST_F ) 
+    { sprintf(ccast,"F"); ptr = (void*)malloc(MEMF); }
+  else if ( ICAST == ICAST_C ) {
+    sprintf(ccast,"C"); ptr = (void*)malloc(MEMC); 
+    for(i=0; i < mxlen; i++ ) { ((char**)ptr)[i] = NULL; }
+  }
+  else {
+    sprintf(MSGERR1,"Invalid ICAST=%d for VARLIST='%s'", ICAST, VARLIST);
+    sprintf(MSGERR2,"Valid ICAST are ICAST_D=%d, ICAST_F=%d, ICAST_C=%d",
+	    ICAST_D, ICAST_F, ICAST_C);
+    errmsg(SEV_FATAL, 0, fnam, MSGERR1, MSGERR2); 
+  }
+
+  // tack on cast to each name in VARLIST; replace cast if already there
+  // (e.g., 'CID:C*20' -> 'CID:C')
+  sprintf(VARLIST_LOCAL, "%s", VARLIST);
+  VARLIST_CAST[0] = 0 ;
+  ptrtok = strtok(VARLIST_LOCAL," ");
+  while ( ptrtok != NULL ) {
+    ptrcast = strchr(ptrtok,':');
+    if ( ptrcast != NULL ) { *ptrcast = 0 ; }
+    sprintf(varTmp," %s:%s", ptrtok, ccast);
+    strcat(VARLIST_CAST,varTmp);
+    ptrtok = strtok(NULL," ");
+  }
+
+  IVAR = SNTABLE_READPREP_VARDEF(VARLIST_CAST, ptr, mxlen, optMask);
+
+  if ( IVAR < 0 ) { free(ptr); return IVAR; }
+
+  NPTR = READTABLE_POINTERS.NPTR[IVAR] ;
+  if ( ICAST == ICAST_D ) 
+    { READTABLE_POINTERS.COLUMN_D[IVAR] = (double*)ptr; }
+  else if ( ICAST == ICAST_F ) 
+    { READTABLE_POINTERS.COLUMN_F[IVAR] = (float*)ptr; }
+  else {
+    READTABLE_POINTERS.COLUMN_C[IVAR]          = (char**)ptr; 
+    READTABLE_POINTERS.INTERN_C[NPTR-1][IVAR]  = true ;
+  }
+
+  return IVAR ;
+
+} // end SNTABLE_READPREP_COLUMN
+
+double *SNTABLE_COLUMN_D(int IVAR) {
+  // Created Oct 2026: return double column for IVAR (no copy);
+  // NULL if IVAR was not prepared with SNTABLE_READPREP_COLUMN.
+  if ( IVAR < 0 || IVAR >= MXVAR_TABLE ) { return NULL; }
+  return READTABLE_POINTERS.COLUMN_D[IVAR] ;
+} 
+
+float *SNTABLE_COLUMN_F(int IVAR) {
+  // Created Oct 2026: return float column for IVAR (no copy)
+  if ( IVAR < 0 || IVAR >= MXVAR_TABLE ) { return NULL; }
+  return READTABLE_POINTERS.COLUMN_F[IVAR] ;
+} 
+
+char **SNTABLE_COLUMN_C(int IVAR) {
+  // Created Oct 2026: return interned-string column for IVAR (no copy)
+  if ( IVAR < 0 || IVAR >= MXVAR_TABLE ) { return NULL; }
+  return READTABLE_POINTERS.COLUMN_C[IVAR] ;
+} 
+
+// ===============================================================
+char *intern_READTABLE_STRING(char *STRING) {
+
+  // Created Oct 2026
+  // Return pointer to unique copy of STRING in INTERN_STRING_POOL;
+  // add STRING to pool if not already there.
+
+  struct intern_string_def *s ;
+  int LEN = strlen(STRING);
+
+  HASH_FIND(hh, INTERN_STRING_POOL, STRING, LEN, s);
+  if ( s == NULL ) {
+    s      = (struct intern_string_def*)malloc(sizeof(*s));
+    s->str = (char*)malloc(LEN+1);
+    memcpy(s->str, STRING, LEN+1);
+    HASH_ADD_KEYPTR(hh, INTERN_STRING_POOL, s->str, LEN, s);
+  }
+  return s->str ;
+
+} // end intern_READTABLE_STRING
+
+
 // ============================================
 void load_DUMPLINE(int OPT, char *LINE, double DVAL) {
 
@@ -1598,6 +1859,41 @@ int SNTABLE_READ_EXEC(void) {
 
 } // end of  SNTABLE_READ_EXEC
 
+
+// ============================================
+int SNTABLE_READ_ROW(int IROW) {
+
+  // Created Oct 2026
+  // Streaming alternative to SNTABLE_READ_EXEC: read next table row
+  // into element IROW of arrays passed to SNTABLE_READPREP_VARDEF
+  // (typically mxlen=1 and IROW=0). Returns 1 if a row was read;
+  // returns 0 at end of table, and the table file is closed.
+  // Only TEXT format is supported.
+
+  int IFILETYPE = READTABLE_POINTERS.IFILETYPE ;
+  int ISTAT = 0 ;
+  char fnam[] = "SNTABLE_READ_ROW" ;
+
+  // --------------- BEGIN ---------------
+
+#ifdef USE_TEXT
+  if ( IFILETYPE == IFILETYPE_TEXT ) {
+    ISTAT = SNTABLE_READ_ROW_TEXT(IROW);
+    if ( ISTAT ) { READTABLE_POINTERS.NROW++ ; }
+    else         { SNTABLE_CLOSE_TEXT(); }
+    return ISTAT ;
+  }
+#endif
+
+  sprintf(MSGERR1,"Row-streaming not available for %s table",
+	  STRING_TABLEFILE_TYPE[IFILETYPE] );
+  sprintf(MSGERR2,"table = '%s'", READTABLE_POINTERS.TABLENAME );
+  errmsg(SEV_FATAL, 0, fnam, MSGERR1, MSGERR2);   
+
+  return ISTAT ;
+
+} // end of SNTABLE_READ_ROW
+
 // =====================================
 void SNTABLE_LIST(char *FILENAME) {
 
@@ -1972,6 +2268,9 @@ int SNTABLE_AUTOSTORE_INIT(char *fileName, char *tableName,
   //
   // Retreive values with 
   //   SNTABLE_AUTOSTORE_READ(CCID, varName, *istat, &VAL_D, VAL_C);
+  // or, for many reads of the same varName,
+  //   HANDLE = HANDLE_VARNAME_AUTOSTORE(varName);
+  //   SNTABLE_AUTOSTORE_READ_HANDLE(CCID, HANDLE, *istat, &VAL_D, VAL_C);
   //
   // This function is useful if you do NOT want to bother allocating 
   // your own memory, or if you need a fortran interface.
@@ -2010,14 +2309,13 @@ int SNTABLE_AUTOSTORE_INIT(char *fileName, char *tableName,
   //   + use catVarList_with_comma util
 
   bool APPEND_FLAG, ABORT_FLAG;
-  int  IFILETYPE, NF, ICAST, UNIQUE ;
+  int  IFILETYPE, NF, ICAST, ICAST_COL, UNIQUE ;
   int  NVAR_USR, ivar, NROW, i, indx ;
   char *ptrtok, *tmpVar, varName_withCast[MXCHAR_VARNAME];
   char *varList_table, *varList_table_ptrtok;
   char varName[MXCHAR_VARNAME] ;
   char readOpt[] = "read";
   char blankFile[] = "" ;
-  void *ptrStore;
   char fnam[] = "SNTABLE_AUTOSTORE_INIT" ;
 
   // -------------- BEGIN --------------
@@ -2041,6 +2339,7 @@ int SNTABLE_AUTOSTORE_INIT(char *fileName, char *tableName,
   varList_table[0] = 0;
 
   NF = NFILE_AUTOSTORE-1;  // file index
+  SNTABLE_AUTOSTORE_hash(-1,NF); // free CCID hash from previous use
   SNTABLE_AUTOSTORE[NF].NVAR = 0 ;
   SNTABLE_AUTOSTORE[NF].NROW = 0 ;
   SNTABLE_AUTOSTORE[NF].IFILETYPE = -9;
@@ -2146,27 +2445,22 @@ int SNTABLE_AUTOSTORE_INIT(char *fileName, char *tableName,
 
     if ( ICAST < 0 ) { continue ; }   
 
-    if ( ICAST == ICAST_C )  {  
-      sprintf(varName_withCast,"%s:C", varName ); 
-      SNTABLE_AUTOSTORE_malloc(ICAST_C,NF,ivar); 
-      ptrStore = SNTABLE_AUTOSTORE[NF].CVAL[ivar] ; 
-    }
-    else  {
-      sprintf(varName_withCast,"%s:D", varName ); 
-      SNTABLE_AUTOSTORE_malloc(ICAST_D,NF,ivar); 
-      ptrStore = SNTABLE_AUTOSTORE[NF].DVAL[ivar] ;  
-    }
-
-    indx = SNTABLE_READPREP_VARDEF(varName_withCast, ptrStore, NROW, 1);
+    // Oct 2026: let table allocate column; strings are interned
+    if ( ICAST != ICAST_C ) { ICAST_COL = ICAST_D; }
+    else                    { ICAST_COL = ICAST_C; }
+    sprintf(varName_withCast,"%s:%c", varName, CCAST_TABLEVAR[ICAST_COL]); 
+    indx = SNTABLE_READPREP_COLUMN(varName, ICAST_COL, NROW, 1);
 
     if ( indx >= 0 ) { 
+      SNTABLE_AUTOSTORE[NF].DVAL[ivar]    = SNTABLE_COLUMN_D(indx);
+      SNTABLE_AUTOSTORE[NF].CVAL[ivar]    = SNTABLE_COLUMN_C(indx);
       SNTABLE_AUTOSTORE[NF].IVARMAP[indx] = ivar ; 
       SNTABLE_AUTOSTORE[NF].EXIST[ivar]   = 1; 
       SNTABLE_AUTOSTORE[NF].ICAST_READ[ivar]   = ICAST ; 
     }
     else {
       sprintf(MSGERR1,"Invalid indx=%d for %s", indx, varName_withCast);
-      sprintf(MSGERR2,"returned from SNTABLE_READPREP_VARDEF" );
+      sprintf(MSGERR2,"returned from SNTABLE_READPREP_COLUMN" );
       errmsg(SEV_FATAL, 0, fnam, MSGERR1, MSGERR2); 
     }
     
@@ -2185,6 +2479,9 @@ int SNTABLE_AUTOSTORE_INIT(char *fileName, char *tableName,
     SNTABLE_AUTOSTORE[NF].LENCCID[i] = strlen(ptrCCID);
   } 
 
+  // Oct 2026: CCID -> row hash table for fast READ
+  SNTABLE_AUTOSTORE_hash(+1,NF);
+
   // init LASTREAD quantities
   LASTREAD_AUTOSTORE.IFILE = -9;
   LASTREAD_AUTOSTORE.IROW  = -9;
@@ -2209,8 +2506,8 @@ void  SNTABLE_AUTOSTORE_malloc(int OPT, int IFILE, int IVAR) {
 
   // Created Jan 2017
   // OPT =  0  --> mallic CCID, and create NVAR pointers
-  // OPT = +1  --> malloc char for each row
-  // OPT = +8  --> malloc double for each row
+  // Oct 2026: DVAL & CVAL columns are now allocated by
+  //    SNTABLE_READPREP_COLUMN; +ICAST options removed.
   // OPT = -1  --> free char mem 
   // OPT = -8  --> free double mem 
   //
@@ -2247,21 +2544,8 @@ void  SNTABLE_AUTOSTORE_malloc(int OPT, int IFILE, int IVAR) {
 
   }
 
-  else if ( OPT == ICAST_C) {
-
-    SNTABLE_AUTOSTORE[IFILE].CVAL[IVAR] = (char**)malloc(NROW*sizeof(char*)); 
-    for(i=0; i < NROW; i++ )  { 
-      SNTABLE_AUTOSTORE[IFILE].CVAL[IVAR][i] = 
-	(char*)malloc(MEMC*MXCHAR_CCID);
-    }
-    
-  }
-  else if ( OPT == ICAST_D ) {
-    SNTABLE_AUTOSTORE[IFILE].DVAL[IVAR] = (double*)malloc(NROW*MEMD); 
-
-  }
   else if ( OPT == -ICAST_C ) {	  
-    for(i=0; i<NROW; i++ ) { free(SNTABLE_AUTOSTORE[IFILE].CVAL[IVAR][i]); }
+    // Oct 2026: strings are interned -> free only the column
     free(SNTABLE_AUTOSTORE[IFILE].CVAL[IVAR]);
   }
   else if ( OPT == -ICAST_D ) {
@@ -2451,56 +2735,60 @@ void SNTABLE_AUTOSTORE_READ(char *CCID, char *VARNAME, int *ISTAT,
   //
   // Oct 20 2020:
   //   + do NOT abort on missing varname; instead, return ISTAT = -2
+  //
+  // Oct 2026: 
+  //   + resolve VARNAME with HANDLE_VARNAME_AUTOSTORE and read with
+  //     SNTABLE_AUTOSTORE_READ_HANDLE (CCID hash lookup). Callers that
+  //     read the same VARNAME for many CCIDs should get the handle
+  //     once and call SNTABLE_AUTOSTORE_READ_HANDLE directly.
 
-  int IVAR_READ, IFILE_READ, ivar, i ;
-  int NVAR_USR, NROW_TOT, ICAST, LENCCID, IROW ;
-  char *tmpCCID, *tmpVar;
-  
-  char fnam[] = "SNTABLE_AUTOSTORE_READ" ;
-
+  int HANDLE ;
   // ------------- BEGIN --------------
 
-  *ISTAT = -1 ;       // default is that CCID is not found.
-  IVAR_READ = IFILE_READ = IROW = -9 ;
-  NREAD_AUTOSTORE++ ;
+  HANDLE = HANDLE_VARNAME_AUTOSTORE(VARNAME);
+  SNTABLE_AUTOSTORE_READ_HANDLE(CCID, HANDLE, ISTAT, DVAL, CVAL);
+  return ;
 
-  // search file and variable indices
-  for(i=0; i < NFILE_AUTOSTORE; i++ ) {
-    NVAR_USR = SNTABLE_AUTOSTORE[i].NVAR ;
-    for(ivar=0; ivar < NVAR_USR; ivar++ ) {
-      tmpVar = SNTABLE_AUTOSTORE[i].VARNAME[ivar] ;
-      if ( strcmp(tmpVar,VARNAME) == 0 ) 
-	{ IVAR_READ = ivar ; IFILE_READ = i ;  goto FIND_CCID; }   
-    }
-  }
+} // end of SNTABLE_AUTOSTORE_READ
 
 
-  if ( IVAR_READ < 0  || IFILE_READ < 0 ) { *ISTAT = -2; return ; }
+// =====================================
+void SNTABLE_AUTOSTORE_READ_HANDLE(char *CCID, int HANDLE, int *ISTAT,
+				   double *DVAL, char *CVAL ) {
+
+  // Created Oct 2026
+  // Same as SNTABLE_AUTOSTORE_READ, but variable is specified by
+  // HANDLE returned from HANDLE_VARNAME_AUTOSTORE. CCID row is
+  // found with hash lookup, so each read is O(1).
+  //
+  // *ISTAT =  0  if CCID is found;
+  // *ISTAT = -1  if CCID is NOT found 
+  // *ISTAT = -2  if HANDLE is not valid (VARNAME not found)
 
- FIND_CCID:
+  int IFILE_READ, IVAR_READ, IROW, ICAST ;
+  // char fnam[] = "SNTABLE_AUTOSTORE_READ_HANDLE" ;
+
+  // ------------- BEGIN --------------
+
+  *ISTAT = -1 ;       // default is that CCID is not found.
+  NREAD_AUTOSTORE++ ;
 
-  ICAST    = SNTABLE_AUTOSTORE[IFILE_READ].ICAST_READ[IVAR_READ] ;    
-  NROW_TOT = SNTABLE_AUTOSTORE[IFILE_READ].NROW ; // total number of rows read
-  LENCCID  = strlen(CCID);
+  if ( HANDLE < 0 ) { *ISTAT = -2; return ; }
 
-  // if IFILE and CCID are the same as last time, 
-  // skip slow check of all CCIDs
+  IFILE_READ = HANDLE / MXVAR_TABLE ;
+  IVAR_READ  = HANDLE % MXVAR_TABLE ;
+  ICAST      = SNTABLE_AUTOSTORE[IFILE_READ].ICAST_READ[IVAR_READ] ;    
 
+  // if IFILE and CCID are the same as last time, skip hash lookup
   bool IS_SAME_FILE = ( IFILE_READ == LASTREAD_AUTOSTORE.IFILE );
   bool IS_SAME_CCID = ( strcmp(CCID,LASTREAD_AUTOSTORE.CCID)==0);
   if (IS_SAME_FILE && IS_SAME_CCID ) 
-    { IROW =  LASTREAD_AUTOSTORE.IROW ;  goto SET_OUTVAL; }
-
-  // do slow loop over each row and do CCID string match each row.
-  for(i=0; i < NROW_TOT; i++ ) {
-    tmpCCID = SNTABLE_AUTOSTORE[IFILE_READ].CCID[i] ;
-    if ( tmpCCID[0] != CCID[0] ) { continue ; } // quick check first char
-    if ( strcmp(tmpCCID,CCID) == 0 )  { IROW = i ;  goto SET_OUTVAL ; }
-  }
+    { IROW =  LASTREAD_AUTOSTORE.IROW ; }
+  else
+    { IROW = IROW_AUTOSTORE(IFILE_READ, CCID); }
 
   if ( IROW < 0 ) { return ; } // could not find CCID
 
- SET_OUTVAL:
   *ISTAT = 0 ;
   if ( ICAST == ICAST_C ) {  
     sprintf(CVAL,"%s",SNTABLE_AUTOSTORE[IFILE_READ].CVAL[IVAR_READ][IROW]) ; 
@@ -2514,10 +2802,98 @@ void SNTABLE_AUTOSTORE_READ(char *CCID, char *VARNAME, int *ISTAT,
   LASTREAD_AUTOSTORE.IROW  = IROW;
   sprintf(LASTREAD_AUTOSTORE.CCID,"%s", CCID );
 
-  // if we get here, return 'not found' value.
   return ;
 
-} // end of SNTABLE_AUTOSTORE_READ
+} // end of SNTABLE_AUTOSTORE_READ_HANDLE
+
+
+// ============================================
+int HANDLE_VARNAME_AUTOSTORE(char *varName) {
+
+  // Created Oct 2026
+  // Return handle = IFILE*MXVAR_TABLE + IVAR for first stored
+  // *varName, to pass to SNTABLE_AUTOSTORE_READ_HANDLE.
+  // As in IVAR_VARNAME_AUTOSTORE, a match with EXIST=0 is skipped
+  // and remaining files are searched. Returns -9 if not stored.
+
+  int ifile, ivar, NVAR_USR ;
+  // ------- BEGIN ---------
+
+  for(ifile=0; ifile < NFILE_AUTOSTORE; ifile++ ) {
+    NVAR_USR = SNTABLE_AUTOSTORE[ifile].NVAR ;
+    for(ivar=0; ivar < NVAR_USR; ivar++ ) {
+      if ( strcmp(SNTABLE_AUTOSTORE[ifile].VARNAME[ivar],varName)==0 ) {
+	if ( SNTABLE_AUTOSTORE[ifile].EXIST[ivar] ) 
+	  { return( ifile*MXVAR_TABLE + ivar ) ; }
+      }
+    }
+  }
+
+  return(-9);
+
+} // end HANDLE_VARNAME_AUTOSTORE
+
+
+// ============================================
+int IROW_AUTOSTORE(int IFILE, char *CCID) {
+
+  // Created Oct 2026
+  // Return row index for *CCID in autoStore file IFILE;
+  // return -9 if CCID is not found.
+
+  struct hash_autostore_def *s ;
+  // ------- BEGIN ---------
+
+  HASH_FIND_STR( SNTABLE_AUTOSTORE[IFILE].HASH_CCID, CCID, s);
+  if ( s ) { return s->irow ; }
+  return(-9);
+
+} // end IROW_AUTOSTORE
+
+
+// ============================================
+void SNTABLE_AUTOSTORE_hash(int OPT, int IFILE) {
+
+  // Created Oct 2026
+  // OPT > 0 : build CCID -> IROW hash table for autoStore IFILE.
+  // OPT < 0 : free hash table for IFILE.
+  // For duplicate CCIDs the first row is kept, as for the
+  // original linear search.
+
+  struct hash_autostore_def *s, *store, *tmp ;
+  int  NROW = SNTABLE_AUTOSTORE[IFILE].NROW ;
+  int  i ;
+  char *ccid ;
+  // ------- BEGIN ---------
+
+  if ( OPT < 0 ) {
+    if ( SNTABLE_AUTOSTORE[IFILE].HASH_CCID_STORE == NULL ) { return; }
+    HASH_CLEAR(hh, SNTABLE_AUTOSTORE[IFILE].HASH_CCID);
+    free(SNTABLE_AUTOSTORE[IFILE].HASH_CCID_STORE);
+    SNTABLE_AUTOSTORE[IFILE].HASH_CCID       = NULL ;
+    SNTABLE_AUTOSTORE[IFILE].HASH_CCID_STORE = NULL ;
+    return ;
+  }
+
+  store = (struct hash_autostore_def*)
+    malloc( (NROW+1) * sizeof(struct hash_autostore_def) );
+  SNTABLE_AUTOSTORE[IFILE].HASH_CCID_STORE = store ;
+  SNTABLE_AUTOSTORE[IFILE].HASH_CCID       = NULL ;
+
+  for(i=0; i < NROW; i++ ) {
+    ccid = SNTABLE_AUTOSTORE[IFILE].CCID[i] ;
+    HASH_FIND_STR( SNTABLE_AUTOSTORE[IFILE].HASH_CCID, ccid, tmp);
+    if ( tmp ) { continue; }  // keep first row for duplicate CCID
+    s = &store[i] ;
+    s->irow = i ;
+    s->name = ccid ;
+    HASH_ADD_KEYPTR(hh, SNTABLE_AUTOSTORE[IFILE].HASH_CCID, s->name,
+		    SNTABLE_AUTOSTORE[IFILE].LENCCID[i], s);
+  }
+
+  return ;
+
+} // end SNTABLE_AUTOSTORE_hash
 
 // fortran/mangle function
 void sntable_autostore_read__(char *CCID, char *varName, int *ISTAT, 
@@ -2525,6 +2901,14 @@ void sntable_autostore_read__(char *CCID, char *varName, int *ISTAT,
   SNTABLE_AUTOSTORE_READ(CCID,varName,ISTAT,DVAL,CVAL);
 }
 
+void sntable_autostore_read_handle__(char *CCID, int *HANDLE, int *ISTAT, 
+				     double *DVAL, char *CVAL ) {
+  SNTABLE_AUTOSTORE_READ_HANDLE(CCID,*HANDLE,ISTAT,DVAL,CVAL);
+}
+
+int handle_varname_autostore__(char *varName) 
+{ return HANDLE_VARNAME_AUTOSTORE(varName); }
+
 
 void fetch_autostore_ccid(int ifile, int isn, char *ccid) {
   // Created Jan 4 2021
@@ -32,6 +32,17 @@
 
  Jan 05 2023: MXCHAR_FILENAME-> 300 (was 240)
 
+ Oct 2026: add CCID hash index (HASH_CCID) to SNTABLE_AUTOSTORE and
+           declare varName handle functions for O(1) AUTOSTORE reads.
+
+ Oct 2026: add table-owned columns (COLUMN_D, COLUMN_C) and interned
+           string flag (INTERN_C) to READTABLE_POINTERS; see
+           SNTABLE_READPREP_COLUMN.
+ Oct 2026: declare SNTABLE_READ_ROW for streaming TEXT tables,
+           and SNTABLE_CLOSE_TEXT & set_NROW_FLUSH_TEXT for combine_fitres.
+ Oct 2026: add float columns (COLUMN_F), and load_READTABLE_ROW for
+           per-row bulk fill by each backend.
+
 *******************************************/
 
 
@@ -159,6 +170,13 @@ struct READTABLE_POINTERS {
   short int  *PTRVAL_S[2][MXVAR_TABLE];      
   long long int *PTRVAL_L[2][MXVAR_TABLE]; 
   char   **PTRVAL_C[2][MXVAR_TABLE];  // Aug 2013
+  bool   INTERN_C[2][MXVAR_TABLE];    // store interned char* (Oct 2026)
+
+  // Oct 2026: columns allocated by SNTABLE_READPREP_COLUMN;
+  // memory is handed to the caller after SNTABLE_READ_EXEC.
+  double     *COLUMN_D[MXVAR_TABLE];  // index is NVARTOT
+  float      *COLUMN_F[MXVAR_TABLE];
+  char      **COLUMN_C[MXVAR_TABLE];  // entries point to interned strings
   
   // ... or store file pointer for ascii dump
   FILE *FP_DUMP ;
@@ -334,6 +352,7 @@ struct OUTLIER_INFO {
 #define MXFILE_AUTOSTORE 10   // max files to autoStore (Jan 2017)
 int NFILE_AUTOSTORE ;
 int NREAD_AUTOSTORE ;
+struct hash_autostore_def ;  // uthash entry: CCID -> IROW (Oct 2026)
 struct SNTABLE_AUTOSTORE {
   int     NVAR ;
   int     IVARMAP[MXVAR_TABLE]; 
@@ -348,6 +367,9 @@ struct SNTABLE_AUTOSTORE {
   double  **DVAL ;
   char    ***CVAL ;
 
+  struct hash_autostore_def *HASH_CCID ;       // hash head for CCID lookup
+  struct hash_autostore_def *HASH_CCID_STORE ; // NROW entries (for free)
+
 } SNTABLE_AUTOSTORE[MXFILE_AUTOSTORE] ;
 
 
@@ -484,9 +506,19 @@ extern"C" {
   int sntable_readprep_vardef1(char *VARNAME_withCast, void *ptr, 
 			       int mxlen, int vboseflag, char *varName_noCast);
   int SNTABLE_READ_EXEC(void);
+  int SNTABLE_READ_ROW(int IROW);
+  void SNTABLE_CLOSE_TEXT(void) ;
+  void set_NROW_FLUSH_TEXT(int IDTABLE, int NROW_FLUSH);
 
   int  IVAR_READTABLE_POINTER(char *varName) ;
   void load_READTABLE_POINTER(int IROW, int IVAR, double DVAL, char *CVAL) ;
+  void load_READTABLE_ROW(int IROW, long double *DVAL_LIST, char **CVAL_LIST);
+  int  SNTABLE_READPREP_COLUMN(char *VARLIST, int ICAST, int mxlen, 
+			       int optMask);
+  double *SNTABLE_COLUMN_D(int IVAR);
+  float  *SNTABLE_COLUMN_F(int IVAR);
+  char  **SNTABLE_COLUMN_C(int IVAR);
+  char   *intern_READTABLE_STRING(char *STRING);
   void load_DUMPLINE(int OPT, char *LINE, double DVAL) ;
   void load_DUMPLINE_STR(char *LINE, char *STRING) ;
 
@@ -511,6 +543,16 @@ extern"C" {
   void fetch_autostore_ccid__(int *ifile, int *isn, char *ccid);
 
   void   SNTABLE_AUTOSTORE_malloc(int OPT, int IFILE, int IVAR);
+  void   SNTABLE_AUTOSTORE_hash(int OPT, int IFILE);
+
+  // Oct 2026: resolve varName once, then read per CCID with hash lookup
+  int  IROW_AUTOSTORE(int IFILE, char *CCID);
+  int  HANDLE_VARNAME_AUTOSTORE(char *varName);
+  int  handle_varname_autostore__(char *varName);
+  void SNTABLE_AUTOSTORE_READ_HANDLE(char *CCID, int HANDLE, int *ISTAT,
+				     double *DVAL, char *CVAL);
+  void sntable_autostore_read_handle__(char *CCID, int *HANDLE, int *ISTAT,
+				       double *DVAL, char *CVAL);
   
 
   int IVAR_VARNAME_AUTOSTORE(char *varName, int *ICAST);
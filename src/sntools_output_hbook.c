@@ -910,6 +910,7 @@ void sntable_pushRowOut_hbook(int IROW, int OPT_READ, int IFIT) {
   //  IFIT       : vector index (pass 0 for scaler)
 
   // Feb 24 2019:  check SEPKEY
+  // Oct 2026: fill read-arrays with one load_READTABLE_ROW call per row
 
   //  char fnam[] =  "sntable_pushRowOut_hbook" ;
 
@@ -922,6 +923,8 @@ void sntable_pushRowOut_hbook(int IROW, int OPT_READ, int IFIT) {
   double VAL_D ;
   float  VAL_F ;
   char  *ptrC  ;
+  long double DROW[MXVAR_TABLE];  // per-row values for load_READTABLE_ROW
+  char       *CROW[MXVAR_TABLE];
 
   char   *SEPKEY = READTABLE_POINTERS.SEPKEY_DUMP ;
   char   LINE[MXCHAR_VARLIST], *VARNAME, band[2] ;
@@ -942,6 +945,7 @@ void sntable_pushRowOut_hbook(int IROW, int OPT_READ, int IFIT) {
     VARNAME    = READTABLE_POINTERS.VARNAME[IVAR_TOT] ;
     ICAST_READ = HBOOK_CWNT_READROW.ICAST[IVAR_DUMP] ;
     VAL_D      = -9999. ;
+    DROW[IVAR_TOT] = VAL_D ;  CROW[IVAR_TOT] = BLANK ;
 
     OPT=0;  if ( ISTABLEVAR_IFILT(VARNAME) ) { OPT=1; }
 
@@ -951,7 +955,7 @@ void sntable_pushRowOut_hbook(int IROW, int OPT_READ, int IFIT) {
       VAL_D   = (double)VAL_I ; 
 
       if ( LDUMP )  { load_DUMPLINE(OPT, LINE, VAL_D); }
-      if ( LREAD )  { load_READTABLE_POINTER(IROW,IVAR_TOT,VAL_D,BLANK); }
+      if ( LREAD )  { DROW[IVAR_TOT] = VAL_D;  CROW[IVAR_TOT] = BLANK; }
     }
     
     else if ( ICAST_READ == ICAST_F )  { 
@@ -959,14 +963,14 @@ void sntable_pushRowOut_hbook(int IROW, int OPT_READ, int IFIT) {
       VAL_F = HBOOK_CWNT_READROW.VAL_F[ivarcast][IFIT]  ;
       VAL_D = (double)VAL_F ;   
       if ( LDUMP )  { load_DUMPLINE(OPT,LINE, VAL_D); }
-      if ( LREAD )  { load_READTABLE_POINTER(IROW,IVAR_TOT,VAL_D,BLANK); }
+      if ( LREAD )  { DROW[IVAR_TOT] = VAL_D;  CROW[IVAR_TOT] = BLANK; }
     }
     
     else if ( ICAST_READ == ICAST_D )  { 
       ivarcast = HBOOK_CWNT_READROW.IVARCAST_MAP[IVAR_DUMP][ICAST_D];
       VAL_D = HBOOK_CWNT_READROW.VAL_D[ivarcast][IFIT] ;
       if ( LDUMP )  { load_DUMPLINE(OPT, LINE, VAL_D); }
-      if ( LREAD )  { load_READTABLE_POINTER(IROW,IVAR_TOT,VAL_D,BLANK); }
+      if ( LREAD )  { DROW[IVAR_TOT] = VAL_D;  CROW[IVAR_TOT] = BLANK; }
     }
     
     else if ( ICAST_READ == ICAST_C ) {
@@ -974,7 +978,7 @@ void sntable_pushRowOut_hbook(int IROW, int OPT_READ, int IFIT) {
       ptrC   =  HBOOK_CWNT_READROW.VAL_C[ivarcast][IFIT]; 
       trim_blank_spaces(ptrC);  
       load_DUMPLINE_STR(LINE,ptrC);
-      if ( LREAD )  { load_READTABLE_POINTER(IROW,IVAR_TOT,VAL_D,ptrC); }
+      if ( LREAD )  { DROW[IVAR_TOT] = VAL_D;  CROW[IVAR_TOT] = ptrC; }
     }
 
     /*
@@ -991,6 +995,7 @@ void sntable_pushRowOut_hbook(int IROW, int OPT_READ, int IFIT) {
 
   } // end of IVAR
 
+  if ( LREAD ) { load_READTABLE_ROW(IROW, DROW, CROW); }
 
   // ------------------------------------------
   // update ascii file for dump option
@@ -711,6 +711,8 @@ int sntable_read_exec_root(int IROW_MIN, int IROW_MAX) {
   char   LINE[MXCHAR_VARLIST] ;
   char   valStore[MXVAR_TABLE][40];
   double DVAL, DARRAY[MXVAR_TABLE] ;
+  long double DROW[MXVAR_TABLE];  // per-row values for load_READTABLE_ROW
+  char       *CROW[MXVAR_TABLE];
 
   long long int IROW_START = IROW_MIN;
   long long int NROW_READ  = IROW_MAX - IROW_MIN + 1;
@@ -763,7 +765,8 @@ int sntable_read_exec_root(int IROW_MIN, int IROW_MAX) {
       DARRAY[i] = DVAL ;
 
       if( LREAD )   { 
-	load_READTABLE_POINTER(irow+IROW_MIN, i, DVAL, tmpString); 
+	DROW[IVAR_TOT] = (long double)DVAL ;
+	CROW[IVAR_TOT] = valStore[i] ;
       }
       else if ( LDUMP )  {
 	if ( ICAST == ICAST_C ) 
@@ -776,6 +779,9 @@ int sntable_read_exec_root(int IROW_MIN, int IROW_MAX) {
 
     } // end of i loop over Nfield
 
+    // Oct 2026: fill all read-variables for this row at once
+    if ( LREAD ) { load_READTABLE_ROW(irow+IROW_MIN, DROW, CROW); }
+
 
     DO_DUMP = 0;
     if ( LDUMP    ) { DO_DUMP = 1; }
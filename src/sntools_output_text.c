@@ -24,6 +24,11 @@
 // Jan 4 2021: MXCHAR_LINE -> 3200 (was 2500)
 // Sep 07 2021: abort if found too few variables (SNTABLE_READ_EXEC_TEXT)
 // Jan 07 2025: MXCHAR_LINE -> 4000 (was 3200)
+// Oct 2026: 
+//   + split row-read out of SNTABLE_READ_EXEC_TEXT into 
+//     SNTABLE_READ_ROW_TEXT so that a table can be streamed row by row.
+//   + optional NROW_FLUSH per output table (set_NROW_FLUSH_TEXT)
+//     to replace fflush after every row with buffered writes.
 // **********************************************
 
 char FILEPREFIX_TEXT[100];
@@ -50,6 +55,7 @@ char FILEPREFIX_TEXT[100];
 #define MSKOPT_PARSE_WORDS_IGNORECOMMA 4 
 
 FILE *PTRFILE_TEXT ;                   // generic ascii file pointer
+int  NROW_READ_TEXT ;                  // rows read since READPREP (Oct 2026)
 char FILENAME_TEXT[MXCHAR_FILENAME];   // name of opened text file
 int  GZIPFLAG_TEXT;                    // gzipped or not
 
@@ -79,6 +85,7 @@ struct TABLEINFO_TEXT {
   char **VARNAME[MXTABLE_TEXT];
 
   int    NFILL[MXTABLE_TEXT] ; // number of SNTABLE_FILL_TEXT calls.
+  int    NROW_FLUSH[MXTABLE_TEXT] ; // fflush every NROW_FLUSH rows (Oct 2026)
 
   int        *ICAST[MXTABLE_TEXT] ;
   double    **ptr_D[MXTABLE_TEXT] ;
@@ -134,6 +141,7 @@ extern"C" {
   int  get_OPT_FORMAT(char *FORMAT, char *comment) ;
 
   void set_FILENAME_OVERRIDE_TEXT(int IDTABLE, char *fileName);
+  void set_NROW_FLUSH_TEXT(int IDTABLE, int NROW_FLUSH);
   void set_filename_override_text__(int *IDTABLE, char *fileName);
 
   int  SNTABLE_NEVT_TEXT(char *FILENAME);
@@ -142,6 +150,7 @@ extern"C" {
 
   int  SNTABLE_READPREP_TEXT(void);
   int  SNTABLE_READ_EXEC_TEXT(void);
+  int  SNTABLE_READ_ROW_TEXT(int IROW);
   void SNTABLE_CLOSE_TEXT(void) ;
 
   int validRowKey_TEXT(char *string) ;
@@ -248,6 +257,7 @@ void SNTABLE_CREATE_TEXT(int IDTABLE, char *TBNAME, char *TEXT_FORMAT) {
   // store other info
   TABLEINFO_TEXT.IDTABLE[NTAB] = IDTABLE ;
   TABLEINFO_TEXT.NFILL[NTAB]   = 0 ;
+  TABLEINFO_TEXT.NROW_FLUSH[NTAB] = 1 ; // default: flush each row
   sprintf(TABLEINFO_TEXT.TBNAME[NTAB],   "%s", TBNAME);
   sprintf(TABLEINFO_TEXT.FILENAME[NTAB], "%s", FILENAME);
   sprintf(TABLEINFO_TEXT.FORMAT[NTAB],   "%s", TEXT_FORMAT);  
@@ -584,13 +594,44 @@ void SNTABLE_FILL_TEXT(int IDTABLE) {
     fprintf(FP, "%s\n", ROW);
   }
 
-  fflush(FP);
+  // Oct 2026: optional buffered write
+  if ( (NFILL+1) % TABLEINFO_TEXT.NROW_FLUSH[ITAB] == 0 ) { fflush(FP); }
 
   // increment number of FILL calls
   TABLEINFO_TEXT.NFILL[ITAB]++ ;
 
 } // end of SNTABLE_FILL_TEXT
 
+
+// ==================================================
+void set_NROW_FLUSH_TEXT(int IDTABLE, int NROW_FLUSH) {
+
+  // Created Oct 2026
+  // Flush output table every NROW_FLUSH rows instead of every row,
+  // and give the file a large buffer. Must be called before the
+  // first SNTABLE_FILL. Remaining rows are flushed on close.
+
+  int  ITAB, MEMBUF = 4*1024*1024 ;
+  char fnam[] = "set_NROW_FLUSH_TEXT" ;
+
+  // ------------- BEGIN ------------
+
+  ITAB = ITABLE_TEXT(IDTABLE,fnam,1); // abort if no table.
+  if ( TABLEINFO_TEXT.OPT_FORMAT[ITAB] == OPT_FORMAT_NONE ) { return ; }
+
+  if ( TABLEINFO_TEXT.NFILL[ITAB] > 0 || NROW_FLUSH < 1 ) {
+    sprintf(MSGERR1, "Invalid NROW_FLUSH=%d for IDTABLE=%d (NFILL=%d)", 
+	    NROW_FLUSH, IDTABLE, TABLEINFO_TEXT.NFILL[ITAB] );
+    sprintf(MSGERR2, "NROW_FLUSH must be >0 and set before first fill.");
+    errmsg(SEV_FATAL, 0, fnam, MSGERR1, MSGERR2);    
+  }
+
+  TABLEINFO_TEXT.NROW_FLUSH[ITAB] = NROW_FLUSH ;
+  if ( NROW_FLUSH > 1 ) 
+    { setvbuf(TABLEINFO_TEXT.FP[ITAB], NULL, _IOFBF, MEMBUF); }
+
+} // end set_NROW_FLUSH_TEXT
+
 // ===============================================================
 int get_OPT_FORMAT(char *FORMAT, char *comment) {
 
@@ -1098,6 +1139,7 @@ int  SNTABLE_READPREP_TEXT(void) {
   // ---------- BEGIN -------------
 
   FP    = PTRFILE_TEXT ;
+  NROW_READ_TEXT = 0 ;
   sprintf(ctmp,"BLANK"); 
   ISTAT = 999;
   NVAR = FOUNDKEY = NRD = 0 ;
@@ -1178,25 +1220,54 @@ int SNTABLE_READ_EXEC_TEXT(void) {
   // Jun  29 2021; check GZIPFLAG_TEXT for using pclose or fclose
   // Sep  07 2021: abort if ivar < NVAR_TOT 
   //    (e.g., if split jobs with different NVAR are merged)
+  // Oct 2026: 
+  //   + row read moved to SNTABLE_READ_ROW_TEXT.
+  //   + scan only the stored cast; store interned strings
+  //     for columns from SNTABLE_READPREP_COLUMN.
   //
 
   int NROW = 0 ;
-  int i, iwd, ivar, isn, ICAST, nptr, NWD_LINE ;
 
-  char ctmp[MXCHAR_FILENAME], LINE[MXCHAR_LINE], *ptrtok, cvar[300];
-  char KEYNAME_ID[40];
-  long double DVAR[MXVAR_TABLE];
-  char        CVAR[MXVAR_TABLE][60];
+  // ------------ BEGIN -----------    
+
+  while ( SNTABLE_READ_ROW_TEXT(NROW) ) { NROW++ ; }
+
+  SNTABLE_CLOSE_TEXT();
+
+  return(NROW) ;
+
+} // end of SNTABLE_READ_EXEC_TEXT
+
+
+// ==============================================
+int SNTABLE_READ_ROW_TEXT(int IROW) {
+
+  // Created Oct 2026
+  // Read next valid row from PTRFILE_TEXT and store values in 
+  // element IROW of pointers passed to SNTABLE_READPREP_VARDEF.
+  // Returns 1 if a row was read, 0 at end of file.
+  // Enables streaming a table with mxlen=1 and IROW=0.
+  // Code moved from SNTABLE_READ_EXEC_TEXT.
+  // Values are stored with one load_READTABLE_ROW call per row.
+
+  int ivar ;
+
+  char ctmp[MXCHAR_FILENAME], LINE[MXCHAR_LINE], *ptrtok;
+  char *KEYNAME_ID = READTABLE_POINTERS.VARNAME[0] ; // e.g., CID, GALID
+  // static so that unparsed values carry over from previous row,
+  // as before the row-read was split out of SNTABLE_READ_EXEC_TEXT.
+  static long double DVAR[MXVAR_TABLE];
+  static char        CVAR[MXVAR_TABLE][60];
+  static char       *CPTR[MXVAR_TABLE];  // CPTR[ivar] -> CVAR[ivar]
   
   int  NVAR_TOT  = READTABLE_POINTERS.NVAR_TOT ;  // all variables
-  int  NVAR_READ = READTABLE_POINTERS.NVAR_READ ; // subset to read
   FILE *FP       = PTRFILE_TEXT ; 
-  char fnam[]    = "SNTABLE_READ_EXEC_TEXT" ;
+  char fnam[]    = "SNTABLE_READ_ROW_TEXT" ;
 
   // ------------ BEGIN -----------    
 
-  // get key name of ID varname such as CID, GALID, etc.
-  sprintf(KEYNAME_ID,"%s", READTABLE_POINTERS.VARNAME[0] ); 
+  if ( CPTR[0] == NULL ) 
+    { for(ivar=0; ivar < MXVAR_TABLE; ivar++ ) { CPTR[ivar] = CVAR[ivar]; } }
 
   while ( fgets(LINE, MXCHAR_LINE, FP ) != NULL ) {
 
@@ -1209,15 +1280,17 @@ int SNTABLE_READ_EXEC_TEXT(void) {
 
     // if we get here, we have a valid ROW key so read rest of row.
 
-    NROW++ ;   
+    NROW_READ_TEXT++ ;   
 
     ptrtok = strtok(NULL," " ); ivar=0 ;
     while ( ptrtok != NULL && ivar < NVAR_TOT) { 
       // Dec 20 2017: extract only variables on READ-list
+      // Oct 2026: parse only the cast that is stored
       if ( READTABLE_POINTERS.NPTR[ivar] > 0 ) {      
-	sprintf(cvar,"%s",   ptrtok );      
-	sscanf(cvar, "%Lf",  &DVAR[ivar] );
-	sscanf(cvar, "%s",   CVAR[ivar] );
+	if ( ivar == 0 || READTABLE_POINTERS.ICAST_STORE[ivar] == ICAST_C )
+	  { sscanf(ptrtok, "%s",   CVAR[ivar] ); }
+	if ( READTABLE_POINTERS.ICAST_STORE[ivar] != ICAST_C )
+	  { sscanf(ptrtok, "%Lf",  &DVAR[ivar] ); }
       }
       ptrtok = strtok(NULL," " );
       ivar++ ;
@@ -1225,87 +1298,36 @@ int SNTABLE_READ_EXEC_TEXT(void) {
 
     // - - - - -
 
-    if ( NROW>1 && ivar < NVAR_TOT ) {
+    if ( NROW_READ_TEXT>1 && ivar < NVAR_TOT ) {
       sprintf(MSGERR1,"Exepcted %d values, but found %d", NVAR_TOT, ivar);
       sprintf(MSGERR2,"Check CID = %s", CVAR[0]);
       errmsg(SEV_FATAL, 0, fnam, MSGERR1, MSGERR2 );
     }
 
-    if ( fmodf( (float)(NROW), 100000. ) == 0 && NROW > 0 )  { 
+    if ( (NROW_READ_TEXT % 100000) == 0 )  { 
       printf("\t Reading table row %d  (%s=%s) \n", 
-	     NROW, KEYNAME_ID, CVAR[0] );  fflush(stdout);
+	     NROW_READ_TEXT, KEYNAME_ID, CVAR[0] );  fflush(stdout);
     }
 
+    // bulk fill of user arrays and table-owned columns
+    load_READTABLE_ROW(IROW, DVAR, CPTR);
 
-    // set user arrays via pointer
-    for ( i = 0; i < NVAR_READ; i++ ) {
-      
-      ivar  = READTABLE_POINTERS.PTRINDEX[i] ; // starts at 1
-      ICAST = READTABLE_POINTERS.ICAST_STORE[ivar] ;     
-      
-	if ( ivar < 0 || ivar >= MXVAR_TABLE ) {
-	  sprintf(MSGERR1,"Invalid PTRINDEX[%d] = %d", i, ivar );
-	  sprintf(MSGERR2,"PTRINDEX must be %d to %d", 0, MXVAR_TABLE-1 );
-	  errmsg(SEV_FATAL, 0, fnam, MSGERR1, MSGERR2 );
-	}
-    
-	isn = NROW - 1;  // isn is a C-like index
-
-	for(nptr=0; nptr<READTABLE_POINTERS.NPTR[ivar]; nptr++ ) {
-
-	  if ( ICAST == ICAST_D )  { 
-	    READTABLE_POINTERS.PTRVAL_D[nptr][ivar][isn] = 
-	      (double)DVAR[ivar] ; 
-	  }	  
-	  else if ( ICAST == ICAST_F )  { 
-	    READTABLE_POINTERS.PTRVAL_F[nptr][ivar][isn] = 
-	      (float)DVAR[ivar] ; 
-	  }	  
-	  else if ( ICAST == ICAST_I )  { 
-	    READTABLE_POINTERS.PTRVAL_I[nptr][ivar][isn] = 
-	      (int)DVAR[ivar] ; 
-	  }	  
-	  else if ( ICAST == ICAST_S )  { 
-	    READTABLE_POINTERS.PTRVAL_S[nptr][ivar][isn] = 
-	      (short int)DVAR[ivar] ; 
-	  }	  
-	  else if ( ICAST == ICAST_L )  { 
-	    READTABLE_POINTERS.PTRVAL_L[nptr][ivar][isn] = 
-	      (long long int)DVAR[ivar] ; 
-	  }	  
-	  else if ( ICAST == ICAST_C )  { 
-	    sprintf(READTABLE_POINTERS.PTRVAL_C[nptr][ivar][isn],"%s",
-		    CVAR[ivar]); 
-	  }	  
-	  else {
-	    sprintf(MSGERR1,"Unknown ICAST=%d  var[%d]=%s  nptr=%d", 
-		    ICAST, ivar, READTABLE_POINTERS.VARNAME[ivar], nptr );
-	    sprintf(MSGERR2,"See ICAST_  parameters in sntools_output.h");
-	    errmsg(SEV_FATAL, 0, fnam, MSGERR1, MSGERR2 );
-	  }
-	} // end nptr loop
-	
-      } // end of i loop      
-
-  } // end fscanf 
-  
+    return 1 ;
 
-  if ( GZIPFLAG_TEXT ) { pclose(FP); } else { fclose(FP); }
+  } // end fgets
 
-  // May 2 2019: reset flags to allow opening another file.
-  NAME_TABLEFILE[OPENFLAG_READ][IFILETYPE_TEXT][0] = 0 ;
-  USE_TABLEFILE[OPENFLAG_READ][IFILETYPE_TEXT]     = 0;
-
-  return(NROW) ;
+  return 0 ;
 
-} // end of SNTABLE_READ_EXEC_TEXT
+} // end of SNTABLE_READ_ROW_TEXT
 
 void SNTABLE_CLOSE_TEXT(void) {
   // May 2020
   // can call this function after SNTABLE_NEVT
   // so that there is no need to read entire file.
 
-  fclose(PTRFILE_TEXT); // Feb 13 2021
+  // Oct 2026: pclose for gzip (moved from SNTABLE_READ_EXEC_TEXT)
+  if ( GZIPFLAG_TEXT ) { pclose(PTRFILE_TEXT); } 
+  else                 { fclose(PTRFILE_TEXT); } // Feb 13 2021
   NAME_TABLEFILE[OPENFLAG_READ][IFILETYPE_TEXT][0] = 0 ;
   USE_TABLEFILE[OPENFLAG_READ][IFILETYPE_TEXT]     = 0;
 } 
@@ -42,6 +42,11 @@
       of ZP vs. Texpose. Works much better with sparse Texpose grid.
       [issue found by comparing SNR against D.Rubin]
 
+  Oct 2026:
+    + new getSNR_spectrograph_array returns SNR for a list of lambda
+      bins; TEXPOSE bin-search and interp weights are computed once
+      per spectrum instead of four bin-searches per lambda bin.
+
 *********************************************************/
 
 #include "fitsio.h"
@@ -1622,6 +1627,167 @@ double getSNR_spectrograph(int ILAM, double TEXPOSE_S, double TEXPOSE_T,
 } // end getSNR_spectrograph
 
 
+// ====================================================
+void getSNR_spectrograph_array(int NLAM, int *ILAM_LIST, 
+			       double TEXPOSE_S, double TEXPOSE_T,
+			       bool ALLOW_TEXTRAP, double *GENMAG_LIST,
+			       double *SNR_LIST, double *ERRFRAC_T_LIST) {
+
+  // Created Oct 2026
+  // Same as getSNR_spectrograph, but for NLAM lambda bins in ILAM_LIST
+  // with common exposure times. GENMAG_LIST, SNR_LIST and ERRFRAC_T_LIST
+  // are indexed 0 to NLAM-1 (not by ILAM). Interp weights vs. TEXPOSE
+  // are computed once, and the interp arithmetic matches interp_1DFUN
+  // so that results are identical to getSNR_spectrograph.
+
+  int    NBT = INPUTS_SPECTRO.NBIN_TEXPOSE ;
+  TEXPOSE_INTERP_SPECTROGRAPH_DEF INTERP ;
+  int    i, ILAM, IB ;
+  double *ZP, *SQSIGSKY, ZP_S, ZP_T, SQ_S, SQ_T, SQ_SUM ;
+  double Flux, FluxErr, SNR, SCALE_TEXTRAP = 1.0 ;
+
+  // ----------- BEGIN ------------
+
+  if ( NBT < 2 ) {
+    // interp_1DFUN has special logic for 1 bin; use scalar function
+    for(i=0; i < NLAM; i++ ) {
+      SNR_LIST[i] = 
+	getSNR_spectrograph(ILAM_LIST[i], TEXPOSE_S, TEXPOSE_T, ALLOW_TEXTRAP,
+			    GENMAG_LIST[i], &ERRFRAC_T_LIST[i] ) ;
+    }
+    return ;
+  }
+
+  set_TEXPOSE_INTERP_spectrograph(TEXPOSE_S, TEXPOSE_T, ALLOW_TEXTRAP,
+				  &INTERP);
+  if ( INTERP.DO_TEXTRAP ) 
+    { SCALE_TEXTRAP = sqrt(TEXPOSE_S / INTERP.TEXPOSE_S_LOCAL); }
+
+  for(i=0; i < NLAM; i++ ) {
+
+    ILAM      = ILAM_LIST[i];
+    ZP        = INPUTS_SPECTRO.ZP[ILAM] ;
+    SQSIGSKY  = INPUTS_SPECTRO.SQSIGSKY[ILAM] ;
+    SNR_LIST[i] = ERRFRAC_T_LIST[i] = 0.0 ;
+
+    if ( ZP[0] < 0.0 ) { continue; } // undefined ZP -> SNR=0
+
+    IB   = INTERP.IBIN_ZP_S ;
+    ZP_S = ZP[IB] + INTERP.FRAC_ZP_S * (ZP[IB+1] - ZP[IB]) ;
+    IB   = INTERP.IBIN_SQ_S ;
+    SQ_S = SQSIGSKY[IB] + INTERP.FRAC_SQ_S * (SQSIGSKY[IB+1]-SQSIGSKY[IB]);
+
+    ZP_T = SQ_T = 0.0 ;
+    if ( INTERP.USE_T ) {
+      IB   = INTERP.IBIN_ZP_T ;
+      ZP_T = ZP[IB] + INTERP.FRAC_ZP_T * (ZP[IB+1] - ZP[IB]) ;
+      IB   = INTERP.IBIN_SQ_T ;
+      SQ_T = SQSIGSKY[IB] + INTERP.FRAC_SQ_T*(SQSIGSKY[IB+1]-SQSIGSKY[IB]);
+      SQ_T *= pow( TEN, 0.8*(ZP_S-ZP_T) ) ;
+    }
+
+    Flux   = pow(TEN, -0.4*(GENMAG_LIST[i]-ZP_S) );
+    SQ_SUM = (SQ_S + SQ_T + Flux);
+    SNR    = 0.0 ;
+    if ( SQ_SUM >= 0.0 ) 
+      {  FluxErr = sqrt(SQ_SUM);  SNR = Flux/FluxErr ;  }
+    else
+      { FluxErr = -9.0 ; }
+
+    SNR *= SCALE_TEXTRAP ;
+
+    if ( isnan(SNR) ) {
+      // repeat with scalar function to get dump and abort
+      SNR = getSNR_spectrograph(ILAM, TEXPOSE_S, TEXPOSE_T, ALLOW_TEXTRAP,
+				GENMAG_LIST[i], &ERRFRAC_T_LIST[i]);
+    }
+
+    SNR_LIST[i] = SNR ;
+    if ( SQ_T >= 0.0 )  { ERRFRAC_T_LIST[i] = sqrt(SQ_T)/FluxErr ; } 
+
+  } // end i loop over lambda bins
+
+  return ;
+
+} // end getSNR_spectrograph_array
+
+
+// ====================================================
+void set_TEXPOSE_INTERP_spectrograph(double TEXPOSE_S, double TEXPOSE_T,
+				     bool ALLOW_TEXTRAP,
+				     TEXPOSE_INTERP_SPECTROGRAPH_DEF *INTERP) {
+
+  // Created Oct 2026
+  // Compute TEXPOSE bins and interp weights for search (S) and
+  // template (T) exposure; ZP is interpolated vs. log10(TEXPOSE)
+  // and SQSIGSKY vs. TEXPOSE as in getSNR_spectrograph.
+
+  int    NBT   = INPUTS_SPECTRO.NBIN_TEXPOSE ;
+  double Tmin  = INPUTS_SPECTRO.TEXPOSE_LIST[0] ;
+  double Tmax  = INPUTS_SPECTRO.TEXPOSE_LIST[NBT-1] ;
+  double TEXPOSE_S_LOCAL = TEXPOSE_S ;
+  char fnam[] = "set_TEXPOSE_INTERP_spectrograph" ;
+
+  // ----------- BEGIN ------------
+
+  INTERP->DO_TEXTRAP = false ;
+  if ( ALLOW_TEXTRAP ) {
+    if ( TEXPOSE_S < Tmin ) 
+      { TEXPOSE_S_LOCAL = Tmin + 0.00001 ; INTERP->DO_TEXTRAP = true; }
+    if ( TEXPOSE_S > Tmax ) 
+      { TEXPOSE_S_LOCAL = Tmax - 0.00001 ; INTERP->DO_TEXTRAP = true; }
+  }
+  else if ( TEXPOSE_S < Tmin  || TEXPOSE_S > Tmax ) {
+    sprintf(c1err,"Invalid TEXPOSE_S = %f", TEXPOSE_S );
+    sprintf(c2err,"Valid TEXPOSE_S range: %.2f to %.2f \n", Tmin, Tmax);
+    errmsg(SEV_FATAL, 0, fnam, c1err, c2err); 
+  }
+
+  INTERP->TEXPOSE_S       = TEXPOSE_S ;
+  INTERP->TEXPOSE_S_LOCAL = TEXPOSE_S_LOCAL ;
+  INTERP->TEXPOSE_T       = TEXPOSE_T ;
+  INTERP->USE_T           = ( TEXPOSE_T > 0.01 );
+
+  set_TEXPOSE_INTERP_BIN(log10(TEXPOSE_S_LOCAL), 
+			 INPUTS_SPECTRO.LOGTEXPOSE_LIST, "ZP_S",
+			 &INTERP->IBIN_ZP_S, &INTERP->FRAC_ZP_S );
+  set_TEXPOSE_INTERP_BIN(TEXPOSE_S_LOCAL, 
+			 INPUTS_SPECTRO.TEXPOSE_LIST, "SQ_S",
+			 &INTERP->IBIN_SQ_S, &INTERP->FRAC_SQ_S );
+
+  if ( INTERP->USE_T ) {
+    set_TEXPOSE_INTERP_BIN(log10(TEXPOSE_T), 
+			   INPUTS_SPECTRO.LOGTEXPOSE_LIST, "ZP_T",
+			   &INTERP->IBIN_ZP_T, &INTERP->FRAC_ZP_T );
+    set_TEXPOSE_INTERP_BIN(TEXPOSE_T, 
+			   INPUTS_SPECTRO.TEXPOSE_LIST, "SQ_T",
+			   &INTERP->IBIN_SQ_T, &INTERP->FRAC_SQ_T );
+  }
+
+  return ;
+
+} // end set_TEXPOSE_INTERP_spectrograph
+
+void set_TEXPOSE_INTERP_BIN(double VAL, double *VAL_LIST, char *comment,
+			    int *IBIN, double *FRAC) {
+  // Created Oct 2026
+  // Return TEXPOSE bin and linear-interp fraction, same as interp_1DFUN.
+  int  NBT = INPUTS_SPECTRO.NBIN_TEXPOSE ;
+  int  IB ;
+  char abort_comment[80];
+  char fnam[] = "set_TEXPOSE_INTERP_BIN" ;
+  sprintf(abort_comment, "getSNR_spectrograph(%s)", comment);
+  IB    = quickBinSearch(VAL, NBT, VAL_LIST, abort_comment);
+  if ( IB < 0 || IB >= NBT-1 ) {
+    sprintf(c1err,"quickBinSearch returned invalid IBIN=%d (NBT=%d)", IB,NBT);
+    sprintf(c2err,"Check '%s'", abort_comment);
+    errmsg(SEV_FATAL, 0, fnam, c1err, c2err ); 
+  }
+  *IBIN = IB ;
+  *FRAC = (VAL - VAL_LIST[IB]) / (VAL_LIST[IB+1] - VAL_LIST[IB]) ;
+} // end set_TEXPOSE_INTERP_BIN
+
+
 int IMJD_GENSPEC(double MJD) {
   // Created July 2023
   // return IMJD index such that MJD_LIST[IMJD] = MJD       
@@ -69,6 +69,15 @@ struct {
 #define MXVALUES_SPECBIN  10+2*MXTEXPOSE_SPECTROGRAPH
 double  VALUES_SPECBIN[MXVALUES_SPECBIN];
 
+// Oct 2026: TEXPOSE-interpolation bins and weights; same for every
+// lambda bin, so compute once per spectrum.
+typedef struct {
+  double TEXPOSE_S, TEXPOSE_S_LOCAL, TEXPOSE_T ;
+  bool   DO_TEXTRAP, USE_T ;
+  int    IBIN_ZP_S, IBIN_SQ_S, IBIN_ZP_T, IBIN_SQ_T ; // TEXPOSE bin
+  double FRAC_ZP_S, FRAC_SQ_S, FRAC_ZP_T, FRAC_SQ_T ; // frac within bin
+} TEXPOSE_INTERP_SPECTROGRAPH_DEF ;
+
 
 // ------ GENERATED SPECTRA ------                                                        
 struct {
@@ -171,6 +180,16 @@ void get_FILTERtrans_spectrograph(double *LMIN, double *LMAX, int MXLAM,
 double getSNR_spectrograph(int ilam, double Texpose_S, double Texpose_T, 
 			   bool ALLOW_TEXTRAP,double genMag,double *ERRFRAC_T);
 
+void getSNR_spectrograph_array(int NLAM, int *ILAM_LIST, 
+			       double Texpose_S, double Texpose_T, 
+			       bool ALLOW_TEXTRAP, double *genMag_LIST,
+			       double *SNR_LIST, double *ERRFRAC_T_LIST);
+void set_TEXPOSE_INTERP_spectrograph(double Texpose_S, double Texpose_T,
+				     bool ALLOW_TEXTRAP,
+				     TEXPOSE_INTERP_SPECTROGRAPH_DEF *INTERP);
+void set_TEXPOSE_INTERP_BIN(double VAL, double *VAL_LIST, char *comment,
+			    int *IBIN, double *FRAC);
+
 void check_SNR_SPECTROGRAPH(int l, int t);
 
 int  IMJD_GENSPEC(double MJD); // return IMJD index such that MJD_LIST[IMJD] = MJD
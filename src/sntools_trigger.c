@@ -51,6 +51,13 @@
  Aug 09 2024: add logic to read and apply optional REQUIRE key in SPECEFF map.
  Aug 19 2024: replace c_get[60] with c_get[100] in a few places
 
+ Oct 2026: 
+   + batched pipeline efficiency (GETEFF_PIPELINE_DETECT_BATCH) with
+     per-event cache of DETECT and PHOTPROB map index vs. filter.
+   + batched PHOTPROB (get_PIPELINE_PHOTPROB_BATCH) gathers map
+     variables for all PHOTPROB epochs before interpolation.
+   + trigger logic is re-evaluated only when the filter mask changes.
+
 ************************************/
 
 #include "sntools.h"
@@ -1836,10 +1843,17 @@ int gen_SEARCHEFF_PIPELINE(int ID, MJD_DETECT_DEF *MJD_DETECT) {
   //
   // Oct 18 2021: load MJD_DETECT-FIRST[LAST]
   //
+  // Oct 2026: 
+  //  + compute pipeline EFF for all epochs in one batched call,
+  //    with map lookup done once per filter.
+  //  + evaluate SEARCHEFF_LOGIC only when IFILTOBS_MASK changes;
+  //    once trigger is found, only detection info is tracked.
+  //
 
   int NMJD_DETECT, NDETECT, imask, NOBS, MARK, DETECT_MARK, IMAP ;
   int IFILTOBS, obs, OVP, obsLast, istore, LFIND, FIRST=0;
   int IFILTOBS_MASK, IFILTDEF_MASK, NEXT_DETECT, DETECT_FLAG ;
+  int IFILTOBS_MASK_LAST = -1 ;
   int FOUND_TRIGGER=0,  FOUND_DETECT_FIRST=0, LCUT_PHOTPROB ;
   int OBSMARKER_DETECT[MXOBS_TRIGGER];
   double  RAN, EFF, MJD, MJD_LAST, MJD_DIF, TDIF_NEXT, SNR,MAG;
@@ -1893,6 +1907,10 @@ int gen_SEARCHEFF_PIPELINE(int ID, MJD_DETECT_DEF *MJD_DETECT) {
   NDETECT = IFILTOBS_MASK = LFIND = DETECT_MARK = 0 ;
   OBS_PHOTPROB.NSTORE = 0 ;
 
+  // evaluate pipeline efficiency for all epochs
+  reset_SEARCHEFF_BATCH();
+  GETEFF_PIPELINE_DETECT_BATCH(NOBS, SEARCHEFF_BATCH.EFF_PIPELINE);
+
   // loop over each epoch and determine if there is a detection,
   // and also if there is a PHOTPROB measurement.
   for(obs = 0 ; obs < SEARCHEFF_DATA.NOBS; obs++ ) {
@@ -1904,7 +1922,7 @@ int gen_SEARCHEFF_PIPELINE(int ID, MJD_DETECT_DEF *MJD_DETECT) {
 
     IFILTOBS = SEARCHEFF_DATA.IFILTOBS[obs] ;
     RAN      = SEARCHEFF_RANDOMS.FLAT_PIPELINE[obs] ;
-    EFF      = GETEFF_PIPELINE_DETECT(obs); // compute effic
+    EFF      = SEARCHEFF_BATCH.EFF_PIPELINE[obs];
     DETECT_FLAG =  ( RAN < EFF ) ;
 
     // Jul 2022 check resolving nearby source 
@@ -1936,10 +1954,11 @@ int gen_SEARCHEFF_PIPELINE(int ID, MJD_DETECT_DEF *MJD_DETECT) {
   // PHOTPROB covariance can be included.
   if ( OBS_PHOTPROB.NSTORE > 0 ) {
     setRan_for_PHOTPROB();
+    get_PIPELINE_PHOTPROB_BATCH(SEARCHEFF_BATCH.PHOTPROB);
     for(istore=0; istore < OBS_PHOTPROB.NSTORE ; istore++ ) {
       obs      = OBS_PHOTPROB.OBS_LIST[istore];
       IMAP     = OBS_PHOTPROB.IMAP_LIST[istore] ;
-      PHOTPROB = get_PIPELINE_PHOTPROB(istore); 
+      PHOTPROB = SEARCHEFF_BATCH.PHOTPROB[istore]; 
       // xxx if ( (ID%3) == 0 ) { PHOTPROB=0.7; } else { PHOTPROB=0.3; }
 
       SEARCHEFF_DATA.PHOTPROB[obs] = PHOTPROB ;
@@ -1986,11 +2005,15 @@ int gen_SEARCHEFF_PIPELINE(int ID, MJD_DETECT_DEF *MJD_DETECT) {
  
     if ( !FOUND_TRIGGER  ) {
 
-      NDETECT = 0 ;  // reset number of detections 
-      for ( imask=0; imask < SEARCHEFF_LOGIC.NMASK; imask++ ) {
-	IFILTDEF_MASK = SEARCHEFF_LOGIC.IFILTDEF_MASK[imask];
-	OVP = IFILTDEF_MASK & IFILTOBS_MASK ;
-	if ( OVP == IFILTDEF_MASK ) { NDETECT++ ; }
+      // NDETECT depends only on IFILTOBS_MASK
+      if ( IFILTOBS_MASK != IFILTOBS_MASK_LAST ) {
+	NDETECT = 0 ;  // reset number of detections 
+	for ( imask=0; imask < SEARCHEFF_LOGIC.NMASK; imask++ ) {
+	  IFILTDEF_MASK = SEARCHEFF_LOGIC.IFILTDEF_MASK[imask];
+	  OVP = IFILTDEF_MASK & IFILTOBS_MASK ;
+	  if ( OVP == IFILTDEF_MASK ) { NDETECT++ ; }
+	}
+	IFILTOBS_MASK_LAST = IFILTOBS_MASK ;
       }
 
       if ( NDETECT>0 && !DETECT_MARK ) { NMJD_DETECT++;  DETECT_MARK=1; }
@@ -2070,9 +2093,10 @@ void dumpLine_PIPELINE_PHOTPROB(void) {
 
 
 // ***************************************
-double GETEFF_PIPELINE_DETECT(int obs) {
+double GETEFF_PIPELINE_DETECT(int obs, int IMAP) {
 
-  // Return pipeline/detection search efficiency for this obs.
+  // Return pipeline/detection search efficiency for this obs
+  // using PIPELINE/DETECT map IMAP (IMAP >= 0).
   // Note that obs specifies both MJD and filter.
   //
   // Jan 3 2018: never use saturated epoch for trigger (see NPE_SAT)
@@ -2082,63 +2106,28 @@ double GETEFF_PIPELINE_DETECT(int obs) {
   // Feb 15 2022: add more info for isnan abort.
   // Jun 15 2022: check opt for single-exposure detections instead of coadd
   // Nov 30 2022: check for FIELD dependence
+  // Oct 2026: map lookup, FIX_EFF and no-map logic moved to
+  //           GETEFF_PIPELINE_DETECT_BATCH; pass IMAP as argument.
 
-  int NMAP                = INPUTS_SEARCHEFF.NMAP_DETECT ;
   int APPLY_DETECT_SINGLE = INPUTS_SEARCHEFF.APPLY_DETECT_SINGLE ;
 
-  double MAG, SNR, MJD, EFF, FIX_EFF, XNEXPOSE;
+  double MAG, SNR, MJD, EFF, XNEXPOSE;
   double EFF_atmax, EFF_atmin, VAL_atmax, VAL_atmin, VAL ;
   double ZERO = 0.0, ONE  = 1.0 ;
 
-  int CID, ifilt_obs, NPE_SAT, NBIN_EFF, imap, IMAP, NMAP_FOUND=0;
+  int CID, ifilt_obs, NPE_SAT, NBIN_EFF;
   int OPT_INTERP  = 1;   // 1=linear;  2=quadratic
-  bool MATCH_FILTER, MATCH_FIELD;
 
-  char cfilt[4], *field_map, *filt_map;
+  char cfilt[4];
   char fnam[] ="GETEFF_PIPELINE_DETECT" ;
 
   // ---------- BEGIN ---------
 
-  // check debugging option with fixed effic.
-  FIX_EFF = INPUTS_SEARCHEFF.FIX_EFF_PIPELINE ;
-  if ( FIX_EFF > 0.0 ) { return FIX_EFF ; }
-
   EFF       = 0.0 ;
 
-  // find map corresponding to filter and [optional] FIELD
-  ifilt_obs = SEARCHEFF_DATA.IFILTOBS[obs] ;  IMAP=-9;
+  ifilt_obs = SEARCHEFF_DATA.IFILTOBS[obs] ;
   sprintf(cfilt,"%c", FILTERSTRING[ifilt_obs] );
 
-  for(imap=0; imap < NMAP; imap++ ) {
-    field_map     = SEARCHEFF_DETECT[imap].FIELDLIST;
-    filt_map      = SEARCHEFF_DETECT[imap].FILTERLIST ;
-    MATCH_FILTER  = ( strstr(filt_map,cfilt) != NULL );
-    if ( strlen(field_map) > 0 ) 
-      { MATCH_FIELD   = MATCH_SEARCHEFF_FIELD(field_map); }
-    else
-      { MATCH_FIELD = true; }
-
-    if ( MATCH_FILTER && MATCH_FIELD ) 	
-      {  IMAP = imap;   NMAP_FOUND++; }
-  }
-
-  // if no maps are found for this filter, there are two possibilities:
-  // 1) there are no maps at all --> return EFF=1
-  // 2) there are maps for other bands -> return EFF=0
-  if ( NMAP_FOUND == 0 ) { 
-    if ( NMAP == 0 ) { return(ONE); }  else { return(ZERO); }
-  }
-
-
-  if ( NMAP_FOUND > 1 ) {
-    sprintf(c1err,
-	    "Found %d PIPELINE/DETECT maps for ifilt_obs=%d(%s)",
-	    NMAP_FOUND, ifilt_obs, cfilt);
-    sprintf(c2err,"Check EFF maps in %s", 
-	    INPUTS_SEARCHEFF.PIPELINE_EFF_FILE );
-    errmsg(SEV_FATAL, 0, fnam, c1err, c2err) ; 
-  }
-
   CID       = SEARCHEFF_DATA.CID ;
   NBIN_EFF  = SEARCHEFF_DETECT[IMAP].NBIN;
   SNR       = SEARCHEFF_DATA.SNR_CALC[obs] ;
@@ -2224,6 +2213,169 @@ double GETEFF_PIPELINE_DETECT(int obs) {
 } // end of  GETEFF_PIPELINE_DETECT
 
 
+// *************************************
+void GETEFF_PIPELINE_DETECT_BATCH(int NOBS, double *EFF_LIST) {
+
+  // Created Oct 2026
+  // Load pipeline/detection efficiency EFF_LIST[obs] for all
+  // obs=0 to NOBS-1 of this event. The FIX_EFF option is applied
+  // once for all epochs, and the map index for each filter is
+  // resolved once (see IMAP_SEARCHEFF_DETECT) before the epoch loop.
+  // Caller must call reset_SEARCHEFF_BATCH once per event.
+
+  int    NMAP    = INPUTS_SEARCHEFF.NMAP_DETECT ;
+  double FIX_EFF = INPUTS_SEARCHEFF.FIX_EFF_PIPELINE ;
+  int    IMAP_LIST[MXFILTINDX];
+  int    obs, ifilt_obs, IMAP ;
+
+  // ----------- BEGIN ------------
+
+  // check debugging option with fixed effic.
+  if ( FIX_EFF > 0.0 ) {
+    for(obs=0; obs < NOBS; obs++ ) { EFF_LIST[obs] = FIX_EFF; }
+    return ;
+  }
+
+  // find map for each filter and [optional] FIELD
+  for(obs=0; obs < NOBS; obs++ ) {
+    ifilt_obs = SEARCHEFF_DATA.IFILTOBS[obs] ;
+    IMAP_LIST[ifilt_obs] = IMAP_SEARCHEFF_DETECT(ifilt_obs);
+  }
+
+  for(obs=0; obs < NOBS; obs++ ) {
+    EFF_LIST[obs] = 0.0 ;
+    if ( SEARCHEFF_DATA.MAG[obs] == MAG_UNDEFINED ) { continue ; }
+
+    IMAP = IMAP_LIST[SEARCHEFF_DATA.IFILTOBS[obs]] ;
+
+    // if no maps are found for this filter, there are two possibilities:
+    // 1) there are no maps at all --> EFF=1
+    // 2) there are maps for other bands -> EFF=0
+    if ( IMAP < 0 ) 
+      { if ( NMAP == 0 ) { EFF_LIST[obs] = 1.0; }  continue ; }
+
+    EFF_LIST[obs] = GETEFF_PIPELINE_DETECT(obs,IMAP);
+  }
+
+  return ;
+
+} // end GETEFF_PIPELINE_DETECT_BATCH
+
+
+// *************************************
+void reset_SEARCHEFF_BATCH(void) {
+
+  // Created Oct 2026
+  // Reset per-event cache of map index vs. filter;
+  // must be called for each event since map match depends on FIELD.
+
+  int ifilt;
+  for(ifilt=0; ifilt < MXFILTINDX; ifilt++ ) {
+    SEARCHEFF_BATCH.IMAP_DETECT[ifilt]   = IMAP_SEARCHEFF_UNKNOWN ;
+    SEARCHEFF_BATCH.IMAP_PHOTPROB[ifilt] = IMAP_SEARCHEFF_UNKNOWN ;
+  }
+  return ;
+
+} // end reset_SEARCHEFF_BATCH
+
+
+// *************************************
+int IMAP_SEARCHEFF_DETECT(int ifilt_obs) {
+
+  // Created Oct 2026
+  // Return PIPELINE/DETECT map index for this filter and event FIELD,
+  // or IMAP_SEARCHEFF_NONE if there is no map.
+  // Result is cached in SEARCHEFF_BATCH.IMAP_DETECT[ifilt_obs].
+  // Code moved from GETEFF_PIPELINE_DETECT.
+
+  int  NMAP  = INPUTS_SEARCHEFF.NMAP_DETECT ;
+  int  IMAP  = SEARCHEFF_BATCH.IMAP_DETECT[ifilt_obs] ;
+  int  imap, NMAP_FOUND=0 ;
+  bool MATCH_FILTER, MATCH_FIELD;
+  char cfilt[4], *field_map, *filt_map;
+  char fnam[] = "IMAP_SEARCHEFF_DETECT" ;
+
+  // ----------- BEGIN ------------
+
+  if ( IMAP != IMAP_SEARCHEFF_UNKNOWN ) { return IMAP ; }
+
+  IMAP = IMAP_SEARCHEFF_NONE ;
+  sprintf(cfilt,"%c", FILTERSTRING[ifilt_obs] );
+
+  for(imap=0; imap < NMAP; imap++ ) {
+    field_map     = SEARCHEFF_DETECT[imap].FIELDLIST;
+    filt_map      = SEARCHEFF_DETECT[imap].FILTERLIST ;
+    MATCH_FILTER  = ( strstr(filt_map,cfilt) != NULL );
+    if ( strlen(field_map) > 0 ) 
+      { MATCH_FIELD   = MATCH_SEARCHEFF_FIELD(field_map); }
+    else
+      { MATCH_FIELD = true; }
+
+    if ( MATCH_FILTER && MATCH_FIELD ) 	
+      {  IMAP = imap;   NMAP_FOUND++; }
+  }
+
+  if ( NMAP_FOUND > 1 ) {
+    sprintf(c1err,
+	    "Found %d PIPELINE/DETECT maps for ifilt_obs=%d(%s)",
+	    NMAP_FOUND, ifilt_obs, cfilt);
+    sprintf(c2err,"Check EFF maps in %s", 
+	    INPUTS_SEARCHEFF.PIPELINE_EFF_FILE );
+    errmsg(SEV_FATAL, 0, fnam, c1err, c2err) ; 
+  }
+
+  SEARCHEFF_BATCH.IMAP_DETECT[ifilt_obs] = IMAP ;
+  return IMAP ;
+
+} // end IMAP_SEARCHEFF_DETECT
+
+
+// *************************************
+double EFFMAX_PIPELINE_DETECT(int ifilt_obs, double MAGMIN) {
+
+  // Created Oct 2026
+  // Return strict upper bound on pipeline/detection efficiency
+  // for any epoch in band ifilt_obs with true mag >= MAGMIN.
+  // Max is over all maps for this filter (any FIELD), and over
+  // every map bin that can contribute to the interpolation.
+  // Returns 1 if EFF is not a function of true mag (e.g., SNR map).
+  // Used by the sim to reject events before generating fluxes.
+
+  int    NMAP = INPUTS_SEARCHEFF.NMAP_DETECT ;
+  int    imap, ibin, NBIN ;
+  double EFFMAX = 0.0, *VAL, *EFF ;
+  char   cfilt[4];
+
+  // ----------- BEGIN ------------
+
+  if ( INPUTS_SEARCHEFF.FUNEFF_DEBUG )          { return(1.0); }
+  if ( INPUTS_SEARCHEFF.FIX_EFF_PIPELINE > 0.0 ) { return(1.0); }
+  if ( SEARCHEFF_FLAG != FLAG_EFFMAG_DETECT )    { return(1.0); }
+  if ( NMAP == 0 )                               { return(1.0); }
+
+  sprintf(cfilt,"%c", FILTERSTRING[ifilt_obs] );
+
+  for(imap=0; imap < NMAP; imap++ ) {
+    if ( strstr(SEARCHEFF_DETECT[imap].FILTERLIST,cfilt) == NULL ) 
+      { continue ; }
+
+    NBIN = SEARCHEFF_DETECT[imap].NBIN ;
+    VAL  = SEARCHEFF_DETECT[imap].VAL ;
+    EFF  = SEARCHEFF_DETECT[imap].EFF ;
+    if ( NBIN == 0 ) { return(1.0); }
+
+    // include each bin whose interval to next bin reaches MAGMIN
+    for(ibin=0; ibin < NBIN; ibin++ ) {
+      if ( ibin < NBIN-1 && VAL[ibin+1] < MAGMIN ) { continue ; }
+      if ( EFF[ibin] > EFFMAX ) { EFFMAX = EFF[ibin]; }
+    }
+  }
+
+  return EFFMAX ;
+
+} // end EFFMAX_PIPELINE_DETECT
+
+
 // *************************************
 void setObs_for_PHOTPROB(int DETECT_FLAG, int obs) {
 
@@ -2238,23 +2390,60 @@ void setObs_for_PHOTPROB(int DETECT_FLAG, int obs) {
   
   int   NMAP       = INPUTS_SEARCHEFF.NMAP_PHOTPROB ;
   int   IFILTOBS   = SEARCHEFF_DATA.IFILTOBS[obs] ;
-  char  *FIELD     = SEARCHEFF_DATA.FIELDNAME ; 
 
   int  NSTORE = OBS_PHOTPROB.NSTORE;
-  int  imap, IMAP, NMATCH;
-  bool MATCH_FIELD, MATCH_FILT ;
-  char FILT[2], *FIELD_TMP, *FILT_TMP;
-  char fnam[]      = "setObs_for_PHOTPROB" ;
+  int  IMAP;
 
   // ------------ BEGIN ------------
 
   if ( NMAP == 0 ) { return ; }
 
+  // find map for this filter and field (Oct 2026: cached per filter)
+  IMAP = IMAP_SEARCHEFF_PHOTPROB(IFILTOBS);
+  if ( IMAP < 0 )  { return; }
+
+  // check if PHOTPROB map requires a detection
+  if ( DETECT_FLAG==0 && SEARCHEFF_PHOTPROB[IMAP].REQUIRE_DETECTION )
+    { return; }
+
+  
+  // if we get here, store info
+  if ( NSTORE < MXOBS_PHOTPROB ) {
+    OBS_PHOTPROB.OBS_LIST[NSTORE]  = obs ;
+    OBS_PHOTPROB.OBSINV_LIST[obs]  = NSTORE ;
+    OBS_PHOTPROB.IMAP_LIST[NSTORE] = IMAP ;
+  }
+  OBS_PHOTPROB.NSTORE++ ;
+
+  return ;
+
+}  // end setObs_for_PHOTPROB" ;
+
+
+// *************************************
+int IMAP_SEARCHEFF_PHOTPROB(int ifilt_obs) {
+
+  // Created Oct 2026
+  // Return PHOTPROB map index for this filter and event FIELD,
+  // or IMAP_SEARCHEFF_NONE if there is no map.
+  // Result is cached in SEARCHEFF_BATCH.IMAP_PHOTPROB[ifilt_obs].
+  // Code moved from setObs_for_PHOTPROB.
+
+  int   NMAP   = INPUTS_SEARCHEFF.NMAP_PHOTPROB ;
+  int   IMAP   = SEARCHEFF_BATCH.IMAP_PHOTPROB[ifilt_obs] ;
+  char  *FIELD = SEARCHEFF_DATA.FIELDNAME ; 
+  int   imap, NMATCH = 0 ;
+  bool  MATCH_FIELD, MATCH_FILT ;
+  char  FILT[2], *FIELD_TMP, *FILT_TMP;
+  char  fnam[] = "IMAP_SEARCHEFF_PHOTPROB" ;
+
+  // ----------- BEGIN ------------
 
-  sprintf(FILT, "%c", FILTERSTRING[IFILTOBS] );
+  if ( IMAP != IMAP_SEARCHEFF_UNKNOWN ) { return IMAP ; }
+
+  IMAP = IMAP_SEARCHEFF_NONE ;
+  sprintf(FILT, "%c", FILTERSTRING[ifilt_obs] );
 
-  // find map for this filter and field.
-  NMATCH = 0 ;  IMAP=-9;
   for(imap=0; imap < NMAP; imap++ ) {
     MATCH_FIELD = MATCH_FILT = false ;
     FIELD_TMP  = SEARCHEFF_PHOTPROB[imap].FIELDLIST;
@@ -2269,30 +2458,16 @@ void setObs_for_PHOTPROB(int DETECT_FLAG, int obs) {
 
   } // end imap loop
 
-  if(NMATCH==0 )  { return; }
-
   if(NMATCH > 1 ) {
     sprintf(c1err,"%d matches to PHOTPROB map invalid.", NMATCH );
     sprintf(c2err,"FIELD='%s'  FILT='%s' ", FIELD, FILT);
     errmsg(SEV_FATAL, 0, fnam, c1err, c2err) ; 
   }
 
-  // check if PHOTPROB map requires a detection
-  if ( DETECT_FLAG==0 && SEARCHEFF_PHOTPROB[IMAP].REQUIRE_DETECTION )
-    { return; }
-
-  
-  // if we get here, store info
-  if ( NSTORE < MXOBS_PHOTPROB ) {
-    OBS_PHOTPROB.OBS_LIST[NSTORE]  = obs ;
-    OBS_PHOTPROB.OBSINV_LIST[obs]  = NSTORE ;
-    OBS_PHOTPROB.IMAP_LIST[NSTORE] = IMAP ;
-  }
-  OBS_PHOTPROB.NSTORE++ ;
-
-  return ;
+  SEARCHEFF_BATCH.IMAP_PHOTPROB[ifilt_obs] = IMAP ;
+  return IMAP ;
 
-}  // end setObs_for_PHOTPROB" ;
+} // end IMAP_SEARCHEFF_PHOTPROB
 
 
 // ***************************************************
@@ -2434,12 +2609,49 @@ void setRan_for_PHOTPROB(void) {
 
 
 // ***************************************************
-double get_PIPELINE_PHOTPROB(int istore) {
+void get_PIPELINE_PHOTPROB_BATCH(double *PHOTPROB_LIST) {
+
+  // Created Oct 2026
+  // Load PHOTPROB_LIST[istore] for all istore=0 to NSTORE-1.
+  // The map variables for all stored epochs are gathered first,
+  // then each epoch's CDF is interpolated and inverted.
+  // Before calling this function, must call 
+  // setObs_for_PHOTPROB & setRan_for_PHOTPROB
+
+  int NSTORE = OBS_PHOTPROB.NSTORE ;
+  int istore, obs, IMAP, ivar, NVAR_MAP ;
+
+  // ----------- BEGIN ------------
+
+  for(istore=0; istore < NSTORE; istore++ ) {
+    obs      = OBS_PHOTPROB.OBS_LIST[istore];
+    IMAP     = OBS_PHOTPROB.IMAP_LIST[istore];
+    NVAR_MAP = SEARCHEFF_PHOTPROB[IMAP].NVAR_MAP;
+    for(ivar=0; ivar < NVAR_MAP; ivar++ ) {
+      SEARCHEFF_BATCH.VARDATA_PHOTPROB[istore][ivar] = 
+	LOAD_PHOTPROB_VAR(obs,IMAP,ivar);
+    }
+  }
+
+  for(istore=0; istore < NSTORE; istore++ ) {
+    PHOTPROB_LIST[istore] = 
+      get_PIPELINE_PHOTPROB(istore, SEARCHEFF_BATCH.VARDATA_PHOTPROB[istore]);
+  }
+
+  return ;
+
+} // end get_PIPELINE_PHOTPROB_BATCH
+
+
+// ***************************************************
+double get_PIPELINE_PHOTPROB(int istore, double *VARDATA) {
 
   // Created April 2018
   // Determine random PHOTPROB for this 'istore'.
   // Before calling this function, must call 
   // setObs_for_PHOTPROB & setRan_for_PHOTPROB
+  //
+  // Oct 2026: pass map variables VARDATA (see get_PIPELINE_PHOTPROB_BATCH)
 
   int    obs    = OBS_PHOTPROB.OBS_LIST[istore];  // SEARCHEFF_DATA index
   int    IMAP   = OBS_PHOTPROB.IMAP_LIST[istore]; // select PHOTPROB map
@@ -2456,7 +2668,6 @@ double get_PIPELINE_PHOTPROB(int istore) {
 
   int    istat, ivar, LDMP ;
   double PHOTPROB_CDF[MXVAR_SEARCHEFF_PHOTPROB];
-  double VARDATA[MXVAR_SEARCHEFF_PHOTPROB];
   char  *VARNAME, cFILT[4];
   double PHOTPROB = 0.0 ;
 
@@ -2464,10 +2675,6 @@ double get_PIPELINE_PHOTPROB(int istore) {
 
   // ------------ BEGIN --------------
 
-  
-  for(ivar=0; ivar < NVAR_MAP; ivar++ ) 
-    { VARDATA[ivar] = LOAD_PHOTPROB_VAR(obs,IMAP,ivar);   }
-  
   PHOTPROB_CDF[0] = 0.0 ;
   istat = interp_GRIDMAP(&SEARCHEFF_PHOTPROB[IMAP].GRIDMAP, VARDATA, 
 			 &PHOTPROB_CDF[1] );  // <== returned  
@@ -2965,8 +3172,9 @@ double LOAD_PHOTPROB_VAR(int OBS, int IMAP, int IVAR) {
 
   if ( SNR < 0.1 ) { SNR=0.1; }
 
+  // use IVARABS stored when map was read (Oct 2026)
   VARNAME = SEARCHEFF_PHOTPROB[IMAP].VARNAMES[IVAR] ;
-  IVARABS = IVARABS_SEARCHEFF_PHOTPROB(VARNAME) ;
+  IVARABS = SEARCHEFF_PHOTPROB[IMAP].IVARABS[IVAR] ;
 
   if ( IVARABS == IVARABS_PHOTPROB_SNR ) 
     { VAL = SNR ; }
@@ -196,6 +196,20 @@ struct {
 } OBS_PHOTPROB;
 
 
+// per-event cache of map index vs. ifiltobs, and batched pipeline
+// efficiency per obs (Oct 2026). Map match depends on filter and FIELD,
+// so cache is reset at the start of each event.
+#define IMAP_SEARCHEFF_UNKNOWN  -9  // map lookup not done yet
+#define IMAP_SEARCHEFF_NONE     -1  // no map for this filter
+struct {
+  int    IMAP_DETECT[MXFILTINDX];
+  int    IMAP_PHOTPROB[MXFILTINDX];
+  double EFF_PIPELINE[MXOBS_TRIGGER];  // EFF for each obs
+  double PHOTPROB[MXOBS_PHOTPROB];     // PHOTPROB for each istore
+  double VARDATA_PHOTPROB[MXOBS_PHOTPROB][MXVAR_SEARCHEFF_PHOTPROB];
+} SEARCHEFF_BATCH ;
+
+
 #define MXMASK_SEARCHEFF_LOGIC 10 // max number of logic conditions
 struct SEARCHEFF_LOGIC {
   int  NMJD;     // number of MJDs to have a detection
@@ -342,11 +356,17 @@ void   check_SEARCHEFF_PHOTPROB(int imap );
 double LOAD_SPECEFF_VAR(int imap, int ivar);
 void   LOAD_PHOTPROB_CDF(int NVAR_CDF, double *WGTLIST );
 double LOAD_PHOTPROB_VAR(int OBS, int IMAP, int IVAR) ;
-double GETEFF_PIPELINE_DETECT(int obs);
+double GETEFF_PIPELINE_DETECT(int obs, int IMAP);
+void   GETEFF_PIPELINE_DETECT_BATCH(int NOBS, double *EFF_LIST);
+void   reset_SEARCHEFF_BATCH(void);
+int    IMAP_SEARCHEFF_DETECT(int ifilt_obs);
+double EFFMAX_PIPELINE_DETECT(int ifilt_obs, double MAGMIN);
+int    IMAP_SEARCHEFF_PHOTPROB(int ifilt_obs);
 
 void   setObs_for_PHOTPROB(int DETECT_FLAG, int obs);
 void   setRan_for_PHOTPROB(void) ;
-double get_PIPELINE_PHOTPROB(int obs);
+double get_PIPELINE_PHOTPROB(int istore, double *VARDATA);
+void   get_PIPELINE_PHOTPROB_BATCH(double *PHOTPROB_LIST);
 double get_PIPELINE_PHOTPROB_Obsolete(int DETECT_FLAG, int obs);
 void   dumpLine_PIPELINE_PHOTPROB(void);
 
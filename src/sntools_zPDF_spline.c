@@ -1,8 +1,10 @@
 // Created Jun 2022
 // Tools to interpolate zPDF quantiles and return probability.
 //
-#include <gsl/gsl_errno.h>
-#include <gsl/gsl_spline.h> 
+// Oct 2026: replace GSL spline with internal spline coefficients stored
+//   in flat arrays (ZPDF_POOL_DEF) to avoid alloc/free per candidate,
+//   and add batched evaluation on a z-grid.
+//
 
 #include "sntools.h"
 #include "sntools_zPDF_spline.h"
@@ -15,7 +17,6 @@ void init_zPDF_spline(int N_Q, double* percentile_list, double* zphot_q_list,
 		      double *mean, double *std_dev, int *error_flag ) {
   // created Jun 2022 R. Chen
   // Initialize spline interpolate for photo-z quantiles
-  // allocate interpolation accelerator and gsl_spline object
   //
   // Inputs :
   //       N_Q : Number of Quantiles
@@ -37,50 +38,198 @@ void init_zPDF_spline(int N_Q, double* percentile_list, double* zphot_q_list,
   // Mar 25,2024: return mean and RMS
   // May 30 2024: return error_flag!=0  on bad quantiles instead of aborting;
   //              allows calling code to reject event and move on.
+  // Oct 2026: use slot 0 of ZPDF_POOL_LEGACY; no alloc after first call.
   //
 
-  char fnam[] = "init_zPDF_spline";
-  double sum    = 0. ;
-  double sum_pdf= 0. ;
-  double sum_sq = 0. ;
-  int i,i2;
-  int LDMP = 0;
+  // ------ BEGIN ---------
+
+  if ( ZPDF_POOL_LEGACY.NCAND == 0 ) 
+    { init_zPDF_pool(1, MXQ_ZPDF, &ZPDF_POOL_LEGACY); }
+
+  load_zPDF_pool(0, N_Q, percentile_list, zphot_q_list, cid, method_spline,
+		 verbose, mean, std_dev, error_flag, &ZPDF_POOL_LEGACY);
 
+} // END OF init_zPDF_spline
+
+void init_zPDF_spline_block(int NCAND, int N_Q, int MXQ_LIST, 
+			    double *percentile_list, double *zphot_q_list, 
+			    char *cid, char *method_spline, int verbose,
+			    double *mean_list, double *std_list, 
+			    int *error_flag_list) {
+  // Created Oct 2026
+  // Load quantiles for a block of NCAND candidates (e.g., host matches
+  // of one SN) into ZPDF_POOL_LEGACY with one call. Quantiles for 
+  // candidate icand are zphot_q_list[icand*MXQ_LIST + q]; outputs
+  // mean, std and error_flag are returned per candidate.
+  // Candidate 0 is evaluated by eval_zPDF_spline[_grid].
+
+  int icand ;
   // ------ BEGIN ---------
- 
-  *error_flag = 0; // init output 
-    
-  zPDF_spline.acc    = gsl_interp_accel_alloc();
 
-  if (strcmp(method_spline,METHOD_SPLINE_LINEAR)==0 ){
-    zPDF_spline.spline = gsl_spline_alloc(gsl_interp_linear, N_Q);     // Linear
-  }
-  else if (strcmp(method_spline,METHOD_SPLINE_CUBIC)==0){
-    zPDF_spline.spline = gsl_spline_alloc(gsl_interp_cspline, N_Q);   // cubic
+  init_zPDF_pool(NCAND, MXQ_ZPDF, &ZPDF_POOL_LEGACY);
+
+  for(icand=0; icand < NCAND; icand++ ) {
+    load_zPDF_pool(icand, N_Q, percentile_list, &zphot_q_list[icand*MXQ_LIST],
+		   cid, method_spline, verbose, 
+		   &mean_list[icand], &std_list[icand], &error_flag_list[icand],
+		   &ZPDF_POOL_LEGACY);
   }
-  else if  (strcmp(method_spline,METHOD_SPLINE_STEFFEN)==0){
-#ifdef GSL_INTERP_STEFFEN
-    zPDF_spline.spline = gsl_spline_alloc(gsl_interp_steffen, N_Q);    // Steffan
-#else
-    sprintf(c1err,"Compilation does not include %s method for GSL",
-	    method_spline);
-    sprintf(c2err,"Needs GSL 2.7 or higher");
-    errmsg(SEV_FATAL, 0, fnam, c1err, c2err);    
-#endif
+
+} // end init_zPDF_spline_block
+
+double eval_zPDF_spline(double z) {
+  // created Jun 2022 R. Chen
+  // Returns PDF probability at redshift z
+  // Must call init_zPDF_spline before calling this function
+  //
+  // Jan 9 2024 RK : pdf /= pdf_max
+  // Oct 2026: evaluate slot 0 of ZPDF_POOL_LEGACY
+
+  return eval_zPDF_pool(0, z, &ZPDF_POOL_LEGACY);
+
+} // END OF eval_zPDF_spline
+
+void eval_zPDF_spline_grid(int NZ, double *z_list, double *pdf_list) {
+  // Created Oct 2026
+  // Batched version of eval_zPDF_spline; returns pdf_list[0:NZ-1].
+  eval_zPDF_pool_grid(0, NZ, z_list, &ZPDF_POOL_LEGACY, pdf_list);
+} // end eval_zPDF_spline_grid
+
+
+void init_zpdf_spline__(int *N_Q, double* percentile_list, 
+			double* zphot_q_list, char *cid, char *method_spline, int *verbose, double *mean, double *std, int *error_flag) {
+  init_zPDF_spline(*N_Q, percentile_list, zphot_q_list, cid, method_spline, *verbose, mean, std, error_flag);
+}
+void init_zpdf_spline_block__(int *NCAND, int *N_Q, int *MXQ_LIST, 
+			      double *percentile_list, double *zphot_q_list,
+			      char *cid, char *method_spline, int *verbose,
+			      double *mean_list, double *std_list, 
+			      int *error_flag_list) {
+  init_zPDF_spline_block(*NCAND, *N_Q, *MXQ_LIST, percentile_list, 
+			 zphot_q_list, cid, method_spline, *verbose,
+			 mean_list, std_list, error_flag_list);
+}
+double eval_zpdf_spline__(double *z) {
+  return eval_zPDF_spline(*z) ; 
+
+}
+void eval_zpdf_spline_grid__(int *NZ, double *z_list, double *pdf_list) {
+  eval_zPDF_spline_grid(*NZ, z_list, pdf_list);
+}
+
+
+// =====================================================
+//
+//    Pooled zPDF spline workspace (Oct 2026)
+//
+// =====================================================
+
+void init_zPDF_pool(int NCAND, int MXQ, ZPDF_POOL_DEF *POOL) {
+
+  // Created Oct 2026
+  // Allocate flat arrays for NCAND candidates with up to MXQ quantiles
+  // each. Re-calling with sizes that fit in existing arrays does not
+  // allocate. Input POOL must be zero-initialized before first call.
+
+  int  NTOT ;
+  char fnam[] = "init_zPDF_pool" ;
+
+  // ------ BEGIN ---------
+
+  if ( NCAND <= 0 || MXQ < 2 || MXQ > MXQ_ZPDF ) {
+    sprintf(c1err,"Invalid NCAND=%d or MXQ=%d", NCAND, MXQ);
+    sprintf(c2err,"Need NCAND>0 and 2 <= MXQ <= %d", MXQ_ZPDF);
+    errmsg(SEV_FATAL, 0, fnam, c1err, c2err);
   }
+
+  if ( NCAND <= POOL->NCAND && MXQ == POOL->MXQ ) { return; }
+
+  NTOT = NCAND * MXQ ;
+  POOL->N_Q     = (int*)   realloc(POOL->N_Q,     NCAND*sizeof(int));
+  POOL->IMETHOD = (int*)   realloc(POOL->IMETHOD, NCAND*sizeof(int));
+  POOL->zmin    = (double*)realloc(POOL->zmin,    NCAND*sizeof(double));
+  POOL->zmax    = (double*)realloc(POOL->zmax,    NCAND*sizeof(double));
+  POOL->pdf_max = (double*)realloc(POOL->pdf_max, NCAND*sizeof(double));
+  POOL->ZQ      = (double*)realloc(POOL->ZQ,      NTOT*sizeof(double));
+  POOL->PQ      = (double*)realloc(POOL->PQ,      NTOT*sizeof(double));
+  POOL->B       = (double*)realloc(POOL->B,       NTOT*sizeof(double));
+  POOL->C       = (double*)realloc(POOL->C,       NTOT*sizeof(double));
+  POOL->D       = (double*)realloc(POOL->D,       NTOT*sizeof(double));
+
+  POOL->NCAND = NCAND;
+  POOL->MXQ   = MXQ;
+
+  memset(POOL->N_Q, 0, NCAND*sizeof(int) );
+
+} // end init_zPDF_pool
+
+void free_zPDF_pool(ZPDF_POOL_DEF *POOL) {
+  // Created Oct 2026
+  free(POOL->N_Q);  free(POOL->IMETHOD);
+  free(POOL->zmin); free(POOL->zmax);  free(POOL->pdf_max);
+  free(POOL->ZQ);   free(POOL->PQ);
+  free(POOL->B);    free(POOL->C);     free(POOL->D);
+  memset(POOL, 0, sizeof(ZPDF_POOL_DEF));
+} // end free_zPDF_pool
+
+
+int get_IMETHOD_zPDF(char *method_spline, char *cid) {
+  // Created Oct 2026: return integer index for method_spline string
+  char fnam[] = "get_IMETHOD_zPDF" ;
+  if ( strcmp(method_spline,METHOD_SPLINE_LINEAR) == 0 )
+    { return IMETHOD_SPLINE_LINEAR; }
+  else if ( strcmp(method_spline,METHOD_SPLINE_CUBIC) == 0 ) 
+    { return IMETHOD_SPLINE_CUBIC; }
+  else if ( strcmp(method_spline,METHOD_SPLINE_STEFFEN) == 0 ) 
+    { return IMETHOD_SPLINE_STEFFEN; }
   else {
     sprintf(c1err,"Invalid method_spline = '%s' for CID=%s", method_spline, cid );
     sprintf(c2err,"Valid methods are:  %s  %s  %s", 
 	    METHOD_SPLINE_LINEAR, METHOD_SPLINE_CUBIC, METHOD_SPLINE_STEFFEN);
     errmsg(SEV_FATAL, 0, fnam, c1err, c2err);
   }
-    
-  sprintf(zPDF_spline.method_spline, "%s", method_spline);
-  zPDF_spline.zmin   = zphot_q_list[0];
-  zPDF_spline.zmax   = zphot_q_list[N_Q-1];
-  int NBIN_SPLINE    = 20; // Warning -- hack 
-  zPDF_spline.dz     = (zPDF_spline.zmax - zPDF_spline.zmin)/(double)NBIN_SPLINE ;
-  
+  return -9 ;
+} // end get_IMETHOD_zPDF
+
+
+void load_zPDF_pool(int icand, int N_Q, double *percentile_list, 
+		    double *zphot_q_list, char *cid, char *method_spline,
+		    int verbose, double *mean, double *std_dev, 
+		    int *error_flag, ZPDF_POOL_DEF *POOL) {
+
+  // Created Oct 2026 [code moved from init_zPDF_spline]
+  // Load quantiles for candidate slot icand, compute spline 
+  // coefficients, and return mean, std_dev and error_flag as 
+  // described in init_zPDF_spline. Nothing is allocated here.
+
+  int    MXQ  = POOL->MXQ ;
+  int    OFF  = icand * MXQ ;
+  int    LDMP = 0;
+  int    i, iz, q ;
+  double sum = 0.0, sum_pdf = 0.0, sum_sq = 0.0 ;
+  double zmin, zmax, dz, z, pdf, pdf_max = 0.0 ;
+  double pdf_store[NBIN_SPLINE_ZPDF+2];
+  char fnam[] = "load_zPDF_pool";
+
+  // ------ BEGIN ---------
+
+  *error_flag = 0; // init output 
+
+  if ( icand < 0 || icand >= POOL->NCAND ) {
+    sprintf(c1err,"Invalid icand=%d for CID=%s", icand, cid);
+    sprintf(c2err,"Valid range is 0 to %d (see init_zPDF_pool)", 
+	    POOL->NCAND-1);
+    errmsg(SEV_FATAL, 0, fnam, c1err, c2err);
+  }
+  if ( N_Q < 2 || N_Q > MXQ ) {
+    sprintf(c1err,"N_Q=%d quantiles for CID=%s", N_Q, cid);
+    sprintf(c2err,"Valid range is 2 to MXQ=%d", MXQ);
+    errmsg(SEV_FATAL, 0, fnam, c1err, c2err);
+  }
+
+  POOL->N_Q[icand]     = 0 ; // flag as not loaded until success
+  POOL->IMETHOD[icand] = get_IMETHOD_zPDF(method_spline, cid);
+
   // check that percentile list covers 0 and 1.0
   double P0 = percentile_list[0];
   if (P0 > 1.0e-4) {
@@ -104,16 +253,6 @@ void init_zPDF_spline(int N_Q, double* percentile_list, double* zphot_q_list,
     bool check_1 = percentile_list[i] > percentile_list[i-1];
     bool check_2 = zphot_q_list[i]    > zphot_q_list[i-1];
 
-    /* xxxxxxxxx  Mark delete, May 30, 2024 xxxxxxxxxxxxxx
-    if(  !(check_1 && check_2)) {
-      print_preAbort_banner(fnam);
-      dump_zPDF(method_spline, N_Q, percentile_list, zphot_q_list, cid);      
-      sprintf(c1err,"Quantile information is not monotonically increasing for CID=%s", cid);
-      sprintf(c2err,"Check both z and percentile in datafile");
-      errmsg(SEV_FATAL, 0, fnam, c1err, c2err);
-    }
-    xxxxxxxxxxxx end mark xxxxxxxxxxxx  */
-
     if ( !(check_1 && check_2)  ) {
       if ( verbose ) 
 	{ dump_zPDF(method_spline, N_Q, percentile_list, zphot_q_list, cid);  }
@@ -128,98 +267,192 @@ void init_zPDF_spline(int N_Q, double* percentile_list, double* zphot_q_list,
     
   } // end loop over quantile percentages
 
-  
-  
-  // intialize spline
-  gsl_spline_init(zPDF_spline.spline, zphot_q_list, percentile_list, N_Q);
+  // load knots and compute spline coefficients
+  for(q=0; q < N_Q; q++ ) {
+    POOL->ZQ[OFF+q] = zphot_q_list[q];
+    POOL->PQ[OFF+q] = percentile_list[q];
+  }
+  POOL->N_Q[icand]  = N_Q ;
+  POOL->zmin[icand] = zphot_q_list[0];
+  POOL->zmax[icand] = zphot_q_list[N_Q-1];
+  fill_coeff_zPDF_pool(icand, POOL);
 
   // - - - - 
-  double zmin, zmax, dz, z, pdf, pdf_max = 0.0;
-  int iz = 0; 
-  double *pdf_store = (double*)malloc((NBIN_SPLINE+1)*sizeof(double));
-  //double pdf_store[40];
-  zmin = zphot_q_list[0] ;
-  zmax = zphot_q_list[N_Q-1] ;
-  dz   = zPDF_spline.dz ;
-  for( z = zmin; z <= zmax; z += dz ) {
-    pdf = gsl_spline_eval_deriv(zPDF_spline.spline, z, zPDF_spline.acc);
+  zmin = POOL->zmin[icand];
+  zmax = POOL->zmax[icand];
+  dz   = (zmax - zmin)/(double)NBIN_SPLINE_ZPDF ;
+  iz   = 0 ;  q = 0 ;
+  for( z = zmin; z <= zmax && iz <= NBIN_SPLINE_ZPDF+1; z += dz ) {
+    q   = find_interval_zPDF_pool(icand, z, q, POOL);
+    pdf = eval_deriv_zPDF_pool(icand, q, z, POOL);
     if (pdf < 0.) {pdf = 0.0 ;} // avoid unphysical negative probability
     pdf_store[iz] =  pdf; iz++; 
     if ( pdf > pdf_max ) { pdf_max = pdf; }
-    if(LDMP) {
-      printf("XXX %s iz = %d, z = %le, pdf = %le \n",fnam,iz,z, pdf);
-      //printf("ZPDF %le %le  \n",z, pdf); // XXX
-    }
+    if(LDMP) 
+      { printf("XXX %s iz = %d, z = %le, pdf = %le \n",fnam,iz,z, pdf); }
     sum     += z*pdf;
     sum_pdf += pdf;
   }
 
-
   *mean = sum/sum_pdf ;
   iz = 0; 
-  for( z = zmin; z <= zmax; z += dz){
+  for( z = zmin; z <= zmax && iz <= NBIN_SPLINE_ZPDF+1; z += dz){
     pdf = pdf_store[iz]; iz++;
     sum_sq += (z - *mean)*(z - *mean)*pdf;
   }
   if(LDMP) {
-    printf("XXX %s sum = %le, sum_pdf = %le, sum_sq = %le \n",fnam,sum,sum_pdf,sum_sq);
+    printf("XXX %s sum = %le, sum_pdf = %le, sum_sq = %le \n",
+	   fnam,sum,sum_pdf,sum_sq);
   }
-  if(sum_sq > 0  && sum_pdf > 0){
-  *std_dev  = sqrt(sum_sq/sum_pdf);
-  }
-  else {*std_dev = 0.;}
+  if(sum_sq > 0  && sum_pdf > 0)
+    { *std_dev  = sqrt(sum_sq/sum_pdf); }
+  else 
+    { *std_dev = 0.; }
 
-  if(LDMP) {
-  printf("XXX %s std = %le \n",fnam,*std_dev);
-  }
-  //free(pdf_store);
-    
-  zPDF_spline.pdf_max = pdf_max;
+  POOL->pdf_max[icand] = pdf_max;
 
   if ( verbose ) {
     printf("\t zPhot-quantile pdf(max) = %.2f mean = %.3f  std = %.3f for CID = %s\n", pdf_max,*mean, *std_dev,  cid);
     fflush(stdout);
   }
 
+} // end load_zPDF_pool
 
-} // END OF init_zPDF_spline
 
-double eval_zPDF_spline(double z) {
-  // created Jun 2022 R. Chen
-  // Returns PDF probability at redshift z
-  // Must call init_zPDF_spline before calling this function
-  //
-  // Jan 9 2024 RK : pdf /= pdf_max
+void fill_coeff_zPDF_pool(int icand, ZPDF_POOL_DEF *POOL) {
+
+  // Created Oct 2026
+  // Compute spline coefficients B,C,D for each quantile interval of
+  // candidate icand. Conventions follow GSL:
+  //   LINEAR  : piecewise linear
+  //   CUBIC   : natural cubic spline (zero 2nd deriv at ends)
+  //   STEFFEN : monotonic cubic (Steffen 1990, A&A 239, 443)
+
+  int    OFF = icand * POOL->MXQ ;
+  int    N   = POOL->N_Q[icand];
+  int    IMETHOD = POOL->IMETHOD[icand];
+  double *x = &POOL->ZQ[OFF], *y = &POOL->PQ[OFF];
+  double *B = &POOL->B[OFF],  *C = &POOL->C[OFF], *D = &POOL->D[OFF];
+  double h[MXQ_ZPDF], s[MXQ_ZPDF], yp[MXQ_ZPDF] ;
+  double M[MXQ_ZPDF], cp[MXQ_ZPDF], dp[MXQ_ZPDF] ;
+  double p, a, b, m ;
+  int    i ;
 
-  double pdf,z0,z1,cdf0,cdf1;
-  double dz = zPDF_spline.dz;
-  char fnam[] = "eval_zPDF_spline";
-  // BEGIN
-  if (z < zPDF_spline.zmin || z > zPDF_spline.zmax )  {
-    pdf=0.0 ;
+  // ------ BEGIN ---------
+
+  for(i=0; i < N-1; i++ ) {
+    h[i] = x[i+1] - x[i] ;
+    s[i] = (y[i+1] - y[i]) / h[i] ;
   }
-  else {
-    z0 = z1 = z;
-    if ( z+dz < zPDF_spline.zmax) { z1 = z+dz ; }
-    if ( z-dz > zPDF_spline.zmin) { z0 = z-dz ; }
-    pdf = gsl_spline_eval_deriv(zPDF_spline.spline, z, zPDF_spline.acc);
 
-    pdf /= zPDF_spline.pdf_max ; // RK Jan 9 2024: make sure that PDF(MAX)=1.0
-    //printf("Derivative PDF value is %lf \n", pdf);
+  if ( IMETHOD == IMETHOD_SPLINE_LINEAR ) {
+    for(i=0; i < N-1; i++ ) { B[i] = s[i]; C[i] = D[i] = 0.0; }
+  }
+  else if ( IMETHOD == IMETHOD_SPLINE_CUBIC ) {
+    // solve tridiagonal system for 2nd derivs M[1..N-2]; M[0]=M[N-1]=0
+    M[0] = M[N-1] = 0.0 ;
+    if ( N > 2 ) {
+      // Thomas algorithm
+      for(i=1; i < N-1; i++ ) {
+	a = h[i-1];  b = 2.0*(h[i-1]+h[i]);  p = 6.0*(s[i]-s[i-1]);
+	if ( i == 1 ) { cp[i] = h[i]/b;  dp[i] = p/b; }
+	else {
+	  m     = b - a*cp[i-1];
+	  cp[i] = h[i]/m ;
+	  dp[i] = (p - a*dp[i-1])/m ;
+	}
+      }
+      M[N-2] = dp[N-2];
+      for(i=N-3; i >= 1; i-- ) { M[i] = dp[i] - cp[i]*M[i+1]; }
+    }
+    for(i=0; i < N-1; i++ ) {
+      B[i] = s[i] - h[i]*(2.0*M[i] + M[i+1])/6.0 ;
+      C[i] = 0.5*M[i] ;
+      D[i] = (M[i+1] - M[i])/(6.0*h[i]) ;
+    }
+  }
+  else if ( IMETHOD == IMETHOD_SPLINE_STEFFEN ) {
+    yp[0]   = s[0];     // "simplest possibility" at boundaries
+    yp[N-1] = s[N-2];
+    for(i=1; i < N-1; i++ ) {
+      p = (s[i-1]*h[i] + s[i]*h[i-1]) / (h[i-1] + h[i]);
+      m = fmin( fabs(s[i-1]), fmin(fabs(s[i]), 0.5*fabs(p)) );
+      yp[i] = (copysign(1.0,s[i-1]) + copysign(1.0,s[i])) * m ;
+    }
+    for(i=0; i < N-1; i++ ) {
+      B[i] = yp[i] ;
+      C[i] = (3.0*s[i] - 2.0*yp[i] - yp[i+1]) / h[i] ;
+      D[i] = (yp[i] + yp[i+1] - 2.0*s[i]) / (h[i]*h[i]) ;
+    }
   }
-  return pdf ;
-} // END OF eval_zPDF_spline
 
-void init_zpdf_spline__(int *N_Q, double* percentile_list, 
-			double* zphot_q_list, char *cid, char *method_spline, int *verbose, double *mean, double *std, int *error_flag) {
-  init_zPDF_spline(*N_Q, percentile_list, zphot_q_list, cid, method_spline, *verbose, mean, std, error_flag);
-}
-double eval_zpdf_spline__(double *z) {
-  return eval_zPDF_spline(*z) ; 
+} // end fill_coeff_zPDF_pool
 
-}
 
+int find_interval_zPDF_pool(int icand, double z, int q_hint, 
+			    ZPDF_POOL_DEF *POOL) {
+  // Created Oct 2026
+  // Return interval q such that ZQ[q] <= z < ZQ[q+1], clamped to
+  // [0,N_Q-2]. Check q_hint and its neighbor first (sorted z input).
+  int    N  = POOL->N_Q[icand];
+  double *x = &POOL->ZQ[icand * POOL->MXQ] ;
+  int    lo, hi, mid ;
+
+  if ( q_hint >= 0 && q_hint < N-1 ) {
+    if ( z >= x[q_hint] && z < x[q_hint+1] ) { return q_hint; }
+    if ( q_hint < N-2 && z >= x[q_hint+1] && z < x[q_hint+2] )
+      { return q_hint+1; }
+  }
+
+  lo = 0;  hi = N-1;
+  while ( hi - lo > 1 ) {
+    mid = (lo + hi) / 2 ;
+    if ( x[mid] > z ) { hi = mid; } else { lo = mid; }
+  }
+  return lo ;
+} // end find_interval_zPDF_pool
+
+
+double eval_deriv_zPDF_pool(int icand, int q, double z, ZPDF_POOL_DEF *POOL) {
+  // Created Oct 2026: return dCDF/dz (unnormalized pdf) in interval q
+  int    j  = icand * POOL->MXQ + q ;
+  double dz = z - POOL->ZQ[j] ;
+  return POOL->B[j] + dz*(2.0*POOL->C[j] + 3.0*dz*POOL->D[j]) ;
+} // end eval_deriv_zPDF_pool
+
+
+double eval_zPDF_pool(int icand, double z, ZPDF_POOL_DEF *POOL) {
+  // Created Oct 2026
+  // Return pdf(z)/pdf_max for candidate icand; 0 outside quantile range.
+  int q ;
+  if ( z < POOL->zmin[icand] || z > POOL->zmax[icand] ) { return 0.0; }
+  q = find_interval_zPDF_pool(icand, z, -1, POOL);
+  return eval_deriv_zPDF_pool(icand, q, z, POOL) / POOL->pdf_max[icand] ;
+} // end eval_zPDF_pool
+
+
+void eval_zPDF_pool_grid(int icand, int NZ, double *z_list, 
+			 ZPDF_POOL_DEF *POOL, double *pdf_list) {
+
+  // Created Oct 2026
+  // Return pdf_list[iz] = pdf(z_list[iz])/pdf_max for candidate icand,
+  // e.g., to use as a prior on a z-grid. Interval search uses previous
+  // interval as hint, so sorted z_list is fastest.
+
+  double zmin    = POOL->zmin[icand];
+  double zmax    = POOL->zmax[icand];
+  double pdf_max = POOL->pdf_max[icand];
+  double z ;
+  int    iz, q = 0 ;
+
+  for(iz=0; iz < NZ; iz++ ) {
+    z = z_list[iz];
+    if ( z < zmin || z > zmax ) { pdf_list[iz] = 0.0; continue; }
+    q = find_interval_zPDF_pool(icand, z, q, POOL);
+    pdf_list[iz] = eval_deriv_zPDF_pool(icand, q, z, POOL) / pdf_max ;
+  }
 
+} // end eval_zPDF_pool_grid
 
 
 void dump_zPDF(char *method_spline, int N_Q, double* percentile_list, double* zphot_q_list,
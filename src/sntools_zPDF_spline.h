@@ -1,33 +1,76 @@
-
 // Mar 28 2024: Define pre-proc flag for using STEFFEN interp option.
 //    Adequate GSL version available only on Perlmutter;
 //    not on FNAL or RCC.
+//
+// Oct 2026: splines are computed internally (no GSL) and stored in
+//    flat arrays of ZPDF_POOL_DEF so that a block of candidates can be
+//    initialized repeatedly without malloc/free. STEFFEN is always
+//    available and the GSL_INTERP_STEFFEN flag is no longer used.
+//    Legacy init/eval_zPDF_spline use candidate slot 0 of ZPDF_POOL_LEGACY;
+//    snlc_fit loads all host matches as one block (init_zPDF_spline_block).
 
-#define GSL_INTERP_STEFFENxxx    
 #define METHOD_SPLINE_LINEAR "LINEAR"
 #define	METHOD_SPLINE_CUBIC "CUBIC"
 #define	METHOD_SPLINE_STEFFEN "STEFFEN"
 
+#define IMETHOD_SPLINE_LINEAR  1
+#define IMETHOD_SPLINE_CUBIC   2
+#define IMETHOD_SPLINE_STEFFEN 3
+
+#define MXQ_ZPDF          101  // max number of quantiles per candidate
+#define NBIN_SPLINE_ZPDF  20   // z-bins to compute pdf_max, mean, std
+
+// Pool of quantile splines for NCAND candidates. For candidate icand
+// and quantile interval q, index is icand*MXQ + q, and
+//   CDF(z) = PQ + B*dz + C*dz^2 + D*dz^3,  with dz = z - ZQ
+typedef struct {
+  int    NCAND, MXQ ;    // allocated sizes
+  int    *N_Q, *IMETHOD ;
+  double *zmin, *zmax, *pdf_max ;
+  double *ZQ, *PQ ;      // quantile redshifts and CDF values
+  double *B, *C, *D ;    // spline coefficients
+} ZPDF_POOL_DEF ;
 
-struct{
-  char method_spline[40];
-  gsl_interp_accel *acc;
-  gsl_spline       *spline;
-  double zmin, zmax, dz; // dz used for derivative calculation
-  double pdf_max ;
-} zPDF_spline ;
+ZPDF_POOL_DEF ZPDF_POOL_LEGACY ;  // pool for snlc_fit; slot 0 -> eval calls
 
 
-void init_zPDF_spline(int N_Q, double* percentile_list, double* zphot_q_list, 
+void init_zPDF_spline(int N_Q, double* percentile_list, double* zphot_q_list,
 		      char *cid, char *method_spline, int verbose, double *mean, double *std_dev, int *error_flag );
+void init_zPDF_spline_block(int NCAND, int N_Q, int MXQ_LIST, 
+			    double *percentile_list, double *zphot_q_list, 
+			    char *cid, char *method_spline, int verbose,
+			    double *mean_list, double *std_list, 
+			    int *error_flag_list);
 double eval_zPDF_spline(double z);
+void   eval_zPDF_spline_grid(int NZ, double *z_list, double *pdf_list);
 
 void dump_zPDF(char *method_spline, int N_Q, double* percentile_list, double* zphot_q_list,
                       char *cid);
 
+// pooled workspace for a block of candidates (Oct 2026)
+void   init_zPDF_pool(int NCAND, int MXQ, ZPDF_POOL_DEF *POOL);
+void   free_zPDF_pool(ZPDF_POOL_DEF *POOL);
+void   load_zPDF_pool(int icand, int N_Q, double *percentile_list,
+		      double *zphot_q_list, char *cid, char *method_spline,
+		      int verbose, double *mean, double *std_dev,
+		      int *error_flag, ZPDF_POOL_DEF *POOL);
+double eval_zPDF_pool(int icand, double z, ZPDF_POOL_DEF *POOL);
+void   eval_zPDF_pool_grid(int icand, int NZ, double *z_list,
+			   ZPDF_POOL_DEF *POOL, double *pdf_list);
+int    get_IMETHOD_zPDF(char *method_spline, char *cid);
+void   fill_coeff_zPDF_pool(int icand, ZPDF_POOL_DEF *POOL);
+int    find_interval_zPDF_pool(int icand, double z, int q_hint,
+			       ZPDF_POOL_DEF *POOL);
+double eval_deriv_zPDF_pool(int icand, int q, double z, ZPDF_POOL_DEF *POOL);
+
 // Mangled fortran functions for snlc_fit
 
-void init_zpdf_spline__( int *N_Q, double* percentile_list, double* zphot_q_list, 
+void init_zpdf_spline__( int *N_Q, double* percentile_list, double* zphot_q_list,
 			 char *cid, char *method_spline, int *verbose, double *mean, double *std_dev, int *error_flag );
+void init_zpdf_spline_block__(int *NCAND, int *N_Q, int *MXQ_LIST, 
+			      double *percentile_list, double *zphot_q_list,
+			      char *cid, char *method_spline, int *verbose,
+			      double *mean_list, double *std_list, 
+			      int *error_flag_list);
 double eval_zpdf_spline__(double *z);
-
+void   eval_zpdf_spline_grid__(int *NZ, double *z_list, double *pdf_list);
@@ -38,6 +38,21 @@
 
  Oct 2019: revived again for DES5YR analysis.
 
+ Oct 2026: 
+   + bin arrays (INDEXMAP, TABLE entries, P_UNFOLD, PSIM_SUM ...) and 
+     migration lists are malloc'ed from the user binning, so MAXBIN, 
+     MAXZBIN, MAXBINTOT and MAXMIGBIN limits are gone.
+   + after filling tables, migration lists are compressed into sparse
+     CSR matrices (GEN rows and transposed FIT rows) so that PSIM_ADD
+     and UNFOLD_ADD are gathers with no write conflicts.
+   + new input key NTHREAD: <n> (or command-line NTHREAD <n>) splits 
+     PSIM_ADD and UNFOLD_ADD over redshift bins with pthreads.
+     Per-z sums are reduced in fixed order, so results do not depend 
+     on NTHREAD.
+   + DOMIGRATION_FLAG=0: no-migration term XDATA/EFFSIM is added to the
+     generated bin and included in PSUM_UNFOLD (fitted bin index was
+     uninitialized).
+
 *************/
 
 #include <stdio.h>
@@ -49,6 +64,12 @@
 #include "sntools.h"
 #include "sntools_output.h"
 
+#define USE_THREAD   // Oct 2026: threads over z-bins
+
+#ifdef USE_THREAD
+#include <pthread.h>
+#endif
+
 
 // ##########################
 //
@@ -69,9 +90,14 @@ void  SET_TABLEBINS(char *string, int ipar);
 void  SET_INDEXMAP(void);
 void  GENBIN_LOOP(int OPT);
 void  UNFOLD_ZERO(int IZ, int IBIN1, int IBIN2 ) ;
-void  UNFOLD_ADD(int IZ, int IBIN1, int IBIN2) ;  // evaluate Eq. D2 of K09
 void  UNFOLD_RENORM(int IBIN1, int IBIN2 ) ;
-void  PSIM_ADD(int IZ, int IBIN1, int IBIN2) ;  // sum PSIM_SUM array
+
+void  build_MIGRATION_CSR(void);
+void  UNFOLD_THREAD_EXEC(int OPT);
+void *UNFOLD_THREAD(void *thread_arg);
+void  PSIM_ADD_ZBIN(int IZ);     // PSIM_SUM for fitted z-bin IZ
+void  UNFOLD_ADD_ZBIN(int IZ);   // Eq. D2 for generated z-bin IZ
+void  UNFOLD_DUMP(void);
 
 int PARVAL2BIN(int ipar, double val);
 
@@ -108,9 +134,6 @@ void  TEST_PARVAL2BIN(void);
 #define IPAR_1  1 // index for 1st param
 #define IPAR_2  2 // index for 2nd param
 
-#define MAXBINTOT 100000 // max for total number of bins
-#define MAXBIN  40       // max number of bins to store per parameter
-#define MAXZBIN 40       // fewere Z-bins to save memory
 #define MAXSN  2000000   // max SN to store
 #define MAXBINDUMP 50    // max bins to dump detailed info in UNFOLD()
 
@@ -161,6 +184,8 @@ struct INPUTS {
 
   int DOMIGRATION_FLAG;  // default = 1
 
+  int NTHREAD ;  // number of threads over z-bins (Oct 2026)
+
 }  INPUTS ;
 
 
@@ -172,47 +197,72 @@ struct ARRAY {
 } ARRAY[MAXTYPE];
 
 
+// Oct 2026: all bin arrays below are malloc'ed in init_unfold
+//   (or SET_TABLEBINS) based on NBIN_PAR.
+//   1D INDEX = (IZ*NB1 + IB1)*NB2 + IB2, so each z-bin is contiguous.
+
 int NBINTOT ; // total number of bins to process
-int INDEXMAP[MAXZBIN][MAXBIN][MAXBIN]; // translate multi-index to 1 index
+int ***INDEXMAP ; // [iz][i1][i2] : translate multi-index to 1 index
 
 struct INDEXMAP_INV {
   int IZ ;
   int I1 ;
   int I2 ;
-} INDEXMAP_INV[MAXBINTOT];
+} *INDEXMAP_INV ;
 
 
 struct TABLE {
   double N_OVERFLOW;
   double N_FILLED ;
-  double ENTRIES[MAXBINTOT];      // entries in each z,par1,par2 bin
-  double ENTRIES_SUMZ[MAXBINTOT]; // entries in par1,par2, summed over z
+  double *ENTRIES;      // entries in each z,par1,par2 bin
+  double *ENTRIES_SUMZ; // entries in par1,par2, summed over z
 } TABLE[MAXTYPE];
 
 
-double TABLE_BINVALUES[MAXPAR][MAXBIN];  // bin-centered values like HBOOK
+double *TABLE_BINVALUES[MAXPAR];  // bin-centered values like HBOOK
 
-double P_UNFOLD[MAXBIN][MAXBIN] ;       // Eq D2 unfolding function
-double P0_UNFOLD[MAXBIN][MAXBIN] ;      // initial guess of P_UNFOLD
-double PSIM_SUM[MAXZBIN][MAXBIN][MAXBIN];  // used to normalize each Psim
+double **P_UNFOLD ;       // [i1][i2] Eq D2 unfolding function
+double **P0_UNFOLD ;      // [i1][i2] initial guess of P_UNFOLD
+double  *PSIM_SUM ;       // [INDEX] used to normalize each Psim
 
+double **PZ_UNFOLD ;      // [iz][i1*NB2+i2] P_UNFOLD sum per gen z-bin
+double  *PZSUM_UNFOLD ;   // [iz] sum of PZ_UNFOLD per gen z-bin
 
 double P_UNFOLD_RENORM;            // global renorm factor
 double PSUM_UNFOLD;                // sum of P_UNFOLD
 
 
-#define MAXMIGBIN 300
+#define NMIGBIN_REALLOC 20  // realloc increment for migration lists
 typedef struct MIGRATION_TABLE_DEF {
-  short int NMIGBIN ;               // number of bins stored
+  int   NMIGBIN ;                   // number of bins stored
+  int   NMIGBIN_ALLOC ;             // number of bins allocated
   float CONTAIN_FRAC ;              // contain fraction (ideal=100%)
 
-  short int IBINZ_NEAR[MAXMIGBIN];  // underlying bin index
-  short int IBIN1_NEAR[MAXMIGBIN];  // underlying bin index
-  short int IBIN2_NEAR[MAXMIGBIN];  // idem
-  double    NSIMFIT_NEAR[MAXMIGBIN];  // SIMACC entries in this bin
-  double    NSIMFIT_NEAR_SUM;
+  int    *IBINZ_NEAR;     // underlying bin index
+  int    *IBIN1_NEAR;     // underlying bin index
+  int    *IBIN2_NEAR;     // idem
+  double *NSIMFIT_NEAR;   // SIMACC entries in this bin
+  double  NSIMFIT_NEAR_SUM;
 } MIGRATION_TABLE_DEF;
 
+// Oct 2026: sparse migration matrix in CSR layout, built once from
+// MIGRATION_TABLE. ROW and COL are 1D bin INDEX; VAL = NSIMFIT/NSIMGEN.
+// CSR_GEN rows are generated bins; CSR_FIT is the transpose.
+typedef struct {
+  int     NROW, NNZ ;
+  int    *ROWPTR ;   // [NROW+1]
+  int    *COL ;      // [NNZ]
+  double *VAL ;      // [NNZ]
+} CSR_MIGRATION_DEF ;
+
+CSR_MIGRATION_DEF CSR_GEN, CSR_FIT ;
+
+void extend_MIGRATION_TABLE(int NMIG_NEED, MIGRATION_TABLE_DEF *MIG);
+
+typedef struct {
+  int OPT, id_thread, nthread ;
+} THREAD_UNFOLD_DEF ;
+
 MIGRATION_TABLE_DEF ***MIGRATION_TABLE;
 MIGRATION_TABLE_DEF **MIGRATION_TABLE_SUMZ;
 
@@ -285,6 +335,9 @@ int main(int argc, char **argv) {
   fill_TABLE(ITYPE_SIMFIT);
   fill_TABLE(ITYPE_SIMACC); 
 
+  // compress migration tables into sparse matrices
+  build_MIGRATION_CSR();
+
 
   // --------------------------------
   //  prep_bindump();
@@ -359,6 +412,7 @@ void rd_input(void) {
   INPUTS.DOMIGRATION_FLAG = 1 ;  // default = 1
   INPUTS.MIGBIN_RADIUS    = 100.0 ;
   INPUTS.NMIGPLOT         = 0 ;
+  INPUTS.NTHREAD          = 1 ;
 
   INPUTS.NPAR = 2; // fixed for now ... 
 
@@ -404,6 +458,9 @@ void rd_input(void) {
     if ( strcmp(c_get,"N_ITERATION:") == 0 ) 
       readint(fp, 1, &INPUTS.N_ITERATION );
 
+    if ( strcmp(c_get,"NTHREAD:") == 0 ) 
+      readint(fp, 1, &INPUTS.NTHREAD );
+
 
     if ( strcmp(c_get,"BINDUMP:") == 0 ) {
       NTMP = INPUTS.NBINDUMP ;
@@ -540,6 +597,7 @@ void rd_input(void) {
   printf(" -------- \n");
   printf("  MIGRATION-BIN STORAGE RADIUS: %5.1f \n", INPUTS.MIGBIN_RADIUS);
   printf("  Number of MIGRATION-BIN plots: %d \n", INPUTS.NMIGPLOT );
+  printf("  Number of threads over z-bins: %d \n", INPUTS.NTHREAD );
 
   printf("\n Done reading input file. \n\n");
 
@@ -583,6 +641,10 @@ void  unfold_input_override(void) {
       i++ ; sscanf(ARGV_LIST[i] , "%d", &INPUTS.N_ITERATION );
     }
 
+    if ( strcmp( ARGV_LIST[i], "NTHREAD" ) == 0 ) {
+      i++ ; sscanf(ARGV_LIST[i] , "%d", &INPUTS.NTHREAD );
+    }
+
 
     // -------------------
     if ( i > ilast ) {
@@ -599,10 +661,12 @@ void  unfold_input_override(void) {
 // =============================
 void init_unfold(void) {
   // init binned table array
+  // Oct 2026: malloc all bin arrays based on NBIN_PAR
 
   int NBZ = INPUTS.NBIN_PAR[IPAR_Z];
   int NB1 = INPUTS.NBIN_PAR[IPAR_1];
   int NB2 = INPUTS.NBIN_PAR[IPAR_2];
+  int NBTOT = NBZ * NB1 * NB2 ;
   int iz, i1, i2, itype, j ;
   char fnam[] = "init_unfold";
 
@@ -610,20 +674,55 @@ void init_unfold(void) {
 
   print_banner(fnam);
 
+  double DMEMTABLE = 0.0;
+  long long MEMTOT = (long long)NBTOT * sizeof(double);
+
   PSUM_UNFOLD = 0.0 ;
   for ( itype=0; itype < MAXTYPE; itype++ ) {
-    TABLE[itype].N_OVERFLOW = 0. ;
-    TABLE[itype].N_FILLED   = 0. ;
-    for ( j=0; j < MAXBINTOT; j++ ) { 
+    TABLE[itype].N_OVERFLOW   = 0. ;
+    TABLE[itype].N_FILLED     = 0. ;
+    TABLE[itype].ENTRIES      = (double*) malloc(MEMTOT);
+    TABLE[itype].ENTRIES_SUMZ = (double*) malloc(MEMTOT);
+    DMEMTABLE += 2.0*(double)MEMTOT ;
+    for ( j=0; j < NBTOT; j++ ) { 
       TABLE[itype].ENTRIES[j]      = 0.0 ; 
       TABLE[itype].ENTRIES_SUMZ[j] = 0.0 ; 
     }
   } // end itype
 
+  // - - - - - -
+  // malloc index maps and unfolding arrays
+
+  INDEXMAP     = (int***) malloc(NBZ * sizeof(int**) );
+  INDEXMAP_INV = (struct INDEXMAP_INV*) 
+    malloc(NBTOT * sizeof(struct INDEXMAP_INV) );
+  for(iz=0; iz < NBZ; iz++ ) {
+    INDEXMAP[iz] = (int**) malloc(NB1 * sizeof(int*) );
+    for(i1=0; i1 < NB1; i1++ ) 
+      { INDEXMAP[iz][i1] = (int*) malloc(NB2 * sizeof(int) ); }
+  }
+  DMEMTABLE += (double)NBTOT * (sizeof(int)+sizeof(struct INDEXMAP_INV));
+
+  // 2D arrays with contiguous storage
+  P_UNFOLD     = (double**) malloc(NB1 * sizeof(double*) );
+  P0_UNFOLD    = (double**) malloc(NB1 * sizeof(double*) );
+  P_UNFOLD[0]  = (double* ) malloc(NB1 * NB2 * sizeof(double) );
+  P0_UNFOLD[0] = (double* ) malloc(NB1 * NB2 * sizeof(double) );
+  for(i1=1; i1 < NB1; i1++ ) {
+    P_UNFOLD[i1]  = P_UNFOLD[0]  + i1*NB2 ;
+    P0_UNFOLD[i1] = P0_UNFOLD[0] + i1*NB2 ;
+  }
+
+  PSIM_SUM     = (double*) malloc(MEMTOT);
+  PZSUM_UNFOLD = (double*) malloc(NBZ * sizeof(double) );
+  PZ_UNFOLD    = (double**) malloc(NBZ * sizeof(double*) );
+  for(iz=0; iz < NBZ; iz++ ) 
+    { PZ_UNFOLD[iz] = (double*) malloc(NB1 * NB2 * sizeof(double) ); }
+  DMEMTABLE += 2.0 * (double)MEMTOT ;
+
   // - - - - - -
   // malloc migration tables
 
-  double DMEMTABLE = 0.0;
   int MEMz = NBZ * sizeof(MIGRATION_TABLE_DEF**);
   int MEM1 = NB1 * sizeof(MIGRATION_TABLE_DEF*);
   int MEM2 = NB2 * sizeof(MIGRATION_TABLE_DEF);
@@ -646,10 +745,20 @@ void init_unfold(void) {
     DMEMTABLE += (double)MEM2;
   }
   
-  printf("\t Malloc Migration table size: %.3f MB\n", DMEMTABLE/1.0E6);
+  printf("\t Malloc bin arrays and Migration table size: %.3f MB\n", 
+	 DMEMTABLE/1.0E6);
   fflush(stdout);
 
   // - - - - - - 
+  // migration lists are malloc'ed as needed in fill_MIGRATION_TABLE
+
+  MIGRATION_TABLE_DEF MIG_EMPTY ;
+  MIG_EMPTY.NMIGBIN          = 0 ;
+  MIG_EMPTY.NMIGBIN_ALLOC    = 0 ;
+  MIG_EMPTY.CONTAIN_FRAC     = 0.0 ;
+  MIG_EMPTY.NSIMFIT_NEAR_SUM = 0.0 ;
+  MIG_EMPTY.IBINZ_NEAR = MIG_EMPTY.IBIN1_NEAR = MIG_EMPTY.IBIN2_NEAR = NULL;
+  MIG_EMPTY.NSIMFIT_NEAR = NULL ;
 
   for ( iz=0; iz < NBZ; iz++ ) {
     for ( i1=0; i1 < NB1; i1++ ) {
@@ -658,26 +767,16 @@ void init_unfold(void) {
 	if ( iz == 0 ) {
 	  P_UNFOLD[i1][i2]     = 0.0 ;
 	  P0_UNFOLD[i1][i2]    = 1.0 ;  
-	  MIGRATION_TABLE_SUMZ[i1][i2].NMIGBIN      = 0 ;
-	  MIGRATION_TABLE_SUMZ[i1][i2].CONTAIN_FRAC = 0.0 ;
-	  MIGRATION_TABLE_SUMZ[i1][i2].NSIMFIT_NEAR_SUM = 0.0 ;
+	  MIGRATION_TABLE_SUMZ[i1][i2] = MIG_EMPTY ;
 	}
  
-	PSIM_SUM[iz][i1][i2]                     = 0.0 ;
-	MIGRATION_TABLE[iz][i1][i2].NMIGBIN      = 0 ;
-	MIGRATION_TABLE[iz][i1][i2].CONTAIN_FRAC = 0.0 ;
-	MIGRATION_TABLE[iz][i1][i2].NSIMFIT_NEAR_SUM  = 0.0 ;
-
-
-	for ( j=0; j<MAXMIGBIN; j++ ) {
-	  MIGRATION_TABLE[iz][i1][i2].NSIMFIT_NEAR[j] = 0.0 ;
-	  MIGRATION_TABLE_SUMZ[i1][i2].NSIMFIT_NEAR[j] = 0.0 ;
-	}
-
+	MIGRATION_TABLE[iz][i1][i2] = MIG_EMPTY ;
       }
     }
   }   // end iz loop
 
+  for ( j=0; j < NBTOT; j++ ) { PSIM_SUM[j] = 0.0 ; }
+
 }  // end of init_unfold
 
 
@@ -688,7 +787,7 @@ void SET_TABLEBINS(char *string, int ipar) {
 
   double xmin,  xmax, xbin, tmp, xi;
   char fnam[20] = "SET_TABLEBINS" ;
-  int NBIN, NBIN_MAX, ibin ;
+  int NBIN, ibin ;
 
   // --------- BEGIN ---------
 
@@ -696,11 +795,6 @@ void SET_TABLEBINS(char *string, int ipar) {
   xmax = INPUTS.RANGE_PAR[ipar][1] ;
   xbin = INPUTS.BINSIZE_PAR[ipar] ;
 
-  if ( ipar == IPAR_Z ) 
-    { NBIN_MAX = MAXZBIN ; }
-  else
-    { NBIN_MAX = MAXBIN ; }
-
   if ( xbin <= 0.0 ) {
     sprintf(c1err,"Invalid binsize=%f for %s", xbin, string);
     sprintf(c2err,"Check user input file. ");
@@ -710,13 +804,14 @@ void SET_TABLEBINS(char *string, int ipar) {
   tmp = (xmax - xmin)/ xbin ;
   NBIN = (int)(tmp+0.000001);
   NBIN = INPUTS.NBIN_PAR[ipar] = NBIN;
-  if ( NBIN >= NBIN_MAX ) {
-    sprintf(c1err,"NBIN=%d exceeds array bound for %s", NBIN, string);
+  if ( NBIN <= 0 ) {
+    sprintf(c1err,"Invalid NBIN=%d for %s", NBIN, string);
     sprintf(c2err,"Check user input file. ");
     errmsg(SEV_FATAL, 0, fnam, c1err, c2err); 
   }
 
   // set TABLE_BINVALUES
+  TABLE_BINVALUES[ipar] = (double*) malloc(NBIN * sizeof(double) );
 
   for ( ibin=0; ibin < NBIN; ibin++ ) {
     xi = (double)ibin ;
@@ -741,8 +836,6 @@ void SET_INDEXMAP(void) {
   int NBZ, NB1, NB2; 
   int IZ,  IB1, IB2, INDEX ;
 
-  char fnam[20] = "SET_INDEXMAP";
-
   // ----------- BEGIN ------------
 
   print_banner("Set INDEXMAP pointers");
@@ -757,12 +850,6 @@ void SET_INDEXMAP(void) {
     for ( IB1=0; IB1 < NB1; IB1++ ) {
       for ( IB2=0; IB2 < NB2; IB2++ ) {           
 
-	if ( INDEX >= MAXBINTOT ) {
-	  sprintf(c1err,"INDEXMAP = %d exceeds array bound.", INDEX);
-	  sprintf(c2err,"Check parameter MAXBINTOT");
-	  errmsg(SEV_FATAL, 0, fnam, c1err, c2err ); 
-	}
-
 	INDEXMAP[IZ][IB1][IB2] = INDEX;
 	INDEXMAP_INV[INDEX].IZ = IZ ;
 	INDEXMAP_INV[INDEX].I1 = IB1 ;
@@ -967,11 +1054,10 @@ void fill_TABLE(int itype) {
 
     iz = ibin[IPAR_Z];   i1 = ibin[IPAR_1];    i2 = ibin[IPAR_2] ;
 
-    INDEX      = INDEXMAP[iz][i1][i2] ;
-    INDEX_SUMZ = INDEXMAP[0][i1][i2] ;
-
+    WGTGEN = 1.0;
     if ( ISVALID  ) {
-      WGTGEN = 1.0;
+      INDEX      = INDEXMAP[iz][i1][i2] ;
+      INDEX_SUMZ = INDEXMAP[0][i1][i2] ;
       TABLE[itype].ENTRIES[INDEX]           += WGTGEN ;
       TABLE[itype].ENTRIES_SUMZ[INDEX_SUMZ] += WGTGEN ;
       TABLE[itype].N_FILLED                 += WGTGEN ;
@@ -1100,6 +1186,7 @@ void fill_MIGRATION_TABLE(int IZACC, int IB1ACC, int IB2ACC,
 
   if ( IFIT_USED < 0 ) {
     IFIT_USED = NMIGBIN ;
+    extend_MIGRATION_TABLE(NMIGBIN+1, &MIGRATION_TABLE[IZACC][IB1ACC][IB2ACC]);
     MIGRATION_TABLE[IZACC][IB1ACC][IB2ACC].NMIGBIN = NMIGBIN+1 ;
     MIGRATION_TABLE[IZACC][IB1ACC][IB2ACC].IBINZ_NEAR[NMIGBIN] = IZFIT ;
     MIGRATION_TABLE[IZACC][IB1ACC][IB2ACC].IBIN1_NEAR[NMIGBIN] = IB1FIT ;
@@ -1108,13 +1195,6 @@ void fill_MIGRATION_TABLE(int IZACC, int IB1ACC, int IB2ACC,
     if ( LDMP ) printf("\t NMIGBIN=%d for IZ,IB1,IunfoB2(FIT)=%d,%d,%d \n",
 		       NMIGBIN, IZFIT, IB1FIT,IB2FIT );
 
-    if ( NMIGBIN >= MAXMIGBIN ) {
-      sprintf(c1err,"NMIGBIN=%d exceeds array bound for", NMIGBIN);
-      sprintf(c2err,"IZ,I1,I2(ACC)=%d %d %d   IZ,I1,I2(FIT)=%d %d %d ",
-	      IZACC, IB1ACC, IB2ACC,  IZFIT, IB1FIT, IB2FIT );
-      errmsg(SEV_FATAL, 0, fnam, c1err, c2err); 
-    }
-
     /*
     printf(" xxx %s(%d,%d,%d): increment NMIGBIN = %d \n", 
 	   fnam, IZACC, IB1ACC, IB2ACC, NMIGBIN+1); fflush(stdout);
@@ -1135,6 +1215,7 @@ void fill_MIGRATION_TABLE(int IZACC, int IB1ACC, int IB2ACC,
   MIGRATION_TABLE[IZACC][IB1ACC][IB2ACC].NSIMFIT_NEAR_SUM        += WGTGEN ;
 
   // sum over z-bins 
+  extend_MIGRATION_TABLE(IFIT_USED+1, &MIGRATION_TABLE_SUMZ[IB1ACC][IB2ACC]);
   MIGRATION_TABLE_SUMZ[IB1ACC][IB2ACC].NSIMFIT_NEAR[IFIT_USED] += WGTGEN ;
   MIGRATION_TABLE_SUMZ[IB1ACC][IB2ACC].NSIMFIT_NEAR_SUM        += WGTGEN ;
 
@@ -1160,10 +1241,139 @@ void fill_MIGRATION_TABLE(int IZACC, int IB1ACC, int IB2ACC,
 } // end of fill_MIGRATION_TABLE
 
 
+// ===================================
+void extend_MIGRATION_TABLE(int NMIG_NEED, MIGRATION_TABLE_DEF *MIG) {
+
+  // Created Oct 2026
+  // Make sure migration lists in *MIG hold at least NMIG_NEED bins;
+  // realloc in steps of NMIGBIN_REALLOC and zero new NSIMFIT_NEAR.
+
+  int NALLOC_OLD = MIG->NMIGBIN_ALLOC ;
+  int NALLOC, j ;
+  int MEMI, MEMD ;
+
+  // ------------ BEGIN ------------
+
+  if ( NMIG_NEED <= NALLOC_OLD ) { return ; }
+
+  NALLOC = NALLOC_OLD + NMIGBIN_REALLOC ;
+  if ( NALLOC < NMIG_NEED ) { NALLOC = NMIG_NEED ; }
+  MEMI = NALLOC * sizeof(int);
+  MEMD = NALLOC * sizeof(double);
+
+  MIG->IBINZ_NEAR   = (int*)   realloc(MIG->IBINZ_NEAR,   MEMI);
+  MIG->IBIN1_NEAR   = (int*)   realloc(MIG->IBIN1_NEAR,   MEMI);
+  MIG->IBIN2_NEAR   = (int*)   realloc(MIG->IBIN2_NEAR,   MEMI);
+  MIG->NSIMFIT_NEAR = (double*)realloc(MIG->NSIMFIT_NEAR, MEMD);
+
+  for ( j=NALLOC_OLD; j < NALLOC; j++ ) { MIG->NSIMFIT_NEAR[j] = 0.0 ; }
+  MIG->NMIGBIN_ALLOC = NALLOC ;
+
+  return ;
+
+} // end extend_MIGRATION_TABLE
+
+
+// ===================================
+void build_MIGRATION_CSR(void) {
+
+  // Created Oct 2026
+  // Compress MIGRATION_TABLE into sparse CSR_GEN (row = generated bin)
+  // and its transpose CSR_FIT (row = fitted bin).
+  // Only generated bins with SIMGEN and SIMACC entries are stored,
+  // and VAL = NSIMFIT/NSIMGEN is the migration probability PSIM.
+  // Rows are 1D INDEX, so each z-bin is a contiguous block of rows.
+
+  int NROW = NBINTOT ;
+  int IZ, IB1, IB2, INDEX, index, imig, NMIGBIN, k, NNZ ;
+  int *NFILL ;
+  double XGEN, XACC, PSIM ;
+  MIGRATION_TABLE_DEF *MIG ;
+  char fnam[] = "build_MIGRATION_CSR" ;
+
+  // ------------ BEGIN ------------
+
+  CSR_GEN.NROW = CSR_FIT.NROW = NROW ;
+  CSR_GEN.ROWPTR = (int*) malloc( (NROW+1) * sizeof(int) );
+  CSR_FIT.ROWPTR = (int*) malloc( (NROW+1) * sizeof(int) );
+  NFILL          = (int*) malloc( (NROW+1) * sizeof(int) );
+  for ( INDEX=0; INDEX <= NROW; INDEX++ ) 
+    { CSR_GEN.ROWPTR[INDEX] = CSR_FIT.ROWPTR[INDEX] = NFILL[INDEX] = 0; }
+
+  // 1st pass: count non-zero elements per GEN and FIT row
+  for ( INDEX=0; INDEX < NROW; INDEX++ ) {
+    IZ  = INDEXMAP_INV[INDEX].IZ ;
+    IB1 = INDEXMAP_INV[INDEX].I1 ;
+    IB2 = INDEXMAP_INV[INDEX].I2 ;
+    XGEN = TABLE[ITYPE_SIMGEN].ENTRIES[INDEX] ;
+    XACC = TABLE[ITYPE_SIMACC].ENTRIES[INDEX] ;
+    if ( XGEN <= 0.0 || XACC <= 0.0 ) { continue; }
+
+    MIG = &MIGRATION_TABLE[IZ][IB1][IB2] ;
+    NMIGBIN = MIG->NMIGBIN ;
+    CSR_GEN.ROWPTR[INDEX+1] = NMIGBIN ;
+    for ( imig=0; imig < NMIGBIN; imig++ ) {
+      index = INDEXMAP[MIG->IBINZ_NEAR[imig]]
+	[MIG->IBIN1_NEAR[imig]][MIG->IBIN2_NEAR[imig]] ;
+      CSR_FIT.ROWPTR[index+1]++ ;
+    }
+  }
+
+  for ( INDEX=0; INDEX < NROW; INDEX++ ) {
+    CSR_GEN.ROWPTR[INDEX+1] += CSR_GEN.ROWPTR[INDEX] ;
+    CSR_FIT.ROWPTR[INDEX+1] += CSR_FIT.ROWPTR[INDEX] ;
+  }
+
+  NNZ = CSR_GEN.NNZ = CSR_FIT.NNZ = CSR_GEN.ROWPTR[NROW] ;
+  CSR_GEN.COL = (int*)    malloc( (NNZ+1) * sizeof(int) );
+  CSR_GEN.VAL = (double*) malloc( (NNZ+1) * sizeof(double) );
+  CSR_FIT.COL = (int*)    malloc( (NNZ+1) * sizeof(int) );
+  CSR_FIT.VAL = (double*) malloc( (NNZ+1) * sizeof(double) );
+
+  // 2nd pass: fill; GEN rows are visited in order, so FIT rows
+  // end up sorted by GEN index.
+  for ( INDEX=0; INDEX < NROW; INDEX++ ) {
+    if ( CSR_GEN.ROWPTR[INDEX+1] == CSR_GEN.ROWPTR[INDEX] ) { continue; }
+    IZ  = INDEXMAP_INV[INDEX].IZ ;
+    IB1 = INDEXMAP_INV[INDEX].I1 ;
+    IB2 = INDEXMAP_INV[INDEX].I2 ;
+    XGEN = TABLE[ITYPE_SIMGEN].ENTRIES[INDEX] ;
+    MIG  = &MIGRATION_TABLE[IZ][IB1][IB2] ;
+
+    for ( imig=0; imig < MIG->NMIGBIN; imig++ ) {
+      index = INDEXMAP[MIG->IBINZ_NEAR[imig]]
+	[MIG->IBIN1_NEAR[imig]][MIG->IBIN2_NEAR[imig]] ;
+      PSIM  = MIG->NSIMFIT_NEAR[imig] / XGEN ;
+
+      k = CSR_GEN.ROWPTR[INDEX] + imig ;
+      CSR_GEN.COL[k] = index ;
+      CSR_GEN.VAL[k] = PSIM ;
+
+      k = CSR_FIT.ROWPTR[index] + NFILL[index] ;
+      CSR_FIT.COL[k] = INDEX ;
+      CSR_FIT.VAL[k] = PSIM ;
+      NFILL[index]++ ;
+    }
+  }
+
+  free(NFILL);
+
+  printf("  %s: %d non-zero migration elements for %d bins (%.3f MB)\n",
+	 fnam, NNZ, NROW, 
+	 2.0*(double)NNZ*(sizeof(int)+sizeof(double))/1.0E6 );
+  fflush(stdout);
+
+  return ;
+
+} // end build_MIGRATION_CSR
+
+
 // ======================================
 void GENBIN_LOOP(int OPT) {
 
   // loop over generation bins and call function based on input OPT
+  // Oct 2026: PSIM_ADD and UNFOLD_ADD loop over z-bins (threads)
+  //           using sparse CSR migration matrices.
 
   int IZ, IBIN1, IBIN2, NBZ, NB1, NB2;
   char fnam[] = "GENBIN_LOOP" ;
@@ -1178,6 +1388,9 @@ void GENBIN_LOOP(int OPT) {
 
   printf("\t %s(%s) \n", fnam, STRING_OPT_UNFOLD[OPT] );
 
+  if ( OPT == OPT_PSIM_ADD || OPT == OPT_UNFOLD_ADD ) 
+    { UNFOLD_THREAD_EXEC(OPT);  return ; }
+
   // -----------
 
   for ( IZ=0; IZ < NBZ; IZ++ ) {
@@ -1187,12 +1400,6 @@ void GENBIN_LOOP(int OPT) {
 	if ( OPT == OPT_UNFOLD_ZERO ) 
 	  { UNFOLD_ZERO(IZ,IBIN1,IBIN2) ; }
 
-	else if ( OPT == OPT_PSIM_ADD )
-	  { PSIM_ADD(IZ,IBIN1,IBIN2) ; }
-
-	else if ( OPT == OPT_UNFOLD_ADD )
-	  { UNFOLD_ADD(IZ,IBIN1,IBIN2) ; }
-
 	else if ( OPT == OPT_UNFOLD_RENORM ) 
 	  { UNFOLD_RENORM(IBIN1,IBIN2); }
 
@@ -1203,48 +1410,149 @@ void GENBIN_LOOP(int OPT) {
 
 } // end of LOOPSHELL
 
-// =======================================
-void PSIM_ADD (int IZ, int IBIN1, int IBIN2) {
 
-  // Fill PSIM_SUM to use in unfolding equation.
-  // IBIN1, IBIN2 refer to generated values
-  // ibin1, ibin2 refer to measured (fitted) values
+// ======================================
+void UNFOLD_THREAD_EXEC(int OPT) {
+
+  // Created Oct 2026
+  // Process PSIM_ADD or UNFOLD_ADD for all z-bins, with z-bins 
+  // split among INPUTS.NTHREAD threads. NTHREAD=1 does not use pthread.
+  // For UNFOLD_ADD, per-z sums are added to P_UNFOLD in z-order
+  // after all threads finish, so that results don't depend on NTHREAD.
+
+  int NBZ     = INPUTS.NBIN_PAR[IPAR_Z];
+  int NB1     = INPUTS.NBIN_PAR[IPAR_1];
+  int NB2     = INPUTS.NBIN_PAR[IPAR_2];
+  int nthread = INPUTS.NTHREAD ;
+  int t, iz, i1, i2, rc, NERR ;
+  THREAD_UNFOLD_DEF *thread_unfold ;
+#ifdef USE_THREAD
+  pthread_t *thread ;
+#endif
+  char fnam[] = "UNFOLD_THREAD_EXEC" ;
+
+  // --------- BEGIN ----------
+
+  if ( nthread < 1   ) { nthread = 1;   }
+  if ( nthread > NBZ ) { nthread = NBZ; }
+#ifndef USE_THREAD
+  nthread = 1;
+#endif
+
+  thread_unfold = (THREAD_UNFOLD_DEF*)
+    malloc(nthread * sizeof(THREAD_UNFOLD_DEF) );
+#ifdef USE_THREAD
+  thread = (pthread_t*) malloc(nthread * sizeof(pthread_t) );
+#endif
+
+  for ( t=0; t < nthread; t++ ) {
+    thread_unfold[t].OPT       = OPT ;
+    thread_unfold[t].id_thread = t ;
+    thread_unfold[t].nthread   = nthread ;
+
+    if ( nthread == 1 ) 
+      { UNFOLD_THREAD(&thread_unfold[t]); }
+#ifdef USE_THREAD
+    else {
+      rc = pthread_create(&thread[t], NULL, UNFOLD_THREAD, 
+			  &thread_unfold[t] ) ; 
+    }
+#endif
+  }
 
-  int iz, ibin1, ibin2, NMIGBIN, imig;
-  int i, INDEX, IFLAG_DUMP ;
-  double PSIM, XFIT, XGEN, XACC, P0 ;
+#ifdef USE_THREAD
+  if ( nthread > 1 ) {
+    NERR = 0 ;
+    for ( t = 0; t < nthread; t++ ) { 
+      rc = pthread_join(thread[t], NULL); 
+      if ( rc != 0 ) {
+	NERR++; 
+	printf(" ERROR: thread return errcode=%d for t=%d\n", rc,t); }
+    }
+    if ( NERR > 0 ) {
+      sprintf(c1err,"%d thread return code errors", NERR);
+      sprintf(c2err,"for %s", STRING_OPT_UNFOLD[OPT] );
+      errmsg(SEV_FATAL, 0, fnam, c1err, c2err); 
+    }
+  }
+  free(thread);
+#endif
+
+  free(thread_unfold);
+
+  // - - - - - - - 
+  // reduce per-z sums for UNFOLD_ADD
+  if ( OPT == OPT_UNFOLD_ADD ) {
+    for ( iz=0; iz < NBZ; iz++ ) {
+      for ( i1=0; i1 < NB1; i1++ ) {
+	for ( i2=0; i2 < NB2; i2++ ) 
+	  { P_UNFOLD[i1][i2] += PZ_UNFOLD[iz][i1*NB2+i2] ; }
+      }
+      PSUM_UNFOLD += PZSUM_UNFOLD[iz] ;
+    }
 
-  // --------------- BEGIN ----------------
+    UNFOLD_DUMP();
+  }
+
+  return ;
 
-  // bail if there are no generated events here
+} // end UNFOLD_THREAD_EXEC
 
-  INDEX = INDEXMAP[IZ][IBIN1][IBIN2] ;
-  XGEN  = TABLE[ITYPE_SIMGEN].ENTRIES[INDEX] ;
-  XACC  = TABLE[ITYPE_SIMACC].ENTRIES[INDEX] ;
-  if ( XGEN <= 0.  ) return ;
-  if ( XACC <= 0.  ) return ;
 
-  P0 = P0_UNFOLD[IBIN1][IBIN2] ; // initial/last guess
+// ======================================
+void *UNFOLD_THREAD(void *thread_arg) {
 
-  // loop over migration bins 
-  NMIGBIN = MIGRATION_TABLE[IZ][IBIN1][IBIN2].NMIGBIN;
+  // Created Oct 2026
+  // Process every nthread'th z-bin starting at z-bin = id_thread.
 
-  for ( imig=0; imig < NMIGBIN ; imig++ ) {
+  THREAD_UNFOLD_DEF *thread_unfold = (THREAD_UNFOLD_DEF*)thread_arg ;
+  int NBZ     = INPUTS.NBIN_PAR[IPAR_Z];
+  int OPT     = thread_unfold->OPT ;
+  int nthread = thread_unfold->nthread ;
+  int IZ ;
 
-    XFIT = MIGRATION_TABLE[IZ][IBIN1][IBIN2].NSIMFIT_NEAR[imig];
-    PSIM = XFIT / XGEN ;      
+  // --------- BEGIN ----------
 
-    // extract fitted indices
-    iz      = MIGRATION_TABLE[IZ][IBIN1][IBIN2].IBINZ_NEAR[imig] ;
-    ibin1   = MIGRATION_TABLE[IZ][IBIN1][IBIN2].IBIN1_NEAR[imig] ;
-    ibin2   = MIGRATION_TABLE[IZ][IBIN1][IBIN2].IBIN2_NEAR[imig] ;
+  for ( IZ = thread_unfold->id_thread; IZ < NBZ; IZ += nthread ) {
+    if ( OPT == OPT_PSIM_ADD )
+      { PSIM_ADD_ZBIN(IZ); }
+    else if ( OPT == OPT_UNFOLD_ADD )
+      { UNFOLD_ADD_ZBIN(IZ); }
+  }
 
-    PSIM_SUM[iz][ibin1][ibin2] += (PSIM*P0) ;
-    
-  } // end of imig loop
+  return NULL ;
 
+} // end UNFOLD_THREAD
 
-} // end of PSIM_ADD
+
+// =======================================
+void PSIM_ADD_ZBIN(int IZ) {
+
+  // Oct 2026: refactor of PSIM_ADD(IZ,IBIN1,IBIN2) 
+  // Fill PSIM_SUM to use in unfolding equation for each fitted 
+  // (measured) bin in z-bin IZ, by summing the transposed migration
+  // matrix over generated bins: PSIM_SUM = sum_gen PSIM * P0(gen).
+  // Each thread writes only its own PSIM_SUM rows.
+
+  int NB12   = INPUTS.NBIN_PAR[IPAR_1] * INPUTS.NBIN_PAR[IPAR_2];
+  int INDEX0 = IZ * NB12 ;
+  int index, k, k1 ;
+  double SUM ;
+  struct INDEXMAP_INV *INV ;
+
+  // --------------- BEGIN ----------------
+
+  for ( index = INDEX0; index < INDEX0 + NB12; index++ ) {
+    SUM = 0.0 ;
+    k1  = CSR_FIT.ROWPTR[index+1] ;
+    for ( k = CSR_FIT.ROWPTR[index]; k < k1; k++ ) {
+      INV   = &INDEXMAP_INV[CSR_FIT.COL[k]] ; // generated bin
+      SUM  += CSR_FIT.VAL[k] * P0_UNFOLD[INV->I1][INV->I2] ;
+    }
+    PSIM_SUM[index] = SUM ;
+  }
+
+} // end of PSIM_ADD_ZBIN
 
 
 // ==================================
@@ -1252,7 +1560,11 @@ void UNFOLD_ZERO(int IZ, int IBIN1, int IBIN2 ) {
 
   // zero out arrays before starting another iteration
 
-  PSIM_SUM[IZ][IBIN1][IBIN2] = 0.0 ;
+  int INDEX = INDEXMAP[IZ][IBIN1][IBIN2] ;
+  PSIM_SUM[INDEX] = 0.0 ;
+  PZ_UNFOLD[IZ][IBIN1*INPUTS.NBIN_PAR[IPAR_2]+IBIN2] = 0.0 ;
+
+  if ( IBIN1 == 0 && IBIN2 == 0 ) { PZSUM_UNFOLD[IZ] = 0.0 ; }
 
   if ( IZ == 0 ) {
     P_UNFOLD[IBIN1][IBIN2]  = 0.0 ;
@@ -1278,96 +1590,130 @@ void UNFOLD_RENORM(int IBIN1, int IBIN2 ) {
 } // end of UNFOLD_RENORM
 
 // =======================================
-void UNFOLD_ADD (int IZ, int IBIN1, int IBIN2) {
-
+void UNFOLD_ADD_ZBIN(int IZ) {
+
+  // Oct 2026: refactor of UNFOLD_ADD(IZ,IBIN1,IBIN2) to process all
+  // generated bins in z-bin IZ using sparse CSR_GEN rows.
+  // Results go to PZ_UNFOLD[IZ] and PZSUM_UNFOLD[IZ] so that threads
+  // never write the same memory; UNFOLD_THREAD_EXEC sums over z.
+  // Bin dumps are done afterwards in UNFOLD_DUMP.
+  //
   // IBIN1, IBIN2 refer to generated values
-  // ibin1, ibin2 refer to measured (fitted) values
+  // index refers to measured (fitted) bin
 
-  int iz, ibin1, ibin2, INDEX, index, NMIGBIN, imig, i ,IFLAG_DUMP ;
-  double PSIM, P0, PSIM_WGT, EFFSIM ;
-  double XDATA, XGEN, XFIT, XTMP, XACC, PROB_MIG, PRODUCT    ;
-  char fnam[] = "UNFOLD_ADD";
+  int NB2    = INPUTS.NBIN_PAR[IPAR_2];
+  int NB12   = INPUTS.NBIN_PAR[IPAR_1] * NB2 ;
+  int INDEX0 = IZ * NB12 ;
+  int INDEX, index, IBIN1, IBIN2, k, k1 ;
+  double PSIM, P0, PSIM_WGT, EFFSIM, SUM ;
+  double XDATA, XGEN, XACC, PROB_MIG, PRODUCT    ;
+  double *PZ = PZ_UNFOLD[IZ] ;
+  char fnam[] = "UNFOLD_ADD_ZBIN";
 
   // --------------- BEGIN ----------------
 
-  // bail if there are no generated events here
+  SUM = 0.0 ;
 
-  INDEX = INDEXMAP[IZ][IBIN1][IBIN2] ;
-  XACC  = TABLE[ITYPE_SIMACC].ENTRIES[INDEX] ;
-  XGEN  = TABLE[ITYPE_SIMGEN].ENTRIES[INDEX] ;
-  if ( XGEN <= 0.0  ) return ;
-  if ( XACC <= 0.0  ) return ;
+  for ( INDEX = INDEX0; INDEX < INDEX0 + NB12; INDEX++ ) {
 
+    // bail if there are no generated events here
+    XACC  = TABLE[ITYPE_SIMACC].ENTRIES[INDEX] ;
+    XGEN  = TABLE[ITYPE_SIMGEN].ENTRIES[INDEX] ;
+    if ( XGEN <= 0.0  ) { continue ; }
+    if ( XACC <= 0.0  ) { continue ; }
 
-  EFFSIM = XACC / XGEN ; 
-  P0     = P0_UNFOLD[IBIN1][IBIN2] ; // initial/last guess
+    IBIN1  = INDEXMAP_INV[INDEX].I1 ;
+    IBIN2  = INDEXMAP_INV[INDEX].I2 ;
+    EFFSIM = XACC / XGEN ; 
+    P0     = P0_UNFOLD[IBIN1][IBIN2] ; // initial/last guess
 
-  // check for dump flag
-  IFLAG_DUMP = 0;
-  for ( i=0; i < INPUTS.NBINDUMP; i++ ) {
-    if ( IBIN1 == INPUTS.IBINDUMP[i][IPAR_1] &&
-	 IBIN2 == INPUTS.IBINDUMP[i][IPAR_2] &&
-	 IZ    == INPUTS.IBINDUMP[i][IPAR_Z] 
-	 ) {
-      IFLAG_DUMP = 1;  
-    }
-  }
+    // loop over migration bins 
+    k1 = CSR_GEN.ROWPTR[INDEX+1] ;
+    for ( k = CSR_GEN.ROWPTR[INDEX]; k < k1; k++ ) {
 
+      index   = CSR_GEN.COL[k] ;  // fitted bin
+      XDATA   = TABLE[ITYPE_DATA].ENTRIES[index] ;
+      if ( XDATA <= 0.0 ) { continue ; }
 
-  // init dump
-  if ( IFLAG_DUMP  ) { DMP_UNFOLD(IZ, IBIN1, IBIN2, -1 ); }
-  
+      PSIM = CSR_GEN.VAL[k] ;
 
-  // loop over migration bins 
-  NMIGBIN = MIGRATION_TABLE[IZ][IBIN1][IBIN2].NMIGBIN;
+      if ( INPUTS.DOMIGRATION_FLAG  )
+	{ PSIM_WGT = PSIM_SUM[index]; }
+      else
+	{ PSIM_WGT = 1.0 ; }
 
-  for ( imig=0; imig < NMIGBIN ; imig++ ) {
+      if ( PSIM_WGT <= 0.0 ) {
+	sprintf(c1err,"Invalid PSIM_WGT=%f at iz=%d ibin1=%d ibin2=%d",
+		PSIM_WGT, INDEXMAP_INV[index].IZ,
+		INDEXMAP_INV[index].I1, INDEXMAP_INV[index].I2 );
+	sprintf(c2err,"IBIN1=%d  IBIN2=%d", IBIN1, IBIN2 );
+	errmsg(SEV_FATAL, 0, fnam, c1err, c2err); 
+      }
+    
+      // See Eq. 3 of D'Agonstini NIM A 362, 487 (1995)
+      PROB_MIG = (PSIM * P0 / PSIM_WGT) ;  // P(C_i | E_j)
 
-    // ibin[1,2] are fitted bins
-    iz      = MIGRATION_TABLE[IZ][IBIN1][IBIN2].IBINZ_NEAR[imig] ;
-    ibin1   = MIGRATION_TABLE[IZ][IBIN1][IBIN2].IBIN1_NEAR[imig] ;
-    ibin2   = MIGRATION_TABLE[IZ][IBIN1][IBIN2].IBIN2_NEAR[imig] ;
+      // Eq. 4 of above
+      PRODUCT = XDATA * PROB_MIG / EFFSIM  ;
 
-    index   = INDEXMAP[iz][ibin1][ibin2] ; 
-    XDATA   = TABLE[ITYPE_DATA].ENTRIES[index] ;
-    if ( XDATA <= 0.0 ) { continue ; }
+      PZ[IBIN1*NB2+IBIN2] += PRODUCT ;
+      SUM += PRODUCT ;
 
-    if ( IFLAG_DUMP ) { DMP_UNFOLD(IZ, IBIN1, IBIN2, imig); }
+    } // end of k loop over migration bins
 
-    XFIT = MIGRATION_TABLE[IZ][IBIN1][IBIN2].NSIMFIT_NEAR[imig];
-    PSIM = XFIT / XGEN ;      
+    if ( !INPUTS.DOMIGRATION_FLAG  ) {
+      XDATA = TABLE[ITYPE_DATA].ENTRIES[INDEX] ;
+      // Oct 2026: no-migration term goes to generated bin and PSUM
+      PZ[IBIN1*NB2+IBIN2] += (XDATA / EFFSIM) ;
+      SUM += (XDATA / EFFSIM) ;
+    }
 
-    if ( INPUTS.DOMIGRATION_FLAG  )
-      { PSIM_WGT = PSIM_SUM[iz][ibin1][ibin2]; }
-    else
-      { PSIM_WGT = 1.0 ; }
+  } // end INDEX loop
 
-    if ( PSIM_WGT <= 0.0 ) {
-      sprintf(c1err,"Invalid PSIM_WGT=%f at iz=%d ibin1=%d ibin2=%d",
-	      PSIM_WGT, iz,ibin1, ibin2);
-      sprintf(c2err,"IBIN1=%d  IBIN2=%d", IBIN1, IBIN2 );
-      errmsg(SEV_FATAL, 0, fnam, c1err, c2err); 
-    }
-    
-    // See Eq. 3 of D'Agonstini NIM A 362, 487 (1995)
-    PROB_MIG = (PSIM * P0 / PSIM_WGT) ;  // P(C_i | E_j)
+  PZSUM_UNFOLD[IZ] = SUM ;
+
+} // end of UNFOLD_ADD_ZBIN
 
-    // Eq. 4 of above
-    PRODUCT = XDATA * PROB_MIG / EFFSIM  ;
 
-    P_UNFOLD[IBIN1][IBIN2] += PRODUCT ;
-    PSUM_UNFOLD += PRODUCT ;
+// =======================================
+void UNFOLD_DUMP(void) {
+
+  // Created Oct 2026
+  // Serial dump for BINDUMP keys; these dumps used to be inside
+  // UNFOLD_ADD, which now runs in threads.
 
-  } // end of imig loop
+  int i, IZ, IBIN1, IBIN2, INDEX, index, NMIGBIN, imig ;
+  MIGRATION_TABLE_DEF *MIG ;
 
+  // --------------- BEGIN ----------------
 
-  if ( !INPUTS.DOMIGRATION_FLAG  ) {
-    XDATA = TABLE[ITYPE_DATA].ENTRIES[INDEX] ;
-    P_UNFOLD[ibin1][ibin2] += (XDATA / EFFSIM) ;
+  for ( i=0; i < INPUTS.NBINDUMP; i++ ) {
+    IZ    = INPUTS.IBINDUMP[i][IPAR_Z] ;
+    IBIN1 = INPUTS.IBINDUMP[i][IPAR_1] ;
+    IBIN2 = INPUTS.IBINDUMP[i][IPAR_2] ;
+    if ( IZ    >= INPUTS.NBIN_PAR[IPAR_Z] ) { continue; }
+    if ( IBIN1 >= INPUTS.NBIN_PAR[IPAR_1] ) { continue; }
+    if ( IBIN2 >= INPUTS.NBIN_PAR[IPAR_2] ) { continue; }
+
+    INDEX = INDEXMAP[IZ][IBIN1][IBIN2] ;
+    if ( TABLE[ITYPE_SIMGEN].ENTRIES[INDEX] <= 0.0 ) { continue; }
+    if ( TABLE[ITYPE_SIMACC].ENTRIES[INDEX] <= 0.0 ) { continue; }
+
+    DMP_UNFOLD(IZ, IBIN1, IBIN2, -1 );
+
+    MIG     = &MIGRATION_TABLE[IZ][IBIN1][IBIN2] ;
+    NMIGBIN = MIG->NMIGBIN ;
+    for ( imig=0; imig < NMIGBIN; imig++ ) {
+      index = INDEXMAP[MIG->IBINZ_NEAR[imig]]
+	[MIG->IBIN1_NEAR[imig]][MIG->IBIN2_NEAR[imig]] ;
+      if ( TABLE[ITYPE_DATA].ENTRIES[index] <= 0.0 ) { continue ; }
+      DMP_UNFOLD(IZ, IBIN1, IBIN2, imig); 
+    }
   }
 
+  return ;
 
-} // end of UNFOLD_ADD
+} // end UNFOLD_DUMP
 
 
 
@@ -183,6 +183,22 @@
  Apr 8 2025
    + speed_flag_chi2 += 4 adds new speed trick to stop chi2(diag) calc when chi2>threshold.
 
+ Oct 2026
+   + new option -adaptive_dchi2 <dchi2> evaluates chi2 on a coarse grid, 
+     then recursively refines only grid cells within dchi2 of chi2min;
+     other cells are filled by multi-linear interpolation of the cell 
+     corners. See wfit_minimize_adaptive.
+
+   + mucovsys_file in text format accepts "diagonal + low-rank" covariance,
+     COV = DIAG + U*U^T, with header line "NDIM NRANK" followed by NDIM rows 
+     of "DIAG U_1 ... U_NRANK". Inverse and log-determinant use the Woodbury
+     identity, so memory and chi2 cost scale as NDIM*NRANK instead of NDIM^2.
+
+   + mucovsys_file in npz format is streamed directly into the cov array
+     (mmap for stored members, chunked inflate for compressed members), 
+     with float32 upper-triangle "cov" from create_covariance.py unpacked 
+     in place. Peak memory is ~NDIM^2 doubles.
+
 *****************************************************************************/
 
 #include <stdlib.h>
@@ -203,6 +219,8 @@
 // ======== global params ==========
 
 #define MXSN 100000 // max number of SN to read & fit
+#define MXRANK_MUCOV      100   // max rank of low-rank mucov (Oct 2026)
+#define MXCHAR_LINE_MUCOV 4000  // max line length in mucov text file
 
 // bit-mask options for speed_flag_chi2
 #define SPEED_MASK_INTERP       1  // interplate r(z) and mu_cos(z)
@@ -248,6 +266,9 @@
 #define DEFAULT_wa_min    -4.0
 #define DEFAULT_wa_max    +4.0
 
+#define NSTRIDE_ADAPTIVE_GRID  8  // coarse-grid stride for -adaptive_dchi2
+#define MXNODE_ADAPTIVE_GRID  500 // max coarse nodes per axis
+
 
 #define OPT_RD_CALC     0  // 0=Planck; 1=compute with constant c_s, 2=c_s(z)
 
@@ -266,6 +287,10 @@ struct INPUTS {
   char string_muerr_ideal[100];
 
   int   speed_flag_chi2; // default = 1; set to 0 to disable
+  double adaptive_dchi2; // >0 -> refine grid only within dchi2 of chi2min
+                         // (or where cell-center chi2 differs from interp
+                         // by > dchi2); a minimum narrower than a coarse
+                         // cell that misses its corners & center is lost
   bool  USE_SPEED_INTERP;  // internal: intero r(z) and mu(z)
   bool  USE_SPEED_SKIP_OFFDIAG; // internal: skip off-diag calc if chi2(diag)>threshold
   bool  USE_SPEED_STOP_DIAG;    // internal: stop diag calc when chi2>threshold
@@ -328,6 +353,18 @@ typedef struct COVMAT {
   double *ARRAY1D ;   // 1D representation of matrix
   int     N_NONZERO ; // number of non-zero elements
   int     NDIM ;      // dimension size  
+
+  // Oct 2026: optional diagonal + low-rank matrix, COV = DIAG + U*U^T
+  bool    IS_LOWRANK ;
+  int     NRANK ;      // number of columns in U
+  double *DIAG ;       // NDIM diagonal elements
+  double *U1D ;        // U[i][r] = U1D[i*NRANK+r]
+  // Woodbury terms from invert_mucovar_lowrank
+  double *DIAGINV ;    // 1/DIAG
+  double *MINV1D ;     // NRANK x NRANK matrix (I + U^T DIAG^-1 U)^-1
+  double *UDINV1 ;     // NRANK vector U^T DIAG^-1 ONE
+  double  CSUM_CORR ;  // UDINV1^T MINV UDINV1 (subtract from ONE^T DIAG^-1 ONE)
+  double  LOGDET ;     // log det(COV)
 } COVMAT_DEF ;
 
 // define workspace
@@ -504,6 +541,8 @@ void sync_HD_LIST(HD_DEF *HD_REF, HD_DEF *HD, COVMAT_DEF *MUCOV);
 void sync_HD_redshifts(HD_DEF *HD0, HD_DEF *HD1) ;
 void compute_MUCOV_FINAL();
 void invert_mucovar(COVMAT_DEF *COV, double sqmurms_add);
+void invert_mucovar_lowrank(COVMAT_DEF *COV);
+void compute_MUCOV_FINAL_LOWRANK(void);
 void check_invertMatrix(int N, double *COV, double *COVINV );
 void set_stepsizes(void);
 void set_Ndof(void);
@@ -512,6 +551,12 @@ void exec_rz_interp(int k, Cosparam *cospar, double *rz, double *dmu);
 void check_refit(void);
 
 void wfit_minimize(void);
+void wfit_minimize_adaptive(int *imin, int *kmin, int *jmin);
+void get_chi2_gridpoint(int i, int kk, int j, int *imin, int *kmin, int *jmin);
+void fill_chi2_gridcell(int *LO, int *HI, char *GRIDFLAG);
+double interp_chi2_gridcell(int *LO, int *HI, int *IND, double ***CHI3D);
+void add_chi2_gridcell(int *LO, int *HI, int *NCELL, int *MXCELL,
+		       int **CELL_LO, int **CELL_HI);
 void prep_speed_skip_offdiag(double extchi_tmp);
 void wfit_normalize(void);
 void wfit_marginalize(void);
@@ -738,6 +783,7 @@ void init_stuff(void) {
   INPUTS.string_muerr_ideal[0] = 0 ;
 
   INPUTS.speed_flag_chi2 = SPEED_FLAG_CHI2_DEFAULT ;
+  INPUTS.adaptive_dchi2  = 0.0 ; // default is dense grid
 
   INPUTS.OMEGA_MATTER_SIM = OMEGA_MATTER_DEFAULT ;
   INPUTS.w0_SIM           = w0_DEFAULT ;
@@ -874,12 +920,16 @@ void print_wfit_help(void) {
     "   -blind_auto\tBlind data, unblind sim; requires ISDATA_REAL in HD file",
     "   -blind_seed\tSeed to pick large random numbers for sin arg ",
     "   -mucovsys_file\tfile with COV_syst e.g., from create_covariance",
+    "\t\t  (text header 'NDIM NRANK' -> rows of DIAG U_1..U_NRANK)",
     "   -mucov_file   \tlegacy key for mucovsys_file",
     "   -mucovtot_inv_file\tfile with inverse of COVTOT",
     "   -ndump_mucov\t dump this many rows/columns of MUCOV and MUCOVINV",
     "   -varname_muerr\t column name with distance errors (default=MUERR)",
     "   -refit\tfit once for sigint then refit with snrms=sigint.", 
     "   -speed_flag_chi2   +=1->interp trick, +=2->skip offdiag, +=4->stop diag",
+    "   -adaptive_dchi2 <dchi2>  refine coarse grid only within dchi2 of chi2min",
+    "                 or where cell-center chi2 differs from interp by > dchi2;",
+    "                 beware: may miss minimum narrower than 8 grid steps",
     "   -debug_flag 91\t compare calc mu(wfit) vs. mu(sim)",
     "   -muerr_ideal  replace all mu with mu_true + Gauss(0,muerr);",
     "                 e.g.,  muerr_ideal 0.1,0.01,0.05 -> "
@@ -1179,6 +1229,8 @@ void parse_args(int argc, char **argv) {
 
       else if (strcasecmp(argv[iarg]+1,"speed_flag_chi2")==0)
 	{ INPUTS.speed_flag_chi2 = atoi(argv[++iarg]); }      
+      else if (strcasecmp(argv[iarg]+1,"adaptive_dchi2")==0)
+	{ INPUTS.adaptive_dchi2 = atof(argv[++iarg]); }      
 
       else {
 	printf("Bad arg: %s\n", argv[iarg]);
@@ -1333,25 +1385,35 @@ void  malloc_HDarrays(int opt, int NSN, HD_DEF *HD) {
   // malloc arrays to store Hubble diagram data
   // opt > 0 -> malloc
   // opt < 0 -> free
+  //
+  // Oct 2026: 
+  //   opt = +2 -> skip cid, mu, mu_sig, mu_ref, z, z_sig that are
+  //               table-owned columns from read_HD.
+  //   opt = -2 -> free those columns, but not the interned cid strings.
 
   int i;
+  bool TABLE_COLUMNS = ( abs(opt) == 2 );
   char fnam[] = "malloc_HDarrays" ;
   
   // --------- BEGIN --------
 
   if ( opt > 0 ) {
-    HD->cid = (char**) malloc( NSN * sizeof(char*) );
-    for(i=0; i < NSN; i++ ) { HD->cid[i] = (char*)malloc( 20*sizeof(char) ); }
+    if ( !TABLE_COLUMNS ) {
+      HD->cid = (char**) malloc( NSN * sizeof(char*) );
+      for(i=0; i < NSN; i++ ) 
+	{ HD->cid[i] = (char*)malloc( 20*sizeof(char) ); }
+
+      HD->mu          = (double *)calloc(NSN,sizeof(double));
+      HD->mu_sig      = (double *)calloc(NSN,sizeof(double));
+      HD->mu_ref      = (double *)calloc(NSN,sizeof(double));
+      HD->z           = (double *)calloc(NSN,sizeof(double));
+      HD->z_sig       = (double *)calloc(NSN,sizeof(double));
+    }
 
     HD->pass_cut    = (bool   *)calloc(NSN,sizeof(bool));
-    HD->mu          = (double *)calloc(NSN,sizeof(double));
-    HD->mu_sig      = (double *)calloc(NSN,sizeof(double));
-    HD->mu_ref      = (double *)calloc(NSN,sizeof(double));
     HD->mu_sim      = (double *)calloc(NSN,sizeof(double));    
     HD->mu_sqsig    = (double *)calloc(NSN,sizeof(double));   
-    HD->z           = (double *)calloc(NSN,sizeof(double));
     HD->logz        = (double *)calloc(NSN,sizeof(double));
-    HD->z_sig       = (double *)calloc(NSN,sizeof(double));
     HD->f_interp    = (double *)calloc(NSN,sizeof(double));
     HD->z_orig      = (double *)calloc(NSN,sizeof(double));        
     
@@ -1372,7 +1434,8 @@ void  malloc_HDarrays(int opt, int NSN, HD_DEF *HD) {
     free(HD->f_interp);
     free(HD->z_orig);    
     free(HD->nfit_perbin); 
-    for(i=0; i < NSN; i++ ) { free(HD->cid[i]); } 
+    if ( !TABLE_COLUMNS ) 
+      { for(i=0; i < NSN; i++ ) { free(HD->cid[i]); } }
     free(HD->cid);
 
     if ( INPUTS.USE_HDIBC )  { free(HD->mu_cospar_biascor); }
@@ -1383,10 +1446,30 @@ void  malloc_HDarrays(int opt, int NSN, HD_DEF *HD) {
 // ==========================
 void malloc_COVMAT(int opt, COVMAT_DEF *COVMAT) {
 
+  // Oct 2026: for low-rank COV, malloc DIAG and U instead of NDIM^2 matrix.
+
   int NDIM = COVMAT->NDIM ;
   long long int MEMD = NDIM * NDIM * sizeof(double);
+  int NRANK = COVMAT->NRANK ;
   // ------------ BEGIN ------------
 
+  if ( COVMAT->IS_LOWRANK ) {
+    if ( opt > 0 ) {
+      COVMAT->DIAG    = (double*) malloc(NDIM * sizeof(double) );
+      COVMAT->U1D     = (double*) malloc(NDIM * NRANK * sizeof(double) );
+      COVMAT->DIAGINV = NULL ;
+      COVMAT->MINV1D  = NULL ;
+      COVMAT->UDINV1  = NULL ;
+    }
+    else {
+      free(COVMAT->DIAG);  free(COVMAT->U1D);
+      if ( COVMAT->DIAGINV ) { free(COVMAT->DIAGINV); }
+      if ( COVMAT->MINV1D  ) { free(COVMAT->MINV1D);  }
+      if ( COVMAT->UDINV1  ) { free(COVMAT->UDINV1);  }
+    }
+    return ;
+  }
+
   if ( opt > 0 )  {
     COVMAT->ARRAY1D = (double*) malloc(MEMD);
   }
@@ -1404,6 +1487,8 @@ void read_HD(int index_HD, char *inFile, HD_DEF *HD) {
   // Refactored routine to read Hubble diagram from fitres-formatted file
   // using SNANA read utilities.
   // Mar 2023: refactor to pass HD struct to enable reading 1 or 2 HDs
+  // Oct 2026: read CID, MU, MUERR, MUREF, zHD, zHDERR as table-owned
+  //           columns (no copy); CID strings are interned.
 
   int IVAR_ROW=-8, IVAR_MU=-8, IVAR_MUERR=-8, IVAR_MUREF;
   int IVAR_zHD=-8, IVAR_zHDERR=-8, IVAR_NFIT=-8 ;
@@ -1412,6 +1497,7 @@ void read_HD(int index_HD, char *inFile, HD_DEF *HD) {
   double rz, mu_cos, ztmp, sigtmp ;
   bool ISDATA_REAL = false ;
   char TBNAME[] = "HD" ;  // table name is Hubble diagram
+  static char BLANK_CID[] = "" ;
   char fnam[] = "read_HD" ;
 
   // --------------- BEGIN --------------
@@ -1424,13 +1510,13 @@ void read_HD(int index_HD, char *inFile, HD_DEF *HD) {
   IFILETYPE = TABLEFILE_OPEN(inFile,"read");
   NVAR_ORIG = SNTABLE_READPREP(IFILETYPE,TBNAME);
 
-  malloc_HDarrays(+1, NROW, HD); 
+  malloc_HDarrays(+2, NROW, HD); // skip arrays read as table columns
 
-  IVAR_ROW   = SNTABLE_READPREP_VARDEF(VARLIST_DEFAULT_CID,
-				       HD->cid, NROW, VBOSE);
+  IVAR_ROW   = SNTABLE_READPREP_COLUMN(VARLIST_DEFAULT_CID, ICAST_C,
+				       NROW, VBOSE);
 
-  IVAR_MU    = SNTABLE_READPREP_VARDEF(VARLIST_DEFAULT_MU, 
-				       HD->mu,  NROW, VBOSE) ;
+  IVAR_MU    = SNTABLE_READPREP_COLUMN(VARLIST_DEFAULT_MU, ICAST_D,
+				       NROW, VBOSE) ;
 
   char STRING_MUERR[100] ;
   if ( strlen(INPUTS.varname_muerr) > 0 )  // command line override
@@ -1438,18 +1524,18 @@ void read_HD(int index_HD, char *inFile, HD_DEF *HD) {
   else
     { sprintf(STRING_MUERR,"%s", VARLIST_DEFAULT_MUERR) ;  }
 
-  IVAR_MUERR = SNTABLE_READPREP_VARDEF(STRING_MUERR,
-                                       HD->mu_sig, NROW, VBOSE) ;
+  IVAR_MUERR = SNTABLE_READPREP_COLUMN(STRING_MUERR, ICAST_D,
+				       NROW, VBOSE) ;
   
-  IVAR_MUREF = SNTABLE_READPREP_VARDEF(VARLIST_DEFAULT_MUREF,
-				       HD->mu_ref, NROW, VBOSE);
+  IVAR_MUREF = SNTABLE_READPREP_COLUMN(VARLIST_DEFAULT_MUREF, ICAST_D,
+				       NROW, VBOSE);
   IVAR_NFIT  = SNTABLE_READPREP_VARDEF(VARLIST_DEFAULT_NFIT,
 				       HD->nfit_perbin, NROW, VBOSE );
   // - - - -
-  IVAR_zHD    = SNTABLE_READPREP_VARDEF(VARLIST_DEFAULT_zHD, 
-					HD->z,     NROW, VBOSE) ;
-  IVAR_zHDERR = SNTABLE_READPREP_VARDEF(VARLIST_DEFAULT_zHDERR,
-					HD->z_sig, NROW, VBOSE) ;
+  IVAR_zHD    = SNTABLE_READPREP_COLUMN(VARLIST_DEFAULT_zHD, ICAST_D,
+					NROW, VBOSE) ;
+  IVAR_zHDERR = SNTABLE_READPREP_COLUMN(VARLIST_DEFAULT_zHDERR, ICAST_D,
+					NROW, VBOSE) ;
 
   // check for required elements
   if ( IVAR_MU < 0 ) {
@@ -1472,6 +1558,24 @@ void read_HD(int index_HD, char *inFile, HD_DEF *HD) {
   // read table ; note that HD.NSN_ORIG = NROW
   HD->NSN_ORIG = SNTABLE_READ_EXEC();
 
+  // take table-owned columns; optional columns that are missing
+  // are allocated here.
+  HD->cid    = SNTABLE_COLUMN_C(IVAR_ROW);
+  HD->mu     = SNTABLE_COLUMN_D(IVAR_MU);
+  HD->mu_sig = SNTABLE_COLUMN_D(IVAR_MUERR);
+  HD->mu_ref = SNTABLE_COLUMN_D(IVAR_MUREF);
+  HD->z      = SNTABLE_COLUMN_D(IVAR_zHD);
+  HD->z_sig  = SNTABLE_COLUMN_D(IVAR_zHDERR);
+
+  if ( HD->cid == NULL ) {
+    HD->cid = (char**) malloc( NROW * sizeof(char*) );
+    for(irow=0; irow < NROW; irow++ ) { HD->cid[irow] = BLANK_CID; }
+  }
+  if ( HD->mu_ref == NULL ) 
+    { HD->mu_ref = (double *)calloc(NROW,sizeof(double)); }
+  if ( HD->z_sig == NULL ) 
+    { HD->z_sig  = (double *)calloc(NROW,sizeof(double)); }
+
 
   // for MUDIF output from BBC, MU is actually MUDIF,
   // so set MU += MUREF
@@ -1832,6 +1936,14 @@ void read_mucov(char *inFile, int imat, COVMAT_DEF *MUCOV ){
   int NDIM_CHECK = applyCut_COVMAT(HD_LIST[imat].pass_cut, MUCOV);
 
   NMAT_store = NDIM_STORE*NDIM_STORE;
+  if ( MUCOV->IS_LOWRANK ) {
+    if ( INPUTS.use_mucov == 2 ) {
+      sprintf(c1err,"Low-rank format not valid for mucovtot_inv_file");
+      sprintf(c2err,"Check %s", inFile);
+      errmsg(SEV_FATAL, 0, fnam, c1err, c2err);
+    }
+    NMAT_store = NDIM_CHECK*NDIM_CHECK ; // no NDIM^2 storage
+  }
 
   printf("\t Read %d non-zero %s elements in %.0f seconds.\n",
 	 MUCOV->N_NONZERO, covtype, dt_read );
@@ -1863,7 +1975,10 @@ void read_mucov(char *inFile, int imat, COVMAT_DEF *MUCOV ){
     for ( i=0; i<NDIM_STORE; i++ )  {
       kk = i*NDIM_STORE + i;
       COV_STAT = HD_LIST[imat].mu_sqsig[i] ;
-      MUCOV->ARRAY1D[kk] += COV_STAT ;
+      if ( MUCOV->IS_LOWRANK ) 
+	{ MUCOV->DIAG[i] += COV_STAT ; }
+      else
+	{ MUCOV->ARRAY1D[kk] += COV_STAT ; }
     }
   } 
 
@@ -1881,15 +1996,20 @@ int read_mucov_text(char *inFile, int NSN,  COVMAT_DEF *MUCOV) {
   //   *inFile   name of file containing cov matrix in text format
   //   *NSN      exect matrix of size NSN**2
   //   *MUCOV    return cov in this structure
+  //
+  // Oct 2026: if first line has two values "NDIM NRANK", read low-rank
+  //   format: NDIM rows of "DIAG U_1 ... U_NRANK" with COV = DIAG + U*U^T.
 
   FILE *fp ;
   int gzipFlag, i0, i1, k0, k1, NSPLIT, j;
   int NROW_read=0, NMAT_read = 0, NDIM_ORIG = 0, NMAT_ORIG=0 ;
   int NMAT_READ_UPDATE = 5000000;  // 5 million
+  int MXSPLIT = MXSPLIT_mucov + MXRANK_MUCOV ;
+  int NRANK = 0, irow, r ;
   time_t  t_start_read, t_read;
   double cov, XM, XMTOT, dt_read;
   bool UPDSTD;
-  char locFile[1000], ctmp[200], **ptrSplit ;
+  char locFile[1000], ctmp[MXCHAR_LINE_MUCOV], **ptrSplit ;
   char fnam[] = "read_mucov_text" ;
 
   // ------------- BEGIN -----------
@@ -1906,8 +2026,8 @@ int read_mucov_text(char *inFile, int NSN,  COVMAT_DEF *MUCOV) {
   }
 
   // allocate strings to read each line ... in case there are comments
-  ptrSplit = (char **)malloc(MXSPLIT_mucov*sizeof(char*));
-  for(j=0;j<MXSPLIT_mucov;j++){
+  ptrSplit = (char **)malloc(MXSPLIT*sizeof(char*));
+  for(j=0;j<MXSPLIT;j++){
     ptrSplit[j]=(char *)malloc(200*sizeof(char));
   }
   
@@ -1915,12 +2035,12 @@ int read_mucov_text(char *inFile, int NSN,  COVMAT_DEF *MUCOV) {
   k0 = k1 = 0 ;
   t_start_read = time(NULL);
   
-  while ( fgets(ctmp, 100, fp) != NULL ) {
+  while ( fgets(ctmp, MXCHAR_LINE_MUCOV, fp) != NULL ) {
     // ignore comment lines 
     if ( commentchar(ctmp) ) { continue; }
     
     // break line into words
-    splitString(ctmp, " ", fnam, MXSPLIT_mucov,  // (I)
+    splitString(ctmp, " ", fnam, MXSPLIT,  // (I)
 		&NSPLIT, ptrSplit);       // (O)
 
     if ( NROW_read == 0 ) {
@@ -1934,12 +2054,39 @@ int read_mucov_text(char *inFile, int NSN,  COVMAT_DEF *MUCOV) {
 	errmsg(SEV_FATAL, 0, fnam, c1err, c2err);
       }
 
+      MUCOV->IS_LOWRANK = ( NSPLIT == 2 );
+      if ( MUCOV->IS_LOWRANK ) {
+	sscanf(ptrSplit[1],"%d",&NRANK);
+	printf("\t Found low-rank COV format: DIAG + U*U^T with NRANK=%d\n",
+	       NRANK);
+	if ( NRANK < 1 || NRANK > MXRANK_MUCOV ) {
+	  sprintf(c1err,"Invalid NRANK=%d for low-rank COV", NRANK);
+	  sprintf(c2err,"Valid NRANK is 1 to %d", MXRANK_MUCOV);
+	  errmsg(SEV_FATAL, 0, fnam, c1err, c2err);
+	}
+      }
+      MUCOV->NRANK   = NRANK ;
       MUCOV->NDIM    = NDIM_ORIG; // read entire COV without cuts
       malloc_COVMAT(+1,MUCOV);
 
       NMAT_ORIG = NDIM_ORIG * NDIM_ORIG ;
+      if ( MUCOV->IS_LOWRANK ) { NMAT_ORIG = NDIM_ORIG * (NRANK+1); }
       XMTOT = (double)(NMAT_ORIG) * 1.0E-6 ;
     }
+    else if ( MUCOV->IS_LOWRANK ) {
+      // each row is DIAG U_1 ... U_NRANK
+      irow = NROW_read - 1;
+      if ( NSPLIT != NRANK+1 || irow >= NDIM_ORIG ) {
+	sprintf(c1err,"Found %d values in low-rank COV row %d", NSPLIT, irow);
+	sprintf(c2err,"Expected NRANK+1=%d values and %d rows", 
+		NRANK+1, NDIM_ORIG );
+	errmsg(SEV_FATAL, 0, fnam, c1err, c2err);
+      }
+      sscanf(ptrSplit[0],"%le", &MUCOV->DIAG[irow] );
+      for(r=0; r < NRANK; r++ ) 
+	{ sscanf(ptrSplit[r+1],"%le", &MUCOV->U1D[irow*NRANK+r] ); }
+      NMAT_read += (NRANK+1) ;
+    }
     else {
       // store entire cov matrix (no cuts yet)
       sscanf( ptrSplit[0],"%le",&cov);
@@ -1963,7 +2110,13 @@ int read_mucov_text(char *inFile, int NSN,  COVMAT_DEF *MUCOV) {
   } // end of read loop
 
   // sanity check
-  if ( NMAT_read != NDIM_ORIG*NDIM_ORIG )  {
+  if ( MUCOV->IS_LOWRANK && NMAT_read != NMAT_ORIG ) {
+    sprintf(c1err,"Read %d low-rank cov elements, but expected %d*%d=%d",
+	    NMAT_read, NDIM_ORIG, NRANK+1, NMAT_ORIG);
+    sprintf(c2err,"Check %s", inFile);
+    errmsg(SEV_FATAL, 0, fnam, c1err, c2err);
+  }
+  else if ( !MUCOV->IS_LOWRANK && NMAT_read != NDIM_ORIG*NDIM_ORIG )  {
     sprintf(c1err,"Read %d cov elements, but expected %d**2=%d",
 	    NMAT_read, NDIM_ORIG, NDIM_ORIG*NDIM_ORIG);
     sprintf(c2err,"Check %s", inFile);
@@ -1980,14 +2133,51 @@ int  read_mucov_npz(char *npz_cov_file, int NSN, COVMAT_DEF *MUCOV) {
 
   // Created Apr 2025
   // Read cov matrix writtin by python in npz format.
+  //
+  // Oct 2026: read "nsn" and "cov" members from create_covariance.py,
+  //   streaming "cov" directly into MUCOV->ARRAY1D (float32 -> double).
+  //   If "cov" is the packed upper triangle, unpack in place.
 
-  int NMAT_read = 0 ;
+  int NMAT_read = 0, NDIM_ORIG, NTRIU ;
+  long long NVAL ;
+  double   dnsn ;
   char fnam[] = "read_mucov_npz" ;
 
   // ---------- BEGIN -----------
 
-  NMAT_read = read_npz_array(npz_cov_file, MUCOV->ARRAY1D);
+  read_npz_array_member(npz_cov_file, "nsn", 1, &dnsn);
+  NDIM_ORIG = (int)dnsn ;
+  printf("\t Found COV dimension %d\n", NDIM_ORIG);
+
+  if ( NDIM_ORIG != NSN ) {
+    sprintf(c1err,"NDIM(COV)=%d does not match NSN=%d ??", NDIM_ORIG, NSN);
+    sprintf(c2err,"Above NDIM is before cuts.");
+    errmsg(SEV_FATAL, 0, fnam, c1err, c2err);
+  }
+
+  MUCOV->IS_LOWRANK = false ;
+  MUCOV->NRANK      = 0 ;
+  MUCOV->NDIM       = NDIM_ORIG; // read entire COV without cuts
+  malloc_COVMAT(+1,MUCOV);
+
+  NVAL  = read_npz_array_member(npz_cov_file, "cov", 
+				(long long)NDIM_ORIG*NDIM_ORIG, 
+				MUCOV->ARRAY1D);
+  NTRIU = NDIM_ORIG*(NDIM_ORIG+1)/2 ;
+
+  if ( NVAL == NTRIU ) {
+    printf("\t Unpack %lld upper-triangle elements\n", NVAL);
+    unpack_triu_array(NDIM_ORIG, MUCOV->ARRAY1D);
+  }
+  else if ( NVAL != (long long)NDIM_ORIG*NDIM_ORIG ) {
+    sprintf(c1err,"Read %lld cov elements, but expected %d**2 or %d",
+	    NVAL, NDIM_ORIG, NTRIU);
+    sprintf(c2err,"Check %s", npz_cov_file);
+    errmsg(SEV_FATAL, 0, fnam, c1err, c2err);
+  }
+  fflush(stdout);
 
+  NMAT_read = NDIM_ORIG*NDIM_ORIG ;
   return NMAT_read;
 
 } // end read_mucov_npz
@@ -2181,6 +2371,8 @@ int applyCut_HD(bool *PASS_CUT_LIST, HD_DEF *HD) {
   // Oct 31 2024:
   //  + adjust mu_ref  ... bug fixes
   //  + adjust new mu_sim
+  //
+  // Oct 2026: copy cid pointer instead of string (interned in read_HD)
   
   int NSN_ORIG = HD->NSN_ORIG;
   int irow, NSN_STORE=0;
@@ -2198,7 +2390,7 @@ int applyCut_HD(bool *PASS_CUT_LIST, HD_DEF *HD) {
     mu_sig      = HD->mu_sig[irow];
     cid         = HD->cid[irow] ;
     
-    sprintf(HD->cid[NSN_STORE], "%s", cid );
+    HD->cid[NSN_STORE]      = cid ; // interned; do not overwrite string
     HD->mu[NSN_STORE]       = HD->mu[irow];      
   
     if ( INPUTS.muerr_force > 0.0 ) { mu_sig = INPUTS.muerr_force; }    
@@ -2253,6 +2445,24 @@ int applyCut_COVMAT(bool *PASS_CUT_LIST, COVMAT_DEF *MUCOV) {
     if ( PASS_CUT_LIST[j] ) { NDIM_STORE++ ; }
   }
 
+  if ( MUCOV->IS_LOWRANK ) {
+    // Oct 2026: keep rows of DIAG and U that pass cuts
+    int r, NRANK = MUCOV->NRANK ;
+    for(j=0; j < NDIM_ORIG; j++ ) {
+      if ( !PASS_CUT_LIST[j] ) { continue; }
+      MUCOV->DIAG[k0] = MUCOV->DIAG[j] ;
+      if ( MUCOV->DIAG[k0] != 0.0 ) { MUCOV->N_NONZERO++ ; }
+      for(r=0; r < NRANK; r++ ) {
+	cov = MUCOV->U1D[j*NRANK+r] ;
+	MUCOV->U1D[k0*NRANK+r] = cov ;
+	if ( cov != 0.0 ) { MUCOV->N_NONZERO++ ; }
+      }
+      k0++ ;
+    }
+    MUCOV->NDIM = NDIM_STORE;
+    return(NDIM_STORE) ;
+  }
+
   for(j=0; j < NDIM_ORIG*NDIM_ORIG; j++ ) {
     cov = MUCOV->ARRAY1D[j];
     if( PASS_CUT_LIST[i0] && PASS_CUT_LIST[i1] ) {
@@ -2283,6 +2493,20 @@ void dump_MUCOV(COVMAT_DEF *MUCOV, char *comment ) {
   
   // dump
   printf("\n DUMP %s \n", comment);
+
+  if ( MUCOV->IS_LOWRANK ) {
+    // Oct 2026: dump DIAG and U for each row
+    int r ;
+    for (i0=0; i0 < NROW; i0++)  {
+      printf("%9.5f | ", MUCOV->DIAG[i0] );
+      for(r=0; r < MUCOV->NRANK && r < MAX_ROW; r++ ) 
+	{ printf("%9.5f ", MUCOV->U1D[i0*MUCOV->NRANK+r] ); }
+      printf("\n");
+    }
+    printf("\n");
+    fflush(stdout);
+    return;
+  }
   
   for (i0=0; i0 < NROW; i0++)  {
       for(i1=0; i1 < NROW; i1++) {
@@ -2447,6 +2671,9 @@ void compute_MUCOV_FINAL(void) {
 
   // ---------- BEGIN ------------
 
+  if ( WORKSPACE.MUCOV[0].IS_LOWRANK ) 
+    { compute_MUCOV_FINAL_LOWRANK(); return; }
+
   WORKSPACE.MUCOV_FINAL.NDIM = NSN ;
   malloc_COVMAT(+1, &WORKSPACE.MUCOV_FINAL);
   
@@ -2461,6 +2688,57 @@ void compute_MUCOV_FINAL(void) {
     return ;
 } // end compute_MUCOV_FINAL
 
+// ==================================
+void compute_MUCOV_FINAL_LOWRANK(void) {
+
+  // Created Oct 2026
+  // Average of low-rank COVs is also low-rank:
+  //   DIAG = fac * sum(DIAG_icov)
+  //   U    = [ sqrt(fac)*U_0, sqrt(fac)*U_1 ] (concatenate columns)
+  // with fac = 1/NMUCOV. 
+
+  int  NSN    = HD_LIST[0].NSN;
+  int  NMUCOV = INPUTS.NMUCOV; 
+  double fac  = 1.0 / (double)NMUCOV ;
+  double sqfac = sqrt(fac);
+  COVMAT_DEF *MUCOV_FINAL = &WORKSPACE.MUCOV_FINAL ;
+  COVMAT_DEF *MUCOV ;
+  int  icov, i, r, r_final, NRANK = 0 ;
+  char fnam[] = "compute_MUCOV_FINAL_LOWRANK" ;
+
+  // ---------- BEGIN ------------
+
+  for(icov = 0; icov < NMUCOV; icov++ ) {
+    MUCOV = &WORKSPACE.MUCOV[icov];
+    if ( !MUCOV->IS_LOWRANK ) {
+      sprintf(c1err,"Cannot mix low-rank and full COV formats.");
+      sprintf(c2err,"Check %s", MUCOV->fileName);
+      errmsg(SEV_FATAL, 0, fnam, c1err, c2err);
+    }
+    NRANK += MUCOV->NRANK ;
+  }
+
+  MUCOV_FINAL->IS_LOWRANK = true ;
+  MUCOV_FINAL->NRANK      = NRANK ;
+  MUCOV_FINAL->NDIM       = NSN ;
+  malloc_COVMAT(+1, MUCOV_FINAL);
+
+  for(i=0; i < NSN; i++ ) {
+    MUCOV_FINAL->DIAG[i] = 0.0 ;
+    r_final = 0 ;
+    for(icov = 0; icov < NMUCOV; icov++ ) {
+      MUCOV = &WORKSPACE.MUCOV[icov];
+      MUCOV_FINAL->DIAG[i] += fac * MUCOV->DIAG[i] ;
+      for(r=0; r < MUCOV->NRANK; r++, r_final++ ) {
+	MUCOV_FINAL->U1D[i*NRANK+r_final] = 
+	  sqfac * MUCOV->U1D[i*MUCOV->NRANK+r] ;
+      }
+    }
+  }
+
+  return ;
+} // end compute_MUCOV_FINAL_LOWRANK
+
 //===================================
 void set_priors(void) {
 
@@ -3247,6 +3525,8 @@ void wfit_minimize(void) {
   // Apr 8 2025: 
   //  + for SPEED flag, replace cpar_fixed with COSPAR_SIM
   //  + check for new STOP_DIAG speed trick
+  //
+  // Oct 2026: option to evaluate adaptive (coarse-to-fine) grid
 
   int Ndof                 = WORKSPACE.Ndof;
   double sig_chi2min_naive = WORKSPACE.sig_chi2min_naive ;
@@ -3256,7 +3536,6 @@ void wfit_minimize(void) {
   bool   USE_SPEED_STOP_DIAG    = INPUTS.USE_SPEED_STOP_DIAG ;
   bool   USE_SPEED_TRICK        = ( USE_SPEED_SKIP_OFFDIAG || USE_SPEED_STOP_DIAG);
 
-  Cosparam cpar;
   // xxx mark  Cosparam cpar_fixed;
   double snchi_tmp, extchi_tmp, mures_tmp ;
 
@@ -3319,31 +3598,17 @@ void wfit_minimize(void) {
   // - - - - - - - - 
   time_t t0 = time(NULL);  // monitor time to build prob grid
 
-  cpar.mushift = 0.0;
+  if ( INPUTS.adaptive_dchi2 > 0.0 ) {
+    // Oct 2026: coarse-to-fine grid
+    wfit_minimize_adaptive(&imin, &kmin, &jmin);
+    goto GET_ATCHIMIN ;
+  }
 
   for( i=0; i < INPUTS.w0_steps; i++){
-    cpar.w0 = INPUTS.w0_min + i*INPUTS.w0_stepsize;
     for( kk=0; kk < INPUTS.wa_steps; kk++){    
-      cpar.wa = (INPUTS.wa_min + kk*INPUTS.wa_stepsize);
       for(j=0; j < INPUTS.omm_steps; j++){
-	cpar.omm = INPUTS.omm_min + j*INPUTS.omm_stepsize; 
-	cpar.ome = 1 - cpar.omm;
-	
-	get_chi2_fit ( cpar.w0, cpar.wa, cpar.omm, INPUTS.sqsnrms, 
-		       temp0_list, temp1_list, temp2_list,
-		       &mures_tmp, &snchi_tmp, &extchi_tmp ); 
 
-	WORKSPACE.snchi3d[i][kk][j]  = snchi_tmp ; 
-	WORKSPACE.extchi3d[i][kk][j] = extchi_tmp ;
-	  
-	// Keep track of minimum chi2 
-	if(snchi_tmp < WORKSPACE.snchi_min) 
-	  { WORKSPACE.snchi_min = snchi_tmp ; }
-	
-	if(extchi_tmp < WORKSPACE.extchi_min)  { 
-	  WORKSPACE.extchi_min = extchi_tmp ;  
-	  imin=i; jmin=j; kmin=kk; 
-	}
+	get_chi2_gridpoint(i, kk, j, &imin, &kmin, &jmin);
 
 	// stdout update with timing information
 	NB++;
@@ -3364,6 +3629,7 @@ void wfit_minimize(void) {
     }  // end of k-loop
   }  // end of i-loop
 
+ GET_ATCHIMIN:
 
   // get w,OM at min chi2 by using more refined grid
   // Pass approx w,OM,  then return w,OM at true min
@@ -3387,6 +3653,361 @@ void wfit_minimize(void) {
 
 } // end wfit_minimize
 
+// ==================================
+void wfit_minimize_adaptive(int *imin, int *kmin, int *jmin) {
+
+  // Created Oct 2026
+  // Coarse-to-fine alternative to the dense grid loop in wfit_minimize.
+  //  1) evaluate chi2 at coarse grid nodes separated by 
+  //     NSTRIDE_ADAPTIVE_GRID steps (plus last node on each axis).
+  //  2) for each cell, if min chi2 among its corners is within
+  //     adaptive_dchi2 of chi2min, split cell in half along each axis
+  //     and evaluate new nodes. Otherwise evaluate chi2 at the cell
+  //     center, and split if the center is within adaptive_dchi2 of
+  //     chi2min or if it differs from the interpolated value by more
+  //     than adaptive_dchi2. Remaining cells are filled with 
+  //     multi-linear interpolation of corner chi2 (fill_chi2_gridcell).
+  //     A minimum narrower than a cell and away from both its corners
+  //     and center can still be missed (see -adaptive_dchi2 help).
+  //  3) repeat on the split cells until cells are a single grid step.
+  // All nodes of snchi3d and extchi3d are thus filled on the same 
+  // grid, so that normalize/marginalize/uncertainty are unchanged.
+  // Output imin,kmin,jmin are grid indices at min chi2(SN+prior).
+
+  int    N[3]  = { INPUTS.w0_steps, INPUTS.wa_steps, INPUTS.omm_steps };
+  int    NBTOT = N[0] * N[1] * N[2] ;
+  double dchi2 = INPUTS.adaptive_dchi2 ;
+  int    NSTRIDE = NSTRIDE_ADAPTIVE_GRID ;
+
+  char   *GRIDFLAG ;  // 0=unset, 1=interpolated, 2=evaluated
+  int    *CELL_LO[2], *CELL_HI[2], NCELL[2], MXCELL[2] ;
+  int    NNODE[3], NODE[3][MXNODE_ADAPTIVE_GRID] ;
+  int    NPT[3], PT[3][3], LO[3], HI[3], MID[3], ind[3] ;
+  int    a, n, c, icell, icur, inext, level, NEVAL, NSPLIT, NFILL ;
+  int    i, kk, j, igrid ;
+  double chi2, chi2_corner_min, chi2_cut, chi2_mid, chi2_interp ;
+  bool   HAS_MID, DO_FILL ;
+  time_t t0 = time(NULL);
+  char   comment[100];
+  char   fnam[] = "wfit_minimize_adaptive" ;
+
+  // ------------ BEGIN ------------
+
+  printf("   Adaptive grid: stride=%d, refine cells within dchi2 < %.1f \n",
+	 NSTRIDE, dchi2 );
+  fflush(stdout);
+
+  GRIDFLAG = (char*) calloc(NBTOT, sizeof(char));
+  NEVAL    = 0 ;
+
+  // coarse nodes along each axis
+  for(a=0; a < 3; a++ ) {
+    if ( N[a]/NSTRIDE + 2 > MXNODE_ADAPTIVE_GRID ) {
+      sprintf(c1err,"%d grid steps (axis %d) exceeds bound for", N[a], a);
+      sprintf(c2err,"MXNODE_ADAPTIVE_GRID=%d and stride=%d",
+	      MXNODE_ADAPTIVE_GRID, NSTRIDE);
+      errmsg(SEV_FATAL, 0, fnam, c1err, c2err);
+    }
+    NNODE[a] = 0 ;
+    for(n=0; n < N[a]; n += NSTRIDE ) 
+      { NODE[a][NNODE[a]] = n;  NNODE[a]++ ; }
+    if ( NODE[a][NNODE[a]-1] != N[a]-1 ) 
+      { NODE[a][NNODE[a]] = N[a]-1;  NNODE[a]++ ; }
+  }
+
+  // evaluate coarse nodes
+  for(ind[0]=0; ind[0] < NNODE[0]; ind[0]++ ) {
+    for(ind[1]=0; ind[1] < NNODE[1]; ind[1]++ ) {
+      for(ind[2]=0; ind[2] < NNODE[2]; ind[2]++ ) {
+	i  = NODE[0][ind[0]];  kk = NODE[1][ind[1]];  j = NODE[2][ind[2]];
+	get_chi2_gridpoint(i, kk, j, imin, kmin, jmin);
+	GRIDFLAG[(i*N[1] + kk)*N[2] + j] = 2 ;  NEVAL++ ;
+      }
+    }
+  }
+
+  // coarse cells between adjacent nodes; single node -> zero-width
+  for(icur=0; icur < 2; icur++ ) {
+    MXCELL[icur]  = 1000 ;
+    NCELL[icur]   = 0 ;
+    CELL_LO[icur] = (int*) malloc(3*MXCELL[icur]*sizeof(int));
+    CELL_HI[icur] = (int*) malloc(3*MXCELL[icur]*sizeof(int));
+  }
+  icur = 0 ;
+
+  int NTMP[3];
+  for(a=0; a < 3; a++ ) 
+    { NTMP[a] = ( NNODE[a] > 1 ) ? NNODE[a]-1 : 1 ; }
+
+  for(ind[0]=0; ind[0] < NTMP[0]; ind[0]++ ) {
+    for(ind[1]=0; ind[1] < NTMP[1]; ind[1]++ ) {
+      for(ind[2]=0; ind[2] < NTMP[2]; ind[2]++ ) {
+	for(a=0; a < 3; a++ ) {
+	  LO[a] = NODE[a][ind[a]] ;
+	  HI[a] = ( NNODE[a] > 1 ) ? NODE[a][ind[a]+1] : LO[a] ;
+	}
+	add_chi2_gridcell(LO, HI, &NCELL[icur], &MXCELL[icur],
+			  &CELL_LO[icur], &CELL_HI[icur] );
+      }
+    }
+  }
+
+  // - - - - - - - 
+  // refine level by level
+  level = 0 ;
+  while ( NCELL[icur] > 0 ) {
+
+    inext = 1 - icur ;
+    NCELL[inext] = NSPLIT = NFILL = 0 ;
+
+    for(icell=0; icell < NCELL[icur]; icell++ ) {
+
+      for(a=0; a < 3; a++ ) {
+	LO[a] = CELL_LO[icur][3*icell+a] ;
+	HI[a] = CELL_HI[icur][3*icell+a] ;
+      }
+
+      // min chi2 among 8 corners
+      chi2_corner_min = 1.0E20 ;
+      for(c=0; c < 8; c++ ) {
+	i  = (c & 1) ? HI[0] : LO[0] ;
+	kk = (c & 2) ? HI[1] : LO[1] ;
+	j  = (c & 4) ? HI[2] : LO[2] ;
+	chi2 = WORKSPACE.extchi3d[i][kk][j] ;
+	if ( chi2 < chi2_corner_min ) { chi2_corner_min = chi2; }
+      }
+
+      // note that chi2min only decreases, so cut is never too tight
+      chi2_cut = WORKSPACE.extchi_min + dchi2 ;
+      if ( chi2_corner_min > chi2_cut ) {
+
+	// check interpolation error at cell center
+	DO_FILL = true ;  HAS_MID = false ;
+	for(a=0; a < 3; a++ ) {
+	  MID[a] = (LO[a]+HI[a])/2 ;
+	  if ( MID[a] > LO[a] ) { HAS_MID = true; }
+	}
+	if ( HAS_MID ) {
+	  chi2_interp = interp_chi2_gridcell(LO, HI, MID, WORKSPACE.extchi3d);
+	  igrid = (MID[0]*N[1] + MID[1])*N[2] + MID[2] ;
+	  if ( GRIDFLAG[igrid] < 2 ) {
+	    get_chi2_gridpoint(MID[0], MID[1], MID[2], imin, kmin, jmin);
+	    GRIDFLAG[igrid] = 2 ;  NEVAL++ ;
+	  }
+	  chi2_mid = WORKSPACE.extchi3d[MID[0]][MID[1]][MID[2]] ;
+	  chi2_cut = WORKSPACE.extchi_min + dchi2 ;
+	  if ( chi2_mid <= chi2_cut || 
+	       fabs(chi2_mid - chi2_interp) > dchi2 ) { DO_FILL = false; }
+	}
+
+	if ( DO_FILL ) {
+	  fill_chi2_gridcell(LO, HI, GRIDFLAG);
+	  NFILL++ ;  continue ;
+	}
+      }
+
+      // split cell: along each axis, points are lo,mid,hi
+      NSPLIT++ ;
+      for(a=0; a < 3; a++ ) {
+	NPT[a] = 0 ;
+	PT[a][NPT[a]++] = LO[a] ;
+	if ( HI[a] - LO[a] > 1 ) { PT[a][NPT[a]++] = (LO[a]+HI[a])/2 ; }
+	if ( HI[a] > LO[a]     ) { PT[a][NPT[a]++] = HI[a] ; }
+      }
+
+      for(ind[0]=0; ind[0] < NPT[0]; ind[0]++ ) {
+	for(ind[1]=0; ind[1] < NPT[1]; ind[1]++ ) {
+	  for(ind[2]=0; ind[2] < NPT[2]; ind[2]++ ) {
+	    i  = PT[0][ind[0]];  kk = PT[1][ind[1]];  j = PT[2][ind[2]];
+	    igrid = (i*N[1] + kk)*N[2] + j ;
+	    if ( GRIDFLAG[igrid] < 2 ) {
+	      get_chi2_gridpoint(i, kk, j, imin, kmin, jmin);
+	      GRIDFLAG[igrid] = 2 ;  NEVAL++ ;
+	    }
+	  }
+	}
+      }
+
+      // store sub-cells that are still wider than one grid step
+      for(a=0; a < 3; a++ ) 
+	{ NTMP[a] = ( NPT[a] > 1 ) ? NPT[a]-1 : 1 ; }
+
+      for(ind[0]=0; ind[0] < NTMP[0]; ind[0]++ ) {
+	for(ind[1]=0; ind[1] < NTMP[1]; ind[1]++ ) {
+	  for(ind[2]=0; ind[2] < NTMP[2]; ind[2]++ ) {
+	    for(a=0; a < 3; a++ ) {
+	      LO[a] = PT[a][ind[a]] ;
+	      HI[a] = ( NPT[a] > 1 ) ? PT[a][ind[a]+1] : LO[a] ;
+	    }
+	    if ( HI[0]-LO[0] > 1 || HI[1]-LO[1] > 1 || HI[2]-LO[2] > 1 ) {
+	      add_chi2_gridcell(LO, HI, &NCELL[inext], &MXCELL[inext],
+				&CELL_LO[inext], &CELL_HI[inext] );
+	    }
+	  }
+	}
+      }
+
+    } // end icell
+
+    sprintf(comment,"level %d: split %d cells, fill %d cells, NEVAL=%d",
+	    level, NSPLIT, NFILL, NEVAL );
+    print_elapsed_time(t0, comment, UNIT_TIME_SECOND);
+
+    icur = inext ;  level++ ;
+  } // end while
+
+  printf("   Adaptive grid: evaluated chi2 at %d of %d grid points "
+	 "(%.2f %%)\n", NEVAL, NBTOT, 100.0*(double)NEVAL/(double)NBTOT );
+  fflush(stdout);
+
+  for(icur=0; icur < 2; icur++ ) 
+    { free(CELL_LO[icur]);  free(CELL_HI[icur]); }
+  free(GRIDFLAG);
+
+  return ;
+
+} // end wfit_minimize_adaptive
+
+
+// ==================================
+void add_chi2_gridcell(int *LO, int *HI, int *NCELL, int *MXCELL,
+		       int **CELL_LO, int **CELL_HI) {
+
+  // Created Oct 2026
+  // Append cell LO[3],HI[3] to cell list; extend list if needed.
+
+  int a, n = *NCELL ;
+
+  // ------------ BEGIN ------------
+
+  if ( n >= *MXCELL ) {
+    *MXCELL *= 2 ;
+    *CELL_LO = (int*) realloc(*CELL_LO, 3*(*MXCELL)*sizeof(int));
+    *CELL_HI = (int*) realloc(*CELL_HI, 3*(*MXCELL)*sizeof(int));
+  }
+
+  for(a=0; a < 3; a++ ) {
+    (*CELL_LO)[3*n+a] = LO[a] ;
+    (*CELL_HI)[3*n+a] = HI[a] ;
+  }
+  (*NCELL)++ ;
+
+  return ;
+
+} // end add_chi2_gridcell
+
+
+// ==================================
+void get_chi2_gridpoint(int i, int kk, int j, int *imin, int *kmin, int *jmin) {
+
+  // Created Oct 2026
+  // Evaluate chi2 at grid point i,kk,j (w0,wa,omm) and store in
+  // snchi3d & extchi3d; update chi2 minimum and its grid indices.
+  // Used by both the dense and adaptive grids in wfit_minimize.
+
+  Cosparam cpar;
+  double snchi_tmp, extchi_tmp, mures_tmp ;
+
+  // ------------ BEGIN ------------
+
+  cpar.mushift = 0.0;
+  cpar.w0  = INPUTS.w0_min  + i  * INPUTS.w0_stepsize;
+  cpar.wa  = INPUTS.wa_min  + kk * INPUTS.wa_stepsize;
+  cpar.omm = INPUTS.omm_min + j  * INPUTS.omm_stepsize; 
+  cpar.ome = 1 - cpar.omm;
+
+  get_chi2_fit ( cpar.w0, cpar.wa, cpar.omm, INPUTS.sqsnrms, 
+		 temp0_list, temp1_list, temp2_list,
+		 &mures_tmp, &snchi_tmp, &extchi_tmp ); 
+
+  WORKSPACE.snchi3d[i][kk][j]  = snchi_tmp ; 
+  WORKSPACE.extchi3d[i][kk][j] = extchi_tmp ;
+
+  if ( snchi_tmp < WORKSPACE.snchi_min ) 
+    { WORKSPACE.snchi_min = snchi_tmp ; }
+
+  if ( extchi_tmp < WORKSPACE.extchi_min )  { 
+    WORKSPACE.extchi_min = extchi_tmp ;  
+    *imin = i;  *kmin = kk;  *jmin = j; 
+  }
+
+  return ;
+
+} // end get_chi2_gridpoint
+
+
+// ==================================
+void fill_chi2_gridcell(int *LO, int *HI, char *GRIDFLAG) {
+
+  // Created Oct 2026
+  // For grid cell with corners LO[3],HI[3] (index of w0,wa,omm),
+  // fill snchi3d & extchi3d at nodes that are not yet set
+  // (GRIDFLAG=0) by multi-linear interpolation of 8 corner values.
+  // Used by wfit_minimize_adaptive for cells far from chi2min, 
+  // where probability is negligible.
+
+  int  N1 = INPUTS.wa_steps, N2 = INPUTS.omm_steps ;
+  int  i, kk, j, igrid ;
+  int  IND[3] ;
+
+  // ------------ BEGIN ------------
+
+  for(i=LO[0]; i <= HI[0]; i++ ) {
+    for(kk=LO[1]; kk <= HI[1]; kk++ ) {
+      for(j=LO[2]; j <= HI[2]; j++ ) {
+
+	igrid = (i*N1 + kk)*N2 + j ;
+	if ( GRIDFLAG[igrid] > 0 ) { continue; }
+
+	IND[0] = i;  IND[1] = kk;  IND[2] = j;
+	WORKSPACE.snchi3d[i][kk][j]  = 
+	  interp_chi2_gridcell(LO, HI, IND, WORKSPACE.snchi3d);
+	WORKSPACE.extchi3d[i][kk][j] = 
+	  interp_chi2_gridcell(LO, HI, IND, WORKSPACE.extchi3d);
+	GRIDFLAG[igrid] = 1 ;
+      }
+    }
+  }
+
+  return ;
+
+} // end fill_chi2_gridcell
+
+
+// ==================================
+double interp_chi2_gridcell(int *LO, int *HI, int *IND, double ***CHI3D) {
+
+  // Created Oct 2026
+  // Return multi-linear interpolation of CHI3D at grid index IND[3]
+  // from the 8 corners (LO[3],HI[3]) of its grid cell.
+
+  int    c, a, ic, kc, jc ;
+  double T[3], wgt, chi2 = 0.0 ;
+
+  // ------------ BEGIN ------------
+
+  for(a=0; a < 3; a++ ) {
+    T[a] = 0.0 ;
+    if ( HI[a] > LO[a] ) 
+      { T[a] = (double)(IND[a]-LO[a]) / (double)(HI[a]-LO[a]); }
+  }
+
+  for(c=0; c < 8; c++ ) {
+    wgt  = (c & 1) ? T[0] : 1.0-T[0] ;
+    wgt *= (c & 2) ? T[1] : 1.0-T[1] ;
+    wgt *= (c & 4) ? T[2] : 1.0-T[2] ;
+    if ( wgt == 0.0 ) { continue; }
+    ic  = (c & 1) ? HI[0] : LO[0] ;
+    kc  = (c & 2) ? HI[1] : LO[1] ;
+    jc  = (c & 4) ? HI[2] : LO[2] ;
+    chi2 += wgt * CHI3D[ic][kc][jc] ;
+  }
+
+  return chi2 ;
+
+} // end interp_chi2_gridcell
+
+
 
 // =============================
 void prep_speed_skip_offdiag(double chi2min_approx) {
@@ -4053,6 +4674,8 @@ void invert_mucovar(COVMAT_DEF *MUCOV, double sqmurms_add) {
     return;
   }
 
+  if ( MUCOV->IS_LOWRANK ) { invert_mucovar_lowrank(MUCOV); return; }
+
   // - - - - - -
   printf("\t Invert %d x %d mucov matrix with COV_DIAG += %f \n", 
 	 NSN, NSN, sqmurms_add);
@@ -4102,6 +4725,111 @@ void invert_mucovar(COVMAT_DEF *MUCOV, double sqmurms_add) {
 
 } // end of invert_mucovar
 
+// =========================================
+void invert_mucovar_lowrank(COVMAT_DEF *MUCOV) {
+
+  // Created Oct 2026
+  // For COV = D + U*U^T (D diagonal, U is NDIM x NRANK), 
+  // prepare Woodbury terms so that chi2 never needs NDIM^2 storage:
+  //    COV^-1 = D^-1 - D^-1 U MINV U^T D^-1 
+  //    MINV   = (I + U^T D^-1 U)^-1            [NRANK x NRANK]
+  //    log det(COV) = sum(log D) + log det(I + U^T D^-1 U)
+  //
+  // Cost is NDIM*NRANK^2 here, and NDIM*NRANK per chi2 evaluation.
+
+  int  NSN   = MUCOV->NDIM ;
+  int  NRANK = MUCOV->NRANK ;
+  int  i, r1, r2, r3 ;
+  double dinv, sum, logdet_D = 0.0, logdet_M = 0.0 ;
+  double *M1D, *L1D ;
+  time_t t0;
+  int LDMP_MUCOV = INPUTS.ndump_mucov > 0 ;
+  char fnam[] = "invert_mucovar_lowrank" ;
+
+  // ---------------- BEGIN --------------
+
+  printf("\t Woodbury inverse of %d x %d mucov = DIAG + U*U^T (NRANK=%d)\n",
+	 NSN, NSN, NRANK );
+  fflush(stdout);
+
+  if ( LDMP_MUCOV ) { dump_MUCOV(MUCOV,"MUCOV(DIAG | U)"); }
+
+  if ( strlen(INPUTS.outFile_mucovtot_inv) > 0 ) {
+    sprintf(c1err,"outfile_mucovtot_inv not available for low-rank COV");
+    sprintf(c2err,"Remove outfile_mucovtot_inv arg.");
+    errmsg(SEV_FATAL, 0, fnam, c1err, c2err);
+  }
+
+  t0 = time(NULL);
+
+  MUCOV->DIAGINV = (double*) malloc(NSN * sizeof(double) );
+  MUCOV->MINV1D  = (double*) malloc(NRANK * NRANK * sizeof(double) );
+  MUCOV->UDINV1  = (double*) malloc(NRANK * sizeof(double) );
+  M1D            = MUCOV->MINV1D ;
+  L1D            = (double*) malloc(NRANK * NRANK * sizeof(double) );
+
+  for(r1=0; r1 < NRANK; r1++ ) {
+    MUCOV->UDINV1[r1] = 0.0 ;
+    for(r2=0; r2 < NRANK; r2++ ) 
+      { M1D[r1*NRANK+r2] = ( r1 == r2 ) ? 1.0 : 0.0 ; }
+  }
+
+  for(i=0; i < NSN; i++ ) {
+    if ( MUCOV->DIAG[i] <= 0.0 ) {
+      sprintf(c1err,"Invalid DIAG[%d] = %le for low-rank COV", 
+	      i, MUCOV->DIAG[i] );
+      sprintf(c2err,"DIAG must be > 0 to use Woodbury inverse");
+      errmsg(SEV_FATAL, 0, fnam, c1err, c2err);
+    }
+    dinv = 1.0 / MUCOV->DIAG[i] ;
+    MUCOV->DIAGINV[i] = dinv ;
+    logdet_D += log(MUCOV->DIAG[i]);
+
+    for(r1=0; r1 < NRANK; r1++ ) {
+      MUCOV->UDINV1[r1] += MUCOV->U1D[i*NRANK+r1] * dinv ;
+      for(r2=r1; r2 < NRANK; r2++ ) {
+	M1D[r1*NRANK+r2] += 
+	  MUCOV->U1D[i*NRANK+r1] * dinv * MUCOV->U1D[i*NRANK+r2] ;
+      }
+    }
+  }
+
+  for(r1=0; r1 < NRANK; r1++ ) {
+    for(r2=0; r2 < r1; r2++ ) { M1D[r1*NRANK+r2] = M1D[r2*NRANK+r1]; }
+  }
+
+  // log det of (I + U^T D^-1 U) from Cholesky; matrix is pos-definite
+  for(r1=0; r1 < NRANK; r1++ ) {
+    for(r2=0; r2 <= r1; r2++ ) {
+      sum = M1D[r1*NRANK+r2] ;
+      for(r3=0; r3 < r2; r3++ ) { sum -= L1D[r1*NRANK+r3]*L1D[r2*NRANK+r3]; }
+      if ( r1 == r2 ) 
+	{ L1D[r1*NRANK+r1] = sqrt(sum);  logdet_M += log(sum); }
+      else
+	{ L1D[r1*NRANK+r2] = sum / L1D[r2*NRANK+r2] ; }
+    }
+  }
+  free(L1D);
+
+  invertMatrix(NRANK, NRANK, M1D); // M1D -> MINV
+
+  MUCOV->CSUM_CORR = 0.0 ;
+  for(r1=0; r1 < NRANK; r1++ ) {
+    for(r2=0; r2 < NRANK; r2++ ) {
+      MUCOV->CSUM_CORR += 
+	MUCOV->UDINV1[r1] * M1D[r1*NRANK+r2] * MUCOV->UDINV1[r2] ;
+    }
+  }
+
+  MUCOV->LOGDET = logdet_D + logdet_M ;
+  printf("\t log det(MUCOV) = %.4f \n", MUCOV->LOGDET );
+  print_elapsed_time(t0, "Woodbury inverse", UNIT_TIME_SECOND);
+  fflush(stdout);
+
+  return ;
+
+} // end invert_mucovar_lowrank
+
 
 // =========================================
 void check_invertMatrix(int N, double *COV, double *COVINV ) {
@@ -4168,6 +4896,9 @@ void get_chi2_fit (
   //
   // Apr 8 2025: 
   //   + implement additional STOP_DIAG speedup by bailing on chi2_diag calc early
+  //
+  // Oct 2026: for low-rank MUCOV, use Woodbury terms (NSN*NRANK cost);
+  //           STOP_DIAG is disabled since Woodbury is applied after diag.
 
   bool USE_SPEED_INTERP       = INPUTS.USE_SPEED_INTERP ;
   bool USE_SPEED_SKIP_OFFDIAG = INPUTS.USE_SPEED_SKIP_OFFDIAG ;
@@ -4197,6 +4928,17 @@ void get_chi2_fit (
 
   bool do_offdiag=false,  skip_offdiag;
 
+  // low-rank COV = D + U*U^T
+  COVMAT_DEF *MUCOV_FINAL = &WORKSPACE.MUCOV_FINAL ;
+  bool   IS_LOWRANK = ( use_mucov && MUCOV_FINAL->IS_LOWRANK );
+  int    NRANK = 0, r, r2 ;
+  double *UDINV_dmu = NULL, MINV ; // U^T D^-1 dmu
+  if ( IS_LOWRANK ) {
+    NRANK     = MUCOV_FINAL->NRANK ;
+    UDINV_dmu = (double*) calloc(NRANK, sizeof(double) );
+    USE_SPEED_STOP_DIAG = false ; // early exit would skip Woodbury terms
+  }
+
   // rz-interp variables
   int n_logz, iz;
   double z ;
@@ -4286,7 +5028,12 @@ void get_chi2_fit (
     dmu_list[k] = mu_obs - mu_cos; 
 
     n_count++ ;
-    if ( use_mucov ) {
+    if ( IS_LOWRANK ) {
+      sqmusiginv = MUCOV_FINAL->DIAGINV[k];
+      for(r=0; r < NRANK; r++ ) 
+	{ UDINV_dmu[r] += MUCOV_FINAL->U1D[k*NRANK+r]*sqmusiginv*dmu_list[k]; }
+    }
+    else if ( use_mucov ) {
       sqmusiginv = WORKSPACE.MUCOV_FINAL.ARRAY1D[k*(NSN+1)]; 
     }
     else {
@@ -4327,6 +5074,20 @@ void get_chi2_fit (
     }
   }
 
+  // - - - - - - - - - - -  - - 
+  // low-rank: Woodbury correction costs only NRANK^2, so always apply
+  if ( IS_LOWRANK ) {
+    for(r=0; r < NRANK; r++ ) {
+      for(r2=0; r2 < NRANK; r2++ ) {
+	MINV     = MUCOV_FINAL->MINV1D[r*NRANK+r2] ;
+	chi_hat -= UDINV_dmu[r]            * MINV * UDINV_dmu[r2] ;
+	Bsum    -= MUCOV_FINAL->UDINV1[r] * MINV * UDINV_dmu[r2] ;
+      }
+    }
+    Csum -= MUCOV_FINAL->CSUM_CORR ;
+    do_offdiag = false ;
+  }
+
   // - - - - - - - - - - -  - - 
   // add off-diag elements if using cov matrix
   if ( do_offdiag ) {
@@ -4378,6 +5139,7 @@ void get_chi2_fit (
 
   free(rz_list);
   free(dmu_list);
+  if ( IS_LOWRANK ) { free(UDINV_dmu); }
 
   return ;
 